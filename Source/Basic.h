@@ -32,6 +32,12 @@ Licensed under https://github.com/vczh-libraries/License
 #define VCZH_ARM
 #endif
 
+#if defined VCZH_MSVC
+#define VCZH_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define VCZH_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
 #if defined VCZH_MSVC
 #define VCZH_WCHAR_UTF16
 #elif defined VCZH_GCC
@@ -131,6 +137,8 @@ x86 and x64 Compatbility
 	typedef vint64_t				pos_t;
 	/// <summary>Signed atomic integer.</summary>
 	typedef std::atomic<vint>		atomic_vint;
+	/// <summary>Size of a cache line in bytes, data written by different threads should be kept in different cache lines.</summary>
+	constexpr vint					CacheLineSize = 64;
 
 #define INCRC(ATOMIC) ((ATOMIC)->fetch_add(1) + 1)
 #define DECRC(ATOMIC) ((ATOMIC)->fetch_sub(1) - 1)
@@ -244,6 +252,78 @@ Type Traits
 		}
 	};
 
+	/// <summary>Mix bits of a value, so that every bit in the result depends on every bit in the value.</summary>
+	/// <returns>The mixed value.</returns>
+	/// <param name="value">The value to mix.</param>
+	inline vuint64_t MixHashCode(vuint64_t value)
+	{
+		value ^= value >> 33;
+		value *= 0xFF51AFD7ED558CCDULL;
+		value ^= value >> 33;
+		value *= 0xC4CEB9FE1A85EC53ULL;
+		value ^= value >> 33;
+		return value;
+	}
+
+	/// <summary>Combine two hash codes.</summary>
+	/// <returns>The combined hash code.</returns>
+	/// <param name="seed">The first hash code.</param>
+	/// <param name="value">The second hash code.</param>
+	inline vuint64_t CombineHashCode(vuint64_t seed, vuint64_t value)
+	{
+		return MixHashCode(seed ^ (value + 0x9E3779B97F4A7C15ULL + (seed << 6) + (seed >> 2)));
+	}
+
+	/// <summary>Type for computing hash codes of values for hash containers. Integers, enums and pointers are supported.</summary>
+	/// <typeparam name="T">The type of values.</typeparam>
+	/// <remarks>
+	/// Specialize this type to support other types.
+	/// Hash containers compute hash codes of representative values from <see cref="KeyType`1"/>, equal values must have the same hash code.
+	/// </remarks>
+	template<typename T>
+	struct Hasher
+	{
+		/// <summary>Compute the hash code of a value.</summary>
+		/// <returns>The hash code.</returns>
+		/// <param name="value">The value.</param>
+		static vuint64_t GetHashCode(const T& value)
+			requires(std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>)
+		{
+			if constexpr (std::is_pointer_v<T>)
+			{
+				return MixHashCode((vuint64_t)(vuint)value);
+			}
+			else
+			{
+				return MixHashCode((vuint64_t)value);
+			}
+		}
+	};
+
+	/// <summary>Test if hash codes could be computed for a type using <see cref="Hasher`1"/>.</summary>
+	/// <typeparam name="T">The type of values.</typeparam>
+	template<typename T>
+	concept Hashable = requires(const T& value)
+	{
+		Hasher<T>::GetHashCode(value);
+	};
+
+	/// <summary>
+	/// Type for specifying if a value could be relocated by copying its memory, without calling the move constructor on the new place and the destructor on the old place.
+	/// Containers relocate such values in bulk when they grow or shift their buffers.
+	/// </summary>
+	/// <remarks>
+	/// Trivially copyable types are relocatable.
+	/// A type could opt in by specializing this type, only when no value keeps a pointer to itself or to its members.
+	/// </remarks>
+	/// <typeparam name="T">The element type for containers.</typeparam>
+	template<typename T>
+	struct TriviallyRelocatable
+	{
+		/// <summary>True if values of this type could be relocated by copying memory.</summary>
+		static constexpr bool Value = std::is_trivially_move_constructible_v<T> && std::is_trivially_destructible_v<T>;
+	};
+
 	namespace ordering_decision
 	{
 		template<bool PO, bool WO, bool SO>
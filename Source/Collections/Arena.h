@@ -0,0 +1,354 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_ARENA
+#define VCZH_COLLECTIONS_ARENA
+
+#include <string.h>
+#include <cstddef>
+#include "../Basic.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+
+/***********************************************************************
+Arena
+***********************************************************************/
+
+		/// <summary>
+		/// A bump allocator that allocates memory from blocks.
+		/// Memory is not released one by one, instead all memory allocated after a <see cref="Arena::Marker"/> is released together by <see cref="Arena::Rewind"/>,
+		/// or all memory is released by <see cref="Arena::Reset"/>.
+		/// Objects created by <see cref="Arena::New`2"/> are destructed in the reverse order when their memory is released.
+		/// </summary>
+		/// <remarks>
+		/// The size of a block is a power of two.
+		/// An allocation that is larger than the block size gets its own block.
+		/// </remarks>
+		class Arena : public Object
+		{
+		protected:
+			struct Block
+			{
+				Block*						previous;
+				vint						size;
+
+				char* Begin()
+				{
+					return (char*)(this + 1);
+				}
+
+				char* End()
+				{
+					return (char*)this + size;
+				}
+			};
+
+			struct Destructor
+			{
+				Destructor*					previous;
+				void						(*destructor)(void*);
+				void*						object;
+			};
+
+			vint							blockSize;
+			Block*							block = nullptr;
+			char*							position = nullptr;
+			Destructor*						destructors = nullptr;
+
+			static vint RoundUpToPowerOfTwo(vint size)
+			{
+				vint result = 1;
+				while (result < size)
+				{
+					result <<= 1;
+				}
+				return result;
+			}
+
+			static char* AlignUp(char* address, vint alignment)
+			{
+				return (char*)(((vuint)address + (vuint)alignment - 1) & ~((vuint)alignment - 1));
+			}
+
+			void AllocateBlock(vint size, vint alignment)
+			{
+				vint requiredSize = (vint)sizeof(Block) + size + alignment;
+				vint newBlockSize = requiredSize <= blockSize ? blockSize : RoundUpToPowerOfTwo(requiredSize);
+				auto newBlock = (Block*)malloc(newBlockSize);
+				CHECK_ERROR(newBlock != nullptr, L"vl::collections::Arena::AllocateBlock(vint, vint)#Failed to allocate memory.");
+				newBlock->previous = block;
+				newBlock->size = newBlockSize;
+				block = newBlock;
+				position = newBlock->Begin();
+			}
+
+			template<typename T>
+			static void CallDestructor(void* object)
+			{
+				((T*)object)->~T();
+			}
+
+		public:
+			/// <summary>A position in an arena, to release all memory that is allocated after it.</summary>
+			struct Marker
+			{
+				Block*						block = nullptr;
+				char*						position = nullptr;
+				Destructor*					destructors = nullptr;
+			};
+
+			NOT_COPYABLE(Arena);
+
+			/// <summary>Create an arena.</summary>
+			/// <param name="_blockSize">The size of a block, it is rounded up to a power of two.</param>
+			Arena(vint _blockSize = 65536)
+				: blockSize(RoundUpToPowerOfTwo(_blockSize < 256 ? 256 : _blockSize))
+			{
+			}
+
+			~Arena()
+			{
+				Reset();
+				if (block)
+				{
+					free(block);
+				}
+			}
+
+			/// <summary>Get the size of a block.</summary>
+			/// <returns>The size of a block.</returns>
+			vint GetBlockSize()const
+			{
+				return blockSize;
+			}
+
+			/// <summary>Allocate uninitialized memory.</summary>
+			/// <returns>The allocated memory.</returns>
+			/// <param name="size">The size of the memory.</param>
+			/// <param name="alignment">The alignment of the memory, it must be a power of two.</param>
+			void* Allocate(vint size, vint alignment = alignof(std::max_align_t))
+			{
+				CHECK_ERROR(size >= 0, L"vl::collections::Arena::Allocate(vint, vint)#Argument size should not be negative.");
+				CHECK_ERROR(alignment > 0 && (alignment & (alignment - 1)) == 0, L"vl::collections::Arena::Allocate(vint, vint)#Argument alignment should be a power of two.");
+				if (block)
+				{
+					char* address = AlignUp(position, alignment);
+					if (address + size <= block->End())
+					{
+						position = address + size;
+						return address;
+					}
+				}
+
+				AllocateBlock(size, alignment);
+				char* address = AlignUp(position, alignment);
+				position = address + size;
+				return address;
+			}
+
+			/// <summary>Resize memory allocated by this arena, keeping its content.</summary>
+			/// <returns>The resized memory, it could be different to the original one.</returns>
+			/// <param name="buffer">The memory to resize.</param>
+			/// <param name="oldSize">The size of the memory.</param>
+			/// <param name="newSize">The expected size of the memory.</param>
+			/// <remarks>The memory is resized in place if it is the last allocation and there is enough space in the block.</remarks>
+			void* Reallocate(void* buffer, vint oldSize, vint newSize)
+			{
+				if (block && (char*)buffer + oldSize == position && (char*)buffer + newSize <= block->End())
+				{
+					position = (char*)buffer + newSize;
+					return buffer;
+				}
+
+				void* newBuffer = Allocate(newSize);
+				memcpy(newBuffer, buffer, oldSize < newSize ? oldSize : newSize);
+				return newBuffer;
+			}
+
+			/// <summary>Create an object in this arena.</summary>
+			/// <typeparam name="T">The type of the object.</typeparam>
+			/// <typeparam name="TArgs">Types of arguments for the constructor.</typeparam>
+			/// <returns>The created object.</returns>
+			/// <param name="args">Arguments for the constructor.</param>
+			/// <remarks>
+			/// The destructor will be called when the memory is released, if it is not trivial.
+			/// </remarks>
+			template<typename T, typename ...TArgs>
+			T* New(TArgs&& ...args)
+			{
+				if constexpr (std::is_trivially_destructible_v<T>)
+				{
+					return new(Allocate(sizeof(T), alignof(T))) T(std::forward<TArgs&&>(args)...);
+				}
+				else
+				{
+					auto record = (Destructor*)Allocate(sizeof(Destructor), alignof(Destructor));
+					auto object = new(Allocate(sizeof(T), alignof(T))) T(std::forward<TArgs&&>(args)...);
+					record->previous = destructors;
+					record->destructor = &CallDestructor<T>;
+					record->object = object;
+					destructors = record;
+					return object;
+				}
+			}
+
+			/// <summary>Get the current position of this arena.</summary>
+			/// <returns>The current position.</returns>
+			Marker GetMarker()const
+			{
+				Marker marker;
+				marker.block = block;
+				marker.position = position;
+				marker.destructors = destructors;
+				return marker;
+			}
+
+			/// <summary>Release all memory allocated after a marker. Objects created after the marker are destructed.</summary>
+			/// <param name="marker">The marker from <see cref="GetMarker"/>. Markers taken after it become invalid.</param>
+			void Rewind(const Marker& marker)
+			{
+				while (destructors != marker.destructors)
+				{
+					auto record = destructors;
+					destructors = record->previous;
+					record->destructor(record->object);
+				}
+
+				while (block != marker.block)
+				{
+					if (!marker.block && !block->previous)
+					{
+						// keep the first block for further allocations
+						position = block->Begin();
+						return;
+					}
+					auto previous = block->previous;
+					free(block);
+					block = previous;
+				}
+				position = marker.position;
+			}
+
+			/// <summary>Release all memory. Objects created in this arena are destructed. All markers become invalid.</summary>
+			void Reset()
+			{
+				Rewind(Marker());
+			}
+		};
+
+		/// <summary>Rewind an arena to the position when this object is created, when this object is destructed.</summary>
+		class ArenaScope : public Object
+		{
+		protected:
+			Arena&							arena;
+			Arena::Marker					marker;
+
+		public:
+			NOT_COPYABLE(ArenaScope);
+
+			/// <summary>Record the current position of an arena.</summary>
+			/// <param name="_arena">The arena.</param>
+			ArenaScope(Arena& _arena)
+				: arena(_arena)
+				, marker(_arena.GetMarker())
+			{
+			}
+
+			~ArenaScope()
+			{
+				arena.Rewind(marker);
+			}
+		};
+
+		/// <summary>An allocator for containers that allocates memory in an <see cref="Arena"/>. Memory is only released by the arena.</summary>
+		struct ArenaAllocator
+		{
+			Arena*							arena = nullptr;
+
+			ArenaAllocator() = default;
+			ArenaAllocator(Arena* _arena) :arena(_arena) {}
+
+			void* Allocate(vint size)
+			{
+				return arena->Allocate(size);
+			}
+
+			void Deallocate(void* /*buffer*/, vint /*size*/)
+			{
+			}
+
+			void* Reallocate(void* buffer, vint oldSize, vint newSize)
+			{
+				return arena->Reallocate(buffer, oldSize, newSize);
+			}
+		};
+
+/***********************************************************************
+TypedArena
+***********************************************************************/
+
+		/// <summary>An <see cref="Arena"/> that only creates objects of one type.</summary>
+		/// <typeparam name="T">The type of objects.</typeparam>
+		template<typename T>
+		class TypedArena : public Object
+		{
+		protected:
+			Arena							arena;
+
+		public:
+			NOT_COPYABLE(TypedArena);
+
+			/// <summary>Create an arena.</summary>
+			/// <param name="objectsPerBlock">The number of objects in a block, the size of a block is rounded up to a power of two.</param>
+			TypedArena(vint objectsPerBlock = 256)
+				: arena((vint)sizeof(T) * objectsPerBlock + 64)
+			{
+			}
+
+			/// <summary>Create an object in this arena.</summary>
+			/// <typeparam name="TArgs">Types of arguments for the constructor.</typeparam>
+			/// <returns>The created object.</returns>
+			/// <param name="args">Arguments for the constructor.</param>
+			template<typename ...TArgs>
+			T* New(TArgs&& ...args)
+			{
+				return arena.New<T>(std::forward<TArgs&&>(args)...);
+			}
+
+			/// <summary>Get the current position of this arena.</summary>
+			/// <returns>The current position.</returns>
+			Arena::Marker GetMarker()const
+			{
+				return arena.GetMarker();
+			}
+
+			/// <summary>Destruct all objects created after a marker.</summary>
+			/// <param name="marker">The marker from <see cref="GetMarker"/>.</param>
+			void Rewind(const Arena::Marker& marker)
+			{
+				arena.Rewind(marker);
+			}
+
+			/// <summary>Destruct all objects.</summary>
+			void Reset()
+			{
+				arena.Reset();
+			}
+		};
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
@@ -0,0 +1,944 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_BTREE
+#define VCZH_COLLECTIONS_BTREE
+
+#include <string.h>
+#include "List.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		namespace btree_internal
+		{
+			template<typename T>
+			constexpr vint						SizeOf = (vint)sizeof(T);
+
+			template<>
+			constexpr vint						SizeOf<void> = 0;
+
+			constexpr vint ClampCapacity(vint capacity)
+			{
+				return capacity < 4 ? 4 : capacity > 128 ? 128 : capacity;
+			}
+
+			// move items to a range that could overlap with the source, target slots that are not overlapped must be uninitialized
+			template<typename T>
+			void RelocateOverlapped(T* items, T* source, vint count)
+			{
+				if (count <= 0 || items == source) return;
+				if constexpr (TriviallyRelocatable<T>::Value)
+				{
+					memmove((void*)items, (void*)source, sizeof(T) * count);
+				}
+				else if (items < source)
+				{
+					for (vint i = 0; i < count; i++)
+					{
+						new(&items[i]) T(std::move(source[i]));
+						source[i].~T();
+					}
+				}
+				else
+				{
+					for (vint i = count - 1; i >= 0; i--)
+					{
+						new(&items[i]) T(std::move(source[i]));
+						source[i].~T();
+					}
+				}
+			}
+
+			// uninitialized storage for values in a node
+			template<typename T, vint Capacity>
+			struct Slots
+			{
+				alignas(T) char					buffer[sizeof(T) * Capacity];
+
+				T* Items()
+				{
+					return reinterpret_cast<T*>(buffer);
+				}
+
+				const T* Items()const
+				{
+					return reinterpret_cast<const T*>(buffer);
+				}
+			};
+
+			template<vint Capacity>
+			struct Slots<void, Capacity>
+			{
+			};
+
+/***********************************************************************
+BTree
+***********************************************************************/
+
+			/// <summary>
+			/// A B+tree storing sorted unique keys with optional associated values.
+			/// Entries are stored in leaves, which are linked in both directions for ordered iteration.
+			/// Internal nodes store copies of representative values of keys (see <see cref="KeyType`1"/>) to guide searching.
+			/// Node sizes are multiples of cache lines, searching in a node only reads contiguous keys.
+			/// </summary>
+			/// <typeparam name="K">Type of keys.</typeparam>
+			/// <typeparam name="V">Type of values, or void if there is no value.</typeparam>
+			/// <typeparam name="TAllocator">The allocator for nodes.</typeparam>
+			template<typename K, typename V, typename TAllocator>
+			class BTree
+			{
+			public:
+				using KK = typename KeyType<K>::Type;
+
+				static constexpr vint				NodeSize = CacheLineSize * 8;
+				static constexpr vint				LeafCapacity = ClampCapacity((NodeSize - (vint)sizeof(void*) * 3) / (SizeOf<K> + SizeOf<V>));
+				static constexpr vint				InternalCapacity = ClampCapacity((NodeSize - (vint)sizeof(vint) + SizeOf<KK>) / (SizeOf<KK> + (vint)sizeof(void*)));
+				static constexpr vint				LeafMinCount = LeafCapacity / 2;
+				static constexpr vint				InternalMinCount = InternalCapacity / 2;
+				// bulk loading leaves space in nodes, so that following insertions do not split nodes immediately
+				static constexpr vint				LoadLeafCount = LeafCapacity * 3 / 4;
+				static constexpr vint				LoadInternalCount = InternalCapacity * 3 / 4;
+				static constexpr vint				MaxHeight = 64;
+
+				struct Leaf
+				{
+					vint												count = 0;
+					Leaf*												previous = nullptr;
+					Leaf*												next = nullptr;
+					Slots<K, LeafCapacity>								keys;
+					VCZH_NO_UNIQUE_ADDRESS Slots<V, LeafCapacity>		values;
+				};
+
+				// keys[i] is not larger than any key in children[i + 1], and is larger than any key in children[i]
+				struct Internal
+				{
+					vint												count = 0;
+					Slots<KK, InternalCapacity - 1>						keys;
+					void*												children[InternalCapacity];
+				};
+
+				/// <summary>A position of an entry in a <see cref="BTree`3"/>. It becomes invalid after the tree is modified.</summary>
+				class Cursor
+				{
+					friend class BTree<K, V, TAllocator>;
+				protected:
+					const Leaf*						leaf = nullptr;
+					vint							index = 0;
+
+					Cursor(const Leaf* _leaf, vint _index)
+						: leaf(_leaf)
+						, index(_index)
+					{
+					}
+				public:
+					Cursor() = default;
+
+					bool operator==(const Cursor&)const = default;
+
+					/// <summary>Test if the cursor points to an entry.</summary>
+					/// <returns>Returns true if the cursor points to an entry.</returns>
+					bool IsValid()const
+					{
+						return leaf != nullptr;
+					}
+
+					/// <summary>Get the key of the entry.</summary>
+					/// <returns>The key. It will crash if the cursor is not valid.</returns>
+					const K& Key()const
+					{
+						CHECK_ERROR(leaf, L"BTree<K, V>::Cursor::Key()#The cursor does not point to an entry.");
+						return leaf->keys.Items()[index];
+					}
+
+					/// <summary>Get the value of the entry.</summary>
+					/// <returns>The value. It will crash if the cursor is not valid.</returns>
+					template<typename TValue = V>
+						requires(!std::is_void_v<TValue>)
+					const TValue& Value()const
+					{
+						CHECK_ERROR(leaf, L"BTree<K, V>::Cursor::Value()#The cursor does not point to an entry.");
+						return leaf->values.Items()[index];
+					}
+
+					/// <summary>Move to the next entry.</summary>
+					/// <returns>Returns false if there is no more entry, the cursor becomes invalid.</returns>
+					bool Next()
+					{
+						CHECK_ERROR(leaf, L"BTree<K, V>::Cursor::Next()#The cursor does not point to an entry.");
+						if (++index == leaf->count)
+						{
+							leaf = leaf->next;
+							index = 0;
+						}
+						return leaf != nullptr;
+					}
+
+					/// <summary>Move to the previous entry.</summary>
+					/// <returns>Returns false if there is no more entry, the cursor becomes invalid.</returns>
+					bool Previous()
+					{
+						CHECK_ERROR(leaf, L"BTree<K, V>::Cursor::Previous()#The cursor does not point to an entry.");
+						if (index == 0)
+						{
+							leaf = leaf->previous;
+							index = leaf ? leaf->count - 1 : 0;
+						}
+						else
+						{
+							index--;
+						}
+						return leaf != nullptr;
+					}
+				};
+
+			protected:
+				struct PathItem
+				{
+					Internal*						node;
+					vint							index;
+				};
+
+				VCZH_NO_UNIQUE_ADDRESS TAllocator	allocator;
+				void*								root = nullptr;
+				vint								height = 0;
+				vint								count = 0;
+				Leaf*								first = nullptr;
+				Leaf*								last = nullptr;
+
+				static decltype(auto) KeyOf(const K& key)
+				{
+					return KeyType<K>::GetKeyValue(key);
+				}
+
+				Leaf* NewLeaf()
+				{
+					return new(allocator.Allocate((vint)sizeof(Leaf))) Leaf;
+				}
+
+				Internal* NewInternal()
+				{
+					return new(allocator.Allocate((vint)sizeof(Internal))) Internal;
+				}
+
+				void FreeLeaf(Leaf* leaf)
+				{
+					allocator.Deallocate(leaf, (vint)sizeof(Leaf));
+				}
+
+				void FreeInternal(Internal* node)
+				{
+					allocator.Deallocate(node, (vint)sizeof(Internal));
+				}
+
+				static void DestroyEntries(Leaf* leaf, vint index, vint _count)
+				{
+					memory_management::CallDtors(leaf->keys.Items() + index, _count);
+					if constexpr (!std::is_void_v<V>)
+					{
+						memory_management::CallDtors(leaf->values.Items() + index, _count);
+					}
+				}
+
+				static void RelocateEntries(Leaf* target, vint targetIndex, Leaf* source, vint sourceIndex, vint _count)
+				{
+					RelocateOverlapped(target->keys.Items() + targetIndex, source->keys.Items() + sourceIndex, _count);
+					if constexpr (!std::is_void_v<V>)
+					{
+						RelocateOverlapped(target->values.Items() + targetIndex, source->values.Items() + sourceIndex, _count);
+					}
+				}
+
+				template<typename TKeyItem, typename ...TValueItems>
+				static void ConstructEntry(Leaf* leaf, vint index, TKeyItem&& key, TValueItems&& ...values)
+				{
+					new(&leaf->keys.Items()[index]) K(std::forward<TKeyItem&&>(key));
+					if constexpr (!std::is_void_v<V>)
+					{
+						new(&leaf->values.Items()[index]) V(std::forward<TValueItems&&>(values)...);
+					}
+				}
+
+				void DestroyNode(void* node, vint level)
+				{
+					if (level == 0)
+					{
+						auto leaf = (Leaf*)node;
+						DestroyEntries(leaf, 0, leaf->count);
+						FreeLeaf(leaf);
+					}
+					else
+					{
+						auto internal = (Internal*)node;
+						for (vint i = 0; i < internal->count; i++)
+						{
+							DestroyNode(internal->children[i], level - 1);
+						}
+						memory_management::CallDtors(internal->keys.Items(), internal->count - 1);
+						FreeInternal(internal);
+					}
+				}
+
+				// the first entry whose key is not smaller than the specified key
+				static vint LeafLowerBound(const Leaf* leaf, const KK& key)
+				{
+					const K* keys = leaf->keys.Items();
+					vint start = 0;
+					vint end = leaf->count;
+					while (start < end)
+					{
+						vint middle = (start + end) / 2;
+						if ((KeyOf(keys[middle]) <=> key) < 0)
+						{
+							start = middle + 1;
+						}
+						else
+						{
+							end = middle;
+						}
+					}
+					return start;
+				}
+
+				// the first entry whose key is larger than the specified key
+				static vint LeafUpperBound(const Leaf* leaf, const KK& key)
+				{
+					const K* keys = leaf->keys.Items();
+					vint start = 0;
+					vint end = leaf->count;
+					while (start < end)
+					{
+						vint middle = (start + end) / 2;
+						if ((KeyOf(keys[middle]) <=> key) <= 0)
+						{
+							start = middle + 1;
+						}
+						else
+						{
+							end = middle;
+						}
+					}
+					return start;
+				}
+
+				// the child that could contain the specified key
+				static vint ChildIndex(const Internal* node, const KK& key)
+				{
+					const KK* keys = node->keys.Items();
+					vint start = 0;
+					vint end = node->count - 1;
+					while (start < end)
+					{
+						vint middle = (start + end) / 2;
+						if ((keys[middle] <=> key) <= 0)
+						{
+							start = middle + 1;
+						}
+						else
+						{
+							end = middle;
+						}
+					}
+					return start;
+				}
+
+				Leaf* Descend(const KK& key, PathItem* path)const
+				{
+					void* node = root;
+					for (vint level = 0; level < height; level++)
+					{
+						auto internal = (Internal*)node;
+						vint index = ChildIndex(internal, key);
+						if (path) path[level] = { internal, index };
+						node = internal->children[index];
+					}
+					return (Leaf*)node;
+				}
+
+				static Cursor MakeCursor(const Leaf* leaf, vint index)
+				{
+					if (index < leaf->count) return { leaf, index };
+					if (leaf->next) return { leaf->next, 0 };
+					return {};
+				}
+
+				static void InsertIntoInternal(Internal* node, vint position, KK&& key, void* child)
+				{
+					KK* keys = node->keys.Items();
+					RelocateOverlapped(keys + position, keys + position - 1, node->count - position);
+					new(&keys[position - 1]) KK(std::move(key));
+					memmove(node->children + position + 1, node->children + position, sizeof(void*) * (node->count - position));
+					node->children[position] = child;
+					node->count++;
+				}
+
+				static void RemoveFromInternal(Internal* node, vint position)
+				{
+					KK* keys = node->keys.Items();
+					keys[position - 1].~KK();
+					RelocateOverlapped(keys + position - 1, keys + position, node->count - position - 1);
+					memmove(node->children + position, node->children + position + 1, sizeof(void*) * (node->count - position - 1));
+					node->count--;
+				}
+
+				// insert a new child after path[level].index for each level, splitting full nodes on the way up
+				void InsertSeparator(PathItem* path, KK&& separator, void* child)
+				{
+					KK pending(std::move(separator));
+					for (vint level = height - 1; level >= 0; level--)
+					{
+						auto node = path[level].node;
+						vint position = path[level].index + 1;
+						if (node->count < InternalCapacity)
+						{
+							InsertIntoInternal(node, position, std::move(pending), child);
+							return;
+						}
+
+						constexpr vint C = InternalCapacity;
+						constexpr vint Half = (C + 1) / 2;
+						auto right = NewInternal();
+						KK* keys = node->keys.Items();
+						KK* rightKeys = right->keys.Items();
+						if (position < Half)
+						{
+							memcpy(right->children, node->children + Half - 1, sizeof(void*) * (C - Half + 1));
+							RelocateOverlapped(rightKeys, keys + Half - 1, C - Half);
+							KK up(std::move(keys[Half - 2]));
+							keys[Half - 2].~KK();
+							node->count = Half - 1;
+							right->count = C - Half + 1;
+							InsertIntoInternal(node, position, std::move(pending), child);
+							pending = std::move(up);
+						}
+						else if (position == Half)
+						{
+							right->children[0] = child;
+							memcpy(right->children + 1, node->children + Half, sizeof(void*) * (C - Half));
+							RelocateOverlapped(rightKeys, keys + Half - 1, C - Half);
+							node->count = Half;
+							right->count = C - Half + 1;
+						}
+						else
+						{
+							memcpy(right->children, node->children + Half, sizeof(void*) * (C - Half));
+							RelocateOverlapped(rightKeys, keys + Half, C - Half - 1);
+							KK up(std::move(keys[Half - 1]));
+							keys[Half - 1].~KK();
+							node->count = Half;
+							right->count = C - Half;
+							InsertIntoInternal(right, position - Half, std::move(pending), child);
+							pending = std::move(up);
+						}
+						child = right;
+					}
+
+					auto newRoot = NewInternal();
+					new(newRoot->keys.Items()) KK(std::move(pending));
+					newRoot->children[0] = root;
+					newRoot->children[1] = child;
+					newRoot->count = 2;
+					root = newRoot;
+					height++;
+				}
+
+				// fix an underflowed leaf, returns true if the parent loses a child
+				bool RebalanceLeaf(Internal* parent, vint index)
+				{
+					auto leaf = (Leaf*)parent->children[index];
+					KK* separators = parent->keys.Items();
+					if (index > 0)
+					{
+						auto left = (Leaf*)parent->children[index - 1];
+						if (left->count > LeafMinCount)
+						{
+							RelocateEntries(leaf, 1, leaf, 0, leaf->count);
+							RelocateEntries(leaf, 0, left, left->count - 1, 1);
+							left->count--;
+							leaf->count++;
+							separators[index - 1] = KeyOf(leaf->keys.Items()[0]);
+							return false;
+						}
+					}
+					if (index < parent->count - 1)
+					{
+						auto right = (Leaf*)parent->children[index + 1];
+						if (right->count > LeafMinCount)
+						{
+							RelocateEntries(leaf, leaf->count, right, 0, 1);
+							RelocateEntries(right, 0, right, 1, right->count - 1);
+							right->count--;
+							leaf->count++;
+							separators[index] = KeyOf(right->keys.Items()[0]);
+							return false;
+						}
+					}
+
+					vint mergeIndex = index > 0 ? index - 1 : index;
+					auto left = (Leaf*)parent->children[mergeIndex];
+					auto right = (Leaf*)parent->children[mergeIndex + 1];
+					RelocateEntries(left, left->count, right, 0, right->count);
+					left->count += right->count;
+					left->next = right->next;
+					if (right->next)
+					{
+						right->next->previous = left;
+					}
+					else
+					{
+						last = left;
+					}
+					FreeLeaf(right);
+					RemoveFromInternal(parent, mergeIndex + 1);
+					return true;
+				}
+
+				// fix an underflowed internal node, returns true if the parent loses a child
+				bool RebalanceInternal(Internal* parent, vint index)
+				{
+					auto node = (Internal*)parent->children[index];
+					KK* separators = parent->keys.Items();
+					KK* keys = node->keys.Items();
+					if (index > 0)
+					{
+						auto left = (Internal*)parent->children[index - 1];
+						if (left->count > InternalMinCount)
+						{
+							KK* leftKeys = left->keys.Items();
+							RelocateOverlapped(keys + 1, keys, node->count - 1);
+							new(&keys[0]) KK(std::move(separators[index - 1]));
+							separators[index - 1] = std::move(leftKeys[left->count - 2]);
+							leftKeys[left->count - 2].~KK();
+							memmove(node->children + 1, node->children, sizeof(void*) * node->count);
+							node->children[0] = left->children[left->count - 1];
+							left->count--;
+							node->count++;
+							return false;
+						}
+					}
+					if (index < parent->count - 1)
+					{
+						auto right = (Internal*)parent->children[index + 1];
+						if (right->count > InternalMinCount)
+						{
+							KK* rightKeys = right->keys.Items();
+							new(&keys[node->count - 1]) KK(std::move(separators[index]));
+							separators[index] = std::move(rightKeys[0]);
+							rightKeys[0].~KK();
+							RelocateOverlapped(rightKeys, rightKeys + 1, right->count - 2);
+							node->children[node->count] = right->children[0];
+							memmove(right->children, right->children + 1, sizeof(void*) * (right->count - 1));
+							right->count--;
+							node->count++;
+							return false;
+						}
+					}
+
+					vint mergeIndex = index > 0 ? index - 1 : index;
+					auto left = (Internal*)parent->children[mergeIndex];
+					auto right = (Internal*)parent->children[mergeIndex + 1];
+					KK* leftKeys = left->keys.Items();
+					new(&leftKeys[left->count - 1]) KK(std::move(separators[mergeIndex]));
+					RelocateOverlapped(leftKeys + left->count, right->keys.Items(), right->count - 1);
+					memcpy(left->children + left->count, right->children, sizeof(void*) * right->count);
+					left->count += right->count;
+					FreeInternal(right);
+					RemoveFromInternal(parent, mergeIndex + 1);
+					return true;
+				}
+
+			public:
+				BTree() = default;
+
+				BTree(const TAllocator& _allocator)
+					: allocator(_allocator)
+				{
+				}
+
+				BTree(const BTree<K, V, TAllocator>&) = delete;
+				BTree(BTree<K, V, TAllocator>&& tree)
+					: allocator(tree.allocator)
+					, root(tree.root)
+					, height(tree.height)
+					, count(tree.count)
+					, first(tree.first)
+					, last(tree.last)
+				{
+					tree.root = nullptr;
+					tree.height = 0;
+					tree.count = 0;
+					tree.first = nullptr;
+					tree.last = nullptr;
+				}
+
+				~BTree()
+				{
+					Clear();
+				}
+
+				BTree<K, V, TAllocator>& operator=(const BTree<K, V, TAllocator>&) = delete;
+				BTree<K, V, TAllocator>& operator=(BTree<K, V, TAllocator>&& tree)
+				{
+					if (this != &tree)
+					{
+						Clear();
+						allocator = tree.allocator;
+						root = tree.root;
+						height = tree.height;
+						count = tree.count;
+						first = tree.first;
+						last = tree.last;
+						tree.root = nullptr;
+						tree.height = 0;
+						tree.count = 0;
+						tree.first = nullptr;
+						tree.last = nullptr;
+					}
+					return *this;
+				}
+
+				/// <summary>Get the number of entries.</summary>
+				/// <returns>The number of entries.</returns>
+				vint Count()const
+				{
+					return count;
+				}
+
+				/// <summary>Get the cursor of the first entry.</summary>
+				/// <returns>The cursor, which is invalid if the tree is empty.</returns>
+				Cursor First()const
+				{
+					return first ? Cursor(first, 0) : Cursor();
+				}
+
+				/// <summary>Get the cursor of the last entry.</summary>
+				/// <returns>The cursor, which is invalid if the tree is empty.</returns>
+				Cursor Last()const
+				{
+					return last ? Cursor(last, last->count - 1) : Cursor();
+				}
+
+				/// <summary>Get the cursor of the first entry whose key is not smaller than a specified key.</summary>
+				/// <returns>The cursor, which is invalid if there is no such entry.</returns>
+				/// <param name="key">The key.</param>
+				Cursor LowerBound(const KK& key)const
+				{
+					if (!root) return {};
+					auto leaf = Descend(key, nullptr);
+					return MakeCursor(leaf, LeafLowerBound(leaf, key));
+				}
+
+				/// <summary>Get the cursor of the first entry whose key is larger than a specified key.</summary>
+				/// <returns>The cursor, which is invalid if there is no such entry.</returns>
+				/// <param name="key">The key.</param>
+				Cursor UpperBound(const KK& key)const
+				{
+					if (!root) return {};
+					auto leaf = Descend(key, nullptr);
+					return MakeCursor(leaf, LeafUpperBound(leaf, key));
+				}
+
+				/// <summary>Get the cursor of the entry with a specified key.</summary>
+				/// <returns>The cursor, which is invalid if the key does not exist.</returns>
+				/// <param name="key">The key.</param>
+				Cursor Find(const KK& key)const
+				{
+					if (!root) return {};
+					auto leaf = Descend(key, nullptr);
+					vint index = LeafLowerBound(leaf, key);
+					if (index < leaf->count && (KeyOf(leaf->keys.Items()[index]) <=> key) == 0)
+					{
+						return { leaf, index };
+					}
+					return {};
+				}
+
+				/// <summary>Add an entry.</summary>
+				/// <typeparam name="TKeyItem">Type of the key.</typeparam>
+				/// <typeparam name="TValueItems">Type of the value, or nothing if there is no value.</typeparam>
+				/// <returns>Returns true if the entry is added. Returns false if the key exists.</returns>
+				/// <param name="replace">Set to true to replace the value if the key exists.</param>
+				/// <param name="key">The key.</param>
+				/// <param name="values">The value.</param>
+				template<typename TKeyItem, typename ...TValueItems>
+				bool Insert(bool replace, TKeyItem&& key, TValueItems&& ...values)
+				{
+					if (!root)
+					{
+						auto leaf = NewLeaf();
+						ConstructEntry(leaf, 0, std::forward<TKeyItem&&>(key), std::forward<TValueItems&&>(values)...);
+						leaf->count = 1;
+						root = leaf;
+						first = leaf;
+						last = leaf;
+						height = 0;
+						count = 1;
+						return true;
+					}
+
+					PathItem path[MaxHeight];
+					auto leaf = Descend(KeyOf(key), path);
+					vint index = LeafLowerBound(leaf, KeyOf(key));
+					if (index < leaf->count && (KeyOf(leaf->keys.Items()[index]) <=> KeyOf(key)) == 0)
+					{
+						if constexpr (!std::is_void_v<V>)
+						{
+							if (replace)
+							{
+								((leaf->values.Items()[index] = std::forward<TValueItems&&>(values)), ...);
+							}
+						}
+						return false;
+					}
+
+					if (leaf->count < LeafCapacity)
+					{
+						RelocateEntries(leaf, index + 1, leaf, index, leaf->count - index);
+						ConstructEntry(leaf, index, std::forward<TKeyItem&&>(key), std::forward<TValueItems&&>(values)...);
+						leaf->count++;
+						count++;
+						return true;
+					}
+
+					constexpr vint C = LeafCapacity;
+					constexpr vint Half = (C + 1) / 2;
+					auto right = NewLeaf();
+					if (index < Half)
+					{
+						RelocateEntries(right, 0, leaf, Half - 1, C - Half + 1);
+						leaf->count = Half - 1;
+						right->count = C - Half + 1;
+						RelocateEntries(leaf, index + 1, leaf, index, leaf->count - index);
+						ConstructEntry(leaf, index, std::forward<TKeyItem&&>(key), std::forward<TValueItems&&>(values)...);
+						leaf->count++;
+					}
+					else
+					{
+						RelocateEntries(right, 0, leaf, Half, C - Half);
+						leaf->count = Half;
+						right->count = C - Half;
+						vint rightIndex = index - Half;
+						RelocateEntries(right, rightIndex + 1, right, rightIndex, right->count - rightIndex);
+						ConstructEntry(right, rightIndex, std::forward<TKeyItem&&>(key), std::forward<TValueItems&&>(values)...);
+						right->count++;
+					}
+					count++;
+
+					right->previous = leaf;
+					right->next = leaf->next;
+					if (leaf->next)
+					{
+						leaf->next->previous = right;
+					}
+					else
+					{
+						last = right;
+					}
+					leaf->next = right;
+
+					KK separator = KeyOf(right->keys.Items()[0]);
+					InsertSeparator(path, std::move(separator), right);
+					return true;
+				}
+
+				/// <summary>Remove an entry.</summary>
+				/// <returns>Returns true if the entry is removed.</returns>
+				/// <param name="key">The key of the entry.</param>
+				bool Remove(const KK& key)
+				{
+					if (!root) return false;
+					PathItem path[MaxHeight];
+					auto leaf = Descend(key, path);
+					vint index = LeafLowerBound(leaf, key);
+					if (index == leaf->count || (KeyOf(leaf->keys.Items()[index]) <=> key) != 0)
+					{
+						return false;
+					}
+
+					DestroyEntries(leaf, index, 1);
+					RelocateEntries(leaf, index, leaf, index + 1, leaf->count - index - 1);
+					leaf->count--;
+					count--;
+
+					if (height == 0)
+					{
+						if (leaf->count == 0)
+						{
+							FreeLeaf(leaf);
+							root = nullptr;
+							first = nullptr;
+							last = nullptr;
+						}
+						return true;
+					}
+					if (leaf->count >= LeafMinCount)
+					{
+						return true;
+					}
+
+					bool shrunk = RebalanceLeaf(path[height - 1].node, path[height - 1].index);
+					for (vint level = height - 1; shrunk && level >= 0; level--)
+					{
+						auto node = path[level].node;
+						if (level == 0)
+						{
+							if (node->count == 1)
+							{
+								root = node->children[0];
+								height--;
+								FreeInternal(node);
+							}
+							break;
+						}
+						if (node->count >= InternalMinCount)
+						{
+							break;
+						}
+						shrunk = RebalanceInternal(path[level - 1].node, path[level - 1].index);
+					}
+					return true;
+				}
+
+				/// <summary>Remove all entries.</summary>
+				void Clear()
+				{
+					if (root)
+					{
+						DestroyNode(root, height);
+					}
+					root = nullptr;
+					height = 0;
+					count = 0;
+					first = nullptr;
+					last = nullptr;
+				}
+
+				/// <summary>
+				/// Append an entry when bulk loading a tree, which must start from an empty tree.
+				/// The key must be larger than all existing keys.
+				/// The tree is only available after calling <see cref="EndLoad"/>.
+				/// It will crash if the tree was not empty, or if <see cref="EndLoad"/> has been called.
+				/// </summary>
+				/// <typeparam name="TKeyItem">Type of the key.</typeparam>
+				/// <typeparam name="TValueItems">Type of the value, or nothing if there is no value.</typeparam>
+				/// <param name="key">The key.</param>
+				/// <param name="values">The value.</param>
+				template<typename TKeyItem, typename ...TValueItems>
+				void LoadNext(TKeyItem&& key, TValueItems&& ...values)
+				{
+					CHECK_ERROR(!root, L"BTree<K, V>::LoadNext(TKeyItem&&, TValueItems&&...)#Bulk loading must start from an empty tree.");
+					if (last && (KeyOf(last->keys.Items()[last->count - 1]) <=> KeyOf(key)) >= 0)
+					{
+						EndLoad();
+						CHECK_FAIL(L"BTree<K, V>::LoadNext(TKeyItem&&, TValueItems&&...)#Keys must be sorted and unique.");
+					}
+
+					if (!last || last->count == LoadLeafCount)
+					{
+						auto leaf = NewLeaf();
+						leaf->previous = last;
+						if (last)
+						{
+							last->next = leaf;
+						}
+						else
+						{
+							first = leaf;
+						}
+						last = leaf;
+					}
+					ConstructEntry(last, last->count, std::forward<TKeyItem&&>(key), std::forward<TValueItems&&>(values)...);
+					last->count++;
+					count++;
+				}
+
+				/// <summary>Build internal nodes for leaves appended by <see cref="LoadNext"/>.</summary>
+				void EndLoad()
+				{
+					CHECK_ERROR(!root, L"BTree<K, V>::EndLoad()#Bulk loading must start from an empty tree.");
+					if (!last) return;
+
+					if (last->previous && last->count < LeafMinCount)
+					{
+						auto previous = last->previous;
+						vint total = previous->count + last->count;
+						if (total <= LeafCapacity)
+						{
+							RelocateEntries(previous, previous->count, last, 0, last->count);
+							previous->count = total;
+							previous->next = nullptr;
+							FreeLeaf(last);
+							last = previous;
+						}
+						else
+						{
+							vint moving = total / 2 - last->count;
+							RelocateEntries(last, moving, last, 0, last->count);
+							RelocateEntries(last, 0, previous, previous->count - moving, moving);
+							previous->count -= moving;
+							last->count += moving;
+						}
+					}
+
+					List<void*> nodes;
+					List<Leaf*> leftmosts;
+					for (auto leaf = first; leaf; leaf = leaf->next)
+					{
+						nodes.Add(leaf);
+						leftmosts.Add(leaf);
+					}
+
+					height = 0;
+					while (nodes.Count() > 1)
+					{
+						vint n = nodes.Count();
+						vint groups = (n + LoadInternalCount - 1) / LoadInternalCount;
+						if (groups > 1 && n / groups < InternalMinCount)
+						{
+							groups = n / InternalMinCount;
+						}
+
+						List<void*> parents;
+						List<Leaf*> parentLeftmosts;
+						vint start = 0;
+						for (vint group = 0; group < groups; group++)
+						{
+							vint size = n / groups + (group < n % groups ? 1 : 0);
+							auto node = NewInternal();
+							for (vint i = 0; i < size; i++)
+							{
+								node->children[i] = nodes[start + i];
+								if (i > 0)
+								{
+									new(&node->keys.Items()[i - 1]) KK(KeyOf(leftmosts[start + i]->keys.Items()[0]));
+								}
+							}
+							node->count = size;
+							parents.Add(node);
+							parentLeftmosts.Add(leftmosts[start]);
+							start += size;
+						}
+
+						nodes = std::move(parents);
+						leftmosts = std::move(parentLeftmosts);
+						height++;
+					}
+					root = nodes[0];
+				}
+			};
+		}
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
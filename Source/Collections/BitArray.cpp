@@ -0,0 +1,270 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#include <string.h>
+#include <bit>
+#include "BitArray.h"
+
+#if defined(__AVX2__)
+#define VCZH_BITARRAY_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VCZH_BITARRAY_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		namespace bitarray_internal
+		{
+			struct AndOperator
+			{
+				static vuint64_t Word(vuint64_t a, vuint64_t b) { return a & b; }
+#if defined VCZH_BITARRAY_AVX2
+				static __m256i Vector(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+#elif defined VCZH_BITARRAY_SSE2
+				static __m128i Vector(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+#endif
+			};
+
+			struct OrOperator
+			{
+				static vuint64_t Word(vuint64_t a, vuint64_t b) { return a | b; }
+#if defined VCZH_BITARRAY_AVX2
+				static __m256i Vector(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+#elif defined VCZH_BITARRAY_SSE2
+				static __m128i Vector(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+#endif
+			};
+
+			struct XorOperator
+			{
+				static vuint64_t Word(vuint64_t a, vuint64_t b) { return a ^ b; }
+#if defined VCZH_BITARRAY_AVX2
+				static __m256i Vector(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+#elif defined VCZH_BITARRAY_SSE2
+				static __m128i Vector(__m128i a, __m128i b) { return _mm_xor_si128(a, b); }
+#endif
+			};
+
+			struct AndNotOperator
+			{
+				static vuint64_t Word(vuint64_t a, vuint64_t b) { return a & ~b; }
+#if defined VCZH_BITARRAY_AVX2
+				static __m256i Vector(__m256i a, __m256i b) { return _mm256_andnot_si256(b, a); }
+#elif defined VCZH_BITARRAY_SSE2
+				static __m128i Vector(__m128i a, __m128i b) { return _mm_andnot_si128(b, a); }
+#endif
+			};
+
+			// a[i] = op(a[i], b[i]), a vector register of words at a time, and then one word at a time for the rest
+			template<typename TOperator>
+			void Apply(vuint64_t* a, const vuint64_t* b, vint count)
+			{
+				vint i = 0;
+#if defined VCZH_BITARRAY_AVX2
+				for (; i + 4 <= count; i += 4)
+				{
+					__m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+					__m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+					_mm256_storeu_si256((__m256i*)(a + i), TOperator::Vector(x, y));
+				}
+#elif defined VCZH_BITARRAY_SSE2
+				for (; i + 2 <= count; i += 2)
+				{
+					__m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+					__m128i y = _mm_loadu_si128((const __m128i*)(b + i));
+					_mm_storeu_si128((__m128i*)(a + i), TOperator::Vector(x, y));
+				}
+#endif
+				for (; i < count; i++)
+				{
+					a[i] = TOperator::Word(a[i], b[i]);
+				}
+			}
+		}
+
+/***********************************************************************
+BitArray
+***********************************************************************/
+
+		void BitArray::ClearUnusedBits()
+		{
+			if (count % WordBits != 0)
+			{
+				words[count / WordBits] &= ((vuint64_t)1 << (count % WordBits)) - 1;
+			}
+		}
+
+		BitArray::BitArray(vint size)
+		{
+			Resize(size);
+		}
+
+		BitArray::BitArray(BitArray&& _move)
+			: words(_move.words)
+			, count(_move.count)
+			, capacity(_move.capacity)
+		{
+			_move.words = nullptr;
+			_move.count = 0;
+			_move.capacity = 0;
+		}
+
+		BitArray::~BitArray()
+		{
+			memory_management::DeallocateBuffer(allocator, words, capacity);
+		}
+
+		BitArray& BitArray::operator=(BitArray&& _move)
+		{
+			if (this != &_move)
+			{
+				memory_management::DeallocateBuffer(allocator, words, capacity);
+				words = _move.words;
+				count = _move.count;
+				capacity = _move.capacity;
+				_move.words = nullptr;
+				_move.count = 0;
+				_move.capacity = 0;
+			}
+			return *this;
+		}
+
+		void BitArray::Resize(vint size)
+		{
+			CHECK_ERROR(size >= 0, L"BitArray::Resize(vint)#Argument size should not be negative.");
+			vint oldWords = WordCount(count);
+			vint newWords = WordCount(size);
+			if (newWords > capacity)
+			{
+				vint newCapacity = capacity * 2 > newWords ? capacity * 2 : newWords;
+				auto newBuffer = memory_management::AllocateBuffer<vuint64_t>(allocator, newCapacity);
+				if (oldWords > 0)
+				{
+					memcpy(newBuffer, words, sizeof(vuint64_t) * oldWords);
+				}
+				memory_management::DeallocateBuffer(allocator, words, capacity);
+				words = newBuffer;
+				capacity = newCapacity;
+			}
+			if (newWords > oldWords)
+			{
+				memset(words + oldWords, 0, sizeof(vuint64_t) * (newWords - oldWords));
+			}
+			count = size;
+			ClearUnusedBits();
+		}
+
+		bool BitArray::Clear()
+		{
+			count = 0;
+			return true;
+		}
+
+		void BitArray::Fill(bool value)
+		{
+			if (count == 0) return;
+			memset(words, value ? 0xFF : 0, sizeof(vuint64_t) * WordCount(count));
+			ClearUnusedBits();
+		}
+
+		vint BitArray::PopCount()const
+		{
+			vint result = 0;
+			vint wordCount = WordCount(count);
+			for (vint i = 0; i < wordCount; i++)
+			{
+				result += std::popcount(words[i]);
+			}
+			return result;
+		}
+
+		bool BitArray::Any()const
+		{
+			vint wordCount = WordCount(count);
+			for (vint i = 0; i < wordCount; i++)
+			{
+				if (words[i] != 0) return true;
+			}
+			return false;
+		}
+
+		vint BitArray::FindFirst()const
+		{
+			return FindNext(0);
+		}
+
+		vint BitArray::FindNext(vint index)const
+		{
+			CHECK_ERROR(index >= 0 && index <= count, L"BitArray::FindNext(vint)#Argument index not in range.");
+			if (index == count) return -1;
+
+			vint wordIndex = index / WordBits;
+			vint wordCount = WordCount(count);
+			vuint64_t word = words[wordIndex] & (~(vuint64_t)0 << (index % WordBits));
+			while (true)
+			{
+				if (word != 0)
+				{
+					return wordIndex * WordBits + std::countr_zero(word);
+				}
+				if (++wordIndex == wordCount) return -1;
+				word = words[wordIndex];
+			}
+		}
+
+		BitArray& BitArray::And(const BitArray& bits)
+		{
+			CHECK_ERROR(count == bits.count, L"BitArray::And(const BitArray&)#Two bit arrays should have the same number of bits.");
+			bitarray_internal::Apply<bitarray_internal::AndOperator>(words, bits.words, WordCount(count));
+			return *this;
+		}
+
+		BitArray& BitArray::Or(const BitArray& bits)
+		{
+			CHECK_ERROR(count == bits.count, L"BitArray::Or(const BitArray&)#Two bit arrays should have the same number of bits.");
+			bitarray_internal::Apply<bitarray_internal::OrOperator>(words, bits.words, WordCount(count));
+			return *this;
+		}
+
+		BitArray& BitArray::Xor(const BitArray& bits)
+		{
+			CHECK_ERROR(count == bits.count, L"BitArray::Xor(const BitArray&)#Two bit arrays should have the same number of bits.");
+			bitarray_internal::Apply<bitarray_internal::XorOperator>(words, bits.words, WordCount(count));
+			return *this;
+		}
+
+		BitArray& BitArray::AndNot(const BitArray& bits)
+		{
+			CHECK_ERROR(count == bits.count, L"BitArray::AndNot(const BitArray&)#Two bit arrays should have the same number of bits.");
+			bitarray_internal::Apply<bitarray_internal::AndNotOperator>(words, bits.words, WordCount(count));
+			return *this;
+		}
+
+		BitArray& BitArray::Assign(const BitArray& bits)
+		{
+			if (this != &bits)
+			{
+				Clear();
+				Resize(bits.count);
+				if (count > 0)
+				{
+					memcpy(words, bits.words, sizeof(vuint64_t) * WordCount(count));
+				}
+			}
+			return *this;
+		}
+
+		bool BitArray::operator==(const BitArray& bits)const
+		{
+			if (count != bits.count) return false;
+			if (count == 0) return true;
+			return memcmp(words, bits.words, sizeof(vuint64_t) * WordCount(count)) == 0;
+		}
+	}
+}
@@ -0,0 +1,266 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_BITARRAY
+#define VCZH_COLLECTIONS_BITARRAY
+
+#include "List.h"
+
+namespace vl
+{
+	namespace collections
+	{
+		/// <summary>
+		/// BitArray: a fixed number of bits packed in 64 bits words.
+		/// It could be used as a set of integers from 0 to <see cref="Count"/> - 1.
+		/// </summary>
+		/// <remarks>
+		/// <p>
+		/// Set operations process a whole word at a time, or 4 words at a time when AVX2 is enabled by the compiler.
+		/// Both operands of a set operation must have the same number of bits.
+		/// </p>
+		/// <p>
+		/// Indexes of all true bits are enumerated in order by <see cref="SetBits"/>.
+		/// </p>
+		/// </remarks>
+		class BitArray : public Object
+		{
+		protected:
+			class Enumerator : public Object, public virtual IEnumerator<vint>
+			{
+			private:
+				const BitArray*						container;
+				vint								index;
+				vint								bit;
+
+			public:
+				POOLED_ALLOCATION(Enumerator)
+
+				Enumerator(const BitArray* _container, vint _index = -1, vint _bit = -1)
+					: container(_container)
+					, index(_index)
+					, bit(_bit)
+				{
+				}
+
+				IEnumerator<vint>* Clone()const override
+				{
+					return new Enumerator(container, index, bit);
+				}
+
+				const vint& Current()const override
+				{
+					return bit;
+				}
+
+				vint Index()const override
+				{
+					return index;
+				}
+
+				bool Next() override
+				{
+					if (bit == -1 && index != -1) return false;
+					bit = container->FindNext(bit + 1);
+					if (bit == -1) return false;
+					index++;
+					return true;
+				}
+
+				void Reset() override
+				{
+					index = -1;
+					bit = -1;
+				}
+
+				bool Evaluated()const override
+				{
+					return false;
+				}
+			};
+
+			class SetBitEnumerable : public EnumerableBase<vint>
+			{
+			private:
+				const BitArray*						container;
+
+			public:
+				SetBitEnumerable(const BitArray* _container)
+					: container(_container)
+				{
+				}
+
+				IEnumerator<vint>* CreateEnumerator()const
+				{
+					return new Enumerator(container);
+				}
+			};
+
+			static constexpr vint					WordBits = 64;
+
+			DefaultAllocator						allocator;
+			vuint64_t*								words = nullptr;
+			vint									count = 0;
+			vint									capacity = 0;
+			SetBitEnumerable						setBits{ this };
+
+			static vint WordCount(vint bits)
+			{
+				return (bits + WordBits - 1) / WordBits;
+			}
+
+			void									ClearUnusedBits();
+		public:
+			/// <summary>Create a bit array.</summary>
+			/// <param name="size">The number of bits. All bits are false.</param>
+			BitArray(vint size = 0);
+			BitArray(const BitArray&) = delete;
+			BitArray(BitArray&& _move);
+			~BitArray();
+
+			BitArray& operator=(const BitArray&) = delete;
+			BitArray& operator=(BitArray&& _move);
+
+			/// <summary>Get the number of bits.</summary>
+			/// <returns>The number of bits.</returns>
+			vint Count()const
+			{
+				return count;
+			}
+
+			/// <summary>Get the value of a bit.</summary>
+			/// <returns>The value of the bit. It will crash when the index is out of range.</returns>
+			/// <param name="index">The index of the bit.</param>
+			bool Get(vint index)const
+			{
+				CHECK_ERROR(index >= 0 && index < count, L"BitArray::Get(vint)#Argument index not in range.");
+				return (words[index / WordBits] >> (index % WordBits)) & 1;
+			}
+
+			/// <summary>Get the value of a bit.</summary>
+			/// <returns>The value of the bit. It will crash when the index is out of range.</returns>
+			/// <param name="index">The index of the bit.</param>
+			bool operator[](vint index)const
+			{
+				return Get(index);
+			}
+
+			/// <summary>Change the value of a bit.</summary>
+			/// <returns>Returns true if this operation succeeded. It will crash when the index is out of range.</returns>
+			/// <param name="index">The index of the bit.</param>
+			/// <param name="value">The new value.</param>
+			bool Set(vint index, bool value)
+			{
+				CHECK_ERROR(index >= 0 && index < count, L"BitArray::Set(vint, bool)#Argument index not in range.");
+				vuint64_t mask = (vuint64_t)1 << (index % WordBits);
+				if (value)
+				{
+					words[index / WordBits] |= mask;
+				}
+				else
+				{
+					words[index / WordBits] &= ~mask;
+				}
+				return true;
+			}
+
+			/// <summary>Invert the value of a bit.</summary>
+			/// <returns>The new value of the bit. It will crash when the index is out of range.</returns>
+			/// <param name="index">The index of the bit.</param>
+			bool Flip(vint index)
+			{
+				CHECK_ERROR(index >= 0 && index < count, L"BitArray::Flip(vint)#Argument index not in range.");
+				return (words[index / WordBits] ^= (vuint64_t)1 << (index % WordBits)) >> (index % WordBits) & 1;
+			}
+
+			/// <summary>Change the number of bits.</summary>
+			/// <param name="size">The new number of bits. Added bits are false.</param>
+			void									Resize(vint size);
+			/// <summary>Remove all bits.</summary>
+			/// <returns>Returns true if all bits are removed.</returns>
+			bool									Clear();
+			/// <summary>Change all bits to the same value.</summary>
+			/// <param name="value">The new value.</param>
+			void									Fill(bool value);
+
+			/// <summary>Get the number of true bits.</summary>
+			/// <returns>The number of true bits.</returns>
+			vint									PopCount()const;
+			/// <summary>Test if any bit is true.</summary>
+			/// <returns>Returns true if any bit is true.</returns>
+			bool									Any()const;
+			/// <summary>Find the first true bit.</summary>
+			/// <returns>The index of the first true bit. Returns -1 if all bits are false.</returns>
+			vint									FindFirst()const;
+			/// <summary>Find the first true bit starting from a specified index.</summary>
+			/// <returns>The index of the first true bit not before the specified index. Returns -1 if failed to find.</returns>
+			/// <param name="index">The index to start searching. It could be <see cref="Count"/>.</param>
+			vint									FindNext(vint index)const;
+
+			/// <summary>Keep bits that are true in both bit arrays.</summary>
+			/// <returns>The bit array itself. It will crash if two bit arrays have different numbers of bits.</returns>
+			/// <param name="bits">The other bit array.</param>
+			BitArray&								And(const BitArray& bits);
+			/// <summary>Set bits to true that are true in the other bit array.</summary>
+			/// <returns>The bit array itself. It will crash if two bit arrays have different numbers of bits.</returns>
+			/// <param name="bits">The other bit array.</param>
+			BitArray&								Or(const BitArray& bits);
+			/// <summary>Invert bits that are true in the other bit array.</summary>
+			/// <returns>The bit array itself. It will crash if two bit arrays have different numbers of bits.</returns>
+			/// <param name="bits">The other bit array.</param>
+			BitArray&								Xor(const BitArray& bits);
+			/// <summary>Set bits to false that are true in the other bit array.</summary>
+			/// <returns>The bit array itself. It will crash if two bit arrays have different numbers of bits.</returns>
+			/// <param name="bits">The other bit array.</param>
+			BitArray&								AndNot(const BitArray& bits);
+			/// <summary>Copy all bits from another bit array.</summary>
+			/// <returns>The bit array itself.</returns>
+			/// <param name="bits">The other bit array.</param>
+			BitArray&								Assign(const BitArray& bits);
+
+			/// <summary>Test if two bit arrays have the same bits.</summary>
+			/// <returns>Returns true if two bit arrays have the same number of bits, and all bits are the same.</returns>
+			/// <param name="bits">The other bit array.</param>
+			bool									operator==(const BitArray& bits)const;
+
+			/// <summary>Get indexes of all true bits in order.</summary>
+			/// <returns>The enumerable object of indexes. It reflects changes to the bit array.</returns>
+			const IEnumerable<vint>& SetBits()const
+			{
+				return setBits;
+			}
+		};
+
+/***********************************************************************
+Random Access
+***********************************************************************/
+
+		namespace randomaccess_internal
+		{
+			template<>
+			struct RandomAccessable<BitArray>
+			{
+				static const bool							CanRead = false;
+				static const bool							CanResize = false;
+			};
+
+			template<>
+			struct RandomAccess<BitArray>
+			{
+				// copying indexes to a bit array sets these bits, the bit array grows to hold all indexes
+				static void AppendValue(BitArray& t, vint index)
+				{
+					if (index >= t.Count())
+					{
+						t.Resize(index + 1);
+					}
+					t.Set(index, true);
+				}
+			};
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,359 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_CONCURRENTDICTIONARY
+#define VCZH_COLLECTIONS_CONCURRENTDICTIONARY
+
+#include "HashDictionary.h"
+#include "../Primitives/SpinLock.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		/// <summary>
+		/// ConcurrentDictionary: thread safe one to one map container.
+		/// Keys are partitioned into shards by hash codes, each shard is a <see cref="HashDictionary`4"/> protected by its own spin lock,
+		/// so that threads working on keys in different shards do not block each other.
+		/// </summary>
+		/// <typeparam name="KT">Type of keys.</typeparam>
+		/// <typeparam name="VT">Type of values.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for shards, see <see cref="DefaultAllocator"/>.</typeparam>
+		/// <typeparam name="THasher">Type to compute hash codes of keys, see <see cref="Hasher`1"/>.</typeparam>
+		/// <remarks>
+		/// Values are copied out of the dictionary, references to values are never exposed.
+		/// Factories passed to <see cref="GetOrAdd"/> and <see cref="AddOrUpdate"/> run without locking the shard, so they could access the same dictionary, but they could be called more than once for the same key.
+		/// Enumerating the dictionary iterates a snapshot taken when the enumerator is created, one shard at a time.
+		/// </remarks>
+		template<typename KT, typename VT, typename TAllocator = DefaultAllocator, typename THasher = Hasher<typename KeyType<KT>::Type>>
+		class ConcurrentDictionary : public EnumerableBase<Pair<const KT&, const VT&>>
+		{
+			using KK = typename KeyType<KT>::Type;
+			using KVPair = Pair<const KT&, const VT&>;
+			using Snapshot = List<Pair<KT, VT>>;
+		protected:
+			class Enumerator : public Object, public virtual IEnumerator<KVPair>
+			{
+			private:
+				Ptr<Snapshot>							snapshot;
+				vint									index;
+				Nullable<KVPair>						current;
+
+				void UpdateCurrent()
+				{
+					if (index >= 0 && index < snapshot->Count())
+					{
+						auto&& pair = snapshot->Get(index);
+						current = { pair.key, pair.value };
+					}
+				}
+			public:
+				POOLED_ALLOCATION(Enumerator)
+
+				Enumerator(Ptr<Snapshot> _snapshot, vint _index = -1)
+				{
+					snapshot = _snapshot;
+					index = _index;
+					UpdateCurrent();
+				}
+
+				IEnumerator<KVPair>* Clone()const override
+				{
+					return new Enumerator(snapshot, index);
+				}
+
+				const KVPair& Current()const override
+				{
+					return current.Value();
+				}
+
+				vint Index()const override
+				{
+					return index;
+				}
+
+				bool Next() override
+				{
+					index++;
+					UpdateCurrent();
+					return index >= 0 && index < snapshot->Count();
+				}
+
+				void Reset() override
+				{
+					index = -1;
+				}
+
+				bool Evaluated()const override
+				{
+					return true;
+				}
+			};
+
+			struct Shard
+			{
+				SpinLock											lock;
+				// increased when the dictionary is changed, to detect changes made while the shard is not locked
+				vint												version = 0;
+				HashDictionary<KT, VT, TAllocator, THasher>			dictionary;
+				// keep locks of adjacent shards in different cache lines
+				char												padding[CacheLineSize];
+
+				Shard(const TAllocator& allocator)
+					: dictionary(allocator)
+				{
+				}
+			};
+
+			VCZH_NO_UNIQUE_ADDRESS TAllocator		allocator;
+			Shard*									shards = nullptr;
+			vint									shardCount = 0;
+			vint									shardBits = 0;
+
+			Shard& GetShard(const KK& key)const
+			{
+				if (shardBits == 0) return shards[0];
+				return shards[(vint)(THasher::GetHashCode(key) >> (64 - shardBits))];
+			}
+		public:
+			NOT_COPYABLE(ConcurrentDictionary);
+
+			/// <summary>Create an empty dictionary.</summary>
+			/// <param name="_shardCount">The number of shards, it is rounded up to a power of two. It will crash if it is not positive.</param>
+			/// <param name="_allocator">The allocator for shards.</param>
+			ConcurrentDictionary(vint _shardCount = 16, const TAllocator& _allocator = TAllocator())
+				: allocator(_allocator)
+			{
+				CHECK_ERROR(_shardCount > 0, L"ConcurrentDictionary<KT, VT>::ConcurrentDictionary(vint)#The number of shards should be positive.");
+				shardCount = 1;
+				while (shardCount < _shardCount)
+				{
+					shardCount *= 2;
+					shardBits++;
+				}
+				shards = memory_management::AllocateBuffer<Shard>(allocator, shardCount);
+				for (vint i = 0; i < shardCount; i++)
+				{
+					new(&shards[i]) Shard(allocator);
+				}
+			}
+
+			~ConcurrentDictionary()
+			{
+				memory_management::CallDtors(shards, shardCount);
+				memory_management::DeallocateBuffer(allocator, shards, shardCount);
+			}
+
+			IEnumerator<KVPair>* CreateEnumerator()const
+			{
+				auto snapshot = Ptr(new Snapshot);
+				for (vint i = 0; i < shardCount; i++)
+				{
+					SpinLock::Scope scope(shards[i].lock);
+					auto&& dictionary = shards[i].dictionary;
+					for (vint j = 0; j < dictionary.Count(); j++)
+					{
+						snapshot->Add({ dictionary.Keys()[j], dictionary.Values()[j] });
+					}
+				}
+				return new Enumerator(snapshot);
+			}
+
+			/// <summary>Get the number of shards.</summary>
+			/// <returns>The number of shards.</returns>
+			vint ShardCount()const
+			{
+				return shardCount;
+			}
+
+			/// <summary>Get the number of keys. The result could be out of date when other threads are changing the dictionary.</summary>
+			/// <returns>The number of keys.</returns>
+			vint Count()const
+			{
+				vint count = 0;
+				for (vint i = 0; i < shardCount; i++)
+				{
+					SpinLock::Scope scope(shards[i].lock);
+					count += shards[i].dictionary.Count();
+				}
+				return count;
+			}
+
+			/// <summary>Test if a key exists.</summary>
+			/// <returns>Returns true if the key exists.</returns>
+			/// <param name="key">The key to find.</param>
+			bool Contains(const KK& key)const
+			{
+				Shard& shard = GetShard(key);
+				SpinLock::Scope scope(shard.lock);
+				return shard.dictionary.Contains(key);
+			}
+
+			/// <summary>Get a copy of the value associated to a specified key.</summary>
+			/// <returns>Returns true if the key exists.</returns>
+			/// <param name="key">The key to find.</param>
+			/// <param name="value">The variable to receive the value.</param>
+			bool TryGet(const KK& key, VT& value)const
+			{
+				Shard& shard = GetShard(key);
+				SpinLock::Scope scope(shard.lock);
+				vint index = shard.dictionary.IndexOf(key);
+				if (index == -1) return false;
+				value = shard.dictionary.Values()[index];
+				return true;
+			}
+
+			/// <summary>Add a key with an associated value if the key does not exist.</summary>
+			/// <returns>Returns true if the pair is added.</returns>
+			/// <param name="key">The key to add.</param>
+			/// <param name="value">The value to add.</param>
+			bool TryAdd(const KT& key, const VT& value)
+			{
+				Shard& shard = GetShard(KeyType<KT>::GetKeyValue(key));
+				SpinLock::Scope scope(shard.lock);
+				if (shard.dictionary.Contains(KeyType<KT>::GetKeyValue(key))) return false;
+				shard.dictionary.Add(key, value);
+				shard.version++;
+				return true;
+			}
+
+			/// <summary>Get the value associated to a specified key, add the key with a value if it does not exist.</summary>
+			/// <returns>A copy of the value associated to the key after this call.</returns>
+			/// <param name="key">The key to find.</param>
+			/// <param name="value">The value to add if the key does not exist.</param>
+			VT GetOrAdd(const KT& key, const VT& value)
+			{
+				Shard& shard = GetShard(KeyType<KT>::GetKeyValue(key));
+				SpinLock::Scope scope(shard.lock);
+				vint index = shard.dictionary.IndexOf(KeyType<KT>::GetKeyValue(key));
+				if (index != -1) return shard.dictionary.Values()[index];
+				shard.dictionary.Add(key, value);
+				shard.version++;
+				return value;
+			}
+
+			/// <summary>Get the value associated to a specified key, add the key with a value created by a factory if it does not exist.</summary>
+			/// <returns>A copy of the value associated to the key after this call.</returns>
+			/// <typeparam name="F">Type of the factory.</typeparam>
+			/// <param name="key">The key to find.</param>
+			/// <param name="factory">
+			/// The factory taking the key and returning the value to add. It is called only when the key does not exist, without locking the dictionary.
+			/// If another thread adds the key before the result is stored, the result is discarded and the existing value is returned.
+			/// </param>
+			template<typename F>
+				requires(std::is_invocable_r_v<VT, F&&, const KT&>)
+			VT GetOrAdd(const KT& key, F&& factory)
+			{
+				Shard& shard = GetShard(KeyType<KT>::GetKeyValue(key));
+				{
+					SpinLock::Scope scope(shard.lock);
+					vint index = shard.dictionary.IndexOf(KeyType<KT>::GetKeyValue(key));
+					if (index != -1) return shard.dictionary.Values()[index];
+				}
+
+				VT value = factory(key);
+				SpinLock::Scope scope(shard.lock);
+				vint index = shard.dictionary.IndexOf(KeyType<KT>::GetKeyValue(key));
+				if (index != -1) return shard.dictionary.Values()[index];
+				shard.dictionary.Add(key, value);
+				shard.version++;
+				return value;
+			}
+
+			/// <summary>Add a key with a value if it does not exist, or replace the associated value with a value created by a factory.</summary>
+			/// <returns>A copy of the value associated to the key after this call.</returns>
+			/// <typeparam name="F">Type of the factory.</typeparam>
+			/// <param name="key">The key to find.</param>
+			/// <param name="value">The value to add if the key does not exist.</param>
+			/// <param name="update">
+			/// The factory taking the key and the old value and returning the new value. It is called only when the key exists, without locking the dictionary.
+			/// If another thread changes the same shard before the result is stored, the factory is called again with the latest value.
+			/// </param>
+			template<typename F>
+				requires(std::is_invocable_r_v<VT, F&&, const KT&, const VT&>)
+			VT AddOrUpdate(const KT& key, const VT& value, F&& update)
+			{
+				Shard& shard = GetShard(KeyType<KT>::GetKeyValue(key));
+				while (true)
+				{
+					Nullable<VT> oldValue;
+					vint version = 0;
+					{
+						SpinLock::Scope scope(shard.lock);
+						vint index = shard.dictionary.IndexOf(KeyType<KT>::GetKeyValue(key));
+						if (index == -1)
+						{
+							shard.dictionary.Add(key, value);
+							shard.version++;
+							return value;
+						}
+						oldValue = shard.dictionary.Values()[index];
+						version = shard.version;
+					}
+
+					VT newValue = update(key, oldValue.Value());
+					SpinLock::Scope scope(shard.lock);
+					if (shard.version == version)
+					{
+						shard.dictionary.Set(key, newValue);
+						shard.version++;
+						return newValue;
+					}
+				}
+			}
+
+			/// <summary>Remove a key with the associated value.</summary>
+			/// <returns>Returns true if the key and the value is removed.</returns>
+			/// <param name="key">The key to find.</param>
+			bool TryRemove(const KK& key)
+			{
+				Shard& shard = GetShard(key);
+				SpinLock::Scope scope(shard.lock);
+				if (!shard.dictionary.Remove(key)) return false;
+				shard.version++;
+				return true;
+			}
+
+			/// <summary>Remove a key with the associated value.</summary>
+			/// <returns>Returns true if the key and the value is removed.</returns>
+			/// <param name="key">The key to find.</param>
+			/// <param name="value">The variable to receive the removed value.</param>
+			bool TryRemove(const KK& key, VT& value)
+			{
+				Shard& shard = GetShard(key);
+				SpinLock::Scope scope(shard.lock);
+				vint index = shard.dictionary.IndexOf(key);
+				if (index == -1) return false;
+				value = shard.dictionary.Values()[index];
+				shard.dictionary.Remove(key);
+				shard.version++;
+				return true;
+			}
+
+			/// <summary>Remove all elements, one shard at a time.</summary>
+			/// <returns>Returns true if all elements are removed.</returns>
+			bool Clear()
+			{
+				for (vint i = 0; i < shardCount; i++)
+				{
+					SpinLock::Scope scope(shards[i].lock);
+					shards[i].dictionary.Clear();
+					shards[i].version++;
+				}
+				return true;
+			}
+		};
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
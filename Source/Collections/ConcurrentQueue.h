@@ -0,0 +1,337 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_CONCURRENTQUEUE
+#define VCZH_COLLECTIONS_CONCURRENTQUEUE
+
+#include "List.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		namespace concurrentqueue_internal
+		{
+			inline vint GetPowerOfTwoCapacity(vint minCapacity)
+			{
+				vint capacity = 2;
+				while (capacity < minCapacity)
+				{
+					capacity *= 2;
+				}
+				return capacity;
+			}
+		}
+
+/***********************************************************************
+ConcurrentQueue
+***********************************************************************/
+
+		/// <summary>
+		/// ConcurrentQueue: bounded first in first out container for any number of producer and consumer threads.
+		/// It does not take any lock, every slot carries a sequence number telling whether it is ready to be written or read.
+		/// </summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for the buffer, see <see cref="DefaultAllocator"/>.</typeparam>
+		/// <remarks>
+		/// The capacity is fixed when the queue is created, <see cref="TryEnqueue"/> fails when the queue is full.
+		/// Use <see cref="SpscQueue`2"/> if there is only one producer thread and one consumer thread.
+		/// If constructing an element throws, <see cref="TryEnqueue"/> rethrows and the element is not added.
+		/// If moving an element out throws, <see cref="TryDequeue"/> rethrows and the element is dropped.
+		/// </remarks>
+		template<typename T, typename TAllocator = DefaultAllocator>
+		class ConcurrentQueue : public Object
+		{
+		protected:
+			struct Cell
+			{
+				std::atomic<vint>					sequence;
+				bool								constructed;
+				alignas(T) char						storage[sizeof(T)];
+			};
+
+			VCZH_NO_UNIQUE_ADDRESS TAllocator		allocator;
+			Cell*									buffer = nullptr;
+			vint									mask = 0;
+
+			// producers and consumers update different positions, keep them in different cache lines
+			alignas(CacheLineSize) std::atomic<vint>		enqueuePosition{ 0 };
+			alignas(CacheLineSize) std::atomic<vint>		dequeuePosition{ 0 };
+			char									padding[CacheLineSize - sizeof(std::atomic<vint>)];
+
+			template<typename TItem>
+			bool TryEnqueueInternal(TItem&& item)
+			{
+				vint position = enqueuePosition.load(std::memory_order_relaxed);
+				Cell* cell = nullptr;
+				while (true)
+				{
+					cell = &buffer[position & mask];
+					vint difference = cell->sequence.load(std::memory_order_acquire) - position;
+					if (difference == 0)
+					{
+						if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						{
+							break;
+						}
+					}
+					else if (difference < 0)
+					{
+						return false;
+					}
+					else
+					{
+						position = enqueuePosition.load(std::memory_order_relaxed);
+					}
+				}
+				try
+				{
+					new(cell->storage) T(std::forward<TItem&&>(item));
+					cell->constructed = true;
+				}
+				catch (...)
+				{
+					// the slot is already taken, publish it as an empty one so that consumers skip it instead of waiting forever
+					cell->constructed = false;
+					cell->sequence.store(position + 1, std::memory_order_release);
+					throw;
+				}
+				cell->sequence.store(position + 1, std::memory_order_release);
+				return true;
+			}
+		public:
+			NOT_COPYABLE(ConcurrentQueue);
+
+			/// <summary>Create an empty queue.</summary>
+			/// <param name="_capacity">The maximum number of elements, it is rounded up to a power of two. It will crash if it is not positive.</param>
+			/// <param name="_allocator">The allocator for the buffer.</param>
+			ConcurrentQueue(vint _capacity, const TAllocator& _allocator = TAllocator())
+				: allocator(_allocator)
+			{
+				CHECK_ERROR(_capacity > 0, L"ConcurrentQueue<T, TAllocator>::ConcurrentQueue(vint)#The capacity should be positive.");
+				vint capacity = concurrentqueue_internal::GetPowerOfTwoCapacity(_capacity);
+				buffer = memory_management::AllocateBuffer<Cell>(allocator, capacity);
+				mask = capacity - 1;
+				for (vint i = 0; i < capacity; i++)
+				{
+					new(&buffer[i].sequence) std::atomic<vint>(i);
+				}
+			}
+
+			~ConcurrentQueue()
+			{
+				vint capacity = mask + 1;
+				for (vint position = dequeuePosition.load(); position != enqueuePosition.load(); position++)
+				{
+					Cell& cell = buffer[position & mask];
+					if (cell.constructed)
+					{
+						((T*)cell.storage)->~T();
+					}
+				}
+				memory_management::DeallocateBuffer(allocator, buffer, capacity);
+			}
+
+			/// <summary>Get the maximum number of elements.</summary>
+			/// <returns>The maximum number of elements.</returns>
+			vint Capacity()const
+			{
+				return mask + 1;
+			}
+
+			/// <summary>Add an element to the end of the queue if it is not full.</summary>
+			/// <returns>Returns true if the element is added.</returns>
+			/// <param name="item">The element to add.</param>
+			bool TryEnqueue(const T& item)
+			{
+				return TryEnqueueInternal(item);
+			}
+
+			/// <summary>Add an element to the end of the queue if it is not full. The element is not moved if the queue is full.</summary>
+			/// <returns>Returns true if the element is added.</returns>
+			/// <param name="item">The element to add.</param>
+			bool TryEnqueue(T&& item)
+			{
+				return TryEnqueueInternal(std::move(item));
+			}
+
+			/// <summary>Remove the first element if the queue is not empty.</summary>
+			/// <returns>Returns true if an element is removed.</returns>
+			/// <param name="item">The variable to receive the removed element.</param>
+			bool TryDequeue(T& item)
+			{
+				vint position = dequeuePosition.load(std::memory_order_relaxed);
+				Cell* cell = nullptr;
+				while (true)
+				{
+					cell = &buffer[position & mask];
+					vint difference = cell->sequence.load(std::memory_order_acquire) - (position + 1);
+					if (difference == 0)
+					{
+						if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						{
+							if (cell->constructed)
+							{
+								break;
+							}
+							// the producer failed to construct the element, release the slot and try the next one
+							cell->sequence.store(position + mask + 1, std::memory_order_release);
+							position = dequeuePosition.load(std::memory_order_relaxed);
+						}
+					}
+					else if (difference < 0)
+					{
+						return false;
+					}
+					else
+					{
+						position = dequeuePosition.load(std::memory_order_relaxed);
+					}
+				}
+				T* slot = (T*)cell->storage;
+				try
+				{
+					item = std::move(*slot);
+				}
+				catch (...)
+				{
+					// the element is dropped, the slot must still be released for producers
+					slot->~T();
+					cell->sequence.store(position + mask + 1, std::memory_order_release);
+					throw;
+				}
+				slot->~T();
+				cell->sequence.store(position + mask + 1, std::memory_order_release);
+				return true;
+			}
+		};
+
+/***********************************************************************
+SpscQueue
+***********************************************************************/
+
+		/// <summary>
+		/// SpscQueue: bounded first in first out container for exactly one producer thread and one consumer thread.
+		/// It does not take any lock, and each side only reads the position of the other side when its cached copy says the queue is full or empty.
+		/// </summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for the buffer, see <see cref="DefaultAllocator"/>.</typeparam>
+		/// <remarks>
+		/// The capacity is fixed when the queue is created, <see cref="TryEnqueue"/> fails when the queue is full.
+		/// Calling <see cref="TryEnqueue"/> or <see cref="TryDequeue"/> from more than one thread at the same time is undefined behavior, use <see cref="ConcurrentQueue`2"/> instead.
+		/// </remarks>
+		template<typename T, typename TAllocator = DefaultAllocator>
+		class SpscQueue : public Object
+		{
+		protected:
+			VCZH_NO_UNIQUE_ADDRESS TAllocator		allocator;
+			T*										buffer = nullptr;
+			vint									mask = 0;
+
+			// written by the producer
+			alignas(CacheLineSize) std::atomic<vint>		tail{ 0 };
+			vint									cachedHead = 0;
+
+			// written by the consumer
+			alignas(CacheLineSize) std::atomic<vint>		head{ 0 };
+			vint									cachedTail = 0;
+			char									padding[CacheLineSize - sizeof(std::atomic<vint>) - sizeof(vint)];
+
+			template<typename TItem>
+			bool TryEnqueueInternal(TItem&& item)
+			{
+				vint position = tail.load(std::memory_order_relaxed);
+				if (position - cachedHead > mask)
+				{
+					cachedHead = head.load(std::memory_order_acquire);
+					if (position - cachedHead > mask)
+					{
+						return false;
+					}
+				}
+				new(&buffer[position & mask]) T(std::forward<TItem&&>(item));
+				tail.store(position + 1, std::memory_order_release);
+				return true;
+			}
+		public:
+			NOT_COPYABLE(SpscQueue);
+
+			/// <summary>Create an empty queue.</summary>
+			/// <param name="_capacity">The maximum number of elements, it is rounded up to a power of two. It will crash if it is not positive.</param>
+			/// <param name="_allocator">The allocator for the buffer.</param>
+			SpscQueue(vint _capacity, const TAllocator& _allocator = TAllocator())
+				: allocator(_allocator)
+			{
+				CHECK_ERROR(_capacity > 0, L"SpscQueue<T, TAllocator>::SpscQueue(vint)#The capacity should be positive.");
+				vint capacity = concurrentqueue_internal::GetPowerOfTwoCapacity(_capacity);
+				buffer = memory_management::AllocateBuffer<T>(allocator, capacity);
+				mask = capacity - 1;
+			}
+
+			~SpscQueue()
+			{
+				for (vint position = head.load(); position != tail.load(); position++)
+				{
+					buffer[position & mask].~T();
+				}
+				memory_management::DeallocateBuffer(allocator, buffer, mask + 1);
+			}
+
+			/// <summary>Get the maximum number of elements.</summary>
+			/// <returns>The maximum number of elements.</returns>
+			vint Capacity()const
+			{
+				return mask + 1;
+			}
+
+			/// <summary>Add an element to the end of the queue if it is not full. It should only be called from the producer thread.</summary>
+			/// <returns>Returns true if the element is added.</returns>
+			/// <param name="item">The element to add.</param>
+			bool TryEnqueue(const T& item)
+			{
+				return TryEnqueueInternal(item);
+			}
+
+			/// <summary>Add an element to the end of the queue if it is not full. It should only be called from the producer thread. The element is not moved if the queue is full.</summary>
+			/// <returns>Returns true if the element is added.</returns>
+			/// <param name="item">The element to add.</param>
+			bool TryEnqueue(T&& item)
+			{
+				return TryEnqueueInternal(std::move(item));
+			}
+
+			/// <summary>Remove the first element if the queue is not empty. It should only be called from the consumer thread.</summary>
+			/// <returns>Returns true if an element is removed.</returns>
+			/// <param name="item">The variable to receive the removed element.</param>
+			bool TryDequeue(T& item)
+			{
+				vint position = head.load(std::memory_order_relaxed);
+				if (position == cachedTail)
+				{
+					cachedTail = tail.load(std::memory_order_acquire);
+					if (position == cachedTail)
+					{
+						return false;
+					}
+				}
+				T& slot = buffer[position & mask];
+				item = std::move(slot);
+				slot.~T();
+				head.store(position + 1, std::memory_order_release);
+				return true;
+			}
+		};
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
@@ -9,27 +9,127 @@ Licensed under https://github.com/vczh-libraries/License
 #include "List.h"
 #include "../Primitives/Nullable.h"
 
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
 namespace vl
 {
 	namespace collections
 	{
+		namespace dictionary_internal
+		{
+			/// <summary>
+			/// Copy all pairs into two lists and sort them by keys.
+			/// Pairs with equal keys keep their original order.
+			/// Pairs are enumerated only once.
+			/// Each list allocates its buffer exactly once if the source is an <see cref="ArrayBase`1"/> or already evaluated.
+			/// </summary>
+			template<typename TPair, typename KT, typename VT, typename TAllocator>
+			void CollectSortedPairs(const IEnumerable<TPair>& items, List<KT, TAllocator>& keys, List<VT, TAllocator>& values)
+			{
+				auto enumerator = Ptr(items.CreateEnumerator());
+				vint expectedCount = -1;
+				if (auto arrayBase = dynamic_cast<const ArrayBase<TPair>*>(&items))
+				{
+					expectedCount = arrayBase->Count();
+				}
+				else if (enumerator->Evaluated())
+				{
+					// counting an evaluated container is cheap and has no side effect
+					expectedCount = 0;
+					auto counter = Ptr(items.CreateEnumerator());
+					while (counter->Next())
+					{
+						expectedCount++;
+					}
+				}
+
+				if (expectedCount != -1)
+				{
+					keys.Reserve(expectedCount);
+					values.Reserve(expectedCount);
+				}
+				while (enumerator->Next())
+				{
+					auto&& pair = enumerator->Current();
+					keys.Add(pair.key);
+					values.Add(pair.value);
+				}
+
+				vint count = keys.Count();
+
+				vint unsorted = 1;
+				while (unsorted < count && (keys[unsorted - 1] <=> keys[unsorted]) <= 0)
+				{
+					unsorted++;
+				}
+				if (unsorted >= count) return;
+
+				// sort positions instead of pairs, ties are broken by positions to make the result stable
+				using Ordering = decltype(keys[0] <=> keys[0]);
+				Array<vint, TAllocator> order(count, keys.GetAllocator());
+				for (vint i = 0; i < count; i++)
+				{
+					order[i] = i;
+				}
+				SortLambda(&order[0], count, [&](vint a, vint b) -> Ordering
+				{
+					Ordering result = keys[a] <=> keys[b];
+					if (result != 0) return result;
+					return a <=> b;
+				});
+
+				// order[i] is the original position of the pair that should be moved to i
+				// follow each cycle of the permutation, visited positions are marked by -1
+				for (vint i = 0; i < count; i++)
+				{
+					if (order[i] == -1) continue;
+					if (order[i] == i)
+					{
+						order[i] = -1;
+						continue;
+					}
+
+					KT key = std::move(keys[i]);
+					VT value = std::move(values[i]);
+					vint target = i;
+					while (true)
+					{
+						vint source = order[target];
+						order[target] = -1;
+						if (source == i)
+						{
+							keys[target] = std::move(key);
+							values[target] = std::move(value);
+							break;
+						}
+						keys[target] = std::move(keys[source]);
+						values[target] = std::move(values[source]);
+						target = source;
+					}
+				}
+			}
+		}
+
 		/// <summary>Dictionary: one to one map container.</summary>
 		/// <typeparam name="KT">Type of keys.</typeparam>
 		/// <typeparam name="VT">Type of values.</typeparam>
-		template<typename KT, typename VT>
+		/// <typeparam name="TAllocator">Type of the allocator for keys and values, see <see cref="DefaultAllocator"/>.</typeparam>
+		template<typename KT, typename VT, typename TAllocator = DefaultAllocator>
 		class Dictionary : public EnumerableBase<Pair<const KT&, const VT&>>
 		{
 			using KK = typename KeyType<KT>::Type;
 			using VK = typename KeyType<VT>::Type;
 			using KVPair = Pair<const KT&, const VT&>;
 		public:
-			typedef SortedList<KT>					KeyContainer;
-			typedef List<VT>						ValueContainer;
+			typedef SortedList<KT, TAllocator>		KeyContainer;
+			typedef List<VT, TAllocator>			ValueContainer;
 		protected:
 			class Enumerator : public Object, public virtual IEnumerator<KVPair>
 			{
 			private:
-				const Dictionary<KT, VT>*			container;
+				const Dictionary<KT, VT, TAllocator>*	container;
 				vint								index;
 				Nullable<KVPair>					current;
 
@@ -41,7 +141,9 @@ namespace vl
 					}
 				}
 			public:
-				Enumerator(const Dictionary<KT, VT>* _container, vint _index=-1)
+				POOLED_ALLOCATION(Enumerator)
+
+				Enumerator(const Dictionary<KT, VT, TAllocator>* _container, vint _index=-1)
 				{
 					container=_container;
 					index=_index;
@@ -117,20 +219,105 @@ namespace vl
 
 				return true;
 			}
+
+			template<typename TPair>
+			bool AddRangeInternal(const IEnumerable<TPair>& items, bool replace)
+			{
+				auto allocator = keys.GetAllocator();
+				List<KT, TAllocator> newKeys(allocator);
+				List<VT, TAllocator> newValues(allocator);
+				dictionary_internal::CollectSortedPairs(items, newKeys, newValues);
+				if (replace)
+				{
+					Clear();
+				}
+
+				// for equal keys only the last value is kept, just like calling Set one by one
+				vint newCount = 0;
+				for (vint i = 0; i < newKeys.Count(); i++)
+				{
+					if (i + 1 < newKeys.Count() && (newKeys[i] <=> newKeys[i + 1]) == 0) continue;
+					if (newCount != i)
+					{
+						newKeys[newCount] = std::move(newKeys[i]);
+						newValues[newCount] = std::move(newValues[i]);
+					}
+					newCount++;
+				}
+				if (newCount < newKeys.Count())
+				{
+					newKeys.RemoveRange(newCount, newKeys.Count() - newCount);
+					newValues.RemoveRange(newCount, newValues.Count() - newCount);
+				}
+
+				if (keys.Count() == 0)
+				{
+					keys = std::move(newKeys);
+					values = std::move(newValues);
+					return true;
+				}
+
+				List<KT, TAllocator> oldKeys(std::move(keys));
+				List<VT, TAllocator> oldValues(std::move(values));
+				List<KT, TAllocator> mergedKeys(allocator);
+				List<VT, TAllocator> mergedValues(allocator);
+				mergedKeys.Reserve(oldKeys.Count() + newCount);
+				mergedValues.Reserve(oldKeys.Count() + newCount);
+
+				vint oldIndex = 0;
+				vint newIndex = 0;
+				while (oldIndex < oldKeys.Count() || newIndex < newCount)
+				{
+					bool takeOld = newIndex == newCount;
+					bool takeNew = oldIndex == oldKeys.Count();
+					if (!takeOld && !takeNew)
+					{
+						auto order = oldKeys[oldIndex] <=> newKeys[newIndex];
+						takeOld = order <= 0;
+						takeNew = order >= 0;
+						CHECK_ERROR(takeOld || takeNew, L"Dictionary<KT, VT, TAllocator>::AddRange(const IEnumerable<Pair<KT, VT>>&)#Keys are not comparable.");
+					}
+
+					if (takeOld)
+					{
+						mergedKeys.Add(std::move(oldKeys[oldIndex]));
+						if (!takeNew) mergedValues.Add(std::move(oldValues[oldIndex]));
+						oldIndex++;
+					}
+					if (takeNew)
+					{
+						if (!takeOld) mergedKeys.Add(std::move(newKeys[newIndex]));
+						mergedValues.Add(std::move(newValues[newIndex]));
+						newIndex++;
+					}
+				}
+
+				keys = std::move(mergedKeys);
+				values = std::move(mergedValues);
+				return true;
+			}
 		public:
 			/// <summary>Create an empty dictionary.</summary>
 			Dictionary() = default;
 			~Dictionary() = default;
 
-			Dictionary(const Dictionary<KT, VT>&) = delete;
-			Dictionary(Dictionary<KT, VT>&& _move)
+			/// <summary>Create an empty dictionary with an allocator.</summary>
+			/// <param name="allocator">The allocator for keys and values.</param>
+			explicit Dictionary(const TAllocator& allocator)
+				: keys(allocator)
+				, values(allocator)
+			{
+			}
+
+			Dictionary(const Dictionary<KT, VT, TAllocator>&) = delete;
+			Dictionary(Dictionary<KT, VT, TAllocator>&& _move)
 				: keys(std::move(_move.keys))
 				, values(std::move(_move.values))
 			{
 			}
 
-			Dictionary<KT, VT>& operator=(const Dictionary<KT, VT>&) = delete;
-			Dictionary<KT, VT>& operator=(Dictionary<KT, VT> && _move)
+			Dictionary<KT, VT, TAllocator>& operator=(const Dictionary<KT, VT, TAllocator>&) = delete;
+			Dictionary<KT, VT, TAllocator>& operator=(Dictionary<KT, VT, TAllocator> && _move)
 			{
 				keys = std::move(_move.keys);
 				values = std::move(_move.values);
@@ -237,6 +424,34 @@ namespace vl
 			/// <param name="value">The value to add.</param>
 			bool Add(KT&& key, VT&& value) { return AddInternal<KT&&, VT&&>(std::move(key), std::move(value)); }
 
+			/// <summary>
+			/// Add or replace multiple keys and values.
+			/// Pairs are sorted only once, instead of inserting them one by one.
+			/// The result is the same as calling <see cref="Set"/> for each pair in order,
+			/// which means for equal keys only the last value is kept.
+			/// </summary>
+			/// <returns>Returns true if all pairs are added.</returns>
+			/// <param name="items">Pairs of keys and values to add.</param>
+			bool AddRange(const IEnumerable<Pair<KT, VT>>& items) { return AddRangeInternal(items, false); }
+			/// <summary>
+			/// Add or replace multiple keys and values.
+			/// Pairs are sorted only once, instead of inserting them one by one.
+			/// The result is the same as calling <see cref="Set"/> for each pair in order,
+			/// which means for equal keys only the last value is kept.
+			/// </summary>
+			/// <returns>Returns true if all pairs are added.</returns>
+			/// <param name="items">Pairs of keys and values to add.</param>
+			bool AddRange(const IEnumerable<Pair<const KT&, const VT&>>& items) { return AddRangeInternal(items, false); }
+
+			/// <summary>Replace all keys and values. Each container of keys and values allocates its buffer exactly once.</summary>
+			/// <returns>Returns true if all pairs are added.</returns>
+			/// <param name="items">Pairs of keys and values. For equal keys only the last value is kept.</param>
+			bool BuildFrom(const IEnumerable<Pair<KT, VT>>& items) { return AddRangeInternal(items, true); }
+			/// <summary>Replace all keys and values. Each container of keys and values allocates its buffer exactly once.</summary>
+			/// <returns>Returns true if all pairs are added.</returns>
+			/// <param name="items">Pairs of keys and values. For equal keys only the last value is kept.</param>
+			bool BuildFrom(const IEnumerable<Pair<const KT&, const VT&>>& items) { return AddRangeInternal(items, true); }
+
 			/// <summary>Remove a key with the associated value.</summary>
 			/// <returns>Returns true if the key and the value is removed.</returns>
 			/// <param name="key">The key to find.</param>
@@ -268,20 +483,21 @@ namespace vl
 		/// <summary>Group: one to many map container.</summary>
 		/// <typeparam name="KT">Type of keys.</typeparam>
 		/// <typeparam name="VT">Type of values.</typeparam>
-		template<typename KT, typename VT>
+		/// <typeparam name="TAllocator">Type of the allocator for keys, values and value lists, see <see cref="DefaultAllocator"/>.</typeparam>
+		template<typename KT, typename VT, typename TAllocator = DefaultAllocator>
 		class Group : public EnumerableBase<Pair<const KT&, const VT&>>
 		{
 			using KK = typename KeyType<KT>::Type;
 			using VK = typename KeyType<VT>::Type;
 			using KVPair = Pair<const KT&, const VT&>;
 		public:
-			typedef SortedList<KT>					KeyContainer;
-			typedef List<VT>						ValueContainer;
+			typedef SortedList<KT, TAllocator>		KeyContainer;
+			typedef List<VT, TAllocator>			ValueContainer;
 		protected:
 			class Enumerator : public Object, public virtual IEnumerator<KVPair>
 			{
 			private:
-				const Group<KT, VT>*				container;
+				const Group<KT, VT, TAllocator>*	container;
 				vint								keyIndex;
 				vint								valueIndex;
 				Nullable<KVPair>					current;
@@ -298,7 +514,9 @@ namespace vl
 					}
 				}
 			public:
-				Enumerator(const Group<KT, VT>* _container, vint _keyIndex=-1, vint _valueIndex=-1)
+				POOLED_ALLOCATION(Enumerator)
+
+				Enumerator(const Group<KT, VT, TAllocator>* _container, vint _keyIndex=-1, vint _valueIndex=-1)
 				{
 					container=_container;
 					keyIndex=_keyIndex;
@@ -369,8 +587,22 @@ namespace vl
 				}
 			};
 
-			KeyContainer					keys;
-			List<ValueContainer*>			values;
+			KeyContainer							keys;
+			List<ValueContainer*, TAllocator>		values;
+
+			ValueContainer* CreateValueContainer()
+			{
+				auto allocator = keys.GetAllocator();
+				auto target = (ValueContainer*)allocator.Allocate(sizeof(ValueContainer));
+				return new(target) ValueContainer(allocator);
+			}
+
+			void DeleteValueContainer(ValueContainer* target)
+			{
+				auto allocator = keys.GetAllocator();
+				target->~ValueContainer();
+				allocator.Deallocate(target, sizeof(ValueContainer));
+			}
 
 			template<typename TKeyItem, typename TValueItem>
 			bool AddInternal(TKeyItem&& key, TValueItem&& value)
@@ -383,7 +615,7 @@ namespace vl
 				vint index = keys.IndexOf(KeyType<KT>::GetKeyValue(keyAccept));
 				if (index == -1)
 				{
-					target = new ValueContainer;
+					target = CreateValueContainer();
 					values.Insert(keys.Add(std::forward<TKeyForward>(keyAccept)), target);
 				}
 				else
@@ -393,24 +625,140 @@ namespace vl
 				target->Add(std::forward<TValueItem&&>(value));
 				return true;
 			}
+
+			template<typename TPair>
+			bool AddRangeInternal(const IEnumerable<TPair>& items, bool replace)
+			{
+				auto allocator = keys.GetAllocator();
+				List<KT, TAllocator> newKeys(allocator);
+				List<VT, TAllocator> newValues(allocator);
+				dictionary_internal::CollectSortedPairs(items, newKeys, newValues);
+				if (replace)
+				{
+					Clear();
+				}
+
+				// moves a run of values with the same key to a value container
+				auto moveRun = [&](vint start, ValueContainer* target)
+				{
+					vint end = start + 1;
+					while (end < newKeys.Count() && (newKeys[start] <=> newKeys[end]) == 0)
+					{
+						end++;
+					}
+					target->Reserve(target->Count() + end - start);
+					for (vint i = start; i < end; i++)
+					{
+						target->Add(std::move(newValues[i]));
+					}
+					return end;
+				};
+
+				vint runs = 0;
+				for (vint i = 0; i < newKeys.Count(); i++)
+				{
+					if (i == 0 || (newKeys[i - 1] <=> newKeys[i]) != 0) runs++;
+				}
+
+				if (keys.Count() == 0)
+				{
+					values.Reserve(runs);
+					vint newCount = 0;
+					vint newIndex = 0;
+					while (newIndex < newKeys.Count())
+					{
+						auto target = CreateValueContainer();
+						values.Add(target);
+						vint end = moveRun(newIndex, target);
+						if (newCount != newIndex)
+						{
+							newKeys[newCount] = std::move(newKeys[newIndex]);
+						}
+						newCount++;
+						newIndex = end;
+					}
+					if (newCount < newKeys.Count())
+					{
+						newKeys.RemoveRange(newCount, newKeys.Count() - newCount);
+					}
+					keys = std::move(newKeys);
+					return true;
+				}
+
+				List<KT, TAllocator> oldKeys(std::move(keys));
+				List<ValueContainer*, TAllocator> oldValues(std::move(values));
+				List<KT, TAllocator> mergedKeys(allocator);
+				List<ValueContainer*, TAllocator> mergedValues(allocator);
+				mergedKeys.Reserve(oldKeys.Count() + runs);
+				mergedValues.Reserve(oldKeys.Count() + runs);
+
+				vint oldIndex = 0;
+				vint newIndex = 0;
+				while (oldIndex < oldKeys.Count() || newIndex < newKeys.Count())
+				{
+					bool takeOld = newIndex == newKeys.Count();
+					bool takeNew = oldIndex == oldKeys.Count();
+					if (!takeOld && !takeNew)
+					{
+						auto order = oldKeys[oldIndex] <=> newKeys[newIndex];
+						takeOld = order <= 0;
+						takeNew = order >= 0;
+						CHECK_ERROR(takeOld || takeNew, L"Group<KT, VT, TAllocator>::AddRange(const IEnumerable<Pair<KT, VT>>&)#Keys are not comparable.");
+					}
+
+					ValueContainer* target = nullptr;
+					if (takeOld)
+					{
+						mergedKeys.Add(std::move(oldKeys[oldIndex]));
+						target = oldValues[oldIndex];
+						oldIndex++;
+					}
+					if (takeNew)
+					{
+						if (!target)
+						{
+							target = CreateValueContainer();
+						}
+						vint end = moveRun(newIndex, target);
+						if (!takeOld)
+						{
+							mergedKeys.Add(std::move(newKeys[newIndex]));
+						}
+						newIndex = end;
+					}
+					mergedValues.Add(target);
+				}
+
+				keys = std::move(mergedKeys);
+				values = std::move(mergedValues);
+				return true;
+			}
 		public:
 			/// <summary>Create an empty group.</summary>
 			Group() = default;
 
+			/// <summary>Create an empty group with an allocator.</summary>
+			/// <param name="allocator">The allocator for keys, values and value lists.</param>
+			explicit Group(const TAllocator& allocator)
+				: keys(allocator)
+				, values(allocator)
+			{
+			}
+
 			~Group()
 			{
 				Clear();
 			}
 
-			Group(const Group<KT, VT>&) = delete;
-			Group(Group<KT, VT>&& _move)
+			Group(const Group<KT, VT, TAllocator>&) = delete;
+			Group(Group<KT, VT, TAllocator>&& _move)
 				: keys(std::move(_move.keys))
 				, values(std::move(_move.values))
 			{
 			}
 
-			Group<KT, VT>& operator=(const Group<KT, VT>&) = delete;
-			Group<KT, VT>& operator=(Group<KT, VT> && _move)
+			Group<KT, VT, TAllocator>& operator=(const Group<KT, VT, TAllocator>&) = delete;
+			Group<KT, VT, TAllocator>& operator=(Group<KT, VT, TAllocator> && _move)
 			{
 				Clear();
 				keys = std::move(_move.keys);
@@ -543,6 +891,34 @@ namespace vl
 			/// <param name="key">The key to add.</param>
 			/// <param name="value">The value to add.</param>
 			bool Add(KT&& key, VT&& value) { return AddInternal<KT&&, VT&&>(std::move(key), std::move(value)); }
+
+			/// <summary>
+			/// Add multiple keys with associated values.
+			/// Pairs are sorted only once, instead of inserting them one by one.
+			/// The result is the same as calling <see cref="Add"/> for each pair in order,
+			/// which means values of the same key keep their order.
+			/// </summary>
+			/// <returns>Returns true if all pairs are added.</returns>
+			/// <param name="items">Pairs of keys and values to add.</param>
+			bool AddRange(const IEnumerable<Pair<KT, VT>>& items) { return AddRangeInternal(items, false); }
+			/// <summary>
+			/// Add multiple keys with associated values.
+			/// Pairs are sorted only once, instead of inserting them one by one.
+			/// The result is the same as calling <see cref="Add"/> for each pair in order,
+			/// which means values of the same key keep their order.
+			/// </summary>
+			/// <returns>Returns true if all pairs are added.</returns>
+			/// <param name="items">Pairs of keys and values to add.</param>
+			bool AddRange(const IEnumerable<Pair<const KT&, const VT&>>& items) { return AddRangeInternal(items, false); }
+
+			/// <summary>Replace all keys and values. Each container of keys, value lists or values allocates its buffer exactly once.</summary>
+			/// <returns>Returns true if all pairs are added.</returns>
+			/// <param name="items">Pairs of keys and values. Values of the same key keep their order.</param>
+			bool BuildFrom(const IEnumerable<Pair<KT, VT>>& items) { return AddRangeInternal(items, true); }
+			/// <summary>Replace all keys and values. Each container of keys, value lists or values allocates its buffer exactly once.</summary>
+			/// <returns>Returns true if all pairs are added.</returns>
+			/// <param name="items">Pairs of keys and values. Values of the same key keep their order.</param>
+			bool BuildFrom(const IEnumerable<Pair<const KT&, const VT&>>& items) { return AddRangeInternal(items, true); }
 			
 			/// <summary>Remove a key with all associated values.</summary>
 			/// <returns>Returns true if the key and all associated values are removed.</returns>
@@ -555,7 +931,7 @@ namespace vl
 					keys.RemoveAt(index);
 					auto target=values[index];
 					values.RemoveAt(index);
-					delete target;
+					DeleteValueContainer(target);
 					return true;
 				}
 				else
@@ -583,7 +959,7 @@ namespace vl
 					{
 						keys.RemoveAt(index);
 						values.RemoveAt(index);
-						delete target;
+						DeleteValueContainer(target);
 					}
 					return true;
 				}
@@ -599,7 +975,7 @@ namespace vl
 			{
 				for(vint i=0;i<values.Count();i++)
 				{
-					delete values[i];
+					DeleteValueContainer(values[i]);
 				}
 				keys.Clear();
 				values.Clear();
@@ -615,6 +991,8 @@ GroupInnerJoin
 		/// <typeparam name="TKey">The type of keys in two groups.</typeparam>
 		/// <typeparam name="TValueFirst">The type of values in the first group.</typeparam>
 		/// <typeparam name="TValueSecond">The type of values in the second group.</typeparam>
+		/// <typeparam name="TAllocatorFirst">The type of the allocator in the first group.</typeparam>
+		/// <typeparam name="TAllocatorSecond">The type of the allocator in the second group.</typeparam>
 		/// <typeparam name="TDiscardFirst">The type of the first callback.</typeparam>
 		/// <typeparam name="TDiscardSecond">The type of the second callback.</typeparam>
 		/// <typeparam name="TAccept">The type of the third callback.</typeparam>
@@ -662,13 +1040,15 @@ GroupInnerJoin
 			typename TKey,
 			typename TValueFirst,
 			typename TValueSecond,
+			typename TAllocatorFirst,
+			typename TAllocatorSecond,
 			typename TDiscardFirst,		// TKey * [TValueFirst] -> void
 			typename TDiscardSecond,	// TKey * [TValueSecond] -> void
 			typename TAccept			// TKey * [TValueFirst] * [TValueSecond] -> void
 		>
 		void GroupInnerJoin(
-			const Group<TKey, TValueFirst>& first,
-			const Group<TKey, TValueSecond>& second,
+			const Group<TKey, TValueFirst, TAllocatorFirst>& first,
+			const Group<TKey, TValueSecond, TAllocatorSecond>& second,
 			const TDiscardFirst& discardFirst,
 			const TDiscardSecond& discardSecond,
 			const TAccept& accept
@@ -683,12 +1063,12 @@ GroupInnerJoin
 				if (firstIndex < firstCount)
 				{
 					auto firstKey = first.Keys()[firstIndex];
-					const List<TValueFirst>& firstValues = first.GetByIndex(firstIndex);
+					const auto& firstValues = first.GetByIndex(firstIndex);
 
 					if (secondIndex < secondCount)
 					{
 						auto secondKey = second.Keys()[secondIndex];
-						const List<TValueSecond>& secondValues = second.GetByIndex(secondIndex);
+						const auto& secondValues = second.GetByIndex(secondIndex);
 
 						if (firstKey < secondKey)
 						{
@@ -718,7 +1098,7 @@ GroupInnerJoin
 					if (secondIndex < secondCount)
 					{
 						auto secondKey = second.Keys()[secondIndex];
-						const List<TValueSecond>& secondValues = second.GetByIndex(secondIndex);
+						const auto& secondValues = second.GetByIndex(secondIndex);
 
 						discardSecond(secondKey, secondValues);
 						secondIndex++;
@@ -736,32 +1116,32 @@ Random Access
 ***********************************************************************/
 		namespace randomaccess_internal
 		{
-			template<typename KT, typename VT>
-			struct RandomAccessable<Dictionary<KT, VT>>
+			template<typename KT, typename VT, typename TAllocator>
+			struct RandomAccessable<Dictionary<KT, VT, TAllocator>>
 			{
 				static const bool							CanRead = true;
 				static const bool							CanResize = false;
 			};
 		
-			template<typename KT, typename VT>
-			struct RandomAccess<Dictionary<KT, VT>>
+			template<typename KT, typename VT, typename TAllocator>
+			struct RandomAccess<Dictionary<KT, VT, TAllocator>>
 			{
-				static vint GetCount(const Dictionary<KT, VT>& t)
+				static vint GetCount(const Dictionary<KT, VT, TAllocator>& t)
 				{
 					return t.Count();
 				}
 
-				static Pair<KT, VT> GetValue(const Dictionary<KT, VT>& t, vint index)
+				static Pair<KT, VT> GetValue(const Dictionary<KT, VT, TAllocator>& t, vint index)
 				{
 					return Pair<KT, VT>(t.Keys().Get(index), t.Values().Get(index));
 				}
 
-				static void AppendValue(Dictionary<KT, VT>& t, const Pair<KT, VT>& value)
+				static void AppendValue(Dictionary<KT, VT, TAllocator>& t, const Pair<KT, VT>& value)
 				{
 					t.Set(value.key, value.value);
 				}
 
-				static void AppendValue(Dictionary<KT, VT>& t, const Pair<const KT&, const VT&>& value)
+				static void AppendValue(Dictionary<KT, VT, TAllocator>& t, const Pair<const KT&, const VT&>& value)
 				{
 					t.Set(value.key, value.value);
 				}
@@ -770,4 +1150,8 @@ Random Access
 	}
 }
 
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
 #endif
\ No newline at end of file
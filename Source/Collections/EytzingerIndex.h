@@ -0,0 +1,182 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_EYTZINGERINDEX
+#define VCZH_COLLECTIONS_EYTZINGERINDEX
+
+#include <bit>
+#include "List.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		/// <summary>
+		/// EytzingerIndex: a read-only copy of a <see cref="SortedList`2"/> for fast lookups.
+		/// Elements are stored in the breadth first order of the implicit binary search tree (the Eytzinger layout),
+		/// so that the first levels of the tree stay in cache, and elements to compare in the next few steps are next to each other.
+		/// </summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for the buffer, see <see cref="DefaultAllocator"/>.</typeparam>
+		/// <remarks>
+		/// <p>
+		/// The index is a snapshot of the sorted list when it is created, it is not updated when the sorted list is changed.
+		/// Positions returned by the index are positions in the sorted list.
+		/// For example, an index created from <see cref="Dictionary`3.Keys"/> finds positions in <see cref="Dictionary`3.Values"/>.
+		/// </p>
+		/// <p>
+		/// For trivially copyable elements, the search prefetches the cache line containing elements several levels below.
+		/// </p>
+		/// </remarks>
+		template<typename T, typename TAllocator = DefaultAllocator>
+		class EytzingerIndex : public Object
+		{
+			using K = typename KeyType<T>::Type;
+		protected:
+			// descendants at this number of levels below a node are in the same cache line
+			static constexpr vint					PrefetchStride = sizeof(T) >= 64 ? 1 : 64 / sizeof(T);
+
+			VCZH_NO_UNIQUE_ADDRESS TAllocator		allocator;
+			// items[0] is not used, children of items[k] are items[2k] and items[2k + 1]
+			T*										items = nullptr;
+			vint*									positions = nullptr;
+			vint									count = 0;
+
+			void Build(const SortedList<T, TAllocator>& list, vint& next, vint k)
+			{
+				if (k > count) return;
+				Build(list, next, 2 * k);
+				new(&items[k]) T(list[next]);
+				positions[k] = next++;
+				Build(list, next, 2 * k + 1);
+			}
+
+			// returns the node of the first element that is not less than item, or 0 if it does not exist
+			vint LowerBoundNode(const K& item)const
+			{
+				vuint64_t k = 1;
+				while (k <= (vuint64_t)count)
+				{
+					if constexpr (search_internal::CanPrefetch<T>)
+					{
+						if (k * PrefetchStride <= (vuint64_t)count)
+						{
+							search_internal::Prefetch(items + k * PrefetchStride);
+						}
+					}
+					k = 2 * k + ((items[k] <=> item) < 0 ? 1 : 0);
+				}
+				// remove all right turns, and then the last left turn
+				return (vint)(k >> (std::countr_one(k) + 1));
+			}
+
+			void Release()
+			{
+				if (items)
+				{
+					memory_management::CallDtors(items + 1, count);
+				}
+				memory_management::DeallocateBuffer(allocator, items, count + 1);
+				memory_management::DeallocateBuffer(allocator, positions, count + 1);
+				items = nullptr;
+				positions = nullptr;
+				count = 0;
+			}
+		public:
+			/// <summary>Create an index by copying all elements in a sorted list.</summary>
+			/// <param name="list">The sorted list.</param>
+			/// <param name="_allocator">The allocator for the buffer.</param>
+			EytzingerIndex(const SortedList<T, TAllocator>& list, const TAllocator& _allocator = TAllocator())
+				: allocator(_allocator)
+				, count(list.Count())
+			{
+				if (count > 0)
+				{
+					items = memory_management::AllocateBuffer<T>(allocator, count + 1);
+					positions = memory_management::AllocateBuffer<vint>(allocator, count + 1);
+					vint next = 0;
+					Build(list, next, 1);
+				}
+			}
+
+			EytzingerIndex(const EytzingerIndex<T, TAllocator>&) = delete;
+			EytzingerIndex(EytzingerIndex<T, TAllocator>&& _move)
+				: allocator(_move.allocator)
+				, items(_move.items)
+				, positions(_move.positions)
+				, count(_move.count)
+			{
+				_move.items = nullptr;
+				_move.positions = nullptr;
+				_move.count = 0;
+			}
+
+			~EytzingerIndex()
+			{
+				Release();
+			}
+
+			EytzingerIndex<T, TAllocator>& operator=(const EytzingerIndex<T, TAllocator>&) = delete;
+			EytzingerIndex<T, TAllocator>& operator=(EytzingerIndex<T, TAllocator>&& _move)
+			{
+				if (this != &_move)
+				{
+					Release();
+					allocator = _move.allocator;
+					items = _move.items;
+					positions = _move.positions;
+					count = _move.count;
+					_move.items = nullptr;
+					_move.positions = nullptr;
+					_move.count = 0;
+				}
+				return *this;
+			}
+
+			/// <summary>Get the number of elements.</summary>
+			/// <returns>The number of elements.</returns>
+			vint Count()const
+			{
+				return count;
+			}
+
+			/// <summary>Test does the index contain a value or not.</summary>
+			/// <returns>Returns true if the index contains the specified value.</returns>
+			/// <param name="item">The value to test.</param>
+			bool Contains(const K& item)const
+			{
+				return IndexOf(item) != -1;
+			}
+
+			/// <summary>Get the position of a value in the sorted list.</summary>
+			/// <returns>Returns the position of the first element that equals to the specified value. Returns -1 if failed to find.</returns>
+			/// <param name="item">The value to find.</param>
+			vint IndexOf(const K& item)const
+			{
+				vint k = LowerBoundNode(item);
+				return k != 0 && (items[k] <=> item) == 0 ? positions[k] : -1;
+			}
+
+			/// <summary>Get the position of the first element that is not less than a value in the sorted list.</summary>
+			/// <returns>Returns the position. Returns <see cref="Count"/> if all elements are less than the specified value.</returns>
+			/// <param name="item">The value to compare.</param>
+			vint LowerBound(const K& item)const
+			{
+				vint k = LowerBoundNode(item);
+				return k == 0 ? count : positions[k];
+			}
+		};
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
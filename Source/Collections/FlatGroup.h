@@ -0,0 +1,334 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_FLATGROUP
+#define VCZH_COLLECTIONS_FLATGROUP
+
+#include "Dictionary.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		/// <summary>
+		/// FlatGroup: read only one to many map container.
+		/// Keys are sorted, values of all keys are stored in one buffer,
+		/// so that the whole container only uses three buffers regardless of the number of keys.
+		/// </summary>
+		/// <typeparam name="KT">Type of keys.</typeparam>
+		/// <typeparam name="VT">Type of values.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for keys, values and offsets, see <see cref="DefaultAllocator"/>.</typeparam>
+		/// <remarks>
+		/// Unlike <see cref="Group`3"/>, keys and values could not be added or removed one by one.
+		/// Use <see cref="BuildFrom"/> to replace all keys and values at once.
+		/// </remarks>
+		template<typename KT, typename VT, typename TAllocator = DefaultAllocator>
+		class FlatGroup : public EnumerableBase<Pair<const KT&, const VT&>>
+		{
+			using KK = typename KeyType<KT>::Type;
+			using VK = typename KeyType<VT>::Type;
+			using KVPair = Pair<const KT&, const VT&>;
+		public:
+			typedef SortedList<KT, TAllocator>		KeyContainer;
+			typedef ArraySpan<VT>					ValueContainer;
+		protected:
+			class Enumerator : public Object, public virtual IEnumerator<KVPair>
+			{
+			private:
+				const FlatGroup<KT, VT, TAllocator>*	container;
+				vint									keyIndex;
+				vint									valueIndex;
+				Nullable<KVPair>						current;
+
+				void UpdateCurrent()
+				{
+					if (valueIndex >= 0 && valueIndex < container->values.Count())
+					{
+						current = { container->keys[keyIndex], container->values[valueIndex] };
+					}
+				}
+			public:
+				POOLED_ALLOCATION(Enumerator)
+
+				Enumerator(const FlatGroup<KT, VT, TAllocator>* _container, vint _keyIndex = 0, vint _valueIndex = -1)
+				{
+					container = _container;
+					keyIndex = _keyIndex;
+					valueIndex = _valueIndex;
+					UpdateCurrent();
+				}
+
+				IEnumerator<KVPair>* Clone()const override
+				{
+					return new Enumerator(container, keyIndex, valueIndex);
+				}
+
+				const KVPair& Current()const override
+				{
+					return current.Value();
+				}
+
+				vint Index()const override
+				{
+					return valueIndex;
+				}
+
+				bool Next() override
+				{
+					if (valueIndex < container->values.Count())
+					{
+						valueIndex++;
+					}
+					while (keyIndex < container->keys.Count() && valueIndex >= container->offsets[keyIndex + 1])
+					{
+						keyIndex++;
+					}
+					UpdateCurrent();
+					return valueIndex < container->values.Count();
+				}
+
+				void Reset() override
+				{
+					keyIndex = 0;
+					valueIndex = -1;
+					UpdateCurrent();
+				}
+
+				bool Evaluated()const override
+				{
+					return true;
+				}
+			};
+
+			KeyContainer							keys;
+			Array<VT, TAllocator>					values;
+			Array<vint, TAllocator>					offsets;	// values of keys[i] are values[offsets[i]] to values[offsets[i + 1] - 1]
+
+			void AdoptSortedPairs(List<KT, TAllocator>& newKeys, List<VT, TAllocator>& newValues)
+			{
+				vint runs = 0;
+				for (vint i = 0; i < newKeys.Count(); i++)
+				{
+					if (i == 0 || (newKeys[i - 1] <=> newKeys[i]) != 0) runs++;
+				}
+
+				Array<vint, TAllocator> newOffsets(runs == 0 ? 0 : runs + 1, newKeys.GetAllocator());
+				vint newCount = 0;
+				for (vint i = 0; i < newKeys.Count(); i++)
+				{
+					if (i == 0 || (newKeys[newCount - 1] <=> newKeys[i]) != 0)
+					{
+						if (newCount != i)
+						{
+							newKeys[newCount] = std::move(newKeys[i]);
+						}
+						newOffsets[newCount++] = i;
+					}
+				}
+				if (runs > 0)
+				{
+					newOffsets[runs] = newValues.Count();
+				}
+				if (newCount < newKeys.Count())
+				{
+					newKeys.RemoveRange(newCount, newKeys.Count() - newCount);
+				}
+
+				keys = std::move(newKeys);
+				values = std::move(newValues);
+				offsets = std::move(newOffsets);
+			}
+
+			template<typename TPair>
+			bool BuildFromPairs(const IEnumerable<TPair>& items)
+			{
+				auto allocator = keys.GetAllocator();
+				List<KT, TAllocator> newKeys(allocator);
+				List<VT, TAllocator> newValues(allocator);
+				dictionary_internal::CollectSortedPairs(items, newKeys, newValues);
+				Clear();
+				AdoptSortedPairs(newKeys, newValues);
+				return true;
+			}
+		public:
+			/// <summary>Create an empty group.</summary>
+			FlatGroup() = default;
+			~FlatGroup() = default;
+
+			/// <summary>Create an empty group with an allocator.</summary>
+			/// <param name="allocator">The allocator for keys, values and offsets.</param>
+			explicit FlatGroup(const TAllocator& allocator)
+				: keys(allocator)
+				, values(0, allocator)
+				, offsets(0, allocator)
+			{
+			}
+
+			FlatGroup(const FlatGroup<KT, VT, TAllocator>&) = delete;
+			FlatGroup(FlatGroup<KT, VT, TAllocator>&& _move)
+				: keys(std::move(_move.keys))
+				, values(std::move(_move.values))
+				, offsets(std::move(_move.offsets))
+			{
+			}
+
+			FlatGroup<KT, VT, TAllocator>& operator=(const FlatGroup<KT, VT, TAllocator>&) = delete;
+			FlatGroup<KT, VT, TAllocator>& operator=(FlatGroup<KT, VT, TAllocator>&& _move)
+			{
+				keys = std::move(_move.keys);
+				values = std::move(_move.values);
+				offsets = std::move(_move.offsets);
+				return *this;
+			}
+
+			IEnumerator<KVPair>* CreateEnumerator()const
+			{
+				return new Enumerator(this);
+			}
+
+			/// <summary>Get all keys.</summary>
+			/// <returns>All keys.</returns>
+			const KeyContainer& Keys()const
+			{
+				return keys;
+			}
+
+			/// <summary>Get the number of keys.</summary>
+			/// <returns>The number of keys.</returns>
+			vint Count()const
+			{
+				return keys.Count();
+			}
+
+			/// <summary>Get the number of values of all keys.</summary>
+			/// <returns>The number of values.</returns>
+			vint ValueCount()const
+			{
+				return values.Count();
+			}
+
+			/// <summary>Get all values associated to a specified key.</summary>
+			/// <returns>A span of all values, which becomes invalid after the group is changed. It will crash if the key does not exist.</returns>
+			/// <param name="key">The key to find.</param>
+			ValueContainer Get(const KK& key)const
+			{
+				return GetByIndex(keys.IndexOf(key));
+			}
+
+			/// <summary>Get all values associated to a key at a specified position in <see cref="Keys"/>.</summary>
+			/// <returns>A span of all values, which becomes invalid after the group is changed. It will crash if the index is out of range.</returns>
+			/// <param name="index">The position of the key.</param>
+			ValueContainer GetByIndex(vint index)const
+			{
+				CHECK_ERROR(index >= 0 && index < keys.Count(), L"FlatGroup<KT, VT, TAllocator>::GetByIndex(vint)#Argument index not in range.");
+				vint first = offsets[index];
+				vint count = offsets[index + 1] - first;
+				return count == 0 ? ValueContainer() : ValueContainer(&values[first], count);
+			}
+
+			/// <summary>Get all values associated to a specified key.</summary>
+			/// <returns>A span of all values, which becomes invalid after the group is changed. It will crash if the key does not exist.</returns>
+			/// <param name="key">The key to find.</param>
+			ValueContainer operator[](const KK& key)const
+			{
+				return Get(key);
+			}
+
+			/// <summary>Test if a key exists in the group or not.</summary>
+			/// <returns>Returns true if the key exists.</returns>
+			/// <param name="key">The key to find.</param>
+			bool Contains(const KK& key)const
+			{
+				return keys.Contains(key);
+			}
+
+			/// <summary>Test if a key exists with an associated value in the group or not.</summary>
+			/// <returns>Returns true if the key exists with an associated value.</returns>
+			/// <param name="key">The key to find.</param>
+			/// <param name="value">The value to find.</param>
+			bool Contains(const KK& key, const VK& value)const
+			{
+				vint index = keys.IndexOf(key);
+				return index != -1 && GetByIndex(index).Contains(value);
+			}
+
+			/// <summary>
+			/// Replace all keys and values.
+			/// Pairs are sorted only once, values of the same key keep their order.
+			/// </summary>
+			/// <returns>Returns true if all pairs are added.</returns>
+			/// <param name="items">Pairs of keys and values.</param>
+			bool BuildFrom(const IEnumerable<Pair<KT, VT>>& items) { return BuildFromPairs(items); }
+			/// <summary>
+			/// Replace all keys and values.
+			/// Pairs are sorted only once, values of the same key keep their order.
+			/// </summary>
+			/// <returns>Returns true if all pairs are added.</returns>
+			/// <param name="items">Pairs of keys and values.</param>
+			bool BuildFrom(const IEnumerable<Pair<const KT&, const VT&>>& items) { return BuildFromPairs(items); }
+
+			/// <summary>Replace all keys and values by copying them from a group, no sorting is needed.</summary>
+			/// <typeparam name="TGroupAllocator">Type of the allocator in the group.</typeparam>
+			/// <returns>Returns true if all keys and values are copied.</returns>
+			/// <param name="group">The group to copy.</param>
+			template<typename TGroupAllocator>
+			bool BuildFrom(const Group<KT, VT, TGroupAllocator>& group)
+			{
+				Clear();
+				vint valueCount = 0;
+				for (vint i = 0; i < group.Count(); i++)
+				{
+					valueCount += group.GetByIndex(i).Count();
+				}
+
+				auto allocator = keys.GetAllocator();
+				List<KT, TAllocator> newKeys(allocator);
+				List<VT, TAllocator> newValues(allocator);
+				Array<vint, TAllocator> newOffsets(group.Count() == 0 ? 0 : group.Count() + 1, allocator);
+				newKeys.Reserve(group.Count());
+				newValues.Reserve(valueCount);
+				for (vint i = 0; i < group.Count(); i++)
+				{
+					newKeys.Add(group.Keys()[i]);
+					newOffsets[i] = newValues.Count();
+					const auto& groupValues = group.GetByIndex(i);
+					for (vint j = 0; j < groupValues.Count(); j++)
+					{
+						newValues.Add(groupValues[j]);
+					}
+				}
+				if (group.Count() > 0)
+				{
+					newOffsets[group.Count()] = valueCount;
+				}
+
+				keys = std::move(newKeys);
+				values = std::move(newValues);
+				offsets = std::move(newOffsets);
+				return true;
+			}
+
+			/// <summary>Remove everything.</summary>
+			/// <returns>Returns true if all keys and values are removed.</returns>
+			bool Clear()
+			{
+				keys.Clear();
+				values.Resize(0);
+				offsets.Resize(0);
+				return true;
+			}
+		};
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
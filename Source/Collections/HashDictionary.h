@@ -0,0 +1,402 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_HASHDICTIONARY
+#define VCZH_COLLECTIONS_HASHDICTIONARY
+
+#include "HashTable.h"
+#include "../Primitives/Nullable.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		/// <summary>
+		/// HashDictionary: one to one map container using a hash table.
+		/// Keys and values are stored in two lists in the order of adding, lookups are performed by an open addressing hash index.
+		/// </summary>
+		/// <typeparam name="KT">Type of keys.</typeparam>
+		/// <typeparam name="VT">Type of values.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for keys, values and the hash index, see <see cref="DefaultAllocator"/>.</typeparam>
+		/// <typeparam name="THasher">Type to compute hash codes of keys, see <see cref="Hasher`1"/>.</typeparam>
+		/// <remarks>
+		/// Unlike <see cref="Dictionary`3"/>, keys are not sorted.
+		/// Removing a key moves the last key and its value to the removed position.
+		/// </remarks>
+		template<typename KT, typename VT, typename TAllocator = DefaultAllocator, typename THasher = Hasher<typename KeyType<KT>::Type>>
+		class HashDictionary : public EnumerableBase<Pair<const KT&, const VT&>>
+		{
+			using KK = typename KeyType<KT>::Type;
+			using VK = typename KeyType<VT>::Type;
+			using KVPair = Pair<const KT&, const VT&>;
+		public:
+			typedef List<KT, TAllocator>			KeyContainer;
+			typedef List<VT, TAllocator>			ValueContainer;
+		protected:
+			class Enumerator : public Object, public virtual IEnumerator<KVPair>
+			{
+			private:
+				const HashDictionary<KT, VT, TAllocator, THasher>*	container;
+				vint												index;
+				Nullable<KVPair>									current;
+
+				void UpdateCurrent()
+				{
+					if (index < container->Count())
+					{
+						current = { container->Keys().Get(index),container->Values().Get(index) };
+					}
+				}
+			public:
+				POOLED_ALLOCATION(Enumerator)
+
+				Enumerator(const HashDictionary<KT, VT, TAllocator, THasher>* _container, vint _index = -1)
+				{
+					container = _container;
+					index = _index;
+				}
+
+				IEnumerator<KVPair>* Clone()const override
+				{
+					return new Enumerator(container, index);
+				}
+
+				const KVPair& Current()const override
+				{
+					return current.Value();
+				}
+
+				vint Index()const override
+				{
+					return index;
+				}
+
+				bool Next() override
+				{
+					index++;
+					UpdateCurrent();
+					return index >= 0 && index < container->Count();
+				}
+
+				void Reset() override
+				{
+					index = -1;
+					UpdateCurrent();
+				}
+
+				bool Evaluated()const override
+				{
+					return true;
+				}
+			};
+
+			KeyContainer							keys;
+			ValueContainer							values;
+			hash_internal::HashIndex<TAllocator>	index;
+
+			static vuint64_t GetHash(const KK& key)
+			{
+				return THasher::GetHashCode(key);
+			}
+
+			vint FindSlot(const KK& key, vuint64_t hash)const
+			{
+				return index.Find(hash, [&](vint position)
+				{
+					return KeyType<KT>::GetKeyValue(keys[position]) == key;
+				});
+			}
+
+			void RehashFor(vint expectedCount)
+			{
+				index.Rehash(keys.Count(), expectedCount, [&](vint position)
+				{
+					return GetHash(KeyType<KT>::GetKeyValue(keys[position]));
+				});
+			}
+
+			template<typename TKeyItem, typename TValueItem>
+			bool SetInternal(TKeyItem&& key, TValueItem&& value)
+			{
+				using TKeyAccept = memory_management::AcceptType<KT, TKeyItem&&>;
+				using TKeyForward = memory_management::ForwardType<KT, TKeyItem&&>;
+				TKeyAccept keyAccept = memory_management::RefOrConvert<KT>(std::forward<TKeyItem&&>(key));
+
+				vuint64_t hash = GetHash(KeyType<KT>::GetKeyValue(keyAccept));
+				vint slot = FindSlot(KeyType<KT>::GetKeyValue(keyAccept), hash);
+				if (slot == -1)
+				{
+					if (!index.CanInsert()) RehashFor(keys.Count() + 1);
+					keys.Add(std::forward<TKeyForward>(keyAccept));
+					values.Add(std::forward<TValueItem&&>(value));
+					index.Insert(hash, keys.Count() - 1);
+				}
+				else
+				{
+					values[index.GetPosition(slot)] = std::forward<TValueItem&&>(value);
+				}
+				return true;
+			}
+
+			template<typename TKeyItem, typename TValueItem>
+			bool AddInternal(TKeyItem&& key, TValueItem&& value)
+			{
+				using TKeyAccept = memory_management::AcceptType<KT, TKeyItem&&>;
+				using TKeyForward = memory_management::ForwardType<KT, TKeyItem&&>;
+				TKeyAccept keyAccept = memory_management::RefOrConvert<KT>(std::forward<TKeyItem&&>(key));
+
+				vuint64_t hash = GetHash(KeyType<KT>::GetKeyValue(keyAccept));
+				CHECK_ERROR(FindSlot(KeyType<KT>::GetKeyValue(keyAccept), hash) == -1, L"HashDictionary<KT, VT>::Add(const KT&, const VT&)#Key already exists.");
+				if (!index.CanInsert()) RehashFor(keys.Count() + 1);
+				keys.Add(std::forward<TKeyForward>(keyAccept));
+				values.Add(std::forward<TValueItem&&>(value));
+				index.Insert(hash, keys.Count() - 1);
+				return true;
+			}
+		public:
+			/// <summary>Create an empty dictionary.</summary>
+			HashDictionary() = default;
+			~HashDictionary() = default;
+
+			/// <summary>Create an empty dictionary with an allocator.</summary>
+			/// <param name="allocator">The allocator for keys, values and the hash index.</param>
+			explicit HashDictionary(const TAllocator& allocator)
+				: keys(allocator)
+				, values(allocator)
+				, index(allocator)
+			{
+			}
+
+			HashDictionary(const HashDictionary<KT, VT, TAllocator, THasher>&) = delete;
+			HashDictionary(HashDictionary<KT, VT, TAllocator, THasher>&& _move)
+				: keys(std::move(_move.keys))
+				, values(std::move(_move.values))
+				, index(std::move(_move.index))
+			{
+			}
+
+			HashDictionary<KT, VT, TAllocator, THasher>& operator=(const HashDictionary<KT, VT, TAllocator, THasher>&) = delete;
+			HashDictionary<KT, VT, TAllocator, THasher>& operator=(HashDictionary<KT, VT, TAllocator, THasher>&& _move)
+			{
+				keys = std::move(_move.keys);
+				values = std::move(_move.values);
+				index = std::move(_move.index);
+				return *this;
+			}
+
+			IEnumerator<KVPair>* CreateEnumerator()const
+			{
+				return new Enumerator(this);
+			}
+
+			/// <summary>Get all keys.</summary>
+			/// <returns>All keys in the order of adding.</returns>
+			/// <remarks>Use <see cref="IndexOf"/> or <see cref="Contains"/> of the dictionary to search for a key, instead of searching in the list.</remarks>
+			const KeyContainer& Keys()const
+			{
+				return keys;
+			}
+
+			/// <summary>Get all values.</summary>
+			/// <returns>All values, in the same order of <see cref="Keys"/>.</returns>
+			const ValueContainer& Values()const
+			{
+				return values;
+			}
+
+			/// <summary>Get the number of keys.</summary>
+			/// <returns>The number of keys. It is also the number of values.</returns>
+			vint Count()const
+			{
+				return keys.Count();
+			}
+
+			/// <summary>Prepare enough memory for keys.</summary>
+			/// <param name="count">The number of keys that could be stored without allocating more memory.</param>
+			void Reserve(vint count)
+			{
+				keys.Reserve(count);
+				values.Reserve(count);
+				RehashFor(count);
+			}
+
+			/// <summary>Get the position of a key in <see cref="Keys"/>.</summary>
+			/// <returns>The position of the key. Returns -1 if the key does not exist.</returns>
+			/// <param name="key">The key to find.</param>
+			vint IndexOf(const KK& key)const
+			{
+				vint slot = FindSlot(key, GetHash(key));
+				return slot == -1 ? -1 : index.GetPosition(slot);
+			}
+
+			/// <summary>Test if a key exists.</summary>
+			/// <returns>Returns true if the key exists.</returns>
+			/// <param name="key">The key to find.</param>
+			bool Contains(const KK& key)const
+			{
+				return IndexOf(key) != -1;
+			}
+
+			/// <summary>Get the reference to the value associated to a specified key.</summary>
+			/// <returns>The reference to the value. It will crash if the key does not exist.</returns>
+			/// <param name="key">The key to find.</param>
+			const VT& Get(const KK& key)const
+			{
+				vint position = IndexOf(key);
+				CHECK_ERROR(position != -1, L"HashDictionary<KT, VT>::Get(const KK&)#Key does not exist.");
+				return values.Get(position);
+			}
+
+			/// <summary>Get the reference to the value associated to a specified key.</summary>
+			/// <returns>The reference to the value. It will crash if the key does not exist.</returns>
+			/// <param name="key">The key to find.</param>
+			const VT& operator[](const KK& key)const
+			{
+				return Get(key);
+			}
+
+			/// <summary>Replace the value associated to a specified key.</summary>
+			/// <returns>Returns true if the value is replaced.</returns>
+			/// <param name="key">The key to find. If the key does not exist, it will be added to the dictionary.</param>
+			/// <param name="value">The associated value to replace.</param>
+			bool Set(const KT& key, const VT& value) { return SetInternal<const KT&, const VT&>(key, value); }
+
+			/// <summary>Replace the value associated to a specified key.</summary>
+			/// <returns>Returns true if the value is replaced.</returns>
+			/// <param name="key">The key to find. If the key does not exist, it will be added to the dictionary.</param>
+			/// <param name="value">The associated value to replace.</param>
+			bool Set(const KT& key, VT&& value) { return SetInternal<const KT&, VT&&>(key, std::move(value)); }
+
+			/// <summary>Replace the value associated to a specified key.</summary>
+			/// <returns>Returns true if the value is replaced.</returns>
+			/// <param name="key">The key to find. If the key does not exist, it will be added to the dictionary.</param>
+			/// <param name="value">The associated value to replace.</param>
+			bool Set(KT&& key, const VT& value) { return SetInternal<KT&&, const VT&>(std::move(key), value); }
+
+			/// <summary>Replace the value associated to a specified key.</summary>
+			/// <returns>Returns true if the value is replaced.</returns>
+			/// <param name="key">The key to find. If the key does not exist, it will be added to the dictionary.</param>
+			/// <param name="value">The associated value to replace.</param>
+			bool Set(KT&& key, VT&& value) { return SetInternal<KT, VT>(std::move(key), std::move(value)); }
+
+			/// <summary>Add a key with an associated value.</summary>
+			/// <returns>Returns true if the pair is added. If will crash if the key exists.</returns>
+			/// <param name="value">The pair of key and value.</param>
+			bool Add(const Pair<KT, VT>& value) { return AddInternal<const KT&, const VT&>(value.key, value.value); }
+
+			/// <summary>Add a key with an associated value.</summary>
+			/// <returns>Returns true if the pair is added. If will crash if the key exists.</returns>
+			/// <param name="value">The pair of key and value.</param>
+			bool Add(Pair<KT, VT>&& value) { return AddInternal<KT&&, VT&&>(std::move(value.key), std::move(value.value)); }
+
+			/// <summary>Add a key with an associated value.</summary>
+			/// <returns>Returns true if the pair is added. If will crash if the key exists.</returns>
+			/// <param name="key">The key to add.</param>
+			/// <param name="value">The value to add.</param>
+			bool Add(const KT& key, const VT& value) { return AddInternal<const KT&, const VT&>(key, value); }
+
+			/// <summary>Add a key with an associated value.</summary>
+			/// <returns>Returns true if the pair is added. If will crash if the key exists.</returns>
+			/// <param name="key">The key to add.</param>
+			/// <param name="value">The value to add.</param>
+			bool Add(const KT& key, VT&& value) { return AddInternal<const KT&, VT&&>(key, std::move(value)); }
+
+			/// <summary>Add a key with an associated value.</summary>
+			/// <returns>Returns true if the pair is added. If will crash if the key exists.</returns>
+			/// <param name="key">The key to add.</param>
+			/// <param name="value">The value to add.</param>
+			bool Add(KT&& key, const VT& value) { return AddInternal<KT&&, const VT&>(std::move(key), value); }
+
+			/// <summary>Add a key with an associated value.</summary>
+			/// <returns>Returns true if the pair is added. If will crash if the key exists.</returns>
+			/// <param name="key">The key to add.</param>
+			/// <param name="value">The value to add.</param>
+			bool Add(KT&& key, VT&& value) { return AddInternal<KT&&, VT&&>(std::move(key), std::move(value)); }
+
+			/// <summary>Remove a key with the associated value. The last key and its value are moved to the removed position.</summary>
+			/// <returns>Returns true if the key and the value is removed.</returns>
+			/// <param name="key">The key to find.</param>
+			bool Remove(const KK& key)
+			{
+				vint slot = FindSlot(key, GetHash(key));
+				if (slot == -1)
+				{
+					return false;
+				}
+
+				vint position = index.GetPosition(slot);
+				vint last = keys.Count() - 1;
+				index.Remove(slot);
+				if (position != last)
+				{
+					vint lastSlot = index.Find(GetHash(KeyType<KT>::GetKeyValue(keys[last])), [=](vint lastPosition) { return lastPosition == last; });
+					index.SetPosition(lastSlot, position);
+					keys[position] = std::move(keys[last]);
+					values[position] = std::move(values[last]);
+				}
+				keys.RemoveAt(last);
+				values.RemoveAt(last);
+				return true;
+			}
+
+			/// <summary>Remove all elements.</summary>
+			/// <returns>Returns true if all elements are removed.</returns>
+			bool Clear()
+			{
+				keys.Clear();
+				values.Clear();
+				index.Clear();
+				return true;
+			}
+		};
+
+/***********************************************************************
+Random Access
+***********************************************************************/
+		namespace randomaccess_internal
+		{
+			template<typename KT, typename VT, typename TAllocator, typename THasher>
+			struct RandomAccessable<HashDictionary<KT, VT, TAllocator, THasher>>
+			{
+				static const bool							CanRead = true;
+				static const bool							CanResize = false;
+			};
+
+			template<typename KT, typename VT, typename TAllocator, typename THasher>
+			struct RandomAccess<HashDictionary<KT, VT, TAllocator, THasher>>
+			{
+				static vint GetCount(const HashDictionary<KT, VT, TAllocator, THasher>& t)
+				{
+					return t.Count();
+				}
+
+				static Pair<KT, VT> GetValue(const HashDictionary<KT, VT, TAllocator, THasher>& t, vint index)
+				{
+					return Pair<KT, VT>(t.Keys().Get(index), t.Values().Get(index));
+				}
+
+				static void AppendValue(HashDictionary<KT, VT, TAllocator, THasher>& t, const Pair<KT, VT>& value)
+				{
+					t.Set(value.key, value.value);
+				}
+
+				static void AppendValue(HashDictionary<KT, VT, TAllocator, THasher>& t, const Pair<const KT&, const VT&>& value)
+				{
+					t.Set(value.key, value.value);
+				}
+			};
+		}
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
@@ -0,0 +1,285 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_HASHSET
+#define VCZH_COLLECTIONS_HASHSET
+
+#include "HashTable.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		/// <summary>
+		/// HashSet: linear container with dynamic size in runtime for unique values, using a hash table for searching.
+		/// All elements are contiguous in memory, in the order of adding if no element is removed by <see cref="Remove"/> or <see cref="RemoveAt"/>.
+		/// </summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for the buffer and the hash index, see <see cref="DefaultAllocator"/>.</typeparam>
+		/// <typeparam name="THasher">Type to compute hash codes of elements, see <see cref="Hasher`1"/>.</typeparam>
+		/// <remarks>
+		/// Hash codes are computed from representative values of elements, see <see cref="KeyType`1"/>.
+		/// <see cref="Remove"/> and <see cref="RemoveAt"/> move the last element to the position of the removed one, which takes constant time.
+		/// <see cref="RemoveAndKeepOrder"/> keeps the order of remaining elements, which takes linear time to update positions of all elements.
+		/// </remarks>
+		template<typename T, typename TAllocator = DefaultAllocator, typename THasher = Hasher<typename KeyType<T>::Type>>
+		class HashSet : public EnumerableBase<T>
+		{
+			using K = typename KeyType<T>::Type;
+		protected:
+			List<T, TAllocator>						items;
+			hash_internal::HashIndex<TAllocator>	index;
+
+			static vuint64_t GetHash(const K& item)
+			{
+				return THasher::GetHashCode(item);
+			}
+
+			vint FindSlot(const K& item, vuint64_t hash)const
+			{
+				return index.Find(hash, [&](vint position)
+				{
+					return KeyType<T>::GetKeyValue(items[position]) == item;
+				});
+			}
+
+			vint FindSlotAt(vint position)const
+			{
+				return index.Find(GetHash(KeyType<T>::GetKeyValue(items[position])), [=](vint slotPosition) { return slotPosition == position; });
+			}
+
+			void RehashFor(vint expectedCount)
+			{
+				index.Rehash(items.Count(), expectedCount, [&](vint position)
+				{
+					return GetHash(KeyType<T>::GetKeyValue(items[position]));
+				});
+			}
+
+			template<typename TItem>
+			vint AddInternal(TItem&& item)
+			{
+				vuint64_t hash = GetHash(KeyType<T>::GetKeyValue(item));
+				if (FindSlot(KeyType<T>::GetKeyValue(item), hash) != -1)
+				{
+					return -1;
+				}
+
+				if (!index.CanInsert()) RehashFor(items.Count() + 1);
+				vint position = items.Add(std::forward<TItem>(item));
+				index.Insert(hash, position);
+				return position;
+			}
+
+			void RemoveSlot(vint slot)
+			{
+				vint position = index.GetPosition(slot);
+				vint last = items.Count() - 1;
+				index.Remove(slot);
+				if (position != last)
+				{
+					index.SetPosition(FindSlotAt(last), position);
+					items[position] = std::move(items[last]);
+				}
+				items.RemoveAt(last);
+			}
+
+			void RemoveSlotAndKeepOrder(vint slot)
+			{
+				// elements after the removed one move forward
+				vint position = index.GetPosition(slot);
+				index.Remove(slot);
+				if (position != items.Count() - 1)
+				{
+					index.ShiftPositionsAfter(position);
+				}
+				items.RemoveAt(position);
+			}
+		public:
+			/// <summary>Create an empty set.</summary>
+			HashSet() = default;
+			~HashSet() = default;
+
+			/// <summary>Create an empty set with an allocator.</summary>
+			/// <param name="_allocator">The allocator for the buffer and the hash index.</param>
+			explicit HashSet(const TAllocator& _allocator)
+				: items(_allocator)
+				, index(_allocator)
+			{
+			}
+
+			HashSet(const HashSet<T, TAllocator, THasher>&) = delete;
+			HashSet(HashSet<T, TAllocator, THasher>&& _move)
+				: items(std::move(_move.items))
+				, index(std::move(_move.index))
+			{
+			}
+
+			HashSet<T, TAllocator, THasher>& operator=(const HashSet<T, TAllocator, THasher>&) = delete;
+			HashSet<T, TAllocator, THasher>& operator=(HashSet<T, TAllocator, THasher>&& _move)
+			{
+				items = std::move(_move.items);
+				index = std::move(_move.index);
+				return *this;
+			}
+
+			IEnumerator<T>* CreateEnumerator()const
+			{
+				return items.CreateEnumerator();
+			}
+
+			/// <summary>Get the number of elements.</summary>
+			/// <returns>The number of elements.</returns>
+			vint Count()const
+			{
+				return items.Count();
+			}
+
+			/// <summary>Get the reference to the specified element.</summary>
+			/// <returns>The reference to the specified element. It will crash when the index is out of range.</returns>
+			/// <param name="_index">The index of the element.</param>
+			const T& Get(vint _index)const
+			{
+				return items.Get(_index);
+			}
+
+			/// <summary>Get the reference to the specified element.</summary>
+			/// <returns>The reference to the specified element. It will crash when the index is out of range.</returns>
+			/// <param name="_index">The index of the element.</param>
+			const T& operator[](vint _index)const
+			{
+				return items.Get(_index);
+			}
+
+			/// <summary>Prepare enough memory for elements.</summary>
+			/// <param name="_capacity">The number of elements that could be stored without allocating more memory.</param>
+			void Reserve(vint _capacity)
+			{
+				items.Reserve(_capacity);
+				RehashFor(_capacity);
+			}
+
+			/// <summary>Test does the set contain a value or not.</summary>
+			/// <returns>Returns true if the set contains the specified value.</returns>
+			/// <param name="item">The value to test.</param>
+			bool Contains(const K& item)const
+			{
+				return IndexOf(item) != -1;
+			}
+
+			/// <summary>Get the position of a value in this set.</summary>
+			/// <returns>Returns the position of the element that equals to the specified value. Returns -1 if failed to find.</returns>
+			/// <param name="item">The value to find.</param>
+			vint IndexOf(const K& item)const
+			{
+				vint slot = FindSlot(item, GetHash(item));
+				return slot == -1 ? -1 : index.GetPosition(slot);
+			}
+
+			/// <summary>Add a value at the end of the set if it does not exist.</summary>
+			/// <returns>The index of the added item. Returns -1 if the value already exists, in which case nothing happens.</returns>
+			/// <param name="item">The value to add.</param>
+			vint Add(const T& item)
+			{
+				return AddInternal(item);
+			}
+
+			/// <summary>Add a value at the end of the set if it does not exist.</summary>
+			/// <returns>The index of the added item. Returns -1 if the value already exists, in which case nothing happens.</returns>
+			/// <param name="item">The value to add.</param>
+			vint Add(T&& item)
+			{
+				return AddInternal(std::move(item));
+			}
+
+			/// <summary>Remove an element from the set. The last element is moved to the position of the removed element.</summary>
+			/// <returns>Returns true if the element is removed.</returns>
+			/// <param name="item">The item to remove.</param>
+			bool Remove(const K& item)
+			{
+				vint slot = FindSlot(item, GetHash(item));
+				if (slot == -1)
+				{
+					return false;
+				}
+				RemoveSlot(slot);
+				return true;
+			}
+
+			/// <summary>Remove an element from the set. The order of remaining elements is kept, which takes linear time.</summary>
+			/// <returns>Returns true if the element is removed.</returns>
+			/// <param name="item">The item to remove.</param>
+			bool RemoveAndKeepOrder(const K& item)
+			{
+				vint slot = FindSlot(item, GetHash(item));
+				if (slot == -1)
+				{
+					return false;
+				}
+				RemoveSlotAndKeepOrder(slot);
+				return true;
+			}
+
+			/// <summary>Remove an element at a specified position. The last element is moved to the position of the removed element.</summary>
+			/// <returns>Returns true if the element is removed. It will crash when the index is out of range.</returns>
+			/// <param name="_index">The index of the element to remove.</param>
+			bool RemoveAt(vint _index)
+			{
+				CHECK_ERROR(_index >= 0 && _index < items.Count(), L"HashSet<T>::RemoveAt(vint)#Argument index not in range.");
+				RemoveSlot(FindSlotAt(_index));
+				return true;
+			}
+
+			/// <summary>Remove contiguous elements at a specified psition. The order of remaining elements is kept.</summary>
+			/// <returns>Returns true if elements are removed. It will crash when the index or the size is out of range.</returns>
+			/// <param name="_index">The index of the first element to remove.</param>
+			/// <param name="_count">The number of elements to remove.</param>
+			bool RemoveRange(vint _index, vint _count)
+			{
+				items.RemoveRange(_index, _count);
+				RehashFor(items.Count());
+				return true;
+			}
+
+			/// <summary>Remove all elements.</summary>
+			/// <returns>Returns true if all elements are removed.</returns>
+			bool Clear()
+			{
+				items.Clear();
+				index.Clear();
+				return true;
+			}
+		};
+
+		namespace randomaccess_internal
+		{
+			template<typename T, typename TAllocator, typename THasher>
+			struct RandomAccessable<HashSet<T, TAllocator, THasher>>
+			{
+				static const bool							CanRead = true;
+				static const bool							CanResize = false;
+			};
+		}
+
+/***********************************************************************
+Membership
+***********************************************************************/
+
+		/// <summary>A set for testing membership, which is a <see cref="HashSet`3"/> when hash codes could be computed for elements, otherwise a <see cref="SortedList`2"/>.</summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		template<typename T>
+		using MembershipSet = std::conditional_t<Hashable<typename KeyType<T>::Type>, HashSet<T>, SortedList<T>>;
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
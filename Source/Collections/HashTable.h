@@ -0,0 +1,337 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_HASHTABLE
+#define VCZH_COLLECTIONS_HASHTABLE
+
+#include <string.h>
+#include <bit>
+#include "List.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VCZH_HASHTABLE_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		namespace hash_internal
+		{
+
+/***********************************************************************
+Control Bytes
+***********************************************************************/
+
+			// a control byte is 0-127 for a full slot, which stores 7 bits of the hash code
+			using ControlByte = vint8_t;
+			constexpr ControlByte			Empty = -128;
+			constexpr ControlByte			Deleted = -2;
+			constexpr vint					GroupSize = 16;
+
+			// bit i is set if the control byte at group[i] equals to value
+			inline vuint32_t MatchByte(const ControlByte* group, ControlByte value)
+			{
+#ifdef VCZH_HASHTABLE_SSE2
+				__m128i controls = _mm_loadu_si128((const __m128i*)group);
+				return (vuint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8(value)));
+#else
+				vuint32_t mask = 0;
+				for (vint i = 0; i < GroupSize; i++)
+				{
+					mask |= (vuint32_t)(group[i] == value) << i;
+				}
+				return mask;
+#endif
+			}
+
+			inline vuint32_t MatchEmpty(const ControlByte* group)
+			{
+				return MatchByte(group, Empty);
+			}
+
+			// bit i is set if the control byte at group[i] is empty or deleted
+			inline vuint32_t MatchAvailable(const ControlByte* group)
+			{
+#ifdef VCZH_HASHTABLE_SSE2
+				__m128i controls = _mm_loadu_si128((const __m128i*)group);
+				return (vuint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), controls));
+#else
+				vuint32_t mask = 0;
+				for (vint i = 0; i < GroupSize; i++)
+				{
+					mask |= (vuint32_t)(group[i] < -1) << i;
+				}
+				return mask;
+#endif
+			}
+
+/***********************************************************************
+HashIndex
+***********************************************************************/
+
+			/// <summary>
+			/// An open addressing hash index in the SwissTable layout, which maps hash codes to positions of values stored somewhere else.
+			/// Slots are probed in groups of 16 control bytes, which are compared together.
+			/// </summary>
+			/// <typeparam name="TAllocator">The allocator for slots.</typeparam>
+			template<typename TAllocator>
+			class HashIndex
+			{
+			protected:
+				VCZH_NO_UNIQUE_ADDRESS TAllocator	allocator;
+				vint*								positions = nullptr;
+				ControlByte*						controls = nullptr;
+				vint								capacity = 0;
+				vint								usedSlots = 0;
+
+				static vint GetBufferSize(vint _capacity)
+				{
+					return (vint)sizeof(vint) * _capacity + _capacity + GroupSize;
+				}
+
+				static ControlByte H2(vuint64_t hash)
+				{
+					return (ControlByte)(hash & 0x7F);
+				}
+
+				static vint H1(vuint64_t hash)
+				{
+					return (vint)(hash >> 7);
+				}
+
+				// the first GroupSize control bytes are mirrored after the last one, so that a group could be loaded at any slot
+				void SetControl(vint slot, ControlByte control)
+				{
+					controls[slot] = control;
+					controls[((slot - GroupSize) & (capacity - 1)) + GroupSize] = control;
+				}
+
+				vint FindAvailable(vuint64_t hash)const
+				{
+					vint mask = capacity - 1;
+					vint position = H1(hash) & mask;
+					vint step = 0;
+					while (true)
+					{
+						vuint32_t match = MatchAvailable(controls + position);
+						if (match)
+						{
+							return (position + std::countr_zero(match)) & mask;
+						}
+						step += GroupSize;
+						position = (position + step) & mask;
+					}
+				}
+
+				void ReleaseBuffer()
+				{
+					if (positions)
+					{
+						allocator.Deallocate(positions, GetBufferSize(capacity));
+						positions = nullptr;
+						controls = nullptr;
+					}
+					capacity = 0;
+					usedSlots = 0;
+				}
+
+			public:
+				HashIndex() = default;
+
+				HashIndex(const TAllocator& _allocator)
+					: allocator(_allocator)
+				{
+				}
+
+				HashIndex(const HashIndex<TAllocator>&) = delete;
+				HashIndex(HashIndex<TAllocator>&& index)
+					: allocator(index.allocator)
+					, positions(index.positions)
+					, controls(index.controls)
+					, capacity(index.capacity)
+					, usedSlots(index.usedSlots)
+				{
+					index.positions = nullptr;
+					index.controls = nullptr;
+					index.capacity = 0;
+					index.usedSlots = 0;
+				}
+
+				~HashIndex()
+				{
+					ReleaseBuffer();
+				}
+
+				HashIndex<TAllocator>& operator=(const HashIndex<TAllocator>&) = delete;
+				HashIndex<TAllocator>& operator=(HashIndex<TAllocator>&& index)
+				{
+					if (this != &index)
+					{
+						ReleaseBuffer();
+						allocator = index.allocator;
+						positions = index.positions;
+						controls = index.controls;
+						capacity = index.capacity;
+						usedSlots = index.usedSlots;
+						index.positions = nullptr;
+						index.controls = nullptr;
+						index.capacity = 0;
+						index.usedSlots = 0;
+					}
+					return *this;
+				}
+
+				/// <summary>Get the number of slots.</summary>
+				/// <returns>The number of slots.</returns>
+				vint Capacity()const
+				{
+					return capacity;
+				}
+
+				/// <summary>Find a slot whose position satisfies a condition.</summary>
+				/// <typeparam name="TEqual">The type of the condition.</typeparam>
+				/// <returns>The slot, or -1 if it does not exist.</returns>
+				/// <param name="hash">The hash code of the value.</param>
+				/// <param name="equal">The condition, which accepts the position of a value that has a similar hash code.</param>
+				template<typename TEqual>
+				vint Find(vuint64_t hash, TEqual&& equal)const
+				{
+					if (capacity == 0) return -1;
+					ControlByte h2 = H2(hash);
+					vint mask = capacity - 1;
+					vint position = H1(hash) & mask;
+					vint step = 0;
+					while (true)
+					{
+						const ControlByte* group = controls + position;
+						vuint32_t match = MatchByte(group, h2);
+						while (match)
+						{
+							vint slot = (position + std::countr_zero(match)) & mask;
+							if (equal(positions[slot]))
+							{
+								return slot;
+							}
+							match &= match - 1;
+						}
+						if (MatchEmpty(group))
+						{
+							return -1;
+						}
+						step += GroupSize;
+						position = (position + step) & mask;
+					}
+				}
+
+				/// <summary>Get the position in a slot.</summary>
+				/// <returns>The position.</returns>
+				/// <param name="slot">The slot.</param>
+				vint GetPosition(vint slot)const
+				{
+					return positions[slot];
+				}
+
+				/// <summary>Change the position in a slot.</summary>
+				/// <param name="slot">The slot.</param>
+				/// <param name="position">The position.</param>
+				void SetPosition(vint slot, vint position)
+				{
+					positions[slot] = position;
+				}
+
+				/// <summary>Decrease all positions after a removed position by one, for values after it are moved forward.</summary>
+				/// <param name="position">The removed position.</param>
+				void ShiftPositionsAfter(vint position)
+				{
+					for (vint slot = 0; slot < capacity; slot++)
+					{
+						if (controls[slot] >= 0 && positions[slot] > position)
+						{
+							positions[slot]--;
+						}
+					}
+				}
+
+				/// <summary>Test if a slot could be added without calling <see cref="Rehash"/>.</summary>
+				/// <returns>Returns true if a slot could be added.</returns>
+				bool CanInsert()const
+				{
+					return usedSlots < capacity / 8 * 7;
+				}
+
+				/// <summary>Add a slot. <see cref="CanInsert"/> must be true.</summary>
+				/// <param name="hash">The hash code of the value.</param>
+				/// <param name="position">The position of the value.</param>
+				void Insert(vuint64_t hash, vint position)
+				{
+					vint slot = FindAvailable(hash);
+					if (controls[slot] == Empty)
+					{
+						usedSlots++;
+					}
+					SetControl(slot, H2(hash));
+					positions[slot] = position;
+				}
+
+				/// <summary>Remove a slot. The slot is marked deleted and it is reused after <see cref="Rehash"/>.</summary>
+				/// <param name="slot">The slot.</param>
+				void Remove(vint slot)
+				{
+					SetControl(slot, Deleted);
+				}
+
+				/// <summary>Rebuild slots for values at position 0 to count-1, with enough slots to add more values.</summary>
+				/// <typeparam name="THash">The type of the callback to get the hash code of a value.</typeparam>
+				/// <param name="count">The number of values.</param>
+				/// <param name="expectedCount">The number of values that could be stored without calling this function again.</param>
+				/// <param name="getHash">The callback to get the hash code of a value at a position.</param>
+				template<typename THash>
+				void Rehash(vint count, vint expectedCount, THash&& getHash)
+				{
+					if (expectedCount < count + 1) expectedCount = count + 1;
+					vint newCapacity = GroupSize;
+					while (newCapacity / 8 * 7 < expectedCount)
+					{
+						newCapacity *= 2;
+					}
+
+					if (newCapacity != capacity)
+					{
+						auto buffer = (vint*)allocator.Allocate(GetBufferSize(newCapacity));
+						ReleaseBuffer();
+						positions = buffer;
+						controls = (ControlByte*)(buffer + newCapacity);
+						capacity = newCapacity;
+					}
+
+					memset(controls, Empty, capacity + GroupSize);
+					usedSlots = 0;
+					for (vint i = 0; i < count; i++)
+					{
+						Insert(getHash(i), i);
+					}
+				}
+
+				/// <summary>Remove all slots and release the memory.</summary>
+				void Clear()
+				{
+					ReleaseBuffer();
+				}
+			};
+		}
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
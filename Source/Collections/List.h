@@ -7,8 +7,20 @@ Licensed under https://github.com/vczh-libraries/License
 #define VCZH_COLLECTIONS_LIST
 
 #include <string.h>
+#include <bit>
 #include "Interfaces.h"
 
+#if defined(__AVX2__)
+#define VCZH_LIST_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VCZH_LIST_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define VCZH_LIST_NEON
+#include <arm_neon.h>
+#endif
+
 #ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
 #undef new
 #endif
@@ -18,6 +30,76 @@ namespace vl
 	namespace collections
 	{
 
+/***********************************************************************
+Allocator
+***********************************************************************/
+
+		/// <summary>
+		/// The default allocator for containers, memory is allocated by malloc and released by free.
+		/// An allocator is a copyable object with two functions:
+		/// "void* Allocate(vint size)" to allocate a memory block,
+		/// and "void Deallocate(void* buffer, vint size)" to release a memory block with the size that is used to allocate it.
+		/// An allocator could optionally offer "void* Reallocate(void* buffer, vint oldSize, vint newSize)" to resize a non-null memory block, keeping its content.
+		/// An allocator could optionally offer "vint GetGrowingCapacity(vint capacity, vint count)" and "vint GetShrinkingCapacity(vint capacity, vint count)"
+		/// to decide the capacity of a list buffer when it needs to hold more elements, or when elements are removed.
+		/// Any copy of an allocator should be able to release memory allocated by another copy.
+		/// </summary>
+		/// <remarks>
+		/// <see cref="Array`2"/>, <see cref="List`2"/>, <see cref="SortedList`2"/>, <see cref="Dictionary`3"/> and <see cref="Group`3"/>
+		/// accept a custom allocator as the last type argument.
+		/// A custom allocator could redirect allocations to an arena or a pool,
+		/// in which case the arena or the pool must outlive all containers using it.
+		/// </remarks>
+		struct DefaultAllocator
+		{
+			void* Allocate(vint size)
+			{
+				return malloc(size);
+			}
+
+			void Deallocate(void* buffer, vint /*size*/)
+			{
+				free(buffer);
+			}
+
+			void* Reallocate(void* buffer, vint /*oldSize*/, vint newSize)
+			{
+				return realloc(buffer, newSize);
+			}
+		};
+
+		/// <summary>
+		/// An allocator that grows list buffers by a specified factor.
+		/// When elements are removed, the buffer shrinks once it is larger than twice growing from the number of remaining elements.
+		/// </summary>
+		/// <typeparam name="Numerator">The numerator of the growth factor.</typeparam>
+		/// <typeparam name="Denominator">The denominator of the growth factor.</typeparam>
+		/// <typeparam name="TAllocator">The allocator to allocate memory.</typeparam>
+		template<vint Numerator, vint Denominator, typename TAllocator = DefaultAllocator>
+		struct GrowthFactorAllocator : TAllocator
+		{
+			static_assert(Denominator > 0 && Numerator > Denominator, "vl::collections::GrowthFactorAllocator<Numerator, Denominator, TAllocator> requires a growth factor larger than 1.");
+
+			using TAllocator::TAllocator;
+
+			GrowthFactorAllocator() = default;
+			GrowthFactorAllocator(const TAllocator& allocator)
+				: TAllocator(allocator)
+			{
+			}
+
+			vint GetGrowingCapacity(vint /*capacity*/, vint count)
+			{
+				return count * Numerator / Denominator + 1;
+			}
+
+			vint GetShrinkingCapacity(vint capacity, vint count)
+			{
+				vint newCapacity = GetGrowingCapacity(capacity, count);
+				return GetGrowingCapacity(capacity, newCapacity) < capacity ? newCapacity : capacity;
+			}
+		};
+
 /***********************************************************************
 Memory Management
 ***********************************************************************/
@@ -107,21 +189,100 @@ Memory Management
 			}
 
 			template<typename T>
-			T* AllocateBuffer(vint size)
+			void RelocateItems(T* items, T* source, vint count)
+			{
+				if constexpr (TriviallyRelocatable<T>::Value)
+				{
+					if (count > 0)
+					{
+						memcpy((void*)items, (void*)source, sizeof(T) * count);
+					}
+				}
+				else
+				{
+					CallMoveCtors(items, source, count);
+					CallDtors(source, count);
+				}
+			}
+
+			template<typename TAllocator>
+			concept ReallocatableAllocator = requires(TAllocator& allocator, void* buffer, vint size)
+			{
+				allocator.Reallocate(buffer, size, size);
+			};
+
+			template<typename TAllocator>
+			vint GetGrowingCapacity(TAllocator& allocator, vint capacity, vint count)
+			{
+				if constexpr (requires{ allocator.GetGrowingCapacity(capacity, count); })
+				{
+					vint newCapacity = allocator.GetGrowingCapacity(capacity, count);
+					return newCapacity < count ? count : newCapacity;
+				}
+				else
+				{
+					return count * 5 / 4 + 1;
+				}
+			}
+
+			template<typename TAllocator>
+			vint GetShrinkingCapacity(TAllocator& allocator, vint capacity, vint count)
+			{
+				if constexpr (requires{ allocator.GetShrinkingCapacity(capacity, count); })
+				{
+					vint newCapacity = allocator.GetShrinkingCapacity(capacity, count);
+					return newCapacity < count ? count : newCapacity;
+				}
+				else
+				{
+					if (count <= capacity / 2 && count <= 8)
+					{
+						vint newCapacity = capacity * 5 / 8;
+						if (count < newCapacity)
+						{
+							return newCapacity;
+						}
+					}
+					return capacity;
+				}
+			}
+
+			template<typename T, typename TAllocator>
+			T* AllocateBuffer(TAllocator& allocator, vint size)
 			{
 				if (size <= 0) return nullptr;
-				return (T*)malloc(sizeof(T) * size);
+				return (T*)allocator.Allocate(sizeof(T) * size);
 			}
 
-			template<typename T>
-			void DeallocateBuffer(T* buffer)
+			template<typename T, typename TAllocator>
+			void DeallocateBuffer(TAllocator& allocator, T* buffer, vint size)
 			{
 				if (buffer == nullptr) return;
-				free(buffer);
+				allocator.Deallocate(buffer, sizeof(T) * size);
 			}
 
-			template<typename T>
-			void ReleaseUnnecessaryBuffer(T*& items, vint& capacity, vint oldCount, vint newCount)
+			template<typename T, typename TAllocator>
+			T* ReallocateBuffer(TAllocator& allocator, T* items, vint capacity, vint newCapacity, vint count)
+			{
+				// the first count items are relocated to the new buffer, items after that must have been destructed
+				if (capacity == newCapacity) return items;
+
+				if constexpr (TriviallyRelocatable<T>::Value && ReallocatableAllocator<TAllocator>)
+				{
+					if (items && newCapacity > 0)
+					{
+						return (T*)allocator.Reallocate(items, sizeof(T) * capacity, sizeof(T) * newCapacity);
+					}
+				}
+
+				T* newBuffer = AllocateBuffer<T>(allocator, newCapacity);
+				RelocateItems(newBuffer, items, count);
+				DeallocateBuffer(allocator, items, capacity);
+				return newBuffer;
+			}
+
+			template<typename T, typename TAllocator>
+			void ReleaseUnnecessaryBuffer(TAllocator& allocator, T*& items, vint& capacity, vint oldCount, vint newCount)
 			{
 				if (!items) return;
 
@@ -130,39 +291,43 @@ Memory Management
 					CallDtors(&items[newCount], oldCount - newCount);
 				}
 
-				if (newCount <= capacity / 2 && newCount <= 8)
+				vint newCapacity = GetShrinkingCapacity(allocator, capacity, newCount);
+				if (newCapacity < capacity)
 				{
-					vint newCapacity = capacity * 5 / 8;
-					if (newCount < newCapacity)
-					{
-						T* newBuffer = AllocateBuffer<T>(newCapacity);
-						CallMoveCtors(newBuffer, items, newCount);
-						CallDtors(items, newCount);
-						DeallocateBuffer(items);
-						capacity = newCapacity;
-						items = newBuffer;
-					}
+					items = ReallocateBuffer(allocator, items, capacity, newCapacity, newCount);
+					capacity = newCapacity;
 				}
 			}
 
-			template<typename T>
-			void InsertUninitializedItems(T*& items, vint& capacity, vint& count, vint index, vint insertCount)
+			template<typename T, typename TAllocator>
+			void InsertUninitializedItems(TAllocator& allocator, T*& items, vint& capacity, vint& count, vint index, vint insertCount)
 			{
 				vint newCount = count + insertCount;
 				if (newCount > capacity)
 				{
-					vint newCapacity = newCount < capacity ? capacity : (newCount * 5 / 4 + 1);
-					T* newBuffer = AllocateBuffer<T>(newCapacity);
-					CallMoveCtors(newBuffer, items, index);
-					CallMoveCtors(&newBuffer[index + insertCount], &items[index], count - index);
-					CallDtors(items, count);
-					DeallocateBuffer(items);
+					vint newCapacity = GetGrowingCapacity(allocator, capacity, newCount);
+					if constexpr (TriviallyRelocatable<T>::Value)
+					{
+						items = ReallocateBuffer(allocator, items, capacity, newCapacity, count);
+						memmove((void*)&items[index + insertCount], (void*)&items[index], sizeof(T) * (count - index));
+					}
+					else
+					{
+						T* newBuffer = AllocateBuffer<T>(allocator, newCapacity);
+						RelocateItems(newBuffer, items, index);
+						RelocateItems(&newBuffer[index + insertCount], &items[index], count - index);
+						DeallocateBuffer(allocator, items, capacity);
+						items = newBuffer;
+					}
 					capacity = newCapacity;
-					items = newBuffer;
 				}
 				else if (index < count)
 				{
-					if (insertCount >= (count - index))
+					if constexpr (TriviallyRelocatable<T>::Value)
+					{
+						memmove((void*)&items[index + insertCount], (void*)&items[index], sizeof(T) * (count - index));
+					}
+					else if (insertCount >= (count - index))
 					{
 						CallMoveCtors(&items[index + insertCount], &items[index], count - index);
 						CallDtors(&items[index], count - index);
@@ -207,6 +372,126 @@ Memory Management
 			}
 		}
 
+/***********************************************************************
+Search
+***********************************************************************/
+
+		namespace search_internal
+		{
+			// hint the processor to load the cache line containing the address, it never faults
+			inline void Prefetch(const void* address)
+			{
+#if defined VCZH_GCC
+				__builtin_prefetch(address);
+#elif defined VCZH_LIST_AVX2 || defined VCZH_LIST_SSE2
+				_mm_prefetch((const char*)address, _MM_HINT_T0);
+#endif
+			}
+
+			// prefetching only pays off for elements that are compared without following pointers
+			template<typename T>
+			constexpr bool CanPrefetch = std::is_trivially_copyable_v<T>;
+
+			// scalars whose == compares all bits, so that a vector register of them could be compared at once
+			template<typename T>
+			constexpr bool CanVectorize =
+				(std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>) &&
+				(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+			template<typename T>
+			vint VectorizedIndexOf(const T* buffer, vint count, T item)
+			{
+				constexpr vint Size = sizeof(T);
+				vuint64_t bits = 0;
+				memcpy(&bits, &item, Size);
+				vint i = 0;
+
+#if defined VCZH_LIST_AVX2
+				__m256i pattern;
+				if constexpr (Size == 1) pattern = _mm256_set1_epi8((char)bits);
+				else if constexpr (Size == 2) pattern = _mm256_set1_epi16((short)bits);
+				else if constexpr (Size == 4) pattern = _mm256_set1_epi32((int)bits);
+				else pattern = _mm256_set1_epi64x((long long)bits);
+
+				for (; i + 32 / Size <= count; i += 32 / Size)
+				{
+					__m256i values = _mm256_loadu_si256((const __m256i*)(buffer + i));
+					__m256i equal;
+					if constexpr (Size == 1) equal = _mm256_cmpeq_epi8(values, pattern);
+					else if constexpr (Size == 2) equal = _mm256_cmpeq_epi16(values, pattern);
+					else if constexpr (Size == 4) equal = _mm256_cmpeq_epi32(values, pattern);
+					else equal = _mm256_cmpeq_epi64(values, pattern);
+
+					// each byte of an equal element sets a bit
+					vuint32_t mask = (vuint32_t)_mm256_movemask_epi8(equal);
+					if (mask != 0) return i + std::countr_zero(mask) / Size;
+				}
+#elif defined VCZH_LIST_SSE2
+				__m128i pattern;
+				if constexpr (Size == 1) pattern = _mm_set1_epi8((char)bits);
+				else if constexpr (Size == 2) pattern = _mm_set1_epi16((short)bits);
+				else if constexpr (Size == 4) pattern = _mm_set1_epi32((int)bits);
+				else pattern = _mm_set_epi32((int)(bits >> 32), (int)bits, (int)(bits >> 32), (int)bits);
+
+				for (; i + 16 / Size <= count; i += 16 / Size)
+				{
+					__m128i values = _mm_loadu_si128((const __m128i*)(buffer + i));
+					__m128i equal;
+					if constexpr (Size == 1) equal = _mm_cmpeq_epi8(values, pattern);
+					else if constexpr (Size == 2) equal = _mm_cmpeq_epi16(values, pattern);
+					else if constexpr (Size == 4) equal = _mm_cmpeq_epi32(values, pattern);
+					else
+					{
+						// SSE2 has no 64 bits comparison, both halves of an element must be equal
+						__m128i halves = _mm_cmpeq_epi32(values, pattern);
+						equal = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+					}
+
+					// each byte of an equal element sets a bit
+					vuint32_t mask = (vuint32_t)_mm_movemask_epi8(equal);
+					if (mask != 0) return i + std::countr_zero(mask) / Size;
+				}
+#elif defined VCZH_LIST_NEON
+				for (; i + 16 / Size <= count; i += 16 / Size)
+				{
+					uint8x16_t equal;
+					if constexpr (Size == 1) equal = vceqq_u8(vld1q_u8((const uint8_t*)(buffer + i)), vdupq_n_u8((uint8_t)bits));
+					else if constexpr (Size == 2) equal = vreinterpretq_u8_u16(vceqq_u16(vld1q_u16((const uint16_t*)(buffer + i)), vdupq_n_u16((uint16_t)bits)));
+					else if constexpr (Size == 4) equal = vreinterpretq_u8_u32(vceqq_u32(vld1q_u32((const uint32_t*)(buffer + i)), vdupq_n_u32((uint32_t)bits)));
+					else equal = vreinterpretq_u8_u64(vceqq_u64(vld1q_u64((const uint64_t*)(buffer + i)), vdupq_n_u64((uint64_t)bits)));
+
+					// each byte of an equal element sets 4 bits
+					vuint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(equal), 4)), 0);
+					if (mask != 0) return i + std::countr_zero(mask) / 4 / Size;
+				}
+#endif
+
+				for (; i < count; i++)
+				{
+					if (buffer[i] == item) return i;
+				}
+				return -1;
+			}
+
+			// find the first element that equals to item
+			template<typename T, typename K>
+			vint IndexOf(const T* buffer, vint count, const K& item)
+			{
+				if constexpr (std::is_same_v<T, K> && CanVectorize<T>)
+				{
+					return VectorizedIndexOf<T>(buffer, count, item);
+				}
+				else
+				{
+					for (vint i = 0; i < count; i++)
+					{
+						if (buffer[i] == item) return i;
+					}
+					return -1;
+				}
+			}
+		}
+
 /***********************************************************************
 ArrayBase
 ***********************************************************************/
@@ -224,6 +509,8 @@ ArrayBase
 				vint							index;
 
 			public:
+				POOLED_ALLOCATION(Enumerator)
+
 				Enumerator(const ArrayBase<T>* _container, vint _index = -1)
 				{
 					container = _container;
@@ -299,27 +586,103 @@ ArrayBase
 			}
 		};
 
+/***********************************************************************
+ArraySpan
+***********************************************************************/
+
+		/// <summary>ArraySpan: read only view of contiguous elements owned by another container.</summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <remarks>A span becomes invalid after the owner container is changed or destroyed.</remarks>
+		template<typename T>
+		class ArraySpan : public ArrayBase<T>
+		{
+			using K = typename KeyType<T>::Type;
+		public:
+			/// <summary>Create an empty span.</summary>
+			ArraySpan() = default;
+
+			/// <summary>Create a span.</summary>
+			/// <param name="_buffer">Pointer to the first element.</param>
+			/// <param name="_count">The number of elements.</param>
+			ArraySpan(const T* _buffer, vint _count)
+			{
+				CHECK_ERROR(_count >= 0, L"ArraySpan<T>::ArraySpan(const T*, vint)#Count should not be negative.");
+				this->buffer = const_cast<T*>(_buffer);
+				this->count = _count;
+			}
+
+			ArraySpan(const ArraySpan<T>& span)
+			{
+				this->buffer = span.buffer;
+				this->count = span.count;
+			}
+
+			ArraySpan<T>& operator=(const ArraySpan<T>& span)
+			{
+				this->buffer = span.buffer;
+				this->count = span.count;
+				return *this;
+			}
+
+			/// <summary>Test does the span contain a value or not.</summary>
+			/// <returns>Returns true if the span contains the specified value.</returns>
+			/// <param name="item">The value to test.</param>
+			bool Contains(const K& item)const
+			{
+				return IndexOf(item) != -1;
+			}
+
+			/// <summary>Get the position of a value in this span.</summary>
+			/// <returns>Returns the position of first element that equals to the specified value. Returns -1 if failed to find.</returns>
+			/// <param name="item">The value to find.</param>
+			vint IndexOf(const K& item)const
+			{
+				return search_internal::IndexOf<T, K>(this->buffer, this->count, item);
+			}
+		};
+
 /***********************************************************************
 Array
 ***********************************************************************/
 
+		template<typename T, typename TAllocator>
+		class ListBase;
+
 		/// <summary>Array: linear container with fixed size in runtime. All elements are contiguous in memory.</summary>
 		/// <typeparam name="T">Type of elements.</typeparam>
-		template<typename T>
+		/// <typeparam name="TAllocator">Type of the allocator for the buffer, see <see cref="DefaultAllocator"/>.</typeparam>
+		template<typename T, typename TAllocator = DefaultAllocator>
 		class Array : public ArrayBase<T>
 		{
+			template<typename, typename>
+			friend class ListBase;
+
 			using K = typename KeyType<T>::Type;
+		protected:
+			VCZH_NO_UNIQUE_ADDRESS TAllocator		allocator;
+
+			void TakeOver(ListBase<T, TAllocator>& _move)
+			{
+				this->buffer = memory_management::ReallocateBuffer(allocator, _move.buffer, _move.capacity, _move.count, _move.count);
+				this->count = _move.count;
+				_move.buffer = nullptr;
+				_move.count = 0;
+				_move.capacity = 0;
+			}
+
 		public:
 			/// <summary>Create an array.</summary>
 			/// <param name="size">The size of the array.</param>
+			/// <param name="_allocator">The allocator for the buffer.</param>
 			/// <remarks>
 			/// The default value is zero. <see cref="Resize"/> can be called to determine the size later.
 			/// It will crash when the size is a negative number.
 			/// </remarks>
-			Array(vint size = 0)
+			Array(vint size = 0, const TAllocator& _allocator = TAllocator())
+				: allocator(_allocator)
 			{
 				CHECK_ERROR(size >= 0, L"Array<T>::Array(vint)#Size should not be negative.");
-				this->buffer = memory_management::AllocateBuffer<T>(size);
+				this->buffer = memory_management::AllocateBuffer<T>(allocator, size);
 				memory_management::CallDefaultCtors(this->buffer, size);
 				this->count = size;
 			}
@@ -327,11 +690,13 @@ Array
 			/// <summary>Create an array with elements provided.</summary>
 			/// <param name="_buffer">Pointer to values to copy.</param>
 			/// <param name="size">The number of values to copy.</param>
+			/// <param name="_allocator">The allocator for the buffer.</param>
 			/// <remarks>It will crash when the size is a negative number.</remarks>
-			Array(const T* _buffer, vint size)
+			Array(const T* _buffer, vint size, const TAllocator& _allocator = TAllocator())
+				: allocator(_allocator)
 			{
 				CHECK_ERROR(size >= 0, L"Array<T>::Array(const T*, vint)#Size should not be negative.");
-				this->buffer = memory_management::AllocateBuffer<T>(size);
+				this->buffer = memory_management::AllocateBuffer<T>(allocator, size);
 				memory_management::CallCopyCtors(this->buffer, _buffer, size);
 				this->count = size;
 			}
@@ -341,12 +706,13 @@ Array
 				if (this->buffer)
 				{
 					memory_management::CallDtors(this->buffer, this->count);
-					memory_management::DeallocateBuffer(this->buffer);
+					memory_management::DeallocateBuffer(allocator, this->buffer, this->count);
 				}
 			}
 
-			Array(const Array<T>&) = delete;
-			Array(Array<T>&& _move)
+			Array(const Array<T, TAllocator>&) = delete;
+			Array(Array<T, TAllocator>&& _move)
+				: allocator(_move.allocator)
 			{
 				this->buffer = _move.buffer;
 				this->count = _move.count;
@@ -354,14 +720,15 @@ Array
 				_move.count = 0;
 			}
 
-			Array<T>& operator=(const Array<T>&) = delete;
-			Array<T>& operator=(Array<T>&& _move)
+			Array<T, TAllocator>& operator=(const Array<T, TAllocator>&) = delete;
+			Array<T, TAllocator>& operator=(Array<T, TAllocator>&& _move)
 			{
 				if (this->buffer)
 				{
 					memory_management::CallDtors(this->buffer, this->count);
-					memory_management::DeallocateBuffer(this->buffer);
+					memory_management::DeallocateBuffer(allocator, this->buffer, this->count);
 				}
+				allocator = _move.allocator;
 				this->buffer = _move.buffer;
 				this->count = _move.count;
 				_move.buffer = nullptr;
@@ -369,6 +736,38 @@ Array
 				return *this;
 			}
 
+			/// <summary>Create an array by taking over the buffer of a list, no element is copied.</summary>
+			/// <param name="_move">The list to take over. It becomes empty after the array is created.</param>
+			/// <remarks>The buffer is shrinked to the number of elements if there is any unused capacity.</remarks>
+			Array(ListBase<T, TAllocator>&& _move)
+				: allocator(_move.allocator)
+			{
+				TakeOver(_move);
+			}
+
+			/// <summary>Replace all elements by taking over the buffer of a list, no element is copied.</summary>
+			/// <returns>The array itself.</returns>
+			/// <param name="_move">The list to take over. It becomes empty after the array is changed.</param>
+			/// <remarks>The buffer is shrinked to the number of elements if there is any unused capacity.</remarks>
+			Array<T, TAllocator>& operator=(ListBase<T, TAllocator>&& _move)
+			{
+				if (this->buffer)
+				{
+					memory_management::CallDtors(this->buffer, this->count);
+					memory_management::DeallocateBuffer(allocator, this->buffer, this->count);
+				}
+				allocator = _move.allocator;
+				TakeOver(_move);
+				return *this;
+			}
+
+			/// <summary>Get the allocator of this array.</summary>
+			/// <returns>A copy of the allocator.</returns>
+			TAllocator GetAllocator()const
+			{
+				return allocator;
+			}
+
 			/// <summary>Test does the array contain a value or not.</summary>
 			/// <returns>Returns true if the array contains the specified value.</returns>
 			/// <param name="item">The value to test.</param>
@@ -382,14 +781,7 @@ Array
 			/// <param name="item">The value to find.</param>
 			vint IndexOf(const K& item)const
 			{
-				for (vint i = 0; i < this->count; i++)
-				{
-					if (this->buffer[i] == item)
-					{
-						return i;
-					}
-				}
-				return -1;
+				return search_internal::IndexOf<T, K>(this->buffer, this->count, item);
 			}
 
 			/// <summary>Replace an element in the specified position.</summary>
@@ -431,20 +823,16 @@ Array
 			void Resize(vint size)
 			{
 				CHECK_ERROR(size >= 0, L"Array<T>::Resize(vint)#Size should not be negative.");
-				T* newBuffer = memory_management::AllocateBuffer<T>(size);
 				if (size < this->count)
 				{
-					memory_management::CallMoveCtors(newBuffer, this->buffer, size);
+					memory_management::CallDtors(&this->buffer[size], this->count - size);
+					this->buffer = memory_management::ReallocateBuffer(allocator, this->buffer, this->count, size, size);
 				}
 				else
 				{
-					memory_management::CallMoveCtors(newBuffer, this->buffer, this->count);
-					memory_management::CallDefaultCtors(&newBuffer[this->count], size - this->count);
+					this->buffer = memory_management::ReallocateBuffer(allocator, this->buffer, this->count, size, this->count);
+					memory_management::CallDefaultCtors(&this->buffer[this->count], size - this->count);
 				}
-
-				memory_management::CallDtors(this->buffer, this->count);
-				memory_management::DeallocateBuffer(this->buffer);
-				this->buffer = newBuffer;
 				this->count = size;
 			}
 		};
@@ -455,26 +843,46 @@ ListBase
 
 		/// <summary>Base type for all list containers.</summary>
 		/// <typeparam name="T">Type of elements.</typeparam>
-		template<typename T>
+		/// <typeparam name="TAllocator">Type of the allocator for the buffer, see <see cref="DefaultAllocator"/>.</typeparam>
+		template<typename T, typename TAllocator = DefaultAllocator>
 		class ListBase abstract : public ArrayBase<T>
 		{
+			template<typename, typename>
+			friend class Array;
+
 			using K = typename KeyType<T>::Type;
 		protected:
-			vint					capacity = 0;
+			vint									capacity = 0;
+			VCZH_NO_UNIQUE_ADDRESS TAllocator		allocator;
+
+			void TakeOver(Array<T, TAllocator>& _move)
+			{
+				this->buffer = _move.buffer;
+				this->count = _move.count;
+				this->capacity = _move.count;
+				_move.buffer = nullptr;
+				_move.count = 0;
+			}
 
 		public:
 			ListBase() = default;
+			ListBase(const TAllocator& _allocator)
+				: allocator(_allocator)
+			{
+			}
+
 			~ListBase()
 			{
 				if (this->buffer)
 				{
 					memory_management::CallDtors(this->buffer, this->count);
-					memory_management::DeallocateBuffer(this->buffer);
+					memory_management::DeallocateBuffer(allocator, this->buffer, this->capacity);
 				}
 			}
 
-			ListBase(const ListBase<T>&) = delete;
-			ListBase(ListBase<T>&& _move)
+			ListBase(const ListBase<T, TAllocator>&) = delete;
+			ListBase(ListBase<T, TAllocator>&& _move)
+				: allocator(_move.allocator)
 			{
 				this->buffer = _move.buffer;
 				this->count = _move.count;
@@ -484,14 +892,15 @@ ListBase
 				_move.capacity = 0;
 			}
 
-			ListBase<T>& operator=(const ListBase<T>&) = delete;
-			ListBase<T>& operator=(ListBase<T>&& _move)
+			ListBase<T, TAllocator>& operator=(const ListBase<T, TAllocator>&) = delete;
+			ListBase<T, TAllocator>& operator=(ListBase<T, TAllocator>&& _move)
 			{
 				if (this->buffer)
 				{
 					memory_management::CallDtors(this->buffer, this->count);
-					memory_management::DeallocateBuffer(this->buffer);
+					memory_management::DeallocateBuffer(allocator, this->buffer, this->capacity);
 				}
+				allocator = _move.allocator;
 				this->buffer = _move.buffer;
 				this->count = _move.count;
 				this->capacity = _move.capacity;
@@ -501,6 +910,63 @@ ListBase
 				return *this;
 			}
 
+			ListBase(Array<T, TAllocator>&& _move)
+				: allocator(_move.allocator)
+			{
+				TakeOver(_move);
+			}
+
+			ListBase<T, TAllocator>& operator=(Array<T, TAllocator>&& _move)
+			{
+				if (this->buffer)
+				{
+					memory_management::CallDtors(this->buffer, this->count);
+					memory_management::DeallocateBuffer(allocator, this->buffer, this->capacity);
+				}
+				allocator = _move.allocator;
+				this->capacity = 0;
+				TakeOver(_move);
+				return *this;
+			}
+
+			/// <summary>Get the allocator of this list.</summary>
+			/// <returns>A copy of the allocator.</returns>
+			TAllocator GetAllocator()const
+			{
+				return allocator;
+			}
+
+			/// <summary>Get the number of elements that the list could hold without growing the buffer.</summary>
+			/// <returns>The capacity of the buffer.</returns>
+			vint Capacity()const
+			{
+				return capacity;
+			}
+
+			/// <summary>Grow the buffer so that it could hold the specified number of elements without growing again.</summary>
+			/// <param name="_capacity">The expected capacity. Nothing happens if it is not larger than the current capacity.</param>
+			/// <remarks>
+			/// Removing elements could still shrink the buffer, according to the shrinking policy of the allocator.
+			/// </remarks>
+			void Reserve(vint _capacity)
+			{
+				if (_capacity > capacity)
+				{
+					this->buffer = memory_management::ReallocateBuffer(allocator, this->buffer, capacity, _capacity, this->count);
+					capacity = _capacity;
+				}
+			}
+
+			/// <summary>Shrink the buffer to the number of elements. The buffer is released if the list is empty.</summary>
+			void ShrinkToFit()
+			{
+				if (capacity > this->count)
+				{
+					this->buffer = memory_management::ReallocateBuffer(allocator, this->buffer, capacity, this->count, this->count);
+					capacity = this->count;
+				}
+			}
+
 			/// <summary>Remove an element at a specified position.</summary>
 			/// <returns>Returns true if the element is removed. It will crash when the index is out of range.</returns>
 			/// <param name="index">The index of the element to remove.</param>
@@ -510,7 +976,7 @@ ListBase
 				CHECK_ERROR(index >= 0 && index < this->count, L"ListBase<T>::RemoveAt(vint)#Argument index not in range.");
 				memory_management::CallMoveAssignmentsOverlapped(&this->buffer[index], &this->buffer[index + 1], this->count - index - 1);
 				this->count--;
-				memory_management::ReleaseUnnecessaryBuffer(this->buffer, this->capacity, previousCount, this->count);
+				memory_management::ReleaseUnnecessaryBuffer(allocator, this->buffer, this->capacity, previousCount, this->count);
 				return true;
 			}
 
@@ -525,7 +991,7 @@ ListBase
 				CHECK_ERROR(index + _count >= 0 && index + _count <= this->count, L"ListBase<T,K>::RemoveRange(vint, vint)#Argument _count not in range.");
 				memory_management::CallMoveAssignmentsOverlapped(&this->buffer[index], &this->buffer[index + _count], this->count - index - _count);
 				this->count -= _count;
-				memory_management::ReleaseUnnecessaryBuffer(this->buffer, this->capacity, previousCount, this->count);
+				memory_management::ReleaseUnnecessaryBuffer(allocator, this->buffer, this->capacity, previousCount, this->count);
 				return true;
 			}
 
@@ -534,10 +1000,11 @@ ListBase
 			bool Clear()
 			{
 				vint previousCount = this->count;
+				vint previousCapacity = this->capacity;
 				this->count = 0;
 				this->capacity = 0;
 				memory_management::CallDtors(this->buffer, previousCount);
-				memory_management::DeallocateBuffer(this->buffer);
+				memory_management::DeallocateBuffer(allocator, this->buffer, previousCapacity);
 				this->buffer = nullptr;
 				return true;
 			}
@@ -547,17 +1014,49 @@ ListBase
 List
 ***********************************************************************/
 
+		template<typename T, typename TAllocator>
+		class SortedList;
+
 		/// <summary>List: linear container with dynamic size in runtime for unordered values. All elements are contiguous in memory.</summary>
 		/// <typeparam name="T">Type of elements.</typeparam>
-		template<typename T>
-		class List : public ListBase<T>
+		/// <typeparam name="TAllocator">Type of the allocator for the buffer, see <see cref="DefaultAllocator"/>.</typeparam>
+		template<typename T, typename TAllocator = DefaultAllocator>
+		class List : public ListBase<T, TAllocator>
 		{
 			using K = typename KeyType<T>::Type;
 		public:
 			/// <summary>Create an empty list.</summary>
 			List() = default;
-			List(List<T>&& container) : ListBase<T>(std::move(container)) {}
-			List<T>& operator=(List<T>&& _move) = default;
+			/// <summary>Create an empty list with an allocator.</summary>
+			/// <param name="_allocator">The allocator for the buffer.</param>
+			explicit List(const TAllocator& _allocator) : ListBase<T, TAllocator>(_allocator) {}
+			List(List<T, TAllocator>&& container) : ListBase<T, TAllocator>(std::move(container)) {}
+			List<T, TAllocator>& operator=(List<T, TAllocator>&& _move) = default;
+
+			/// <summary>Create a list by taking over the buffer of an array, no element is copied.</summary>
+			/// <param name="container">The array to take over. It becomes empty after the list is created.</param>
+			List(Array<T, TAllocator>&& container) : ListBase<T, TAllocator>(std::move(container)) {}
+			/// <summary>Create a list by taking over the buffer of a sorted list, no element is copied.</summary>
+			/// <param name="container">The sorted list to take over. It becomes empty after the list is created.</param>
+			List(SortedList<T, TAllocator>&& container) : ListBase<T, TAllocator>(static_cast<ListBase<T, TAllocator>&&>(container)) {}
+
+			/// <summary>Replace all elements by taking over the buffer of an array, no element is copied.</summary>
+			/// <returns>The list itself.</returns>
+			/// <param name="_move">The array to take over. It becomes empty after the list is changed.</param>
+			List<T, TAllocator>& operator=(Array<T, TAllocator>&& _move)
+			{
+				ListBase<T, TAllocator>::operator=(std::move(_move));
+				return *this;
+			}
+
+			/// <summary>Replace all elements by taking over the buffer of a sorted list, no element is copied.</summary>
+			/// <returns>The list itself.</returns>
+			/// <param name="_move">The sorted list to take over. It becomes empty after the list is changed.</param>
+			List<T, TAllocator>& operator=(SortedList<T, TAllocator>&& _move)
+			{
+				ListBase<T, TAllocator>::operator=(static_cast<ListBase<T, TAllocator>&&>(_move));
+				return *this;
+			}
 
 			/// <summary>Test does the list contain a value or not.</summary>
 			/// <returns>Returns true if the list contains the specified value.</returns>
@@ -572,14 +1071,7 @@ List
 			/// <param name="item">The value to find.</param>
 			vint IndexOf(const K& item)const
 			{
-				for (vint i = 0; i < this->count; i++)
-				{
-					if (this->buffer[i] == item)
-					{
-						return i;
-					}
-				}
-				return -1;
+				return search_internal::IndexOf<T, K>(this->buffer, this->count, item);
 			}
 
 			/// <summary>Append a value at the end of the list.</summary>
@@ -605,7 +1097,7 @@ List
 			vint Insert(vint index, const T& item)
 			{
 				CHECK_ERROR(index >= 0 && index <= this->count, L"List<T>::Insert(vint, const T&)#Argument index not in range.");
-				memory_management::InsertUninitializedItems(this->buffer, this->capacity, this->count, index, 1);
+				memory_management::InsertUninitializedItems(this->allocator, this->buffer, this->capacity, this->count, index, 1);
 				memory_management::CallCopyCtors(&this->buffer[index], &item, 1);
 				return index;
 			}
@@ -617,11 +1109,104 @@ List
 			vint Insert(vint index, T&& item)
 			{
 				CHECK_ERROR(index >= 0 && index <= this->count, L"List<T>::Insert(vint, const T&)#Argument index not in range.");
-				memory_management::InsertUninitializedItems(this->buffer, this->capacity, this->count, index, 1);
+				memory_management::InsertUninitializedItems(this->allocator, this->buffer, this->capacity, this->count, index, 1);
 				memory_management::CallMoveCtors(&this->buffer[index], &item, 1);
 				return index;
 			}
 
+			/// <summary>Append values at the end of the list. The buffer is grown at most once.</summary>
+			/// <returns>The index of the first added item.</returns>
+			/// <param name="items">Pointer to values to copy.</param>
+			/// <param name="_count">The number of values to copy.</param>
+			vint AddRange(const T* items, vint _count)
+			{
+				return InsertRange(this->count, items, _count);
+			}
+
+			/// <summary>Append values at the end of the list. The buffer is grown at most once.</summary>
+			/// <returns>The index of the first added item.</returns>
+			/// <param name="items">The values to copy.</param>
+			vint AddRange(const ArrayBase<T>& items)
+			{
+				return InsertRange(this->count, items);
+			}
+
+			/// <summary>Append values at the end of the list. The buffer is grown at most once.</summary>
+			/// <returns>The index of the first added item.</returns>
+			/// <param name="items">The values to copy.</param>
+			vint AddRange(const IEnumerable<T>& items)
+			{
+				return InsertRange(this->count, items);
+			}
+
+			/// <summary>Insert values at the specified position. The buffer is grown at most once.</summary>
+			/// <returns>The index of the first added item. It will crash if the index is out of range</returns>
+			/// <param name="index">The position to insert values.</param>
+			/// <param name="items">Pointer to values to copy.</param>
+			/// <param name="_count">The number of values to copy.</param>
+			vint InsertRange(vint index, const T* items, vint _count)
+			{
+				CHECK_ERROR(index >= 0 && index <= this->count, L"List<T>::InsertRange(vint, const T*, vint)#Argument index not in range.");
+				CHECK_ERROR(_count >= 0, L"List<T>::InsertRange(vint, const T*, vint)#Argument _count should not be negative.");
+				if (_count == 0) return index;
+
+				if (this->buffer && items >= this->buffer && items < this->buffer + this->count)
+				{
+					// values are from this list, copy them before the buffer is changed
+					Array<T, TAllocator> copied(items, _count, this->allocator);
+					return InsertRange(index, &copied[0], _count);
+				}
+
+				memory_management::InsertUninitializedItems(this->allocator, this->buffer, this->capacity, this->count, index, _count);
+				memory_management::CallCopyCtors(&this->buffer[index], items, _count);
+				return index;
+			}
+
+			/// <summary>Insert values at the specified position. The buffer is grown at most once.</summary>
+			/// <returns>The index of the first added item. It will crash if the index is out of range</returns>
+			/// <param name="index">The position to insert values.</param>
+			/// <param name="items">The values to copy.</param>
+			vint InsertRange(vint index, const ArrayBase<T>& items)
+			{
+				if (items.Count() == 0)
+				{
+					CHECK_ERROR(index >= 0 && index <= this->count, L"List<T>::InsertRange(vint, const ArrayBase<T>&)#Argument index not in range.");
+					return index;
+				}
+				return InsertRange(index, &items[0], items.Count());
+			}
+
+			/// <summary>Insert values at the specified position.</summary>
+			/// <returns>The index of the first added item. It will crash if the index is out of range</returns>
+			/// <param name="index">The position to insert values.</param>
+			/// <param name="items">The values to copy.</param>
+			/// <remarks>
+			/// If the number of values is known, the buffer is grown at most once.
+			/// Otherwise values are evaluated into a temporary list before inserting.
+			/// </remarks>
+			vint InsertRange(vint index, const IEnumerable<T>& items)
+			{
+				if (auto arrayBase = dynamic_cast<const ArrayBase<T>*>(&items))
+				{
+					return InsertRange(index, *arrayBase);
+				}
+
+				CHECK_ERROR(index >= 0 && index <= this->count, L"List<T>::InsertRange(vint, const IEnumerable<T>&)#Argument index not in range.");
+				List<T, TAllocator> evaluated(this->allocator);
+				auto enumerator = Ptr(items.CreateEnumerator());
+				while (enumerator->Next())
+				{
+					evaluated.Add(enumerator->Current());
+				}
+
+				if (evaluated.count > 0)
+				{
+					memory_management::InsertUninitializedItems(this->allocator, this->buffer, this->capacity, this->count, index, evaluated.count);
+					memory_management::CallMoveCtors(&this->buffer[index], evaluated.buffer, evaluated.count);
+				}
+				return index;
+			}
+
 			/// <summary>Remove an element from the list. If multiple elements equal to the specified value, only the first one will be removed</summary>
 			/// <returns>Returns true if the element is removed.</returns>
 			/// <param name="item">The item to remove.</param>
@@ -661,7 +1246,7 @@ List
 				return true;
 			}
 
-			using ListBase<T>::operator[];
+			using ListBase<T, TAllocator>::operator[];
 
 			/// <summary>Get the reference to the specified element.</summary>
 			/// <returns>The reference to the specified element. It will crash when the index is out of range.</returns>
@@ -674,144 +1259,169 @@ List
 		};
 
 /***********************************************************************
-SortedList
+SmallList
 ***********************************************************************/
-		
-		/// <summary>Get the position of an element in an array by performing binary search.</summary>
-		/// <typeparam name="T">Type of elements in the array.</typeparam>
-		/// <typeparam name="K">Type of the element to find.</typeparam>
-		/// <typeparam name="F">The comparison function.</typeparam>
-		/// <returns>Returns the position. Returns -1 if it does not exist.</returns>
-		/// <param name="buffer">The array to find in.</param>
-		/// <param name="count">The number of elements in the array.</param>
-		/// <param name="item">The element to find.</param>
-		/// <param name="index">
-		/// If the element exist, this argument returns one of the element that equals to the specified value.
-		/// If the element doesn not exist,
-		/// this argument returns either the greatest element that less than the specified value,
-		/// or the least element that greater than the specified value.
-		/// </param>
-		/// <param name="orderer">The comparar for two elements returning std::(strong|weak)_ordering.</param>
-		template<typename T, typename K, typename F>
-		vint BinarySearchLambda(const T* buffer, vint count, const K& item, vint& index, F&& orderer)
+
+		namespace memory_management
 		{
-			vint start = 0;
-			vint end = count - 1;
-			index = -1;
-			while (start <= end)
+			template<typename TAllocator>
+			struct InlineBufferAllocator
 			{
-				index = start + (end - start) / 2;
-				auto ordering = orderer(buffer[index], item);
-				if constexpr (!std::is_same_v<decltype(ordering), std::partial_ordering>)
+				void*							inlineBuffer;
+				TAllocator*						allocator;
+
+				void* Allocate(vint size)
 				{
-					// VS2022 seems not happy with
-					// requires(!std::is_same_v<decltype(std::declval<F>()(std::declval<T>(), std::declval<K>())), std::partial_ordering>)
-					CHECK_ERROR(ordering != std::partial_ordering::unordered, L"vl::collections::BinarySearchLambda<T, K, F>(const T*, vint, const K&, vint&, F&&)#This function could not apply on elements in partial ordering.");
+					return allocator->Allocate(size);
 				}
 
-				if (ordering < 0)
+				void Deallocate(void* buffer, vint size)
 				{
-					start = index + 1;
+					if (buffer != inlineBuffer)
+					{
+						allocator->Deallocate(buffer, size);
+					}
 				}
-				else if (ordering > 0)
+
+				void* Reallocate(void* buffer, vint oldSize, vint newSize)
+					requires(ReallocatableAllocator<TAllocator>)
 				{
-					end = index - 1;
+					if (buffer != inlineBuffer)
+					{
+						return allocator->Reallocate(buffer, oldSize, newSize);
+					}
+
+					// only trivially relocatable elements are reallocated, copying memory is enough
+					void* newBuffer = allocator->Allocate(newSize);
+					memcpy(newBuffer, buffer, oldSize < newSize ? oldSize : newSize);
+					return newBuffer;
 				}
-				else
+
+				vint GetGrowingCapacity(vint capacity, vint count)
 				{
-					return index;
+					return memory_management::GetGrowingCapacity(*allocator, capacity, count);
 				}
-			}
-			return -1;
-		}
-
-		/// <summary>Get the position of an element in an array by performing binary search.</summary>
-		/// <typeparam name="T">Type of elements in the array.</typeparam>
-		/// <returns>Returns the position. Returns -1 if it does not exist.</returns>
-		/// <param name="buffer">The array to find in.</param>
-		/// <param name="count">The number of elements in the array.</param>
-		/// <param name="item">The element to find.</param>
-		/// <param name="index">
-		/// If the element exist, this argument returns one of the element that equals to the specified value.
-		/// If the element doesn not exist,
-		/// this argument returns either the greatest element that less than the specified value,
-		/// or the least element that greater than the specified value.
-		/// </param>
-		template<typename T>
-		vint BinarySearchLambda2(const T* buffer, vint count, const T& item, vint& index)
-		{
-			return BinarySearchLambda<T, T>(buffer, count, item, index, [](const T& a, const T& b) { return a <=> b; });
+			};
 		}
 
-		/// <summary>SortedList: linear container with dynamic size in runtime for ordered values. All elements are kept in order, and are contiguous in memory.</summary>
+		/// <summary>
+		/// SmallList: linear container with dynamic size in runtime for unordered values. All elements are contiguous in memory.
+		/// The first N elements are stored inside the list object, a buffer is only allocated when there are more elements.
+		/// </summary>
 		/// <typeparam name="T">Type of elements.</typeparam>
-		template<typename T>
-		class SortedList : public ListBase<T>
+		/// <typeparam name="N">The number of elements that could be stored without allocating a buffer.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for the buffer, see <see cref="DefaultAllocator"/>.</typeparam>
+		template<typename T, vint N, typename TAllocator = DefaultAllocator>
+		class SmallList : public ArrayBase<T>
 		{
+			static_assert(N > 0, "vl::collections::SmallList<T, N, TAllocator> requires N to be positive.");
 			using K = typename KeyType<T>::Type;
 		protected:
+			vint									capacity = N;
+			VCZH_NO_UNIQUE_ADDRESS TAllocator		allocator;
+			alignas(T) char							inlineBuffer[sizeof(T) * N];
 
-			template<typename Key>
-			vint IndexOfInternal(const Key& item, vint& index)const
-			{
-				return BinarySearchLambda<T, Key>(this->buffer, this->count, item, index, [](const T& a, const Key& b) { return a <=> b; });
-			}
-
-			vint Insert(vint index, const T& item)
+			bool IsInline()const
 			{
-				bool uninitialized = false;
-				memory_management::InsertUninitializedItems(this->buffer, this->capacity, this->count, index, 1);
-				memory_management::CallCopyCtors(&this->buffer[index], &item, 1);
-				return index;
+				return this->buffer == (const T*)inlineBuffer;
 			}
 
-			vint Insert(vint index, T&& item)
+			void TakeOver(SmallList<T, N, TAllocator>& _move)
 			{
-				bool uninitialized = false;
-				memory_management::InsertUninitializedItems(this->buffer, this->capacity, this->count, index, 1);
-				memory_management::CallMoveCtors(&this->buffer[index], &item, 1);
-				return index;
+				if (_move.IsInline())
+				{
+					memory_management::RelocateItems(this->buffer, _move.buffer, _move.count);
+				}
+				else
+				{
+					this->buffer = _move.buffer;
+					this->capacity = _move.capacity;
+					_move.buffer = (T*)_move.inlineBuffer;
+					_move.capacity = N;
+				}
+				this->count = _move.count;
+				_move.count = 0;
 			}
 
-			template<typename TItem>
-			vint AddInternal(TItem&& item)
+			void ReleaseUnnecessaryBuffer(vint previousCount)
 			{
-				if (ArrayBase<T>::count == 0)
+				if (IsInline())
 				{
-					return Insert(0, std::forward<TItem&&>(item));
+					memory_management::CallDtors(&this->buffer[this->count], previousCount - this->count);
+				}
+				else if (this->count <= N && this->count * 2 <= capacity)
+				{
+					memory_management::CallDtors(&this->buffer[this->count], previousCount - this->count);
+					memory_management::RelocateItems((T*)inlineBuffer, this->buffer, this->count);
+					memory_management::DeallocateBuffer(allocator, this->buffer, capacity);
+					this->buffer = (T*)inlineBuffer;
+					capacity = N;
 				}
 				else
 				{
-					vint outputIndex = -1;
-					if constexpr (std::is_same_v<std::remove_cvref_t<T>, std::remove_cvref_t<K>>)
-					{
-						IndexOfInternal<K>(item, outputIndex);
-					}
-					else if constexpr (std::is_same_v<std::remove_cvref_t<TItem>, std::remove_cvref_t<K>>)
-					{
-						IndexOfInternal<K>(item, outputIndex);
-					}
-					else
-					{
-						IndexOfInternal<K>(KeyType<T>::GetKeyValue(item), outputIndex);
-					}
-					CHECK_ERROR(outputIndex >= 0 && outputIndex < this->count, L"SortedList<T>::Add(const T&)#Internal error, index not in range.");
-					if (this->buffer[outputIndex] < item)
-					{
-						outputIndex++;
-					}
-					return Insert(outputIndex, std::forward<TItem&&>(item));
+					memory_management::ReleaseUnnecessaryBuffer(allocator, this->buffer, capacity, previousCount, this->count);
 				}
 			}
+
+			void InsertUninitializedItems(vint index, vint insertCount)
+			{
+				memory_management::InlineBufferAllocator<TAllocator> inlineAllocator = { inlineBuffer, &allocator };
+				memory_management::InsertUninitializedItems(inlineAllocator, this->buffer, capacity, this->count, index, insertCount);
+			}
+
 		public:
 			/// <summary>Create an empty list.</summary>
-			SortedList() = default;
-			SortedList(SortedList<T>&& container) : ListBase<T>(std::move(container)) {}
-			SortedList<T>& operator=(SortedList<T> && _move) = default;
+			SmallList()
+			{
+				this->buffer = (T*)inlineBuffer;
+			}
+
+			/// <summary>Create an empty list with an allocator.</summary>
+			/// <param name="_allocator">The allocator for the buffer.</param>
+			explicit SmallList(const TAllocator& _allocator)
+				: allocator(_allocator)
+			{
+				this->buffer = (T*)inlineBuffer;
+			}
+
+			~SmallList()
+			{
+				memory_management::CallDtors(this->buffer, this->count);
+				if (!IsInline())
+				{
+					memory_management::DeallocateBuffer(allocator, this->buffer, capacity);
+				}
+			}
+
+			SmallList(const SmallList<T, N, TAllocator>&) = delete;
+			SmallList(SmallList<T, N, TAllocator>&& _move)
+				: allocator(_move.allocator)
+			{
+				this->buffer = (T*)inlineBuffer;
+				TakeOver(_move);
+			}
+
+			SmallList<T, N, TAllocator>& operator=(const SmallList<T, N, TAllocator>&) = delete;
+			SmallList<T, N, TAllocator>& operator=(SmallList<T, N, TAllocator>&& _move)
+			{
+				Clear();
+				allocator = _move.allocator;
+				TakeOver(_move);
+				return *this;
+			}
 
-			SortedList(const SortedList<T>&xs)
-				: ListBase<T>(std::move(const_cast<ListBase<T>&>(static_cast<const ListBase<T>&>(xs))))
+			/// <summary>Get the allocator of this list.</summary>
+			/// <returns>A copy of the allocator.</returns>
+			TAllocator GetAllocator()const
 			{
+				return allocator;
+			}
+
+			/// <summary>Test if elements are stored inside the list object instead of an allocated buffer.</summary>
+			/// <returns>Returns true if no buffer is allocated.</returns>
+			bool IsInlineStorage()const
+			{
+				return IsInline();
 			}
 
 			/// <summary>Test does the list contain a value or not.</summary>
@@ -827,24 +1437,47 @@ SortedList
 			/// <param name="item">The value to find.</param>
 			vint IndexOf(const K& item)const
 			{
-				vint outputIndex = -1;
-				return IndexOfInternal<K>(item, outputIndex);
+				return search_internal::IndexOf<T, K>(this->buffer, this->count, item);
 			}
 
-			/// <summary>Add a value at the correct position, all elements will be kept in order.</summary>
+			/// <summary>Append a value at the end of the list.</summary>
 			/// <returns>The index of the added item.</returns>
 			/// <param name="item">The value to add.</param>
 			vint Add(const T& item)
 			{
-				return AddInternal(item);
+				return Insert(this->count, item);
 			}
 
-			/// <summary>Add a value at the correct position, all elements will be kept in order.</summary>
+			/// <summary>Append a value at the end of the list.</summary>
 			/// <returns>The index of the added item.</returns>
 			/// <param name="item">The value to add.</param>
 			vint Add(T&& item)
 			{
-				return AddInternal(std::move(item));
+				return Insert(this->count, std::move(item));
+			}
+
+			/// <summary>Insert a value at the specified position.</summary>
+			/// <returns>The index of the added item. It will crash if the index is out of range</returns>
+			/// <param name="index">The position to insert the value.</param>
+			/// <param name="item">The value to add.</param>
+			vint Insert(vint index, const T& item)
+			{
+				CHECK_ERROR(index >= 0 && index <= this->count, L"SmallList<T, N>::Insert(vint, const T&)#Argument index not in range.");
+				InsertUninitializedItems(index, 1);
+				memory_management::CallCopyCtors(&this->buffer[index], &item, 1);
+				return index;
+			}
+
+			/// <summary>Insert a value at the specified position.</summary>
+			/// <returns>The index of the added item. It will crash if the index is out of range</returns>
+			/// <param name="index">The position to insert the value.</param>
+			/// <param name="item">The value to add.</param>
+			vint Insert(vint index, T&& item)
+			{
+				CHECK_ERROR(index >= 0 && index <= this->count, L"SmallList<T, N>::Insert(vint, const T&)#Argument index not in range.");
+				InsertUninitializedItems(index, 1);
+				memory_management::CallMoveCtors(&this->buffer[index], &item, 1);
+				return index;
 			}
 
 			/// <summary>Remove an element from the list. If multiple elements equal to the specified value, only the first one will be removed</summary>
@@ -853,9 +1486,9 @@ SortedList
 			bool Remove(const K& item)
 			{
 				vint index = IndexOf(item);
-				if (index >= 0 && index < ArrayBase<T>::count)
+				if (index >= 0 && index < this->count)
 				{
-					this->RemoveAt(index);
+					RemoveAt(index);
 					return true;
 				}
 				else
@@ -863,115 +1496,916 @@ SortedList
 					return false;
 				}
 			}
-		};
-
-/***********************************************************************
-Special Containers
-***********************************************************************/
-
-		template<typename T>
-		class PushOnlyAllocator : public Object
-		{
-		protected:
-			vint							blockSize;
-			vint							allocatedSize;
-			List<T*>						blocks;
-
-		public:
-			NOT_COPYABLE(PushOnlyAllocator);
 
-			PushOnlyAllocator(vint _blockSize = 65536)
-				:blockSize(_blockSize)
-				, allocatedSize(0)
+			/// <summary>Remove an element at a specified position.</summary>
+			/// <returns>Returns true if the element is removed. It will crash when the index is out of range.</returns>
+			/// <param name="index">The index of the element to remove.</param>
+			bool RemoveAt(vint index)
 			{
+				vint previousCount = this->count;
+				CHECK_ERROR(index >= 0 && index < this->count, L"SmallList<T, N>::RemoveAt(vint)#Argument index not in range.");
+				memory_management::CallMoveAssignmentsOverlapped(&this->buffer[index], &this->buffer[index + 1], this->count - index - 1);
+				this->count--;
+				ReleaseUnnecessaryBuffer(previousCount);
+				return true;
 			}
 
-			~PushOnlyAllocator()
+			/// <summary>Remove contiguous elements at a specified psition.</summary>
+			/// <returns>Returns true if elements are removed. It will crash when the index or the size is out of range.</returns>
+			/// <param name="index">The index of the first element to remove.</param>
+			/// <param name="_count">The number of elements to remove.</param>
+			bool RemoveRange(vint index, vint _count)
 			{
-				for (vint i = 0; i < blocks.Count(); i++)
-				{
-					delete[] blocks[i];
-				}
+				vint previousCount = this->count;
+				CHECK_ERROR(index >= 0 && index <= this->count, L"SmallList<T, N>::RemoveRange(vint, vint)#Argument index not in range.");
+				CHECK_ERROR(index + _count >= 0 && index + _count <= this->count, L"SmallList<T, N>::RemoveRange(vint, vint)#Argument _count not in range.");
+				memory_management::CallMoveAssignmentsOverlapped(&this->buffer[index], &this->buffer[index + _count], this->count - index - _count);
+				this->count -= _count;
+				ReleaseUnnecessaryBuffer(previousCount);
+				return true;
 			}
 
-			T* Get(vint index)
+			/// <summary>Remove all elements.</summary>
+			/// <returns>Returns true if all elements are removed.</returns>
+			bool Clear()
 			{
-				if (index >= allocatedSize)
+				memory_management::CallDtors(this->buffer, this->count);
+				if (!IsInline())
 				{
-					return 0;
+					memory_management::DeallocateBuffer(allocator, this->buffer, capacity);
+					this->buffer = (T*)inlineBuffer;
 				}
-				vint row = index / blockSize;
-				vint column = index % blockSize;
-				return &blocks[row][column];
+				this->count = 0;
+				capacity = N;
+				return true;
 			}
 
-			T* Create()
+			/// <summary>Replace an element in the specified position.</summary>
+			/// <returns>Returns true. It will crash when the index is out of range</returns>
+			/// <param name="index">The position of the element to replace.</param>
+			/// <param name="item">The new value to replace.</param>
+			bool Set(vint index, const T& item)
 			{
-				if (allocatedSize == blocks.Count()*blockSize)
-				{
-					blocks.Add(new T[blockSize]);
-				}
-				vint index = allocatedSize++;
-				return Get(index);
+				CHECK_ERROR(index >= 0 && index < this->count, L"SmallList<T, N>::Set(vint)#Argument index not in range.");
+				this->buffer[index] = item;
+				return true;
 			}
-		};
 
-		namespace bom_helper
-		{
-			struct TreeNode
-			{
-				TreeNode*					nodes[4];
+			/// <summary>Replace an element in the specified position.</summary>
+			/// <returns>Returns true. It will crash when the index is out of range</returns>
+			/// <param name="index">The position of the element to replace.</param>
+			/// <param name="item">The new value to replace.</param>
+			bool Set(vint index, T&& item)
+			{
+				CHECK_ERROR(index >= 0 && index < this->count, L"SmallList<T, N>::Set(vint)#Argument index not in range.");
+				this->buffer[index] = std::move(item);
+				return true;
+			}
+
+			using ArrayBase<T>::operator[];
+
+			/// <summary>Get the reference to the specified element.</summary>
+			/// <returns>The reference to the specified element. It will crash when the index is out of range.</returns>
+			/// <param name="index">The index of the element.</param>
+			T& operator[](vint index)
+			{
+				CHECK_ERROR(index >= 0 && index < this->count, L"SmallList<T, N>::operator[](vint)#Argument index not in range.");
+				return this->buffer[index];
+			}
+		};
+
+/***********************************************************************
+Quick Sort
+***********************************************************************/
+
+		/// <summary>Quick sort.</summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <typeparam name="F">Type of the comparer.</typeparam>
+		/// <param name="items">Pointer to element array to sort.</param>
+		/// <param name="length">The number of elements to sort.</param>
+		/// <param name="orderer">
+		/// The comparar for two elements returning std::(strong|weak|partial)_ordering.
+		/// </param>
+		template<typename T, typename F>
+		void SortLambda(T* items, vint length, F&& orderer)
+		{
+			while (true)
+			{
+				if (length == 0) return;
+				vint pivot = 0;
+				vint left = 0;
+				vint right = 0;
+
+				{
+					bool flag = false;
+					while (left + right + 1 != length)
+					{
+						vint& mine = (flag ? left : right);
+						vint& theirs = (flag ? right : left);
+						vint candidate = (flag ? left : length - right - 1);
+						vint factor = (flag ? -1 : 1);
+
+						auto ordering = orderer(items[pivot], items[candidate]);
+						if constexpr (std::is_same_v<decltype(ordering), std::partial_ordering>)
+						{
+							CHECK_ERROR(ordering != std::partial_ordering::unordered, L"vl::collections::SortLambda(T*, vint, F&&)#This function could not apply on elements in partial ordering.");
+						}
+
+						if ((factor == 1 && ordering <= 0) || (factor == -1 && ordering >= 0))
+						{
+							mine++;
+						}
+						else
+						{
+							theirs++;
+							T temp = std::move(items[pivot]);
+							items[pivot] = std::move(items[candidate]);
+							items[candidate] = std::move(temp);
+							pivot = candidate;
+							flag = !flag;
+						}
+					}
+				}
+
+				{
+					vint reading = left - 1;
+					vint writing = reading;
+					while (reading >= 0)
+					{
+						auto ordering = orderer(items[pivot], items[reading]);
+						if constexpr (std::is_same_v<decltype(ordering), std::partial_ordering>)
+						{
+							CHECK_ERROR(ordering != std::partial_ordering::unordered, L"vl::collections::SortLambda(T*, vint, F&&)#This function could not apply on elements in partial ordering.");
+						}
+
+						if (ordering == 0)
+						{
+							if (reading != writing)
+							{
+								T temp = std::move(items[reading]);
+								items[reading] = std::move(items[writing]);
+								items[writing] = std::move(temp);
+							}
+							writing--;
+						}
+						reading--;
+					}
+					left = writing + 1;
+				}
+
+				{
+					vint reading = length - right;
+					vint writing = reading;
+					while (reading < length)
+					{
+						if (orderer(items[pivot], items[reading]) == 0)
+						{
+							if (reading != writing)
+							{
+								T temp = std::move(items[reading]);
+								items[reading] = std::move(items[writing]);
+								items[writing] = std::move(temp);
+							}
+							writing++;
+						}
+						reading++;
+					}
+					right = length - writing;
+				}
+
+				if (left < right)
+				{
+					SortLambda(items, left, orderer);
+					items += length - right;
+					length = right;
+				}
+				else
+				{
+					SortLambda(items + length - right, right, orderer);
+					length = left;
+				}
+			}
+		}
+
+		/// <summary>Quick sort.</summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <param name="items">Pointer to element array to sort.</param>
+		/// <param name="length">The number of elements to sort.</param>
+		/// <param name="orderer">
+		/// The comparar for two elements returning std::(strong|weak|partial)_ordering.
+		/// </param>
+		template<typename T, typename F>
+		void Sort(T* items, vint length, F&& orderer)
+		{
+			SortLambda(items, length, orderer);
+		}
+
+		/// <summary>Quick sort.</summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <param name="items">Pointer to element array to sort.</param>
+		/// <param name="length">The number of elements to sort.</param>
+		template<typename T>
+		void Sort(T* items, vint length)
+		{
+			SortLambda(items, length, [](const T& a, const T& b) { return a <=> b; });
+		}
+
+/***********************************************************************
+SortedList
+***********************************************************************/
+		
+		/// <summary>Get the position of an element in an array by performing binary search.</summary>
+		/// <typeparam name="T">Type of elements in the array.</typeparam>
+		/// <typeparam name="K">Type of the element to find.</typeparam>
+		/// <typeparam name="F">The comparison function.</typeparam>
+		/// <returns>Returns the position of the first element that equals to the specified value. Returns -1 if it does not exist.</returns>
+		/// <param name="buffer">The array to find in.</param>
+		/// <param name="count">The number of elements in the array.</param>
+		/// <param name="item">The element to find.</param>
+		/// <param name="index">
+		/// If the element exist, this argument returns the first element that equals to the specified value.
+		/// If the element doesn not exist,
+		/// this argument returns the least element that greater than the specified value,
+		/// or the last element if all elements are less than the specified value.
+		/// </param>
+		/// <param name="orderer">The comparar for two elements returning std::(strong|weak)_ordering.</param>
+		/// <remarks>
+		/// The search range is halved without a branch depending on the comparison,
+		/// so that the compiler could select the next range by a conditional move instead of a mispredicted jump.
+		/// For trivially copyable elements, elements to compare in the next step are prefetched.
+		/// </remarks>
+		template<typename T, typename K, typename F>
+		vint BinarySearchLambda(const T* buffer, vint count, const K& item, vint& index, F&& orderer)
+		{
+			index = -1;
+			if (count <= 0) return -1;
+
+			// the first element that is not less than item is in [base, base + length]
+			const T* base = buffer;
+			vint length = count;
+			while (length > 1)
+			{
+				vint half = length / 2;
+				if constexpr (search_internal::CanPrefetch<T>)
+				{
+					search_internal::Prefetch(base + half / 2);
+					search_internal::Prefetch(base + half + half / 2);
+				}
+				base = orderer(base[half], item) < 0 ? base + half : base;
+				length -= half;
+			}
+
+			vint position = (vint)(base - buffer) + (orderer(*base, item) < 0 ? 1 : 0);
+			index = position < count ? position : count - 1;
+			if (position == count) return -1;
+
+			auto ordering = orderer(buffer[position], item);
+			if constexpr (!std::is_same_v<decltype(ordering), std::partial_ordering>)
+			{
+				// VS2022 seems not happy with
+				// requires(!std::is_same_v<decltype(std::declval<F>()(std::declval<T>(), std::declval<K>())), std::partial_ordering>)
+				CHECK_ERROR(ordering != std::partial_ordering::unordered, L"vl::collections::BinarySearchLambda<T, K, F>(const T*, vint, const K&, vint&, F&&)#This function could not apply on elements in partial ordering.");
+			}
+			return ordering == 0 ? position : -1;
+		}
+
+		/// <summary>Get the position of an element in an array by performing binary search.</summary>
+		/// <typeparam name="T">Type of elements in the array.</typeparam>
+		/// <returns>Returns the position of the first element that equals to the specified value. Returns -1 if it does not exist.</returns>
+		/// <param name="buffer">The array to find in.</param>
+		/// <param name="count">The number of elements in the array.</param>
+		/// <param name="item">The element to find.</param>
+		/// <param name="index">
+		/// If the element exist, this argument returns the first element that equals to the specified value.
+		/// If the element doesn not exist,
+		/// this argument returns the least element that greater than the specified value,
+		/// or the last element if all elements are less than the specified value.
+		/// </param>
+		template<typename T>
+		vint BinarySearchLambda2(const T* buffer, vint count, const T& item, vint& index)
+		{
+			return BinarySearchLambda<T, T>(buffer, count, item, index, [](const T& a, const T& b) { return a <=> b; });
+		}
+
+		/// <summary>SortedList: linear container with dynamic size in runtime for ordered values. All elements are kept in order, and are contiguous in memory.</summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for the buffer, see <see cref="DefaultAllocator"/>.</typeparam>
+		template<typename T, typename TAllocator = DefaultAllocator>
+		class SortedList : public ListBase<T, TAllocator>
+		{
+			using K = typename KeyType<T>::Type;
+		protected:
+
+			template<typename Key>
+			vint IndexOfInternal(const Key& item, vint& index)const
+			{
+				return BinarySearchLambda<T, Key>(this->buffer, this->count, item, index, [](const T& a, const Key& b) { return a <=> b; });
+			}
+
+			vint Insert(vint index, const T& item)
+			{
+				bool uninitialized = false;
+				memory_management::InsertUninitializedItems(this->allocator, this->buffer, this->capacity, this->count, index, 1);
+				memory_management::CallCopyCtors(&this->buffer[index], &item, 1);
+				return index;
+			}
+
+			vint Insert(vint index, T&& item)
+			{
+				bool uninitialized = false;
+				memory_management::InsertUninitializedItems(this->allocator, this->buffer, this->capacity, this->count, index, 1);
+				memory_management::CallMoveCtors(&this->buffer[index], &item, 1);
+				return index;
+			}
+
+			template<typename TItem>
+			vint AddInternal(TItem&& item)
+			{
+				if (ArrayBase<T>::count == 0)
+				{
+					return Insert(0, std::forward<TItem&&>(item));
+				}
+				else
+				{
+					vint outputIndex = -1;
+					if constexpr (std::is_same_v<std::remove_cvref_t<T>, std::remove_cvref_t<K>>)
+					{
+						IndexOfInternal<K>(item, outputIndex);
+					}
+					else if constexpr (std::is_same_v<std::remove_cvref_t<TItem>, std::remove_cvref_t<K>>)
+					{
+						IndexOfInternal<K>(item, outputIndex);
+					}
+					else
+					{
+						IndexOfInternal<K>(KeyType<T>::GetKeyValue(item), outputIndex);
+					}
+					CHECK_ERROR(outputIndex >= 0 && outputIndex < this->count, L"SortedList<T>::Add(const T&)#Internal error, index not in range.");
+					if (this->buffer[outputIndex] < item)
+					{
+						outputIndex++;
+					}
+					return Insert(outputIndex, std::forward<TItem&&>(item));
+				}
+			}
+
+			void SortTakenOverItems()
+			{
+				for (vint i = 1; i < this->count; i++)
+				{
+					if ((this->buffer[i - 1] <=> this->buffer[i]) > 0)
+					{
+						SortLambda(this->buffer, this->count, [](const T& a, const T& b) { return a <=> b; });
+						return;
+					}
+				}
+			}
+		public:
+			/// <summary>Create an empty list.</summary>
+			SortedList() = default;
+			/// <summary>Create an empty list with an allocator.</summary>
+			/// <param name="_allocator">The allocator for the buffer.</param>
+			explicit SortedList(const TAllocator& _allocator) : ListBase<T, TAllocator>(_allocator) {}
+			SortedList(SortedList<T, TAllocator>&& container) : ListBase<T, TAllocator>(std::move(container)) {}
+			SortedList<T, TAllocator>& operator=(SortedList<T, TAllocator> && _move) = default;
+
+			/// <summary>Create a sorted list by taking over the buffer of an array, no element is copied.</summary>
+			/// <param name="container">The array to take over. It becomes empty after the sorted list is created.</param>
+			/// <remarks>Elements are sorted in place if they are not already in order.</remarks>
+			SortedList(Array<T, TAllocator>&& container) : ListBase<T, TAllocator>(std::move(container)) { SortTakenOverItems(); }
+			/// <summary>Create a sorted list by taking over the buffer of a list, no element is copied.</summary>
+			/// <param name="container">The list to take over. It becomes empty after the sorted list is created.</param>
+			/// <remarks>Elements are sorted in place if they are not already in order.</remarks>
+			SortedList(List<T, TAllocator>&& container) : ListBase<T, TAllocator>(static_cast<ListBase<T, TAllocator>&&>(container)) { SortTakenOverItems(); }
+
+			/// <summary>Replace all elements by taking over the buffer of an array, no element is copied.</summary>
+			/// <returns>The sorted list itself.</returns>
+			/// <param name="_move">The array to take over. It becomes empty after the sorted list is changed.</param>
+			/// <remarks>Elements are sorted in place if they are not already in order.</remarks>
+			SortedList<T, TAllocator>& operator=(Array<T, TAllocator>&& _move)
+			{
+				ListBase<T, TAllocator>::operator=(std::move(_move));
+				SortTakenOverItems();
+				return *this;
+			}
+
+			/// <summary>Replace all elements by taking over the buffer of a list, no element is copied.</summary>
+			/// <returns>The sorted list itself.</returns>
+			/// <param name="_move">The list to take over. It becomes empty after the sorted list is changed.</param>
+			/// <remarks>Elements are sorted in place if they are not already in order.</remarks>
+			SortedList<T, TAllocator>& operator=(List<T, TAllocator>&& _move)
+			{
+				ListBase<T, TAllocator>::operator=(static_cast<ListBase<T, TAllocator>&&>(_move));
+				SortTakenOverItems();
+				return *this;
+			}
+
+			SortedList(const SortedList<T, TAllocator>&xs)
+				: ListBase<T, TAllocator>(std::move(const_cast<ListBase<T, TAllocator>&>(static_cast<const ListBase<T, TAllocator>&>(xs))))
+			{
+			}
+
+			/// <summary>Test does the list contain a value or not.</summary>
+			/// <returns>Returns true if the list contains the specified value.</returns>
+			/// <param name="item">The value to test.</param>
+			bool Contains(const K& item)const
+			{
+				return IndexOf(item) != -1;
+			}
+
+			/// <summary>Get the position of a value in this list.</summary>
+			/// <returns>Returns the position of first element that equals to the specified value. Returns -1 if failed to find.</returns>
+			/// <param name="item">The value to find.</param>
+			vint IndexOf(const K& item)const
+			{
+				vint outputIndex = -1;
+				return IndexOfInternal<K>(item, outputIndex);
+			}
+
+			/// <summary>Add a value at the correct position, all elements will be kept in order.</summary>
+			/// <returns>The index of the added item.</returns>
+			/// <param name="item">The value to add.</param>
+			vint Add(const T& item)
+			{
+				return AddInternal(item);
+			}
+
+			/// <summary>Add a value at the correct position, all elements will be kept in order.</summary>
+			/// <returns>The index of the added item.</returns>
+			/// <param name="item">The value to add.</param>
+			vint Add(T&& item)
+			{
+				return AddInternal(std::move(item));
+			}
+
+			/// <summary>Remove an element from the list. If multiple elements equal to the specified value, only the first one will be removed</summary>
+			/// <returns>Returns true if the element is removed.</returns>
+			/// <param name="item">The item to remove.</param>
+			bool Remove(const K& item)
+			{
+				vint index = IndexOf(item);
+				if (index >= 0 && index < ArrayBase<T>::count)
+				{
+					this->RemoveAt(index);
+					return true;
+				}
+				else
+				{
+					return false;
+				}
+			}
+		};
+
+/***********************************************************************
+Special Containers
+***********************************************************************/
+
+		template<typename T>
+		class PushOnlyAllocator : public Object
+		{
+		protected:
+			vint							blockSize;
+			vint							allocatedSize;
+			List<T*>						blocks;
+
+		public:
+			NOT_COPYABLE(PushOnlyAllocator);
+
+			PushOnlyAllocator(vint _blockSize = 65536)
+				:blockSize(_blockSize)
+				, allocatedSize(0)
+			{
+			}
+
+			~PushOnlyAllocator()
+			{
+				for (vint i = 0; i < allocatedSize; i++)
+				{
+					Get(i)->~T();
+				}
+				for (vint i = 0; i < blocks.Count(); i++)
+				{
+					free(blocks[i]);
+				}
+			}
+
+			T* Get(vint index)
+			{
+				if (index >= allocatedSize)
+				{
+					return 0;
+				}
+				vint row = index / blockSize;
+				vint column = index % blockSize;
+				return &blocks[row][column];
+			}
+
+			T* Create()
+			{
+				if (allocatedSize == blocks.Count()*blockSize)
+				{
+					blocks.Add((T*)malloc(sizeof(T) * blockSize));
+				}
+				vint index = allocatedSize++;
+				return new(Get(index)) T();
+			}
+		};
+
+		namespace bom_helper
+		{
+			enum class NodeType : vuint8_t
+			{
+				Node4,
+				Node16,
+				Node48,
+				Node256,
+			};
+
+			struct NodeBase
+			{
+				NodeType					type;
+				vint						count;
 			};
 
-			template<vint Index = 4>
-			struct Accessor
+			// keys are stored in order
+			template<typename THeader>
+			struct Node4 : THeader
 			{
-				static __forceinline void* Get(TreeNode* root, vuint8_t index)
+				static const vint			Capacity = 4;
+				vuint8_t					keys[4];
+				void*						values[4];
+			};
+
+			// keys are stored in order
+			template<typename THeader>
+			struct Node16 : THeader
+			{
+				static const vint			Capacity = 16;
+				vuint8_t					keys[16];
+				void*						values[16];
+			};
+
+			// indices[key] is 0 for absent keys, otherwise it is the position of the value plus 1
+			template<typename THeader>
+			struct Node48 : THeader
+			{
+				static const vint			Capacity = 48;
+				vuint8_t					indices[256];
+				void*						values[48];
+			};
+
+			template<typename THeader>
+			struct Node256 : THeader
+			{
+				static const vint			Capacity = 256;
+				void*						values[256];
+			};
+
+			/// <summary>Allocates nodes for <see cref="ByteObjectMap`1"/> or <see cref="IntegerObjectMap`2"/>. Nodes replaced by larger nodes are recycled for other maps sharing the same allocator.</summary>
+			/// <typeparam name="THeader">The common header of all nodes.</typeparam>
+			template<typename THeader>
+			class NodeAllocator : public Object
+			{
+			protected:
+				PushOnlyAllocator<Node4<THeader>>		node4s{ 1024 };
+				PushOnlyAllocator<Node16<THeader>>		node16s{ 256 };
+				PushOnlyAllocator<Node48<THeader>>		node48s{ 64 };
+				PushOnlyAllocator<Node256<THeader>>		node256s{ 32 };
+				List<THeader*>							freeNodes[4];
+
+				template<typename TNode>
+				TNode* CreateInternal(NodeType type, PushOnlyAllocator<TNode>& allocator)
 				{
-					if (!root)
+					auto& nodes = freeNodes[(vint)type];
+					TNode* node = nullptr;
+					if (nodes.Count() > 0)
 					{
-						return nullptr;
+						node = static_cast<TNode*>(nodes[nodes.Count() - 1]);
+						nodes.RemoveAt(nodes.Count() - 1);
+					}
+					else
+					{
+						node = allocator.Create();
 					}
-					vint fragmentIndex = (index >> (2 * (Index - 1))) % 4;
-					TreeNode* fragmentRoot = root->nodes[fragmentIndex];
-					return fragmentRoot ? Accessor<Index - 1>::Get(fragmentRoot, index) : 0;
+					node->type = type;
+					node->count = 0;
+					return node;
+				}
+
+			public:
+				NOT_COPYABLE(NodeAllocator);
+				NodeAllocator() = default;
+
+				Node4<THeader>* CreateNode4() { return CreateInternal(NodeType::Node4, node4s); }
+				Node16<THeader>* CreateNode16() { return CreateInternal(NodeType::Node16, node16s); }
+				Node48<THeader>* CreateNode48() { return CreateInternal(NodeType::Node48, node48s); }
+				Node256<THeader>* CreateNode256() { return CreateInternal(NodeType::Node256, node256s); }
+
+				void Release(THeader* node)
+				{
+					freeNodes[(vint)node->type].Add(node);
 				}
+			};
 
-				static __forceinline void Set(TreeNode*& root, vuint8_t index, void* value, PushOnlyAllocator<TreeNode>& allocator)
+			template<typename TNode>
+			__forceinline vint FindKey(TNode* node, vuint8_t index)
+			{
+				for (vint i = 0; i < node->count; i++)
 				{
-					if (!root)
+					if (node->keys[i] == index)
 					{
-						root = allocator.Create();
-						memset(root->nodes, 0, sizeof(root->nodes));
+						return i;
 					}
-					vint fragmentIndex = (index >> (2 * (Index - 1))) % 4;
-					TreeNode*& fragmentRoot = root->nodes[fragmentIndex];
-					Accessor<Index - 1>::Set(fragmentRoot, index, value, allocator);
 				}
-			};
+				return -1;
+			}
+
+			template<typename TNode>
+			bool SetInKeys(TNode* node, vuint8_t index, void* value)
+			{
+				vint position = 0;
+				while (position < node->count && node->keys[position] < index)
+				{
+					position++;
+				}
+				if (position < node->count && node->keys[position] == index)
+				{
+					node->values[position] = value;
+					return true;
+				}
+				if (!value)
+				{
+					return true;
+				}
+				if (node->count < TNode::Capacity)
+				{
+					memmove(node->keys + position + 1, node->keys + position, sizeof(*node->keys) * (node->count - position));
+					memmove(node->values + position + 1, node->values + position, sizeof(*node->values) * (node->count - position));
+					node->keys[position] = index;
+					node->values[position] = value;
+					node->count++;
+					return true;
+				}
+				return false;
+			}
+
+			template<typename THeader>
+			void CopyHeader(THeader* to, THeader* from)
+			{
+				auto type = to->type;
+				*to = *from;
+				to->type = type;
+			}
+
+			// the position of a child is valid until the node is changed
+			template<typename THeader>
+			__forceinline void** GetChildSlot(THeader* node, vuint8_t index)
+			{
+				switch (node->type)
+				{
+				case NodeType::Node4:
+					{
+						auto typed = static_cast<Node4<THeader>*>(node);
+						vint position = FindKey(typed, index);
+						return position == -1 ? nullptr : &typed->values[position];
+					}
+				case NodeType::Node16:
+					{
+						auto typed = static_cast<Node16<THeader>*>(node);
+						vint position = FindKey(typed, index);
+						return position == -1 ? nullptr : &typed->values[position];
+					}
+				case NodeType::Node48:
+					{
+						auto typed = static_cast<Node48<THeader>*>(node);
+						vint position = typed->indices[index];
+						return position ? &typed->values[position - 1] : nullptr;
+					}
+				default:
+					{
+						auto typed = static_cast<Node256<THeader>*>(node);
+						return typed->values[index] ? &typed->values[index] : nullptr;
+					}
+				}
+			}
+
+			template<typename THeader>
+			__forceinline void* GetChild(THeader* node, vuint8_t index)
+			{
+				auto slot = GetChildSlot(node, index);
+				return slot ? *slot : nullptr;
+			}
+
+			// the node is replaced by a larger one when it is full, setting an absent child to null does nothing
+			template<typename THeader>
+			void SetChild(THeader*& root, vuint8_t index, void* value, NodeAllocator<THeader>& allocator)
+			{
+				switch (root->type)
+				{
+				case NodeType::Node4:
+					{
+						auto node = static_cast<Node4<THeader>*>(root);
+						if (SetInKeys(node, index, value)) return;
+
+						auto newNode = allocator.CreateNode16();
+						CopyHeader<THeader>(newNode, node);
+						memcpy(newNode->keys, node->keys, sizeof(node->keys));
+						memcpy(newNode->values, node->values, sizeof(node->values));
+						allocator.Release(node);
+						root = newNode;
+						SetInKeys(newNode, index, value);
+					}
+					break;
+				case NodeType::Node16:
+					{
+						auto node = static_cast<Node16<THeader>*>(root);
+						if (SetInKeys(node, index, value)) return;
+
+						auto newNode = allocator.CreateNode48();
+						CopyHeader<THeader>(newNode, node);
+						memset(newNode->indices, 0, sizeof(newNode->indices));
+						for (vint i = 0; i < node->count; i++)
+						{
+							newNode->indices[node->keys[i]] = (vuint8_t)(i + 1);
+							newNode->values[i] = node->values[i];
+						}
+						allocator.Release(node);
+						root = newNode;
+						SetChild(root, index, value, allocator);
+					}
+					break;
+				case NodeType::Node48:
+					{
+						auto node = static_cast<Node48<THeader>*>(root);
+						vint position = node->indices[index];
+						if (position)
+						{
+							node->values[position - 1] = value;
+							return;
+						}
+						if (!value) return;
+
+						if (node->count < Node48<THeader>::Capacity)
+						{
+							node->values[node->count] = value;
+							node->indices[index] = (vuint8_t)(++node->count);
+							return;
+						}
+
+						auto newNode = allocator.CreateNode256();
+						CopyHeader<THeader>(newNode, node);
+						memset(newNode->values, 0, sizeof(newNode->values));
+						for (vint i = 0; i < 256; i++)
+						{
+							if (node->indices[i])
+							{
+								newNode->values[i] = node->values[node->indices[i] - 1];
+							}
+						}
+						newNode->values[index] = value;
+						newNode->count++;
+						allocator.Release(node);
+						root = newNode;
+					}
+					break;
+				default:
+					{
+						auto node = static_cast<Node256<THeader>*>(root);
+						auto& slot = node->values[index];
+						if (!slot && value) node->count++;
+						if (slot && !value) node->count--;
+						slot = value;
+					}
+				}
+			}
+
+			template<typename TNode>
+			bool RemoveFromKeys(TNode* node, vuint8_t index)
+			{
+				vint position = FindKey(node, index);
+				if (position == -1) return false;
+				memmove(node->keys + position, node->keys + position + 1, sizeof(*node->keys) * (node->count - position - 1));
+				memmove(node->values + position, node->values + position + 1, sizeof(*node->values) * (node->count - position - 1));
+				node->count--;
+				return true;
+			}
 
-			template<>
-			struct Accessor<0>
+			// the node is not replaced by a smaller one
+			template<typename THeader>
+			bool RemoveChild(THeader* root, vuint8_t index)
 			{
-				static __forceinline void* Get(TreeNode* root, vuint8_t index)
+				switch (root->type)
 				{
-					return (void*)root;
+				case NodeType::Node4:
+					return RemoveFromKeys(static_cast<Node4<THeader>*>(root), index);
+				case NodeType::Node16:
+					return RemoveFromKeys(static_cast<Node16<THeader>*>(root), index);
+				case NodeType::Node48:
+					{
+						auto node = static_cast<Node48<THeader>*>(root);
+						vint position = node->indices[index];
+						if (!position) return false;
+
+						// move the last value to the removed position
+						vint last = node->count;
+						if (position != last)
+						{
+							for (vint i = 0; i < 256; i++)
+							{
+								if (node->indices[i] == last)
+								{
+									node->indices[i] = (vuint8_t)position;
+									break;
+								}
+							}
+							node->values[position - 1] = node->values[last - 1];
+						}
+						node->indices[index] = 0;
+						node->count--;
+						return true;
+					}
+				default:
+					{
+						auto node = static_cast<Node256<THeader>*>(root);
+						if (!node->values[index]) return false;
+						node->values[index] = nullptr;
+						node->count--;
+						return true;
+					}
 				}
+			}
 
-				static __forceinline void Set(TreeNode*& root, vuint8_t index, void* value, PushOnlyAllocator<TreeNode>& allocator)
+			// visit non-null children whose index is in [first, last], in the order of indices
+			template<typename THeader, typename TCallback>
+			void ForEachChild(THeader* root, vint first, vint last, TCallback&& callback)
+			{
+				switch (root->type)
 				{
-					((void*&)root) = value;
+				case NodeType::Node4:
+				case NodeType::Node16:
+					{
+						vint count = root->count;
+						vuint8_t* keys = root->type == NodeType::Node4 ? static_cast<Node4<THeader>*>(root)->keys : static_cast<Node16<THeader>*>(root)->keys;
+						void** values = root->type == NodeType::Node4 ? static_cast<Node4<THeader>*>(root)->values : static_cast<Node16<THeader>*>(root)->values;
+						for (vint i = 0; i < count; i++)
+						{
+							if (keys[i] >= first && keys[i] <= last && values[i])
+							{
+								callback(keys[i], values[i]);
+							}
+						}
+					}
+					break;
+				case NodeType::Node48:
+					{
+						auto node = static_cast<Node48<THeader>*>(root);
+						for (vint i = first; i <= last; i++)
+						{
+							if (node->indices[i] && node->values[node->indices[i] - 1])
+							{
+								callback((vuint8_t)i, node->values[node->indices[i] - 1]);
+							}
+						}
+					}
+					break;
+				default:
+					{
+						auto node = static_cast<Node256<THeader>*>(root);
+						for (vint i = first; i <= last; i++)
+						{
+							if (node->values[i])
+							{
+								callback((vuint8_t)i, node->values[i]);
+							}
+						}
+					}
 				}
+			}
+
+			// a node in IntegerObjectMap dispatches on the byte at shift, all keys under it share the bits above that byte
+			struct RadixNodeBase : NodeBase
+			{
+				vint						shift;
+				vuint64_t					prefix;
 			};
 		}
 
+		/// <summary>
+		/// A map from bytes to pointers, which is an adaptive radix node that grows from 4 to 16, 48 and 256 entries.
+		/// A lookup takes one load from the node, or two loads when there are 17 to 48 entries.
+		/// </summary>
+		/// <typeparam name="T">The type of objects that values point to.</typeparam>
+		/// <remarks>
+		/// Nodes are owned by the <see cref="Allocator"/>, which must outlive all maps using it.
+		/// Setting a key to null makes <see cref="Get"/> return null for it.
+		/// </remarks>
 		template<typename T>
 		class ByteObjectMap : public Object
 		{
 		public:
-			typedef PushOnlyAllocator<bom_helper::TreeNode>			Allocator;
+			typedef bom_helper::NodeAllocator<bom_helper::NodeBase>		Allocator;
 		protected:
-			bom_helper::TreeNode*			root = nullptr;
+			bom_helper::NodeBase*			root = nullptr;
 
 		public:
 			NOT_COPYABLE(ByteObjectMap);
@@ -980,12 +2414,306 @@ Special Containers
 
 			T* Get(vuint8_t index)
 			{
-				return (T*)bom_helper::Accessor<>::Get(root, index);
+				return root ? (T*)bom_helper::GetChild(root, index) : nullptr;
 			}
 
 			void Set(vuint8_t index, T* value, Allocator& allocator)
 			{
-				bom_helper::Accessor<>::Set(root, index, value, allocator);
+				if (!root)
+				{
+					if (!value) return;
+					root = allocator.CreateNode4();
+				}
+				bom_helper::SetChild(root, index, value, allocator);
+			}
+		};
+
+		/// <summary>
+		/// A map from integers to pointers, which is an adaptive radix tree with path compression.
+		/// A lookup visits at most one node for each byte of the key, and a chain of nodes with only one child is skipped.
+		/// Keys are visited in order by <see cref="ForEach"/> and <see cref="ForEachInRange"/>.
+		/// </summary>
+		/// <typeparam name="TKey">The type of keys, it must be an integer type.</typeparam>
+		/// <typeparam name="T">The type of objects that values point to.</typeparam>
+		/// <remarks>
+		/// Nodes are owned by the <see cref="Allocator"/>, which must outlive all maps using it.
+		/// Call <see cref="Clear"/> to return nodes to the allocator.
+		/// </remarks>
+		template<typename TKey, typename T>
+		class IntegerObjectMap : public Object
+		{
+			static_assert(std::is_integral_v<TKey> && sizeof(TKey) <= sizeof(vuint64_t), "vl::collections::IntegerObjectMap<TKey, T> requires an integer key.");
+			using Node = bom_helper::RadixNodeBase;
+		public:
+			typedef bom_helper::NodeAllocator<bom_helper::RadixNodeBase>	Allocator;
+		protected:
+			static constexpr vint			KeyBits = sizeof(TKey) * 8;
+
+			Node*							root = nullptr;
+			vint							count = 0;
+
+			// signed keys flip the sign bit, so that unsigned order of encoded keys is the order of keys
+			static vuint64_t Encode(TKey key)
+			{
+				vuint64_t encoded = (vuint64_t)(std::make_unsigned_t<TKey>)key;
+				if constexpr (std::is_signed_v<TKey>)
+				{
+					encoded ^= (vuint64_t)1 << (KeyBits - 1);
+				}
+				return encoded;
+			}
+
+			static TKey Decode(vuint64_t encoded)
+			{
+				if constexpr (std::is_signed_v<TKey>)
+				{
+					encoded ^= (vuint64_t)1 << (KeyBits - 1);
+				}
+				return (TKey)(std::make_unsigned_t<TKey>)encoded;
+			}
+
+			// bits above the byte at shift
+			static vuint64_t HighMask(vint shift)
+			{
+				return shift + 8 >= 64 ? 0 : ~(vuint64_t)0 << (shift + 8);
+			}
+
+			static Node* CreateLeaf(vuint64_t key, T* value, Allocator& allocator)
+			{
+				Node* leaf = allocator.CreateNode4();
+				leaf->shift = 0;
+				leaf->prefix = key & HighMask(0);
+				bom_helper::SetChild(leaf, (vuint8_t)key, value, allocator);
+				return leaf;
+			}
+
+			bool SetInternal(Node*& node, vuint64_t key, T* value, Allocator& allocator)
+			{
+				if (!node)
+				{
+					node = CreateLeaf(key, value, allocator);
+					return true;
+				}
+
+				vuint64_t mask = HighMask(node->shift);
+				if ((key & mask) != node->prefix)
+				{
+					// split at the highest byte that the key differs from the prefix
+					vuint64_t diff = (key ^ node->prefix) & mask;
+					vint shift = KeyBits - 8;
+					while (((diff >> shift) & 0xFF) == 0)
+					{
+						shift -= 8;
+					}
+
+					Node* parent = allocator.CreateNode4();
+					parent->shift = shift;
+					parent->prefix = key & HighMask(shift);
+					bom_helper::SetChild(parent, (vuint8_t)(node->prefix >> shift), (void*)node, allocator);
+					bom_helper::SetChild(parent, (vuint8_t)(key >> shift), (void*)CreateLeaf(key, value, allocator), allocator);
+					node = parent;
+					return true;
+				}
+
+				vuint8_t index = (vuint8_t)(key >> node->shift);
+				if (node->shift == 0)
+				{
+					bool added = bom_helper::GetChild(node, index) == nullptr;
+					bom_helper::SetChild(node, index, (void*)value, allocator);
+					return added;
+				}
+
+				if (auto slot = bom_helper::GetChildSlot(node, index))
+				{
+					Node* child = (Node*)*slot;
+					bool added = SetInternal(child, key, value, allocator);
+					*slot = child;
+					return added;
+				}
+				bom_helper::SetChild(node, index, (void*)CreateLeaf(key, value, allocator), allocator);
+				return true;
+			}
+
+			bool RemoveInternal(Node*& node, vuint64_t key, Allocator& allocator)
+			{
+				if (!node || (key & HighMask(node->shift)) != node->prefix)
+				{
+					return false;
+				}
+
+				vuint8_t index = (vuint8_t)(key >> node->shift);
+				if (node->shift == 0)
+				{
+					if (!bom_helper::RemoveChild(node, index)) return false;
+				}
+				else
+				{
+					auto slot = bom_helper::GetChildSlot(node, index);
+					if (!slot) return false;
+					Node* child = (Node*)*slot;
+					if (!RemoveInternal(child, key, allocator)) return false;
+					if (child)
+					{
+						*slot = child;
+					}
+					else
+					{
+						bom_helper::RemoveChild(node, index);
+					}
+				}
+
+				if (node->count == 0)
+				{
+					allocator.Release(node);
+					node = nullptr;
+				}
+				else if (node->count == 1 && node->shift > 0)
+				{
+					// the only child already stores the full prefix
+					Node* child = nullptr;
+					bom_helper::ForEachChild(node, 0, 255, [&](vuint8_t, void* value) { child = (Node*)value; });
+					allocator.Release(node);
+					node = child;
+				}
+				return true;
+			}
+
+			void ClearInternal(Node* node, Allocator& allocator)
+			{
+				if (node->shift > 0)
+				{
+					bom_helper::ForEachChild(node, 0, 255, [&](vuint8_t, void* child) { ClearInternal((Node*)child, allocator); });
+				}
+				allocator.Release(node);
+			}
+
+			template<typename TCallback>
+			static void ForEachInternal(Node* node, vuint64_t min, vuint64_t max, TCallback& callback)
+			{
+				vuint64_t nodeMin = node->prefix;
+				vuint64_t nodeMax = node->prefix | ~HighMask(node->shift);
+				if (nodeMax < min || nodeMin > max)
+				{
+					return;
+				}
+
+				vint shift = node->shift;
+				vint first = min <= nodeMin ? 0 : (vint)((min >> shift) & 0xFF);
+				vint last = max >= nodeMax ? 255 : (vint)((max >> shift) & 0xFF);
+				bom_helper::ForEachChild(node, first, last, [&](vuint8_t index, void* child)
+				{
+					if (shift == 0)
+					{
+						callback(Decode(nodeMin | index), (T*)child);
+					}
+					else
+					{
+						ForEachInternal((Node*)child, min, max, callback);
+					}
+				});
+			}
+
+		public:
+			NOT_COPYABLE(IntegerObjectMap);
+			IntegerObjectMap() = default;
+			~IntegerObjectMap() = default;
+
+			/// <summary>Get the number of keys.</summary>
+			/// <returns>The number of keys.</returns>
+			vint Count()const
+			{
+				return count;
+			}
+
+			/// <summary>Get the value of a key.</summary>
+			/// <returns>The value, or null if the key does not exist.</returns>
+			/// <param name="key">The key.</param>
+			T* Get(TKey key)const
+			{
+				vuint64_t encoded = Encode(key);
+				Node* node = root;
+				while (node)
+				{
+					if ((encoded & HighMask(node->shift)) != node->prefix)
+					{
+						return nullptr;
+					}
+					void* child = bom_helper::GetChild(node, (vuint8_t)(encoded >> node->shift));
+					if (node->shift == 0)
+					{
+						return (T*)child;
+					}
+					node = (Node*)child;
+				}
+				return nullptr;
+			}
+
+			/// <summary>Set the value of a key. Setting a key to null removes it.</summary>
+			/// <param name="key">The key.</param>
+			/// <param name="value">The value.</param>
+			/// <param name="allocator">The allocator for nodes.</param>
+			void Set(TKey key, T* value, Allocator& allocator)
+			{
+				if (!value)
+				{
+					Remove(key, allocator);
+				}
+				else if (SetInternal(root, Encode(key), value, allocator))
+				{
+					count++;
+				}
+			}
+
+			/// <summary>Remove a key.</summary>
+			/// <returns>Returns true if the key is removed.</returns>
+			/// <param name="key">The key.</param>
+			/// <param name="allocator">The allocator for nodes.</param>
+			bool Remove(TKey key, Allocator& allocator)
+			{
+				if (RemoveInternal(root, Encode(key), allocator))
+				{
+					count--;
+					return true;
+				}
+				return false;
+			}
+
+			/// <summary>Remove all keys and return all nodes to the allocator.</summary>
+			/// <param name="allocator">The allocator for nodes.</param>
+			void Clear(Allocator& allocator)
+			{
+				if (root)
+				{
+					ClearInternal(root, allocator);
+					root = nullptr;
+				}
+				count = 0;
+			}
+
+			/// <summary>Call a callback on all keys and values in the order of keys.</summary>
+			/// <typeparam name="TCallback">The type of the callback, which accepts a key and a value.</typeparam>
+			/// <param name="callback">The callback.</param>
+			template<typename TCallback>
+			void ForEach(TCallback&& callback)const
+			{
+				if (root)
+				{
+					ForEachInternal(root, 0, ~(vuint64_t)0, callback);
+				}
+			}
+
+			/// <summary>Call a callback on all keys in [min, max] and their values in the order of keys.</summary>
+			/// <typeparam name="TCallback">The type of the callback, which accepts a key and a value.</typeparam>
+			/// <param name="min">The smallest key to visit.</param>
+			/// <param name="max">The largest key to visit.</param>
+			/// <param name="callback">The callback.</param>
+			template<typename TCallback>
+			void ForEachInRange(TKey min, TKey max, TCallback&& callback)const
+			{
+				if (root && min <= max)
+				{
+					ForEachInternal(root, Encode(min), Encode(max), callback);
+				}
 			}
 		};
 
@@ -995,22 +2723,36 @@ Random Access
 
 		namespace randomaccess_internal
 		{
-			template<typename T>
-			struct RandomAccessable<Array<T>>
+			template<typename T, typename TAllocator>
+			struct RandomAccessable<Array<T, TAllocator>>
 			{
 				static const bool							CanRead = true;
 				static const bool							CanResize = true;
 			};
 
 			template<typename T>
-			struct RandomAccessable<List<T>>
+			struct RandomAccessable<ArraySpan<T>>
 			{
 				static const bool							CanRead = true;
 				static const bool							CanResize = false;
 			};
 
-			template<typename T>
-			struct RandomAccessable<SortedList<T>>
+			template<typename T, typename TAllocator>
+			struct RandomAccessable<List<T, TAllocator>>
+			{
+				static const bool							CanRead = true;
+				static const bool							CanResize = false;
+			};
+
+			template<typename T, vint N, typename TAllocator>
+			struct RandomAccessable<SmallList<T, N, TAllocator>>
+			{
+				static const bool							CanRead = true;
+				static const bool							CanResize = false;
+			};
+
+			template<typename T, typename TAllocator>
+			struct RandomAccessable<SortedList<T, TAllocator>>
 			{
 				static const bool							CanRead = true;
 				static const bool							CanResize = false;
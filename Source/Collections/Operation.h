@@ -70,142 +70,6 @@ namespace vl
 	namespace collections
 	{
 
-/***********************************************************************
-Quick Sort
-***********************************************************************/
-
-		/// <summary>Quick sort.</summary>
-		/// <typeparam name="T">Type of elements.</typeparam>
-		/// <typeparam name="F">Type of the comparer.</typeparam>
-		/// <param name="items">Pointer to element array to sort.</param>
-		/// <param name="length">The number of elements to sort.</param>
-		/// <param name="orderer">
-		/// The comparar for two elements returning std::(strong|weak|partial)_ordering.
-		/// </param>
-		template<typename T, typename F>
-		void SortLambda(T* items, vint length, F&& orderer)
-		{
-			while (true)
-			{
-				if (length == 0) return;
-				vint pivot = 0;
-				vint left = 0;
-				vint right = 0;
-
-				{
-					bool flag = false;
-					while (left + right + 1 != length)
-					{
-						vint& mine = (flag ? left : right);
-						vint& theirs = (flag ? right : left);
-						vint candidate = (flag ? left : length - right - 1);
-						vint factor = (flag ? -1 : 1);
-
-						auto ordering = orderer(items[pivot], items[candidate]);
-						if constexpr (std::is_same_v<decltype(ordering), std::partial_ordering>)
-						{
-							CHECK_ERROR(ordering != std::partial_ordering::unordered, L"vl::collections::SortLambda(T*, vint, F&&)#This function could not apply on elements in partial ordering.");
-						}
-
-						if ((factor == 1 && ordering <= 0) || (factor == -1 && ordering >= 0))
-						{
-							mine++;
-						}
-						else
-						{
-							theirs++;
-							T temp = items[pivot];
-							items[pivot] = items[candidate];
-							items[candidate] = temp;
-							pivot = candidate;
-							flag = !flag;
-						}
-					}
-				}
-
-				{
-					vint reading = left - 1;
-					vint writing = reading;
-					while (reading >= 0)
-					{
-						auto ordering = orderer(items[pivot], items[reading]);
-						if constexpr (std::is_same_v<decltype(ordering), std::partial_ordering>)
-						{
-							CHECK_ERROR(ordering != std::partial_ordering::unordered, L"vl::collections::SortLambda(T*, vint, F&&)#This function could not apply on elements in partial ordering.");
-						}
-
-						if (ordering == 0)
-						{
-							if (reading != writing)
-							{
-								T temp = items[reading];
-								items[reading] = items[writing];
-								items[writing] = temp;
-							}
-							writing--;
-						}
-						reading--;
-					}
-					left = writing + 1;
-				}
-
-				{
-					vint reading = length - right;
-					vint writing = reading;
-					while (reading < length)
-					{
-						if (orderer(items[pivot], items[reading]) == 0)
-						{
-							if (reading != writing)
-							{
-								T temp = items[reading];
-								items[reading] = items[writing];
-								items[writing] = temp;
-							}
-							writing++;
-						}
-						reading++;
-					}
-					right = length - writing;
-				}
-
-				if (left < right)
-				{
-					SortLambda(items, left, orderer);
-					items += length - right;
-					length = right;
-				}
-				else
-				{
-					SortLambda(items + length - right, right, orderer);
-					length = left;
-				}
-			}
-		}
-
-		/// <summary>Quick sort.</summary>
-		/// <typeparam name="T">Type of elements.</typeparam>
-		/// <param name="items">Pointer to element array to sort.</param>
-		/// <param name="length">The number of elements to sort.</param>
-		/// <param name="orderer">
-		/// The comparar for two elements returning std::(strong|weak|partial)_ordering.
-		/// </param>
-		template<typename T, typename F>
-		void Sort(T* items, vint length, F&& orderer)
-		{
-			SortLambda(items, length, orderer);
-		}
-
-		/// <summary>Quick sort.</summary>
-		/// <typeparam name="T">Type of elements.</typeparam>
-		/// <param name="items">Pointer to element array to sort.</param>
-		/// <param name="length">The number of elements to sort.</param>
-		template<typename T>
-		void Sort(T* items, vint length)
-		{
-			SortLambda(items, length, [](const T& a, const T& b) { return a <=> b; });
-		}
-
 /***********************************************************************
 LazyList
 ***********************************************************************/
@@ -26,6 +26,8 @@ Concat
 			vint							index;
 			bool							turned;
 		public:
+			POOLED_ALLOCATION(ConcatEnumerator)
+
 			ConcatEnumerator(IEnumerator<T>* _enumerator1, IEnumerator<T>* _enumerator2, vint _index=-1, bool _turned=false)
 				:enumerator1(_enumerator1)
 				,enumerator2(_enumerator2)
@@ -51,10 +51,21 @@ Copy Functions for Containers
 					{
 						ds.Clear();
 					}
-					vint copyCount=RandomAccess<Ss>::GetCount(ss);
-					for(vint i=0;i<copyCount;i++)
+					if constexpr (requires{ ds.AddRange(ss); })
+					{
+						ds.AddRange(ss);
+					}
+					else if constexpr (requires{ ds.AddRange(ss.items, ss.count); })
 					{
-						RandomAccess<Ds>::AppendValue(ds, RandomAccess<Ss>::GetValue(ss, i));
+						ds.AddRange(ss.items, ss.count);
+					}
+					else
+					{
+						vint copyCount=RandomAccess<Ss>::GetCount(ss);
+						for(vint i=0;i<copyCount;i++)
+						{
+							RandomAccess<Ds>::AppendValue(ds, RandomAccess<Ss>::GetValue(ss, i));
+						}
 					}
 				}
 			};
@@ -94,10 +105,17 @@ Copy Functions for Containers
 					{
 						ds.Clear();
 					}
-					auto enumerator = Ptr(ss.CreateEnumerator());
-					while (enumerator->Next())
+					if constexpr (requires{ ds.AddRange(ss); })
+					{
+						ds.AddRange(ss);
+					}
+					else
 					{
-						RandomAccess<Ds>::AppendValue(ds, enumerator->Current());
+						auto enumerator = Ptr(ss.CreateEnumerator());
+						while (enumerator->Next())
+						{
+							RandomAccess<Ds>::AppendValue(ds, enumerator->Current());
+						}
 					}
 				}
 			};
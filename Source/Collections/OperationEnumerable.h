@@ -63,6 +63,8 @@ RangeEnumerator
 			T			count;
 			T			current;
 		public:
+			POOLED_ALLOCATION(RangeEnumerator)
+
 			RangeEnumerator(T _start, T _count, T _current)
 				:start(_start)
 				,count(_count)
@@ -128,6 +130,8 @@ ContainerEnumerator
 			vint							index;
 
 		public:
+			POOLED_ALLOCATION(ContainerEnumerator)
+
 			ContainerEnumerator(Ptr<TContainer> _container, vint _index=-1)
 			{
 				container=_container;
@@ -211,7 +215,8 @@ CompareEnumerable
 		template<typename T>
 		struct SortedListOperations
 		{
-			static bool Contains(const SortedList<T>& items, const T& item)
+			template<typename TContainer>
+			static bool Contains(const TContainer& items, const T& item)
 			{
 				return items.Contains(item);
 			}
@@ -220,7 +225,8 @@ CompareEnumerable
 		template<typename T>
 		struct SortedListOperations<Ptr<T>>
 		{
-			static bool Contains(const SortedList<Ptr<T>>& items, const Ptr<T>& item)
+			template<typename TContainer>
+			static bool Contains(const TContainer& items, const Ptr<T>& item)
 			{
 				return items.Contains(item.Obj());
 			}
@@ -25,6 +25,8 @@ Pairwise
 			IEnumerator<T>*					enumerator2;
 			Nullable<Pair<S, T>>			current;
 		public:
+			POOLED_ALLOCATION(PairwiseEnumerator)
+
 			PairwiseEnumerator(IEnumerator<S>* _enumerator1, IEnumerator<T>* _enumerator2, Nullable<Pair<S, T>> _current = {})
 				:enumerator1(_enumerator1)
 				,enumerator2(_enumerator2)
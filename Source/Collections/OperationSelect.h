@@ -26,6 +26,8 @@ Select
 			Func<K(T)>			selector;
 			Nullable<K>			current;
 		public:
+			POOLED_ALLOCATION(SelectEnumerator)
+
 			SelectEnumerator(IEnumerator<T>* _enumerator, const Func<K(T)>& _selector, Nullable<K> _current = {})
 				:enumerator(_enumerator)
 				,selector(_selector)
@@ -9,6 +9,7 @@ Licensed under https://github.com/vczh-libraries/License
 #include "OperationEnumerable.h"
 #include "OperationCopyFrom.h"
 #include "List.h"
+#include "HashSet.h"
 
 namespace vl
 {
@@ -26,6 +27,8 @@ Take
 			IEnumerator<T>*			enumerator;
 			vint					count;
 		public:
+			POOLED_ALLOCATION(TakeEnumerator)
+
 			TakeEnumerator(IEnumerator<T>* _enumerator, vint _count)
 				:enumerator(_enumerator)
 				,count(_count)
@@ -81,6 +84,8 @@ Skip
 			vint					count;
 			bool					skipped;
 		public:
+			POOLED_ALLOCATION(SkipEnumerator)
+
 			SkipEnumerator(IEnumerator<T>* _enumerator, vint _count, bool _skipped=false)
 				:enumerator(_enumerator)
 				,count(_count)
@@ -149,6 +154,8 @@ Repeat
 			vint					index;
 			vint					repeatedCount;
 		public:
+			POOLED_ALLOCATION(RepeatEnumerator)
+
 			RepeatEnumerator(IEnumerator<T>* _enumerator, vint _count, vint _index=-1, vint _repeatedCount=0)
 				:enumerator(_enumerator)
 				,count(_count)
@@ -214,10 +221,12 @@ Distinct
 		{
 		protected:
 			IEnumerator<T>*		enumerator;
-			SortedList<T>		distinct;
+			MembershipSet<T>	distinct;
 			Nullable<T>			lastValue;
 
 		public:
+			POOLED_ALLOCATION(DistinctEnumerator)
+
 			DistinctEnumerator(IEnumerator<T>* _enumerator)
 				:enumerator(_enumerator)
 			{
@@ -283,6 +292,8 @@ Reverse
 			List<T>						cache;
 			vint						index;
 		public:
+			POOLED_ALLOCATION(ReverseEnumerator)
+
 			ReverseEnumerator(const IEnumerable<T>& enumerable)
 				:index(-1)
 			{
@@ -347,6 +358,8 @@ FromIterator
 				I				current;
 
 			public:
+				POOLED_ALLOCATION(Enumerator)
+
 				Enumerator(I _begin, I _end, I _current)
 					:begin(_begin)
 					,end(_end)
@@ -24,10 +24,12 @@ Intersect/Except
 		{
 		protected:
 			IEnumerator<T>*				enumerator;
-			SortedList<T>				reference;
+			MembershipSet<T>			reference;
 			vint						index;
 
 		public:
+			POOLED_ALLOCATION(IntersectExceptEnumerator)
+
 			IntersectExceptEnumerator(IEnumerator<T>* _enumerator, const IEnumerable<T>& _reference)
 				:enumerator(_enumerator)
 				,index(-1)
@@ -25,6 +25,8 @@ Where
 			vint					index;
 
 		public:
+			POOLED_ALLOCATION(WhereEnumerator)
+
 			WhereEnumerator(IEnumerator<T>* _enumerator, const Func<bool(T)>& _selector, vint _index=-1)
 				:enumerator(_enumerator)
 				,selector(_selector)
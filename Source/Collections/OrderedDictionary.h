@@ -0,0 +1,354 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_ORDEREDDICTIONARY
+#define VCZH_COLLECTIONS_ORDEREDDICTIONARY
+
+#include "BTree.h"
+#include "../Primitives/Nullable.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		/// <summary>
+		/// OrderedDictionary: one to one map container using a B+tree.
+		/// Keys are sorted, adding and removing keys take logarithmic time regardless of the number of keys.
+		/// </summary>
+		/// <typeparam name="KT">Type of keys.</typeparam>
+		/// <typeparam name="VT">Type of values.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for tree nodes, see <see cref="DefaultAllocator"/>.</typeparam>
+		/// <remarks>
+		/// Unlike <see cref="Dictionary`3"/>, keys and values could not be accessed by positions.
+		/// Use <see cref="First"/>, <see cref="LowerBound"/> or <see cref="UpperBound"/> to get a cursor and iterate entries in order.
+		/// Representative values of keys (see <see cref="KeyType`1"/>) are copied into internal nodes, so they must be copyable.
+		/// </remarks>
+		template<typename KT, typename VT, typename TAllocator = DefaultAllocator>
+		class OrderedDictionary : public EnumerableBase<Pair<const KT&, const VT&>>
+		{
+			using KK = typename KeyType<KT>::Type;
+			using KVPair = Pair<const KT&, const VT&>;
+			using Tree = btree_internal::BTree<KT, VT, TAllocator>;
+		public:
+			/// <summary>A position of an entry, it becomes invalid after the dictionary is modified.</summary>
+			typedef typename Tree::Cursor			Cursor;
+		protected:
+			class Enumerator : public Object, public virtual IEnumerator<KVPair>
+			{
+			private:
+				const OrderedDictionary<KT, VT, TAllocator>*	container;
+				Cursor											cursor;
+				vint											index = -1;
+				Nullable<KVPair>								current;
+
+			public:
+				POOLED_ALLOCATION(Enumerator)
+
+				Enumerator(const OrderedDictionary<KT, VT, TAllocator>* _container)
+					: container(_container)
+				{
+				}
+
+				IEnumerator<KVPair>* Clone()const override
+				{
+					auto enumerator = new Enumerator(container);
+					enumerator->cursor = cursor;
+					enumerator->index = index;
+					enumerator->current = current;
+					return enumerator;
+				}
+
+				const KVPair& Current()const override
+				{
+					return current.Value();
+				}
+
+				vint Index()const override
+				{
+					return index;
+				}
+
+				bool Next() override
+				{
+					if (index == -1)
+					{
+						cursor = container->First();
+					}
+					else if (cursor.IsValid())
+					{
+						cursor.Next();
+					}
+					index++;
+					if (!cursor.IsValid()) return false;
+					current = { cursor.Key(),cursor.Value() };
+					return true;
+				}
+
+				void Reset() override
+				{
+					cursor = {};
+					index = -1;
+					current.Reset();
+				}
+
+				bool Evaluated()const override
+				{
+					return true;
+				}
+			};
+
+			Tree									tree;
+		public:
+			/// <summary>Create an empty dictionary.</summary>
+			OrderedDictionary() = default;
+			~OrderedDictionary() = default;
+
+			/// <summary>Create an empty dictionary with an allocator.</summary>
+			/// <param name="allocator">The allocator for tree nodes.</param>
+			explicit OrderedDictionary(const TAllocator& allocator)
+				: tree(allocator)
+			{
+			}
+
+			OrderedDictionary(const OrderedDictionary<KT, VT, TAllocator>&) = delete;
+			OrderedDictionary(OrderedDictionary<KT, VT, TAllocator>&& _move)
+				: tree(std::move(_move.tree))
+			{
+			}
+
+			OrderedDictionary<KT, VT, TAllocator>& operator=(const OrderedDictionary<KT, VT, TAllocator>&) = delete;
+			OrderedDictionary<KT, VT, TAllocator>& operator=(OrderedDictionary<KT, VT, TAllocator>&& _move)
+			{
+				tree = std::move(_move.tree);
+				return *this;
+			}
+
+			IEnumerator<KVPair>* CreateEnumerator()const
+			{
+				return new Enumerator(this);
+			}
+
+			/// <summary>Get the number of keys.</summary>
+			/// <returns>The number of keys. It is also the number of values.</returns>
+			vint Count()const
+			{
+				return tree.Count();
+			}
+
+			/// <summary>Get the cursor of the entry with the smallest key.</summary>
+			/// <returns>The cursor, which is invalid if the dictionary is empty.</returns>
+			Cursor First()const
+			{
+				return tree.First();
+			}
+
+			/// <summary>Get the cursor of the entry with the largest key.</summary>
+			/// <returns>The cursor, which is invalid if the dictionary is empty.</returns>
+			Cursor Last()const
+			{
+				return tree.Last();
+			}
+
+			/// <summary>Get the cursor of the first entry whose key is not smaller than a specified key.</summary>
+			/// <returns>The cursor, which is invalid if all keys are smaller than the specified key.</returns>
+			/// <param name="key">The key to compare.</param>
+			Cursor LowerBound(const KK& key)const
+			{
+				return tree.LowerBound(key);
+			}
+
+			/// <summary>Get the cursor of the first entry whose key is larger than a specified key.</summary>
+			/// <returns>The cursor, which is invalid if no key is larger than the specified key.</returns>
+			/// <param name="key">The key to compare.</param>
+			Cursor UpperBound(const KK& key)const
+			{
+				return tree.UpperBound(key);
+			}
+
+			/// <summary>Get the cursor of the entry with a specified key.</summary>
+			/// <returns>The cursor, which is invalid if the key does not exist.</returns>
+			/// <param name="key">The key to find.</param>
+			Cursor Find(const KK& key)const
+			{
+				return tree.Find(key);
+			}
+
+			/// <summary>Test if a key exists.</summary>
+			/// <returns>Returns true if the key exists.</returns>
+			/// <param name="key">The key to find.</param>
+			bool Contains(const KK& key)const
+			{
+				return tree.Find(key).IsValid();
+			}
+
+			/// <summary>Get the reference to the value associated to a specified key.</summary>
+			/// <returns>The reference to the value. It will crash if the key does not exist.</returns>
+			/// <param name="key">The key to find.</param>
+			const VT& Get(const KK& key)const
+			{
+				auto cursor = tree.Find(key);
+				CHECK_ERROR(cursor.IsValid(), L"OrderedDictionary<KT, VT>::Get(const KK&)#Key does not exist.");
+				return cursor.Value();
+			}
+
+			/// <summary>Get the reference to the value associated to a specified key.</summary>
+			/// <returns>The reference to the value. It will crash if the key does not exist.</returns>
+			/// <param name="key">The key to find.</param>
+			const VT& operator[](const KK& key)const
+			{
+				return Get(key);
+			}
+
+			/// <summary>Replace the value associated to a specified key.</summary>
+			/// <returns>Returns true if the value is replaced.</returns>
+			/// <param name="key">The key to find. If the key does not exist, it will be added to the dictionary.</param>
+			/// <param name="value">The associated value to replace.</param>
+			bool Set(const KT& key, const VT& value) { tree.Insert(true, key, value); return true; }
+
+			/// <summary>Replace the value associated to a specified key.</summary>
+			/// <returns>Returns true if the value is replaced.</returns>
+			/// <param name="key">The key to find. If the key does not exist, it will be added to the dictionary.</param>
+			/// <param name="value">The associated value to replace.</param>
+			bool Set(const KT& key, VT&& value) { tree.Insert(true, key, std::move(value)); return true; }
+
+			/// <summary>Replace the value associated to a specified key.</summary>
+			/// <returns>Returns true if the value is replaced.</returns>
+			/// <param name="key">The key to find. If the key does not exist, it will be added to the dictionary.</param>
+			/// <param name="value">The associated value to replace.</param>
+			bool Set(KT&& key, const VT& value) { tree.Insert(true, std::move(key), value); return true; }
+
+			/// <summary>Replace the value associated to a specified key.</summary>
+			/// <returns>Returns true if the value is replaced.</returns>
+			/// <param name="key">The key to find. If the key does not exist, it will be added to the dictionary.</param>
+			/// <param name="value">The associated value to replace.</param>
+			bool Set(KT&& key, VT&& value) { tree.Insert(true, std::move(key), std::move(value)); return true; }
+
+			/// <summary>Add a key with an associated value.</summary>
+			/// <returns>Returns true if the pair is added. If will crash if the key exists.</returns>
+			/// <param name="value">The pair of key and value.</param>
+			bool Add(const Pair<KT, VT>& value) { return Add(value.key, value.value); }
+
+			/// <summary>Add a key with an associated value.</summary>
+			/// <returns>Returns true if the pair is added. If will crash if the key exists.</returns>
+			/// <param name="value">The pair of key and value.</param>
+			bool Add(Pair<KT, VT>&& value) { return Add(std::move(value.key), std::move(value.value)); }
+
+			/// <summary>Add a key with an associated value.</summary>
+			/// <returns>Returns true if the pair is added. If will crash if the key exists.</returns>
+			/// <param name="key">The key to add.</param>
+			/// <param name="value">The value to add.</param>
+			bool Add(const KT& key, const VT& value)
+			{
+				bool added = tree.Insert(false, key, value);
+				CHECK_ERROR(added, L"OrderedDictionary<KT, VT>::Add(const KT&, const VT&)#Key already exists.");
+				return true;
+			}
+
+			/// <summary>Add a key with an associated value.</summary>
+			/// <returns>Returns true if the pair is added. If will crash if the key exists.</returns>
+			/// <param name="key">The key to add.</param>
+			/// <param name="value">The value to add.</param>
+			bool Add(const KT& key, VT&& value)
+			{
+				bool added = tree.Insert(false, key, std::move(value));
+				CHECK_ERROR(added, L"OrderedDictionary<KT, VT>::Add(const KT&, VT&&)#Key already exists.");
+				return true;
+			}
+
+			/// <summary>Add a key with an associated value.</summary>
+			/// <returns>Returns true if the pair is added. If will crash if the key exists.</returns>
+			/// <param name="key">The key to add.</param>
+			/// <param name="value">The value to add.</param>
+			bool Add(KT&& key, const VT& value)
+			{
+				bool added = tree.Insert(false, std::move(key), value);
+				CHECK_ERROR(added, L"OrderedDictionary<KT, VT>::Add(KT&&, const VT&)#Key already exists.");
+				return true;
+			}
+
+			/// <summary>Add a key with an associated value.</summary>
+			/// <returns>Returns true if the pair is added. If will crash if the key exists.</returns>
+			/// <param name="key">The key to add.</param>
+			/// <param name="value">The value to add.</param>
+			bool Add(KT&& key, VT&& value)
+			{
+				bool added = tree.Insert(false, std::move(key), std::move(value));
+				CHECK_ERROR(added, L"OrderedDictionary<KT, VT>::Add(KT&&, VT&&)#Key already exists.");
+				return true;
+			}
+
+			/// <summary>Remove a key with the associated value.</summary>
+			/// <returns>Returns true if the key and the value is removed.</returns>
+			/// <param name="key">The key to find.</param>
+			bool Remove(const KK& key)
+			{
+				return tree.Remove(key);
+			}
+
+			/// <summary>Remove all elements.</summary>
+			/// <returns>Returns true if all elements are removed.</returns>
+			bool Clear()
+			{
+				tree.Clear();
+				return true;
+			}
+
+			/// <summary>
+			/// Replace all elements by pairs of keys and values sorted by keys, without searching in the tree.
+			/// Existing elements are removed first, even if their keys are not in the new pairs.
+			/// It will crash if keys are not sorted or not unique.
+			/// </summary>
+			/// <typeparam name="TItems">Type of the container of pairs, which could be iterated using a range-based for loop.</typeparam>
+			/// <param name="items">The pairs of keys and values.</param>
+			template<typename TItems>
+			void LoadSorted(const TItems& items)
+			{
+				tree.Clear();
+				for (auto&& item : items)
+				{
+					tree.LoadNext(item.key, item.value);
+				}
+				tree.EndLoad();
+			}
+		};
+
+/***********************************************************************
+Random Access
+***********************************************************************/
+		namespace randomaccess_internal
+		{
+			template<typename KT, typename VT, typename TAllocator>
+			struct RandomAccessable<OrderedDictionary<KT, VT, TAllocator>>
+			{
+				static const bool							CanRead = false;
+				static const bool							CanResize = false;
+			};
+
+			template<typename KT, typename VT, typename TAllocator>
+			struct RandomAccess<OrderedDictionary<KT, VT, TAllocator>>
+			{
+				static void AppendValue(OrderedDictionary<KT, VT, TAllocator>& t, const Pair<KT, VT>& value)
+				{
+					t.Set(value.key, value.value);
+				}
+
+				static void AppendValue(OrderedDictionary<KT, VT, TAllocator>& t, const Pair<const KT&, const VT&>& value)
+				{
+					t.Set(value.key, value.value);
+				}
+			};
+		}
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
@@ -0,0 +1,252 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_ORDEREDSET
+#define VCZH_COLLECTIONS_ORDEREDSET
+
+#include "BTree.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		/// <summary>
+		/// OrderedSet: container for unique values using a B+tree.
+		/// Values are sorted, adding and removing values take logarithmic time regardless of the number of values.
+		/// </summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for tree nodes, see <see cref="DefaultAllocator"/>.</typeparam>
+		/// <remarks>
+		/// Unlike <see cref="SortedList`2"/>, elements could not be accessed by positions.
+		/// Use <see cref="First"/>, <see cref="LowerBound"/> or <see cref="UpperBound"/> to get a cursor and iterate elements in order.
+		/// Representative values of elements (see <see cref="KeyType`1"/>) are copied into internal nodes, so they must be copyable.
+		/// </remarks>
+		template<typename T, typename TAllocator = DefaultAllocator>
+		class OrderedSet : public EnumerableBase<T>
+		{
+			using K = typename KeyType<T>::Type;
+			using Tree = btree_internal::BTree<T, void, TAllocator>;
+		public:
+			/// <summary>A position of an element, it becomes invalid after the set is modified.</summary>
+			typedef typename Tree::Cursor			Cursor;
+		protected:
+			class Enumerator : public Object, public virtual IEnumerator<T>
+			{
+			private:
+				const OrderedSet<T, TAllocator>*	container;
+				Cursor								cursor;
+				vint								index = -1;
+
+			public:
+				POOLED_ALLOCATION(Enumerator)
+
+				Enumerator(const OrderedSet<T, TAllocator>* _container)
+					: container(_container)
+				{
+				}
+
+				IEnumerator<T>* Clone()const override
+				{
+					auto enumerator = new Enumerator(container);
+					enumerator->cursor = cursor;
+					enumerator->index = index;
+					return enumerator;
+				}
+
+				const T& Current()const override
+				{
+					return cursor.Key();
+				}
+
+				vint Index()const override
+				{
+					return index;
+				}
+
+				bool Next() override
+				{
+					if (index == -1)
+					{
+						cursor = container->First();
+					}
+					else if (cursor.IsValid())
+					{
+						cursor.Next();
+					}
+					index++;
+					return cursor.IsValid();
+				}
+
+				void Reset() override
+				{
+					cursor = {};
+					index = -1;
+				}
+
+				bool Evaluated()const override
+				{
+					return true;
+				}
+			};
+
+			Tree									tree;
+		public:
+			/// <summary>Create an empty set.</summary>
+			OrderedSet() = default;
+			~OrderedSet() = default;
+
+			/// <summary>Create an empty set with an allocator.</summary>
+			/// <param name="allocator">The allocator for tree nodes.</param>
+			explicit OrderedSet(const TAllocator& allocator)
+				: tree(allocator)
+			{
+			}
+
+			OrderedSet(const OrderedSet<T, TAllocator>&) = delete;
+			OrderedSet(OrderedSet<T, TAllocator>&& _move)
+				: tree(std::move(_move.tree))
+			{
+			}
+
+			OrderedSet<T, TAllocator>& operator=(const OrderedSet<T, TAllocator>&) = delete;
+			OrderedSet<T, TAllocator>& operator=(OrderedSet<T, TAllocator>&& _move)
+			{
+				tree = std::move(_move.tree);
+				return *this;
+			}
+
+			IEnumerator<T>* CreateEnumerator()const
+			{
+				return new Enumerator(this);
+			}
+
+			/// <summary>Get the number of elements.</summary>
+			/// <returns>The number of elements.</returns>
+			vint Count()const
+			{
+				return tree.Count();
+			}
+
+			/// <summary>Get the cursor of the smallest element.</summary>
+			/// <returns>The cursor, which is invalid if the set is empty.</returns>
+			Cursor First()const
+			{
+				return tree.First();
+			}
+
+			/// <summary>Get the cursor of the largest element.</summary>
+			/// <returns>The cursor, which is invalid if the set is empty.</returns>
+			Cursor Last()const
+			{
+				return tree.Last();
+			}
+
+			/// <summary>Get the cursor of the first element that is not smaller than a specified value.</summary>
+			/// <returns>The cursor, which is invalid if all elements are smaller than the specified value.</returns>
+			/// <param name="item">The value to compare.</param>
+			Cursor LowerBound(const K& item)const
+			{
+				return tree.LowerBound(item);
+			}
+
+			/// <summary>Get the cursor of the first element that is larger than a specified value.</summary>
+			/// <returns>The cursor, which is invalid if no element is larger than the specified value.</returns>
+			/// <param name="item">The value to compare.</param>
+			Cursor UpperBound(const K& item)const
+			{
+				return tree.UpperBound(item);
+			}
+
+			/// <summary>Get the cursor of the element that equals to a specified value.</summary>
+			/// <returns>The cursor, which is invalid if the value does not exist.</returns>
+			/// <param name="item">The value to find.</param>
+			Cursor Find(const K& item)const
+			{
+				return tree.Find(item);
+			}
+
+			/// <summary>Test does the set contain a value or not.</summary>
+			/// <returns>Returns true if the set contains the specified value.</returns>
+			/// <param name="item">The value to test.</param>
+			bool Contains(const K& item)const
+			{
+				return tree.Find(item).IsValid();
+			}
+
+			/// <summary>Add a value to the set if it does not exist.</summary>
+			/// <returns>Returns true if the value is added. Returns false if the value already exists, in which case nothing happens.</returns>
+			/// <param name="item">The value to add.</param>
+			bool Add(const T& item)
+			{
+				return tree.Insert(false, item);
+			}
+
+			/// <summary>Add a value to the set if it does not exist.</summary>
+			/// <returns>Returns true if the value is added. Returns false if the value already exists, in which case nothing happens.</returns>
+			/// <param name="item">The value to add.</param>
+			bool Add(T&& item)
+			{
+				return tree.Insert(false, std::move(item));
+			}
+
+			/// <summary>Remove an element from the set.</summary>
+			/// <returns>Returns true if the element is removed.</returns>
+			/// <param name="item">The item to remove.</param>
+			bool Remove(const K& item)
+			{
+				return tree.Remove(item);
+			}
+
+			/// <summary>Remove all elements.</summary>
+			/// <returns>Returns true if all elements are removed.</returns>
+			bool Clear()
+			{
+				tree.Clear();
+				return true;
+			}
+
+			/// <summary>
+			/// Replace all elements by sorted values, without searching in the tree.
+			/// Existing elements are removed first, even if they are not in the new values.
+			/// It will crash if values are not sorted or not unique.
+			/// </summary>
+			/// <typeparam name="TItems">Type of the container of values, which could be iterated using a range-based for loop.</typeparam>
+			/// <param name="items">The values.</param>
+			template<typename TItems>
+			void LoadSorted(const TItems& items)
+			{
+				tree.Clear();
+				for (auto&& item : items)
+				{
+					tree.LoadNext(item);
+				}
+				tree.EndLoad();
+			}
+		};
+
+/***********************************************************************
+Random Access
+***********************************************************************/
+		namespace randomaccess_internal
+		{
+			template<typename T, typename TAllocator>
+			struct RandomAccessable<OrderedSet<T, TAllocator>>
+			{
+				static const bool							CanRead = false;
+				static const bool							CanResize = false;
+			};
+		}
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
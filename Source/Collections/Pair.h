@@ -140,6 +140,19 @@ namespace vl
 		template<typename K, typename V>
 		Pair(K&&, V&&) -> Pair<typename RemoveCVRefArrayCtad<K>::Type, typename RemoveCVRefArrayCtad<V>::Type>;
 	}
+
+	template<typename K, typename V>
+	struct Hasher<collections::Pair<K, V>>
+	{
+		static vuint64_t GetHashCode(const collections::Pair<K, V>& value)
+			requires(Hashable<std::remove_cvref_t<K>> && Hashable<std::remove_cvref_t<V>>)
+		{
+			return CombineHashCode(
+				Hasher<std::remove_cvref_t<K>>::GetHashCode(value.key),
+				Hasher<std::remove_cvref_t<V>>::GetHashCode(value.value)
+				);
+		}
+	};
 }
 
 namespace std
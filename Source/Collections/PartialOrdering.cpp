@@ -18,24 +18,21 @@ PartialOrderingProcessor
 		void PartialOrderingProcessor::InitNodes(vint itemCount)
 		{
 			nodes.Resize(itemCount);
+			nodeEdges.Resize(itemCount * 2);
 
+			for (vint i = 0; i < ins.Count(); i++)
+			{
+				nodeEdges[ins.Keys()[i]] = ins.GetByIndex(i);
+			}
+			for (vint i = 0; i < outs.Count(); i++)
+			{
+				nodeEdges[itemCount + outs.Keys()[i]] = outs.GetByIndex(i);
+			}
 			for (vint i = 0; i < itemCount; i++)
 			{
 				auto& node = nodes[i];
-				node.ins = &emptyList;
-				node.outs = &emptyList;
-
-				vint inIndex = ins.Keys().IndexOf(i);
-				vint outIndex = outs.Keys().IndexOf(i);
-
-				if (inIndex != -1)
-				{
-					node.ins = &ins.GetByIndex(inIndex);
-				}
-				if (outIndex != -1)
-				{
-					node.outs = &outs.GetByIndex(outIndex);
-				}
+				node.ins = &nodeEdges[i];
+				node.outs = &nodeEdges[itemCount + i];
 			}
 		}
 
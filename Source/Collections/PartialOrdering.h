@@ -6,7 +6,8 @@ Licensed under https://github.com/vczh-libraries/License
 #ifndef VCZH_COLLECTIONS_PARTIALORDERING
 #define VCZH_COLLECTIONS_PARTIALORDERING
 
-#include "Dictionary.h"
+#include "FlatGroup.h"
+#include "HashSet.h"
 
 namespace vl
 {
@@ -28,9 +29,9 @@ Partial Ordering
 				/// <summary>The index used in [F:vl.collections.PartialOrderingProcessor.components], specifying the component that contain this node.</summary>
 				vint					component = -1;
 				/// <summary>All nodes that this node depends on.</summary>
-				const List<vint>*		ins = nullptr;
+				const ArraySpan<vint>*	ins = nullptr;
 				/// <summary>All nodes that this node is depended by.</summary>
-				const List<vint>*		outs = nullptr;
+				const ArraySpan<vint>*	outs = nullptr;
 				/// <summary>
 				/// If [M:vl.collections.PartialOrderingProcessor.InitWithSubClass`2] is used,
 				/// a node becomes a sub class representing objects.
@@ -81,9 +82,9 @@ Partial Ordering
 			template<typename TList>
 			using GroupOf = Group<typename TList::ElementType, typename TList::ElementType>;
 		protected:
-			List<vint>					emptyList;				// make a pointer to an empty list available
-			Group<vint, vint>			ins;					// if a depends on b, ins.Contains(a, b)
-			Group<vint, vint>			outs;					// if a depends on b, outs.Contains(b, a)
+			FlatGroup<vint, vint>		ins;					// if a depends on b, ins.Contains(a, b)
+			FlatGroup<vint, vint>		outs;					// if a depends on b, outs.Contains(b, a)
+			Array<ArraySpan<vint>>		nodeEdges;				// one buffer for all Node::ins followed by all Node::outs
 			Array<vint>					firstNodesBuffer;		// one buffer for all Component::firstNode
 			Array<vint>					subClassItemsBuffer;	// one buffer for all Node::firstSubClassItem
 
@@ -182,6 +183,15 @@ Partial Ordering
 			{
 				CHECK_ERROR(nodes.Count() == 0, L"PartialOrdering::InitWithGroup(items, depGroup)#Initializing twice is not allowed.");
 
+				vint edgeCount = 0;
+				for (vint i = 0; i < depGroup.Count(); i++)
+				{
+					edgeCount += depGroup.GetByIndex(i).Count();
+				}
+
+				List<Pair<vint, vint>> inEdges, outEdges;
+				inEdges.Reserve(edgeCount);
+				outEdges.Reserve(edgeCount);
 				for (vint i = 0; i < depGroup.Count(); i++)
 				{
 					vint fromNode = items.IndexOf(KeyType<typename TList::ElementType>::GetKeyValue(depGroup.Keys()[i]));
@@ -193,11 +203,13 @@ Partial Ordering
 						vint toNode = items.IndexOf(KeyType<typename TList::ElementType>::GetKeyValue(edges[j]));
 						CHECK_ERROR(toNode != -1, L"PartialOrdering::InitWithGroup(items, depGroup)#The value in outsGroup does not exist in items.");
 
-						ins.Add(fromNode, toNode);
-						outs.Add(toNode, fromNode);
+						inEdges.Add({ fromNode, toNode });
+						outEdges.Add({ toNode, fromNode });
 					}
 				}
 
+				ins.BuildFrom(inEdges);
+				outs.BuildFrom(outEdges);
 				InitNodes(items.Count());
 			}
 
@@ -273,17 +285,20 @@ Partial Ordering
 			template<typename TList, typename TFunc>
 			void InitWithFunc(const TList& items, TFunc&& depFunc)
 			{
-				GroupOf<TList> depGroup;
+				List<Pair<typename TList::ElementType, typename TList::ElementType>> deps;
 				for (vint i = 0; i < items.Count(); i++)
 				{
 					for (vint j = 0; j < items.Count(); j++)
 					{
 						if (depFunc(items[i], items[j]))
 						{
-							depGroup.Add(items[i], items[j]);
+							deps.Add({ items[i], items[j] });
 						}
 					}
 				}
+
+				GroupOf<TList> depGroup;
+				depGroup.BuildFrom(deps);
 				InitWithGroup(items, depGroup);
 			}
 
@@ -424,6 +439,8 @@ Partial Ordering
 					}
 				};
 
+				HashSet<Pair<vint, vint>> addedEdges;
+				List<Pair<vint, vint>> inEdges, outEdges;
 				for (vint i = 0; i < depGroup.Count(); i++)
 				{
 					const auto& key = depGroup.Keys()[i];
@@ -435,22 +452,25 @@ Partial Ordering
 						const auto& value = values[j];
 						vint valueIndex = getSubClass(value);
 
-						if (!ins.Contains(keyIndex, valueIndex))
+						if (addedEdges.Add({ keyIndex, valueIndex }) != -1)
 						{
-							ins.Add(keyIndex, valueIndex);
+							inEdges.Add({ keyIndex, valueIndex });
 						}
 					}
 				}
+				ins.BuildFrom(inEdges);
 
+				outEdges.Reserve(ins.ValueCount());
 				for (vint i = 0; i < ins.Count(); i++)
 				{
 					vint key = ins.Keys()[i];
-					const auto& values = ins.GetByIndex(i);
+					auto values = ins.GetByIndex(i);
 					for (vint j = 0; j < values.Count(); j++)
 					{
-						outs.Add(values[j], key);
+						outEdges.Add({ values[j], key });
 					}
 				}
+				outs.BuildFrom(outEdges);
 
 				InitNodes(scItems.Count() + singleItems.Count());
 				subClassItemsBuffer.Resize(items.Count());
@@ -0,0 +1,698 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_PERSISTENTDICTIONARY
+#define VCZH_COLLECTIONS_PERSISTENTDICTIONARY
+
+#include <bit>
+#include "PersistentList.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		namespace persistentdictionary_internal
+		{
+			using namespace persistent_internal;
+
+			// a 64 bits hash code is consumed 5 bits per level
+			constexpr vint							MaxDepth = (64 + Bits - 1) / Bits;
+
+			enum class NodeKind
+			{
+				Entry,
+				Collision,
+				Branch,
+			};
+
+			template<typename KT, typename VT>
+			struct Node : NodeBase
+			{
+				NodeKind							kind;
+				vuint64_t							hash = 0;
+
+				Node(NodeKind _kind, vuint64_t _hash)
+					: kind(_kind)
+					, hash(_hash)
+				{
+				}
+			};
+
+			template<typename KT, typename VT>
+			struct Entry : Node<KT, VT>
+			{
+				KT									key;
+				VT									value;
+
+				Entry(vuint64_t _hash, const KT& _key, const VT& _value)
+					: Node<KT, VT>(NodeKind::Entry, _hash)
+					, key(_key)
+					, value(_value)
+				{
+				}
+			};
+
+			// keys with the same hash code
+			template<typename KT, typename VT>
+			struct Collision : Node<KT, VT>
+			{
+				List<Pair<KT, VT>>					pairs;
+
+				Collision(vuint64_t _hash)
+					: Node<KT, VT>(NodeKind::Collision, _hash)
+				{
+				}
+			};
+
+			// children are stored compactly, bit i in the bitmap is set if the i-th possible child exists
+			template<typename KT, typename VT>
+			struct Branch : Node<KT, VT>
+			{
+				vuint32_t							bitmap = 0;
+				vint								count = 0;
+				Node<KT, VT>**						children = nullptr;
+
+				Branch()
+					: Node<KT, VT>(NodeKind::Branch, 0)
+				{
+				}
+
+				~Branch()
+				{
+					delete[] children;
+				}
+
+				static vuint32_t Bit(vuint64_t hash, vint shift)
+				{
+					return (vuint32_t)1 << ((hash >> shift) & Mask);
+				}
+
+				vint IndexOf(vuint32_t bit)const
+				{
+					return std::popcount(bitmap & (bit - 1));
+				}
+
+				void Insert(vuint32_t bit, Node<KT, VT>* child)
+				{
+					vint index = IndexOf(bit);
+					auto newChildren = new Node<KT, VT>*[count + 1];
+					for (vint i = 0; i < index; i++) newChildren[i] = children[i];
+					newChildren[index] = child;
+					for (vint i = index; i < count; i++) newChildren[i + 1] = children[i];
+					delete[] children;
+					children = newChildren;
+					bitmap |= bit;
+					count++;
+				}
+
+				void RemoveAt(vuint32_t bit)
+				{
+					vint index = IndexOf(bit);
+					for (vint i = index + 1; i < count; i++) children[i - 1] = children[i];
+					bitmap &= ~bit;
+					count--;
+				}
+			};
+
+			template<typename KT, typename VT>
+			void Release(Node<KT, VT>* node)
+			{
+				if (!node || DECRC(&node->refCount) != 0) return;
+				switch (node->kind)
+				{
+				case NodeKind::Entry:
+					delete static_cast<Entry<KT, VT>*>(node);
+					break;
+				case NodeKind::Collision:
+					delete static_cast<Collision<KT, VT>*>(node);
+					break;
+				case NodeKind::Branch:
+					{
+						auto branch = static_cast<Branch<KT, VT>*>(node);
+						for (vint i = 0; i < branch->count; i++)
+						{
+							Release(branch->children[i]);
+						}
+						delete branch;
+					}
+					break;
+				}
+			}
+
+			template<typename KT, typename VT>
+			Node<KT, VT>* Clone(Node<KT, VT>* node)
+			{
+				switch (node->kind)
+				{
+				case NodeKind::Entry:
+					{
+						auto entry = static_cast<Entry<KT, VT>*>(node);
+						return new Entry<KT, VT>(entry->hash, entry->key, entry->value);
+					}
+				case NodeKind::Collision:
+					{
+						auto collision = static_cast<Collision<KT, VT>*>(node);
+						auto copied = new Collision<KT, VT>(collision->hash);
+						for (auto&& pair : collision->pairs)
+						{
+							copied->pairs.Add(pair);
+						}
+						return copied;
+					}
+				default:
+					{
+						auto branch = static_cast<Branch<KT, VT>*>(node);
+						auto copied = new Branch<KT, VT>;
+						copied->bitmap = branch->bitmap;
+						copied->count = branch->count;
+						copied->children = new Node<KT, VT>*[branch->count];
+						for (vint i = 0; i < branch->count; i++)
+						{
+							copied->children[i] = branch->children[i];
+							Retain(copied->children[i]);
+						}
+						return copied;
+					}
+				}
+			}
+
+			template<typename KT, typename VT>
+			void MakeUnique(Node<KT, VT>*& node)
+			{
+				if (node->IsShared())
+				{
+					auto copied = Clone(node);
+					Release(node);
+					node = copied;
+				}
+			}
+
+			// create a branch containing two nodes with different hash codes
+			template<typename KT, typename VT>
+			Node<KT, VT>* Merge(Node<KT, VT>* a, Node<KT, VT>* b, vint shift)
+			{
+				auto branch = new Branch<KT, VT>;
+				auto bitA = Branch<KT, VT>::Bit(a->hash, shift);
+				auto bitB = Branch<KT, VT>::Bit(b->hash, shift);
+				if (bitA == bitB)
+				{
+					branch->Insert(bitA, Merge(a, b, shift + Bits));
+				}
+				else
+				{
+					branch->Insert(bitA, a);
+					branch->Insert(bitB, b);
+				}
+				return branch;
+			}
+		}
+
+		/// <summary>
+		/// PersistentDictionary: one to one map container whose copies share memory.
+		/// Pairs are stored in a hash array mapped trie, each level consumes 5 bits of hash codes.
+		/// </summary>
+		/// <typeparam name="KT">Type of keys.</typeparam>
+		/// <typeparam name="VT">Type of values.</typeparam>
+		/// <typeparam name="THasher">Type to compute hash codes of keys, see <see cref="Hasher`1"/>.</typeparam>
+		/// <remarks>
+		/// <p>
+		/// Unlike <see cref="Dictionary`3"/>, copying a persistent dictionary takes constant time, it is a cheap way to keep a snapshot.
+		/// Changing a persistent dictionary never affects its copies: nodes that are shared with other copies are copied before being changed,
+		/// so that finding, setting and removing a key takes O(log32 n) time.
+		/// </p>
+		/// <p>
+		/// Pairs are enumerated in the order of hash codes, not the order of keys.
+		/// Different copies could be read and changed in different threads, but a single copy is not thread safe.
+		/// </p>
+		/// </remarks>
+		template<typename KT, typename VT, typename THasher = Hasher<typename KeyType<KT>::Type>>
+		class PersistentDictionary : public EnumerableBase<Pair<const KT&, const VT&>>
+		{
+			using KK = typename KeyType<KT>::Type;
+			using KVPair = Pair<const KT&, const VT&>;
+			using Node = persistentdictionary_internal::Node<KT, VT>;
+			using Entry = persistentdictionary_internal::Entry<KT, VT>;
+			using Collision = persistentdictionary_internal::Collision<KT, VT>;
+			using Branch = persistentdictionary_internal::Branch<KT, VT>;
+			using NodeKind = persistentdictionary_internal::NodeKind;
+			static constexpr vint Bits = persistent_internal::Bits;
+		protected:
+			class Enumerator : public Object, public virtual IEnumerator<KVPair>
+			{
+			private:
+				struct Frame
+				{
+					const Branch*					branch;
+					vint							index;
+				};
+
+				PersistentDictionary<KT, VT, THasher>	container;
+				Frame								stack[persistentdictionary_internal::MaxDepth];
+				vint								depth = 0;
+				bool								started = false;
+				const Collision*					collision = nullptr;
+				vint								collisionIndex = 0;
+				vint								index = -1;
+				Nullable<KVPair>					current;
+
+				bool Visit(const Node* node)
+				{
+					switch (node->kind)
+					{
+					case NodeKind::Entry:
+						{
+							auto entry = static_cast<const Entry*>(node);
+							current = { entry->key, entry->value };
+						}
+						return true;
+					case NodeKind::Collision:
+						{
+							collision = static_cast<const Collision*>(node);
+							collisionIndex = 0;
+							auto&& pair = collision->pairs[0];
+							current = { pair.key, pair.value };
+						}
+						return true;
+					default:
+						stack[depth++] = { static_cast<const Branch*>(node), 0 };
+						return false;
+					}
+				}
+
+				bool MoveNext()
+				{
+					if (collision && collisionIndex + 1 < collision->pairs.Count())
+					{
+						auto&& pair = collision->pairs[++collisionIndex];
+						current = { pair.key, pair.value };
+						return true;
+					}
+					collision = nullptr;
+
+					if (!started)
+					{
+						started = true;
+						if (container.root && Visit(container.root)) return true;
+					}
+					while (depth > 0)
+					{
+						auto& frame = stack[depth - 1];
+						if (frame.index == frame.branch->count)
+						{
+							depth--;
+						}
+						else if (Visit(frame.branch->children[frame.index++]))
+						{
+							return true;
+						}
+					}
+					return false;
+				}
+			public:
+				POOLED_ALLOCATION(Enumerator)
+
+				Enumerator(const PersistentDictionary<KT, VT, THasher>& _container)
+					: container(_container)
+				{
+				}
+
+				IEnumerator<KVPair>* Clone()const override
+				{
+					auto enumerator = new Enumerator(container);
+					while (enumerator->index < index)
+					{
+						enumerator->Next();
+					}
+					return enumerator;
+				}
+
+				const KVPair& Current()const override
+				{
+					return current.Value();
+				}
+
+				vint Index()const override
+				{
+					return index;
+				}
+
+				bool Next() override
+				{
+					if (!MoveNext()) return false;
+					index++;
+					return true;
+				}
+
+				void Reset() override
+				{
+					depth = 0;
+					started = false;
+					collision = nullptr;
+					index = -1;
+				}
+
+				bool Evaluated()const override
+				{
+					return true;
+				}
+			};
+
+			vint									count = 0;
+			Node*									root = nullptr;
+
+			const VT* Find(const KK& key)const
+			{
+				vuint64_t hash = THasher::GetHashCode(key);
+				const Node* node = root;
+				vint shift = 0;
+				while (node)
+				{
+					switch (node->kind)
+					{
+					case NodeKind::Entry:
+						{
+							auto entry = static_cast<const Entry*>(node);
+							if (entry->hash == hash && KeyType<KT>::GetKeyValue(entry->key) == key) return &entry->value;
+						}
+						return nullptr;
+					case NodeKind::Collision:
+						{
+							auto collision = static_cast<const Collision*>(node);
+							if (collision->hash != hash) return nullptr;
+							for (auto&& pair : collision->pairs)
+							{
+								if (KeyType<KT>::GetKeyValue(pair.key) == key) return &pair.value;
+							}
+						}
+						return nullptr;
+					default:
+						{
+							auto branch = static_cast<const Branch*>(node);
+							auto bit = Branch::Bit(hash, shift);
+							if ((branch->bitmap & bit) == 0) return nullptr;
+							node = branch->children[branch->IndexOf(bit)];
+							shift += Bits;
+						}
+					}
+				}
+				return nullptr;
+			}
+
+			static bool SetInNode(Node*& node, vuint64_t hash, const KT& key, const VT& value, vint shift)
+			{
+				switch (node->kind)
+				{
+				case NodeKind::Entry:
+					{
+						auto entry = static_cast<Entry*>(node);
+						if (entry->hash != hash)
+						{
+							node = persistentdictionary_internal::Merge<KT, VT>(node, new Entry(hash, key, value), shift);
+							return true;
+						}
+						if (KeyType<KT>::GetKeyValue(entry->key) == KeyType<KT>::GetKeyValue(key))
+						{
+							persistentdictionary_internal::MakeUnique(node);
+							static_cast<Entry*>(node)->value = value;
+							return false;
+						}
+						auto collision = new Collision(hash);
+						collision->pairs.Add({ entry->key, entry->value });
+						collision->pairs.Add({ key, value });
+						persistentdictionary_internal::Release(node);
+						node = collision;
+					}
+					return true;
+				case NodeKind::Collision:
+					{
+						if (node->hash != hash)
+						{
+							node = persistentdictionary_internal::Merge<KT, VT>(node, new Entry(hash, key, value), shift);
+							return true;
+						}
+						persistentdictionary_internal::MakeUnique(node);
+						auto&& pairs = static_cast<Collision*>(node)->pairs;
+						for (vint i = 0; i < pairs.Count(); i++)
+						{
+							if (KeyType<KT>::GetKeyValue(pairs[i].key) == KeyType<KT>::GetKeyValue(key))
+							{
+								pairs.Set(i, { key, value });
+								return false;
+							}
+						}
+						pairs.Add({ key, value });
+					}
+					return true;
+				default:
+					{
+						persistentdictionary_internal::MakeUnique(node);
+						auto branch = static_cast<Branch*>(node);
+						auto bit = Branch::Bit(hash, shift);
+						if ((branch->bitmap & bit) == 0)
+						{
+							branch->Insert(bit, new Entry(hash, key, value));
+							return true;
+						}
+						return SetInNode(branch->children[branch->IndexOf(bit)], hash, key, value, shift + Bits);
+					}
+				}
+			}
+
+			// the key must exist
+			static void RemoveFromNode(Node*& node, vuint64_t hash, const KK& key, vint shift)
+			{
+				switch (node->kind)
+				{
+				case NodeKind::Entry:
+					persistentdictionary_internal::Release(node);
+					node = nullptr;
+					break;
+				case NodeKind::Collision:
+					{
+						persistentdictionary_internal::MakeUnique(node);
+						auto&& pairs = static_cast<Collision*>(node)->pairs;
+						for (vint i = 0; i < pairs.Count(); i++)
+						{
+							if (KeyType<KT>::GetKeyValue(pairs[i].key) == key)
+							{
+								pairs.RemoveAt(i);
+								break;
+							}
+						}
+						if (pairs.Count() == 1)
+						{
+							auto entry = new Entry(hash, pairs[0].key, pairs[0].value);
+							persistentdictionary_internal::Release(node);
+							node = entry;
+						}
+					}
+					break;
+				default:
+					{
+						persistentdictionary_internal::MakeUnique(node);
+						auto branch = static_cast<Branch*>(node);
+						auto bit = Branch::Bit(hash, shift);
+						auto& child = branch->children[branch->IndexOf(bit)];
+						RemoveFromNode(child, hash, key, shift + Bits);
+						if (!child)
+						{
+							branch->RemoveAt(bit);
+						}
+
+						// a branch with only one entry or collision is replaced by the child
+						if (branch->count == 0)
+						{
+							persistentdictionary_internal::Release(node);
+							node = nullptr;
+						}
+						else if (branch->count == 1 && branch->children[0]->kind != NodeKind::Branch)
+						{
+							auto last = branch->children[0];
+							branch->count = 0;
+							persistentdictionary_internal::Release(node);
+							node = last;
+						}
+					}
+				}
+			}
+
+			void TakeOver(PersistentDictionary<KT, VT, THasher>& _move)
+			{
+				count = _move.count;
+				root = _move.root;
+				_move.count = 0;
+				_move.root = nullptr;
+			}
+		public:
+			/// <summary>Create an empty dictionary.</summary>
+			PersistentDictionary() = default;
+
+			/// <summary>Create a dictionary sharing all pairs with another dictionary, in constant time.</summary>
+			/// <param name="dictionary">The dictionary to copy.</param>
+			PersistentDictionary(const PersistentDictionary<KT, VT, THasher>& dictionary)
+				: count(dictionary.count)
+				, root(dictionary.root)
+			{
+				persistent_internal::Retain(root);
+			}
+
+			PersistentDictionary(PersistentDictionary<KT, VT, THasher>&& dictionary)
+			{
+				TakeOver(dictionary);
+			}
+
+			~PersistentDictionary()
+			{
+				Clear();
+			}
+
+			/// <summary>Replace all pairs by sharing all pairs with another dictionary, in constant time.</summary>
+			/// <returns>The dictionary itself.</returns>
+			/// <param name="dictionary">The dictionary to copy.</param>
+			PersistentDictionary<KT, VT, THasher>& operator=(const PersistentDictionary<KT, VT, THasher>& dictionary)
+			{
+				PersistentDictionary<KT, VT, THasher> copied(dictionary);
+				Clear();
+				TakeOver(copied);
+				return *this;
+			}
+
+			PersistentDictionary<KT, VT, THasher>& operator=(PersistentDictionary<KT, VT, THasher>&& dictionary)
+			{
+				Clear();
+				TakeOver(dictionary);
+				return *this;
+			}
+
+			IEnumerator<KVPair>* CreateEnumerator()const
+			{
+				return new Enumerator(*this);
+			}
+
+			/// <summary>Get the number of keys.</summary>
+			/// <returns>The number of keys.</returns>
+			vint Count()const
+			{
+				return count;
+			}
+
+			/// <summary>Test if a key exists.</summary>
+			/// <returns>Returns true if the key exists.</returns>
+			/// <param name="key">The key to find.</param>
+			bool Contains(const KK& key)const
+			{
+				return Find(key) != nullptr;
+			}
+
+			/// <summary>Get the reference to the value associated to a specified key.</summary>
+			/// <returns>The reference to the value. It will crash if the key does not exist.</returns>
+			/// <param name="key">The key to find.</param>
+			const VT& Get(const KK& key)const
+			{
+				auto value = Find(key);
+				CHECK_ERROR(value != nullptr, L"PersistentDictionary<KT, VT, THasher>::Get(const KK&)#Key not found.");
+				return *value;
+			}
+
+			/// <summary>Get the reference to the value associated to a specified key.</summary>
+			/// <returns>The reference to the value. It will crash if the key does not exist.</returns>
+			/// <param name="key">The key to find.</param>
+			const VT& operator[](const KK& key)const
+			{
+				auto value = Find(key);
+				CHECK_ERROR(value != nullptr, L"PersistentDictionary<KT, VT, THasher>::operator[](const KK&)#Key not found.");
+				return *value;
+			}
+
+			/// <summary>Replace the value associated to a specified key.</summary>
+			/// <returns>Returns true if the value is replaced.</returns>
+			/// <param name="key">The key to find. If the key does not exist, it will be added.</param>
+			/// <param name="value">The associated value to replace.</param>
+			bool Set(const KT& key, const VT& value)
+			{
+				vuint64_t hash = THasher::GetHashCode(KeyType<KT>::GetKeyValue(key));
+				if (!root)
+				{
+					root = new Entry(hash, key, value);
+					count++;
+				}
+				else if (SetInNode(root, hash, key, value, 0))
+				{
+					count++;
+				}
+				return true;
+			}
+
+			/// <summary>Add a key with an associated value.</summary>
+			/// <returns>Returns true if the pair is added. If will crash if the key exists.</returns>
+			/// <param name="key">The key to add.</param>
+			/// <param name="value">The value to add.</param>
+			bool Add(const KT& key, const VT& value)
+			{
+				CHECK_ERROR(!Contains(KeyType<KT>::GetKeyValue(key)), L"PersistentDictionary<KT, VT, THasher>::Add(const KT&, const VT&)#Key already exists.");
+				return Set(key, value);
+			}
+
+			/// <summary>Remove a key with the associated value.</summary>
+			/// <returns>Returns true if the key and the value is removed.</returns>
+			/// <param name="key">The key to find.</param>
+			bool Remove(const KK& key)
+			{
+				if (!Contains(key)) return false;
+				RemoveFromNode(root, THasher::GetHashCode(key), key, 0);
+				count--;
+				return true;
+			}
+
+			/// <summary>Remove all pairs.</summary>
+			/// <returns>Returns true if all pairs are removed.</returns>
+			bool Clear()
+			{
+				persistentdictionary_internal::Release(root);
+				root = nullptr;
+				count = 0;
+				return true;
+			}
+		};
+
+/***********************************************************************
+Random Access
+***********************************************************************/
+
+		namespace randomaccess_internal
+		{
+			template<typename KT, typename VT, typename THasher>
+			struct RandomAccessable<PersistentDictionary<KT, VT, THasher>>
+			{
+				static const bool							CanRead = false;
+				static const bool							CanResize = false;
+			};
+
+			template<typename KT, typename VT, typename THasher>
+			struct RandomAccess<PersistentDictionary<KT, VT, THasher>>
+			{
+				static void AppendValue(PersistentDictionary<KT, VT, THasher>& t, const Pair<KT, VT>& value)
+				{
+					t.Set(value.key, value.value);
+				}
+
+				static void AppendValue(PersistentDictionary<KT, VT, THasher>& t, const Pair<const KT&, const VT&>& value)
+				{
+					t.Set(value.key, value.value);
+				}
+			};
+		}
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
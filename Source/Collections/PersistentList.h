@@ -0,0 +1,582 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_PERSISTENTLIST
+#define VCZH_COLLECTIONS_PERSISTENTLIST
+
+#include "List.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		namespace persistent_internal
+		{
+			constexpr vint							Bits = 5;
+			constexpr vint							Width = 1 << Bits;
+			constexpr vint							Mask = Width - 1;
+
+			// nodes are shared between versions, a node could only be changed in place when it is not shared
+			struct NodeBase
+			{
+				atomic_vint							refCount{ 1 };
+
+				bool IsShared()const
+				{
+					return refCount.load() != 1;
+				}
+			};
+
+			inline void Retain(NodeBase* node)
+			{
+				if (node) INCRC(&node->refCount);
+			}
+		}
+
+		namespace persistentlist_internal
+		{
+			using namespace persistent_internal;
+
+			template<typename T>
+			struct Leaf : NodeBase
+			{
+				vint								count = 0;
+				alignas(T) char						storage[sizeof(T) * Width];
+
+				Leaf() = default;
+
+				Leaf(const Leaf<T>& leaf)
+				{
+					memory_management::CallCopyCtors(Items(), leaf.Items(), leaf.count);
+					count = leaf.count;
+				}
+
+				~Leaf()
+				{
+					memory_management::CallDtors(Items(), count);
+				}
+
+				T* Items()
+				{
+					return (T*)storage;
+				}
+
+				const T* Items()const
+				{
+					return (const T*)storage;
+				}
+			};
+
+			struct Branch : NodeBase
+			{
+				NodeBase*							children[Width] = {};
+
+				Branch() = default;
+
+				Branch(const Branch& branch)
+				{
+					for (vint i = 0; i < Width; i++)
+					{
+						children[i] = branch.children[i];
+						Retain(children[i]);
+					}
+				}
+			};
+
+			// a node at level 0 is a leaf, a node at level L contains nodes at level L - Bits
+			template<typename T>
+			void Release(NodeBase* node, vint level)
+			{
+				if (!node || DECRC(&node->refCount) != 0) return;
+				if (level == 0)
+				{
+					delete static_cast<Leaf<T>*>(node);
+				}
+				else
+				{
+					auto branch = static_cast<Branch*>(node);
+					for (vint i = 0; i < Width; i++)
+					{
+						Release<T>(branch->children[i], level - Bits);
+					}
+					delete branch;
+				}
+			}
+
+			template<typename T, typename TNode>
+			void MakeUnique(TNode*& node, vint level)
+			{
+				if (node->IsShared())
+				{
+					auto copied = new TNode(*node);
+					Release<T>(node, level);
+					node = copied;
+				}
+			}
+		}
+
+		/// <summary>
+		/// PersistentList: linear container whose copies share memory.
+		/// Elements are stored in a 32-way trie, with the last 32 elements in a separated leaf.
+		/// </summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <remarks>
+		/// <p>
+		/// Unlike <see cref="List`2"/>, copying a persistent list takes constant time, it is a cheap way to keep a snapshot.
+		/// Changing a persistent list never affects its copies: nodes that are shared with other copies are copied before being changed,
+		/// so that getting, adding, replacing and removing the last element takes O(log32 n) time.
+		/// </p>
+		/// <p>
+		/// Different copies could be read and changed in different threads, but a single copy is not thread safe.
+		/// </p>
+		/// </remarks>
+		template<typename T>
+		class PersistentList : public EnumerableBase<T>
+		{
+			using K = typename KeyType<T>::Type;
+			using Leaf = persistentlist_internal::Leaf<T>;
+			using Branch = persistentlist_internal::Branch;
+			using NodeBase = persistent_internal::NodeBase;
+			static constexpr vint Bits = persistent_internal::Bits;
+			static constexpr vint Mask = persistent_internal::Mask;
+			static constexpr vint Width = persistent_internal::Width;
+		protected:
+			class Enumerator : public Object, public virtual IEnumerator<T>
+			{
+			private:
+				PersistentList<T>					container;
+				vint								index;
+				const T*							items = nullptr;
+
+			public:
+				POOLED_ALLOCATION(Enumerator)
+
+				Enumerator(const PersistentList<T>& _container, vint _index = -1)
+					: container(_container)
+					, index(_index)
+				{
+					if (index >= 0 && index < container.Count())
+					{
+						items = container.GetLeaf(index)->Items();
+					}
+				}
+
+				IEnumerator<T>* Clone()const override
+				{
+					return new Enumerator(container, index);
+				}
+
+				const T& Current()const override
+				{
+					return items[index & Mask];
+				}
+
+				vint Index()const override
+				{
+					return index;
+				}
+
+				bool Next() override
+				{
+					index++;
+					if (index < 0 || index >= container.Count()) return false;
+					if (!items || (index & Mask) == 0)
+					{
+						items = container.GetLeaf(index)->Items();
+					}
+					return true;
+				}
+
+				void Reset() override
+				{
+					index = -1;
+					items = nullptr;
+				}
+
+				bool Evaluated()const override
+				{
+					return true;
+				}
+			};
+
+			vint									count = 0;
+			vint									shift = Bits;
+			Branch*									root = nullptr;
+			Leaf*									tail = nullptr;
+
+			vint TailOffset()const
+			{
+				return count == 0 ? 0 : ((count - 1) >> Bits) << Bits;
+			}
+
+			const Leaf* GetLeaf(vint index)const
+			{
+				if (index >= TailOffset()) return tail;
+				NodeBase* node = root;
+				for (vint level = shift; level > 0; level -= Bits)
+				{
+					node = static_cast<Branch*>(node)->children[(index >> level) & Mask];
+				}
+				return static_cast<Leaf*>(node);
+			}
+
+			static NodeBase* NewPath(vint level, Leaf* leaf)
+			{
+				if (level == 0) return leaf;
+				auto branch = new Branch;
+				branch->children[0] = NewPath(level - Bits, leaf);
+				return branch;
+			}
+
+			static Branch* PushLeaf(Branch* branch, vint level, vint index, Leaf* leaf)
+			{
+				persistentlist_internal::MakeUnique<T>(branch, level);
+				vint position = (index >> level) & Mask;
+				if (level == Bits)
+				{
+					branch->children[position] = leaf;
+				}
+				else if (auto child = static_cast<Branch*>(branch->children[position]))
+				{
+					branch->children[position] = PushLeaf(child, level - Bits, index, leaf);
+				}
+				else
+				{
+					branch->children[position] = NewPath(level - Bits, leaf);
+				}
+				return branch;
+			}
+
+			static Branch* PopLeaf(Branch* branch, vint level, vint index)
+			{
+				persistentlist_internal::MakeUnique<T>(branch, level);
+				vint position = (index >> level) & Mask;
+				if (level == Bits)
+				{
+					persistentlist_internal::Release<T>(branch->children[position], 0);
+					branch->children[position] = nullptr;
+				}
+				else
+				{
+					branch->children[position] = PopLeaf(static_cast<Branch*>(branch->children[position]), level - Bits, index);
+				}
+
+				if (position == 0 && branch->children[0] == nullptr)
+				{
+					persistentlist_internal::Release<T>(branch, level);
+					return nullptr;
+				}
+				return branch;
+			}
+
+			static Branch* SetInBranch(Branch* branch, vint level, vint index, const T& value)
+			{
+				persistentlist_internal::MakeUnique<T>(branch, level);
+				vint position = (index >> level) & Mask;
+				if (level == Bits)
+				{
+					auto leaf = static_cast<Leaf*>(branch->children[position]);
+					persistentlist_internal::MakeUnique<T>(leaf, 0);
+					leaf->Items()[index & Mask] = value;
+					branch->children[position] = leaf;
+				}
+				else
+				{
+					branch->children[position] = SetInBranch(static_cast<Branch*>(branch->children[position]), level - Bits, index, value);
+				}
+				return branch;
+			}
+
+			template<typename TItem>
+			void AddInternal(TItem&& item)
+			{
+				if (tail && tail->count < Width)
+				{
+					persistentlist_internal::MakeUnique<T>(tail, 0);
+				}
+				else
+				{
+					if (tail)
+					{
+						// move the full tail into the trie, add a level when the root is full
+						vint index = count - Width;
+						if (!root)
+						{
+							root = new Branch;
+							root->children[0] = tail;
+						}
+						else if ((count >> Bits) > ((vint)1 << shift))
+						{
+							auto newRoot = new Branch;
+							newRoot->children[0] = root;
+							newRoot->children[1] = NewPath(shift, tail);
+							root = newRoot;
+							shift += Bits;
+						}
+						else
+						{
+							root = PushLeaf(root, shift, index, tail);
+						}
+					}
+					tail = new Leaf;
+				}
+				new(&tail->Items()[tail->count]) T(std::forward<TItem>(item));
+				tail->count++;
+				count++;
+			}
+
+			void ReleaseAll()
+			{
+				persistentlist_internal::Release<T>(root, shift);
+				persistentlist_internal::Release<T>(tail, 0);
+				count = 0;
+				shift = Bits;
+				root = nullptr;
+				tail = nullptr;
+			}
+
+			void TakeOver(PersistentList<T>& _move)
+			{
+				count = _move.count;
+				shift = _move.shift;
+				root = _move.root;
+				tail = _move.tail;
+				_move.count = 0;
+				_move.shift = Bits;
+				_move.root = nullptr;
+				_move.tail = nullptr;
+			}
+		public:
+			/// <summary>Create an empty list.</summary>
+			PersistentList() = default;
+
+			/// <summary>Create a list sharing all elements with another list, in constant time.</summary>
+			/// <param name="list">The list to copy.</param>
+			PersistentList(const PersistentList<T>& list)
+				: count(list.count)
+				, shift(list.shift)
+				, root(list.root)
+				, tail(list.tail)
+			{
+				persistent_internal::Retain(root);
+				persistent_internal::Retain(tail);
+			}
+
+			PersistentList(PersistentList<T>&& list)
+			{
+				TakeOver(list);
+			}
+
+			~PersistentList()
+			{
+				ReleaseAll();
+			}
+
+			/// <summary>Replace all elements by sharing all elements with another list, in constant time.</summary>
+			/// <returns>The list itself.</returns>
+			/// <param name="list">The list to copy.</param>
+			PersistentList<T>& operator=(const PersistentList<T>& list)
+			{
+				PersistentList<T> copied(list);
+				ReleaseAll();
+				TakeOver(copied);
+				return *this;
+			}
+
+			PersistentList<T>& operator=(PersistentList<T>&& list)
+			{
+				ReleaseAll();
+				TakeOver(list);
+				return *this;
+			}
+
+			IEnumerator<T>* CreateEnumerator()const
+			{
+				return new Enumerator(*this);
+			}
+
+			/// <summary>Get the number of elements in the list.</summary>
+			/// <returns>The number of elements.</returns>
+			vint Count()const
+			{
+				return count;
+			}
+
+			/// <summary>Get the reference to the specified element.</summary>
+			/// <returns>The reference to the specified element. It will crash when the index is out of range.</returns>
+			/// <param name="index">The index of the element.</param>
+			const T& Get(vint index)const
+			{
+				CHECK_ERROR(index >= 0 && index < count, L"PersistentList<T>::Get(vint)#Argument index not in range.");
+				return GetLeaf(index)->Items()[index & Mask];
+			}
+
+			/// <summary>Get the reference to the specified element.</summary>
+			/// <returns>The reference to the specified element. It will crash when the index is out of range.</returns>
+			/// <param name="index">The index of the element.</param>
+			const T& operator[](vint index)const
+			{
+				CHECK_ERROR(index >= 0 && index < count, L"PersistentList<T>::operator[](vint)#Argument index not in range.");
+				return GetLeaf(index)->Items()[index & Mask];
+			}
+
+			/// <summary>Test does the list contain a value or not.</summary>
+			/// <returns>Returns true if the list contains the specified value.</returns>
+			/// <param name="item">The value to test.</param>
+			bool Contains(const K& item)const
+			{
+				return IndexOf(item) != -1;
+			}
+
+			/// <summary>Get the position of a value in this list.</summary>
+			/// <returns>Returns the position of first element that equals to the specified value. Returns -1 if failed to find.</returns>
+			/// <param name="item">The value to find.</param>
+			vint IndexOf(const K& item)const
+			{
+				for (vint i = 0; i < count; i += Width)
+				{
+					auto leaf = GetLeaf(i);
+					for (vint j = 0; j < leaf->count; j++)
+					{
+						if (leaf->Items()[j] == item)
+						{
+							return i + j;
+						}
+					}
+				}
+				return -1;
+			}
+
+			/// <summary>Append a value at the end of the list.</summary>
+			/// <returns>The index of the added item.</returns>
+			/// <param name="item">The value to add.</param>
+			vint Add(const T& item)
+			{
+				AddInternal(item);
+				return count - 1;
+			}
+
+			/// <summary>Append a value at the end of the list.</summary>
+			/// <returns>The index of the added item.</returns>
+			/// <param name="item">The value to add.</param>
+			vint Add(T&& item)
+			{
+				AddInternal(std::move(item));
+				return count - 1;
+			}
+
+			/// <summary>Replace an element in the specified position.</summary>
+			/// <returns>Returns true if this operation succeeded. It will crash when the index is out of range</returns>
+			/// <param name="index">The position of the element to replace.</param>
+			/// <param name="item">The new value to replace.</param>
+			bool Set(vint index, const T& item)
+			{
+				CHECK_ERROR(index >= 0 && index < count, L"PersistentList<T>::Set(vint, const T&)#Argument index not in range.");
+				if (index >= TailOffset())
+				{
+					persistentlist_internal::MakeUnique<T>(tail, 0);
+					tail->Items()[index & Mask] = item;
+				}
+				else
+				{
+					root = SetInBranch(root, shift, index, item);
+				}
+				return true;
+			}
+
+			/// <summary>Remove the last element.</summary>
+			/// <returns>Returns true if the element is removed. It will crash if the list is empty.</returns>
+			bool RemoveLast()
+			{
+				CHECK_ERROR(count > 0, L"PersistentList<T>::RemoveLast()#The list is empty.");
+				if (count == 1)
+				{
+					ReleaseAll();
+				}
+				else if (tail->count > 1)
+				{
+					persistentlist_internal::MakeUnique<T>(tail, 0);
+					tail->count--;
+					tail->Items()[tail->count].~T();
+					count--;
+				}
+				else
+				{
+					// the last leaf in the trie becomes the tail, remove a level when the root only has one child
+					auto newTail = const_cast<Leaf*>(GetLeaf(count - 2));
+					persistent_internal::Retain(newTail);
+					persistentlist_internal::Release<T>(tail, 0);
+					tail = newTail;
+					root = PopLeaf(root, shift, count - 2);
+					if (!root)
+					{
+						shift = Bits;
+					}
+					else if (shift > Bits && root->children[1] == nullptr)
+					{
+						auto child = static_cast<Branch*>(root->children[0]);
+						root->children[0] = nullptr;
+						persistentlist_internal::Release<T>(root, shift);
+						root = child;
+						shift -= Bits;
+					}
+					count--;
+				}
+				return true;
+			}
+
+			/// <summary>Remove all elements.</summary>
+			/// <returns>Returns true if all elements are removed.</returns>
+			bool Clear()
+			{
+				ReleaseAll();
+				return true;
+			}
+		};
+
+/***********************************************************************
+Random Access
+***********************************************************************/
+
+		namespace randomaccess_internal
+		{
+			template<typename T>
+			struct RandomAccessable<PersistentList<T>>
+			{
+				static const bool							CanRead = true;
+				static const bool							CanResize = false;
+			};
+
+			template<typename T>
+			struct RandomAccess<PersistentList<T>>
+			{
+				static vint GetCount(const PersistentList<T>& t)
+				{
+					return t.Count();
+				}
+
+				static const T& GetValue(const PersistentList<T>& t, vint index)
+				{
+					return t.Get(index);
+				}
+
+				static void AppendValue(PersistentList<T>& t, const T& value)
+				{
+					t.Add(value);
+				}
+			};
+		}
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
@@ -0,0 +1,461 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_PRIORITYQUEUE
+#define VCZH_COLLECTIONS_PRIORITYQUEUE
+
+#include "List.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		/// <summary>The default orderer for priority queues, it compares two values using the spaceship operator.</summary>
+		struct DefaultOrderer
+		{
+			template<typename T>
+			auto operator()(const T& a, const T& b)const
+			{
+				return a <=> b;
+			}
+		};
+
+		namespace heap_internal
+		{
+			template<typename T, typename F>
+			bool IsOrderedBefore(F& orderer, const T& a, const T& b)
+			{
+				auto ordering = orderer(a, b);
+				if constexpr (std::is_same_v<decltype(ordering), std::partial_ordering>)
+				{
+					CHECK_ERROR(ordering != std::partial_ordering::unordered, L"vl::collections::heap_internal::IsOrderedBefore(F&, const T&, const T&)#Priority queues could not apply on elements in partial ordering.");
+				}
+				return ordering < 0;
+			}
+
+			/// <summary>Move an element towards the root until its parent is not ordered after it.</summary>
+			/// <remarks>The moved callback is called for every element that gets a new position.</remarks>
+			template<typename T, typename F, typename TMoved>
+			void SiftUp(T* items, vint index, F& orderer, TMoved&& moved)
+			{
+				T item = std::move(items[index]);
+				while (index > 0)
+				{
+					vint parent = (index - 1) / 2;
+					if (!IsOrderedBefore(orderer, item, items[parent])) break;
+					items[index] = std::move(items[parent]);
+					moved(items[index], index);
+					index = parent;
+				}
+				items[index] = std::move(item);
+				moved(items[index], index);
+			}
+
+			/// <summary>Move an element towards leaves until none of its children is ordered before it.</summary>
+			/// <remarks>The moved callback is called for every element that gets a new position.</remarks>
+			template<typename T, typename F, typename TMoved>
+			void SiftDown(T* items, vint count, vint index, F& orderer, TMoved&& moved)
+			{
+				T item = std::move(items[index]);
+				while (true)
+				{
+					vint child = index * 2 + 1;
+					if (child >= count) break;
+					if (child + 1 < count && IsOrderedBefore(orderer, items[child + 1], items[child]))
+					{
+						child++;
+					}
+					if (!IsOrderedBefore(orderer, items[child], item)) break;
+					items[index] = std::move(items[child]);
+					moved(items[index], index);
+					index = child;
+				}
+				items[index] = std::move(item);
+				moved(items[index], index);
+			}
+
+			/// <summary>Rearrange all elements into a binary heap in linear time.</summary>
+			template<typename T, typename F, typename TMoved>
+			void Heapify(T* items, vint count, F& orderer, TMoved&& moved)
+			{
+				for (vint i = count / 2 - 1; i >= 0; i--)
+				{
+					SiftDown(items, count, i, orderer, moved);
+				}
+			}
+
+			struct NotifyNothing
+			{
+				template<typename T>
+				void operator()(const T&, vint)const
+				{
+				}
+			};
+		}
+
+/***********************************************************************
+PriorityQueue
+***********************************************************************/
+
+		/// <summary>
+		/// PriorityQueue: binary heap stored in a <see cref="List`2"/>.
+		/// The top element is the one that is ordered before all other elements.
+		/// </summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <typeparam name="F">
+		/// Type of the orderer. It compares two elements returning std::(strong|weak|partial)_ordering like the orderer in <see cref="SortLambda`2"/>.
+		/// </typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for the buffer, see <see cref="DefaultAllocator"/>.</typeparam>
+		/// <remarks>Adding and removing elements take O(log n) time, building from an existing list takes O(n) time.</remarks>
+		template<typename T, typename F = DefaultOrderer, typename TAllocator = DefaultAllocator>
+		class PriorityQueue
+		{
+		protected:
+			List<T, TAllocator>						items;
+			VCZH_NO_UNIQUE_ADDRESS F				orderer;
+
+			void HeapifyTakenOverItems()
+			{
+				if (items.Count() > 1)
+				{
+					heap_internal::Heapify(&items[0], items.Count(), orderer, heap_internal::NotifyNothing());
+				}
+			}
+		public:
+			/// <summary>Create an empty priority queue.</summary>
+			PriorityQueue() = default;
+
+			/// <summary>Create an empty priority queue with an orderer and an allocator.</summary>
+			/// <param name="_orderer">The orderer.</param>
+			/// <param name="_allocator">The allocator for the buffer.</param>
+			explicit PriorityQueue(const F& _orderer, const TAllocator& _allocator = TAllocator())
+				: items(_allocator)
+				, orderer(_orderer)
+			{
+			}
+
+			/// <summary>Create a priority queue by taking over the buffer of a list, no element is copied. Elements are rearranged in O(n) time.</summary>
+			/// <param name="container">The list to take over. It becomes empty after the priority queue is created.</param>
+			/// <param name="_orderer">The orderer.</param>
+			explicit PriorityQueue(List<T, TAllocator>&& container, const F& _orderer = F())
+				: items(std::move(container))
+				, orderer(_orderer)
+			{
+				HeapifyTakenOverItems();
+			}
+
+			PriorityQueue(PriorityQueue<T, F, TAllocator>&& container) = default;
+			PriorityQueue<T, F, TAllocator>& operator=(PriorityQueue<T, F, TAllocator>&& _move) = default;
+
+			/// <summary>Replace all elements by taking over the buffer of a list, no element is copied. Elements are rearranged in O(n) time.</summary>
+			/// <returns>The priority queue itself.</returns>
+			/// <param name="_move">The list to take over. It becomes empty after the priority queue is changed.</param>
+			PriorityQueue<T, F, TAllocator>& operator=(List<T, TAllocator>&& _move)
+			{
+				items = std::move(_move);
+				HeapifyTakenOverItems();
+				return *this;
+			}
+
+			/// <summary>Get the number of elements.</summary>
+			/// <returns>The number of elements.</returns>
+			vint Count()const
+			{
+				return items.Count();
+			}
+
+			/// <summary>Make sure the buffer could hold a specified number of elements without growing.</summary>
+			/// <param name="_capacity">The expected number of elements.</param>
+			void Reserve(vint _capacity)
+			{
+				items.Reserve(_capacity);
+			}
+
+			/// <summary>Add an element.</summary>
+			/// <param name="item">The element to add.</param>
+			void Push(const T& item)
+			{
+				items.Add(item);
+				heap_internal::SiftUp(&items[0], items.Count() - 1, orderer, heap_internal::NotifyNothing());
+			}
+
+			/// <summary>Add an element.</summary>
+			/// <param name="item">The element to add.</param>
+			void Push(T&& item)
+			{
+				items.Add(std::move(item));
+				heap_internal::SiftUp(&items[0], items.Count() - 1, orderer, heap_internal::NotifyNothing());
+			}
+
+			/// <summary>Get the top element.</summary>
+			/// <returns>The element that is ordered before all other elements. It will crash if the priority queue is empty.</returns>
+			const T& Top()const
+			{
+				CHECK_ERROR(items.Count() > 0, L"PriorityQueue<T, F, TAllocator>::Top()#The priority queue is empty.");
+				return items[0];
+			}
+
+			/// <summary>Remove the top element.</summary>
+			/// <returns>The removed element. It will crash if the priority queue is empty.</returns>
+			T Pop()
+			{
+				CHECK_ERROR(items.Count() > 0, L"PriorityQueue<T, F, TAllocator>::Pop()#The priority queue is empty.");
+				vint last = items.Count() - 1;
+				T item = std::move(items[0]);
+				if (last > 0)
+				{
+					items[0] = std::move(items[last]);
+				}
+				items.RemoveAt(last);
+				if (last > 1)
+				{
+					heap_internal::SiftDown(&items[0], last, 0, orderer, heap_internal::NotifyNothing());
+				}
+				return item;
+			}
+
+			/// <summary>Remove all elements.</summary>
+			/// <returns>Returns true if all elements are removed.</returns>
+			bool Clear()
+			{
+				return items.Clear();
+			}
+		};
+
+/***********************************************************************
+IndexedPriorityQueue
+***********************************************************************/
+
+		/// <summary>
+		/// IndexedPriorityQueue: priority queue that identifies each element by a handle, so that its priority could be changed after it is added.
+		/// The top element is the one that is ordered before all other elements.
+		/// </summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <typeparam name="F">
+		/// Type of the orderer. It compares two elements returning std::(strong|weak|partial)_ordering like the orderer in <see cref="SortLambda`2"/>.
+		/// </typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for buffers, see <see cref="DefaultAllocator"/>.</typeparam>
+		/// <remarks>
+		/// <see cref="Push"/> returns a non-negative handle, which stays valid until the element is removed.
+		/// Handles of removed elements are reused by later calls to <see cref="Push"/>.
+		/// </remarks>
+		template<typename T, typename F = DefaultOrderer, typename TAllocator = DefaultAllocator>
+		class IndexedPriorityQueue
+		{
+		protected:
+			struct Node
+			{
+				T									value;
+				vint								handle;
+			};
+
+			List<Node, TAllocator>					nodes;
+			List<vint, TAllocator>					positions;
+			List<vint, TAllocator>					freeHandles;
+			VCZH_NO_UNIQUE_ADDRESS F				orderer;
+
+			auto NodeOrderer()
+			{
+				return [this](const Node& a, const Node& b) { return orderer(a.value, b.value); };
+			}
+
+			auto NodeMoved()
+			{
+				return [this](const Node& node, vint index) { positions[node.handle] = index; };
+			}
+
+			vint AllocateHandle()
+			{
+				if (freeHandles.Count() > 0)
+				{
+					vint handle = freeHandles[freeHandles.Count() - 1];
+					freeHandles.RemoveAt(freeHandles.Count() - 1);
+					return handle;
+				}
+				return positions.Add(-1);
+			}
+
+			template<typename TItem>
+			vint PushInternal(TItem&& item)
+			{
+				vint handle = AllocateHandle();
+				vint index = nodes.Add({ std::forward<TItem&&>(item), handle });
+				auto nodeOrderer = NodeOrderer();
+				heap_internal::SiftUp(&nodes[0], index, nodeOrderer, NodeMoved());
+				return handle;
+			}
+
+			T RemoveAtPosition(vint index)
+			{
+				vint last = nodes.Count() - 1;
+				Node& node = nodes[index];
+				T item = std::move(node.value);
+				positions[node.handle] = -1;
+				freeHandles.Add(node.handle);
+				if (index != last)
+				{
+					node = std::move(nodes[last]);
+				}
+				nodes.RemoveAt(last);
+				if (index != last)
+				{
+					auto nodeOrderer = NodeOrderer();
+					if (index > 0 && heap_internal::IsOrderedBefore(nodeOrderer, nodes[index], nodes[(index - 1) / 2]))
+					{
+						heap_internal::SiftUp(&nodes[0], index, nodeOrderer, NodeMoved());
+					}
+					else
+					{
+						heap_internal::SiftDown(&nodes[0], last, index, nodeOrderer, NodeMoved());
+					}
+				}
+				return item;
+			}
+
+			template<typename TItem>
+			void DecreaseKeyInternal(vint handle, TItem&& item)
+			{
+				CHECK_ERROR(Contains(handle), L"IndexedPriorityQueue<T, F, TAllocator>::DecreaseKey(vint, const T&)#Argument handle does not refer to an element.");
+				vint index = positions[handle];
+				CHECK_ERROR(!heap_internal::IsOrderedBefore(orderer, nodes[index].value, item), L"IndexedPriorityQueue<T, F, TAllocator>::DecreaseKey(vint, const T&)#Argument item should not be ordered after the old value.");
+				nodes[index].value = std::forward<TItem&&>(item);
+				auto nodeOrderer = NodeOrderer();
+				heap_internal::SiftUp(&nodes[0], index, nodeOrderer, NodeMoved());
+			}
+		public:
+			/// <summary>Create an empty priority queue.</summary>
+			IndexedPriorityQueue() = default;
+
+			/// <summary>Create an empty priority queue with an orderer and an allocator.</summary>
+			/// <param name="_orderer">The orderer.</param>
+			/// <param name="_allocator">The allocator for buffers.</param>
+			explicit IndexedPriorityQueue(const F& _orderer, const TAllocator& _allocator = TAllocator())
+				: nodes(_allocator)
+				, positions(_allocator)
+				, freeHandles(_allocator)
+				, orderer(_orderer)
+			{
+			}
+
+			IndexedPriorityQueue(IndexedPriorityQueue<T, F, TAllocator>&& container) = default;
+			IndexedPriorityQueue<T, F, TAllocator>& operator=(IndexedPriorityQueue<T, F, TAllocator>&& _move) = default;
+
+			/// <summary>Get the number of elements.</summary>
+			/// <returns>The number of elements.</returns>
+			vint Count()const
+			{
+				return nodes.Count();
+			}
+
+			/// <summary>Test if a handle refers to an element in the priority queue.</summary>
+			/// <returns>Returns true if the element has been added and not been removed.</returns>
+			/// <param name="handle">The handle to test.</param>
+			bool Contains(vint handle)const
+			{
+				return 0 <= handle && handle < positions.Count() && positions[handle] != -1;
+			}
+
+			/// <summary>Get an element by its handle.</summary>
+			/// <returns>The element. It will crash if the handle does not refer to an element in the priority queue.</returns>
+			/// <param name="handle">The handle of the element.</param>
+			const T& Get(vint handle)const
+			{
+				CHECK_ERROR(Contains(handle), L"IndexedPriorityQueue<T, F, TAllocator>::Get(vint)#Argument handle does not refer to an element.");
+				return nodes[positions[handle]].value;
+			}
+
+			/// <summary>Add an element.</summary>
+			/// <returns>The handle of the added element.</returns>
+			/// <param name="item">The element to add.</param>
+			vint Push(const T& item)
+			{
+				return PushInternal(item);
+			}
+
+			/// <summary>Add an element.</summary>
+			/// <returns>The handle of the added element.</returns>
+			/// <param name="item">The element to add.</param>
+			vint Push(T&& item)
+			{
+				return PushInternal(std::move(item));
+			}
+
+			/// <summary>Get the top element.</summary>
+			/// <returns>The element that is ordered before all other elements. It will crash if the priority queue is empty.</returns>
+			const T& Top()const
+			{
+				CHECK_ERROR(nodes.Count() > 0, L"IndexedPriorityQueue<T, F, TAllocator>::Top()#The priority queue is empty.");
+				return nodes[0].value;
+			}
+
+			/// <summary>Get the handle of the top element.</summary>
+			/// <returns>The handle of the element that is ordered before all other elements. It will crash if the priority queue is empty.</returns>
+			vint TopHandle()const
+			{
+				CHECK_ERROR(nodes.Count() > 0, L"IndexedPriorityQueue<T, F, TAllocator>::TopHandle()#The priority queue is empty.");
+				return nodes[0].handle;
+			}
+
+			/// <summary>Remove the top element. Its handle becomes invalid.</summary>
+			/// <returns>The removed element. It will crash if the priority queue is empty.</returns>
+			T Pop()
+			{
+				CHECK_ERROR(nodes.Count() > 0, L"IndexedPriorityQueue<T, F, TAllocator>::Pop()#The priority queue is empty.");
+				return RemoveAtPosition(0);
+			}
+
+			/// <summary>Remove an element by its handle. The handle becomes invalid.</summary>
+			/// <returns>The removed element. It will crash if the handle does not refer to an element in the priority queue.</returns>
+			/// <param name="handle">The handle of the element.</param>
+			T Remove(vint handle)
+			{
+				CHECK_ERROR(Contains(handle), L"IndexedPriorityQueue<T, F, TAllocator>::Remove(vint)#Argument handle does not refer to an element.");
+				return RemoveAtPosition(positions[handle]);
+			}
+
+			/// <summary>Replace an element with a new value that is not ordered after it, in O(log n) time.</summary>
+			/// <param name="handle">The handle of the element.</param>
+			/// <param name="item">
+			/// The new value.
+			/// It will crash if the handle does not refer to an element in the priority queue, or the new value is ordered after the old value.
+			/// </param>
+			void DecreaseKey(vint handle, const T& item)
+			{
+				DecreaseKeyInternal(handle, item);
+			}
+
+			/// <summary>Replace an element with a new value that is not ordered after it, in O(log n) time.</summary>
+			/// <param name="handle">The handle of the element.</param>
+			/// <param name="item">
+			/// The new value.
+			/// It will crash if the handle does not refer to an element in the priority queue, or the new value is ordered after the old value.
+			/// </param>
+			void DecreaseKey(vint handle, T&& item)
+			{
+				DecreaseKeyInternal(handle, std::move(item));
+			}
+
+			/// <summary>Remove all elements. All handles become invalid.</summary>
+			/// <returns>Returns true if all elements are removed.</returns>
+			bool Clear()
+			{
+				nodes.Clear();
+				positions.Clear();
+				freeHandles.Clear();
+				return true;
+			}
+		};
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
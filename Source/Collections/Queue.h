@@ -0,0 +1,709 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_QUEUE
+#define VCZH_COLLECTIONS_QUEUE
+
+#include "List.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		namespace ringbuffer_internal
+		{
+			/// <summary>Base class of containers storing elements in a ring buffer, whose capacity is always zero or a power of two.</summary>
+			/// <typeparam name="T">Type of elements.</typeparam>
+			/// <typeparam name="TAllocator">Type of the allocator for the buffer, see <see cref="DefaultAllocator"/>.</typeparam>
+			template<typename T, typename TAllocator>
+			class RingBufferBase abstract : public EnumerableBase<T>
+			{
+				using K = typename KeyType<T>::Type;
+			protected:
+				class Enumerator : public Object, public virtual IEnumerator<T>
+				{
+				private:
+					const RingBufferBase<T, TAllocator>*	container;
+					vint									index;
+
+				public:
+					POOLED_ALLOCATION(Enumerator)
+
+					Enumerator(const RingBufferBase<T, TAllocator>* _container, vint _index = -1)
+					{
+						container = _container;
+						index = _index;
+					}
+
+					IEnumerator<T>* Clone()const override
+					{
+						return new Enumerator(container, index);
+					}
+
+					const T& Current()const override
+					{
+						return container->Get(index);
+					}
+
+					vint Index()const override
+					{
+						return index;
+					}
+
+					bool Next() override
+					{
+						index++;
+						return index >= 0 && index < container->Count();
+					}
+
+					void Reset() override
+					{
+						index = -1;
+					}
+
+					bool Evaluated()const override
+					{
+						return true;
+					}
+				};
+
+				VCZH_NO_UNIQUE_ADDRESS TAllocator		allocator;
+				T*										buffer = nullptr;
+				vint									capacity = 0;
+				vint									head = 0;
+				vint									count = 0;
+
+				vint Wrap(vint index)const
+				{
+					return index & (capacity - 1);
+				}
+
+				static vint GetPowerOfTwoCapacity(vint minCapacity)
+				{
+					vint newCapacity = 4;
+					while (newCapacity < minCapacity)
+					{
+						newCapacity *= 2;
+					}
+					return newCapacity;
+				}
+
+				void MoveToBuffer(T* newBuffer, vint newCapacity)
+				{
+					// elements are relocated to the beginning of the new buffer, both halves are moved in bulk
+					vint firstHalf = capacity - head < count ? capacity - head : count;
+					memory_management::RelocateItems(newBuffer, buffer + head, firstHalf);
+					memory_management::RelocateItems(newBuffer + firstHalf, buffer, count - firstHalf);
+					memory_management::DeallocateBuffer(allocator, buffer, capacity);
+					buffer = newBuffer;
+					capacity = newCapacity;
+					head = 0;
+				}
+
+				void Reallocate(vint newCapacity)
+				{
+					MoveToBuffer(memory_management::AllocateBuffer<T>(allocator, newCapacity), newCapacity);
+				}
+
+				// the item could be an element in the buffer, so when growing, it is constructed in the new buffer before the old buffer is released
+				template<typename TItem>
+				T* AllocateGrownBuffer(vint newCapacity, vint index, TItem&& item)
+				{
+					T* newBuffer = memory_management::AllocateBuffer<T>(allocator, newCapacity);
+					try
+					{
+						new(&newBuffer[index]) T(std::forward<TItem&&>(item));
+					}
+					catch (...)
+					{
+						memory_management::DeallocateBuffer(allocator, newBuffer, newCapacity);
+						throw;
+					}
+					return newBuffer;
+				}
+
+				template<typename TItem>
+				void GrowAndPushBack(TItem&& item)
+				{
+					if (count < capacity)
+					{
+						PushBackInternal(std::forward<TItem&&>(item));
+						return;
+					}
+
+					vint newCapacity = capacity == 0 ? 4 : capacity * 2;
+					MoveToBuffer(AllocateGrownBuffer(newCapacity, count, std::forward<TItem&&>(item)), newCapacity);
+					count++;
+				}
+
+				template<typename TItem>
+				void GrowAndPushFront(TItem&& item)
+				{
+					if (count < capacity)
+					{
+						PushFrontInternal(std::forward<TItem&&>(item));
+						return;
+					}
+
+					vint newCapacity = capacity == 0 ? 4 : capacity * 2;
+					MoveToBuffer(AllocateGrownBuffer(newCapacity, newCapacity - 1, std::forward<TItem&&>(item)), newCapacity);
+					head = newCapacity - 1;
+					count++;
+				}
+
+				template<typename TItem>
+				void PushBackInternal(TItem&& item)
+				{
+					new(&buffer[Wrap(head + count)]) T(std::forward<TItem&&>(item));
+					count++;
+				}
+
+				template<typename TItem>
+				void PushFrontInternal(TItem&& item)
+				{
+					vint index = Wrap(head + capacity - 1);
+					new(&buffer[index]) T(std::forward<TItem&&>(item));
+					head = index;
+					count++;
+				}
+
+				T PopFrontInternal()
+				{
+					T& slot = buffer[head];
+					T item = std::move(slot);
+					slot.~T();
+					head = Wrap(head + 1);
+					count--;
+					return item;
+				}
+
+				T PopBackInternal()
+				{
+					T& slot = buffer[Wrap(head + count - 1)];
+					T item = std::move(slot);
+					slot.~T();
+					count--;
+					return item;
+				}
+
+				void RemoveFrontInternal()
+				{
+					buffer[head].~T();
+					head = Wrap(head + 1);
+					count--;
+				}
+
+				void RemoveBackInternal()
+				{
+					buffer[Wrap(head + count - 1)].~T();
+					count--;
+				}
+
+				void ReleaseBuffer()
+				{
+					vint firstHalf = capacity - head < count ? capacity - head : count;
+					memory_management::CallDtors(buffer + head, firstHalf);
+					memory_management::CallDtors(buffer, count - firstHalf);
+					memory_management::DeallocateBuffer(allocator, buffer, capacity);
+					buffer = nullptr;
+					capacity = 0;
+					head = 0;
+					count = 0;
+				}
+
+				void TakeOver(RingBufferBase<T, TAllocator>& _move)
+				{
+					allocator = _move.allocator;
+					buffer = _move.buffer;
+					capacity = _move.capacity;
+					head = _move.head;
+					count = _move.count;
+					_move.buffer = nullptr;
+					_move.capacity = 0;
+					_move.head = 0;
+					_move.count = 0;
+				}
+
+				RingBufferBase() = default;
+
+				RingBufferBase(const TAllocator& _allocator)
+					: allocator(_allocator)
+				{
+				}
+
+				RingBufferBase(const RingBufferBase<T, TAllocator>&) = delete;
+				RingBufferBase(RingBufferBase<T, TAllocator>&& _move)
+				{
+					TakeOver(_move);
+				}
+
+				RingBufferBase<T, TAllocator>& operator=(const RingBufferBase<T, TAllocator>&) = delete;
+				RingBufferBase<T, TAllocator>& operator=(RingBufferBase<T, TAllocator>&& _move)
+				{
+					ReleaseBuffer();
+					TakeOver(_move);
+					return *this;
+				}
+
+			public:
+				~RingBufferBase()
+				{
+					ReleaseBuffer();
+				}
+
+				IEnumerator<T>* CreateEnumerator()const
+				{
+					return new Enumerator(this);
+				}
+
+				/// <summary>Get the allocator of this container.</summary>
+				/// <returns>A copy of the allocator.</returns>
+				TAllocator GetAllocator()const
+				{
+					return allocator;
+				}
+
+				/// <summary>Get the number of elements in the container.</summary>
+				/// <returns>The number of elements.</returns>
+				vint Count()const
+				{
+					return count;
+				}
+
+				/// <summary>Get the number of elements that the buffer could hold without growing.</summary>
+				/// <returns>The capacity, which is always zero or a power of two.</returns>
+				vint Capacity()const
+				{
+					return capacity;
+				}
+
+				/// <summary>Get the reference to the specified element. The first element is at position 0.</summary>
+				/// <returns>The reference to the specified element. It will crash when the index is out of range.</returns>
+				/// <param name="index">The index of the element.</param>
+				const T& Get(vint index)const
+				{
+					CHECK_ERROR(index >= 0 && index < count, L"RingBufferBase<T, TAllocator>::Get(vint)#Argument index not in range.");
+					return buffer[Wrap(head + index)];
+				}
+
+				/// <summary>Get the reference to the specified element. The first element is at position 0.</summary>
+				/// <returns>The reference to the specified element. It will crash when the index is out of range.</returns>
+				/// <param name="index">The index of the element.</param>
+				const T& operator[](vint index)const
+				{
+					CHECK_ERROR(index >= 0 && index < count, L"RingBufferBase<T, TAllocator>::operator[](vint)#Argument index not in range.");
+					return buffer[Wrap(head + index)];
+				}
+
+				/// <summary>Test does the container contain a value or not.</summary>
+				/// <returns>Returns true if the container contains the specified value.</returns>
+				/// <param name="item">The value to test.</param>
+				bool Contains(const K& item)const
+				{
+					return IndexOf(item) != -1;
+				}
+
+				/// <summary>Get the position of a value in this container.</summary>
+				/// <returns>Returns the position of first element that equals to the specified value. Returns -1 if failed to find.</returns>
+				/// <param name="item">The value to find.</param>
+				vint IndexOf(const K& item)const
+				{
+					for (vint i = 0; i < count; i++)
+					{
+						if (buffer[Wrap(head + i)] == item)
+						{
+							return i;
+						}
+					}
+					return -1;
+				}
+
+				/// <summary>Remove all elements and release the buffer.</summary>
+				/// <returns>Returns true if all elements are removed.</returns>
+				bool Clear()
+				{
+					ReleaseBuffer();
+					return true;
+				}
+			};
+		}
+
+/***********************************************************************
+Queue
+***********************************************************************/
+
+		/// <summary>Queue: first in first out container backed by a ring buffer. Adding and removing elements take amortized constant time.</summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for the buffer, see <see cref="DefaultAllocator"/>.</typeparam>
+		template<typename T, typename TAllocator = DefaultAllocator>
+		class Queue : public ringbuffer_internal::RingBufferBase<T, TAllocator>
+		{
+		public:
+			/// <summary>Create an empty queue.</summary>
+			Queue() = default;
+			~Queue() = default;
+
+			/// <summary>Create an empty queue with an allocator.</summary>
+			/// <param name="_allocator">The allocator for the buffer.</param>
+			explicit Queue(const TAllocator& _allocator) : ringbuffer_internal::RingBufferBase<T, TAllocator>(_allocator) {}
+			Queue(Queue<T, TAllocator>&& container) : ringbuffer_internal::RingBufferBase<T, TAllocator>(std::move(container)) {}
+			Queue<T, TAllocator>& operator=(Queue<T, TAllocator>&& _move) = default;
+
+			/// <summary>Make sure the buffer could hold a specified number of elements without growing.</summary>
+			/// <param name="_capacity">The expected number of elements.</param>
+			void Reserve(vint _capacity)
+			{
+				if (_capacity > this->capacity)
+				{
+					this->Reallocate(this->GetPowerOfTwoCapacity(_capacity));
+				}
+			}
+
+			/// <summary>Add an element to the end of the queue.</summary>
+			/// <param name="item">The element to add.</param>
+			void Enqueue(const T& item)
+			{
+				this->GrowAndPushBack(item);
+			}
+
+			/// <summary>Add an element to the end of the queue.</summary>
+			/// <param name="item">The element to add.</param>
+			void Enqueue(T&& item)
+			{
+				this->GrowAndPushBack(std::move(item));
+			}
+
+			/// <summary>Remove the first element from the queue.</summary>
+			/// <returns>The removed element. It will crash if the queue is empty.</returns>
+			T Dequeue()
+			{
+				CHECK_ERROR(this->count > 0, L"Queue<T, TAllocator>::Dequeue()#The queue is empty.");
+				return this->PopFrontInternal();
+			}
+
+			/// <summary>Get the first element in the queue.</summary>
+			/// <returns>The first element. It will crash if the queue is empty.</returns>
+			const T& Peek()const
+			{
+				CHECK_ERROR(this->count > 0, L"Queue<T, TAllocator>::Peek()#The queue is empty.");
+				return this->buffer[this->head];
+			}
+		};
+
+/***********************************************************************
+Deque
+***********************************************************************/
+
+		/// <summary>Deque: double ended queue backed by a ring buffer. Adding and removing elements at both ends take amortized constant time.</summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for the buffer, see <see cref="DefaultAllocator"/>.</typeparam>
+		template<typename T, typename TAllocator = DefaultAllocator>
+		class Deque : public ringbuffer_internal::RingBufferBase<T, TAllocator>
+		{
+		public:
+			/// <summary>Create an empty deque.</summary>
+			Deque() = default;
+			~Deque() = default;
+
+			/// <summary>Create an empty deque with an allocator.</summary>
+			/// <param name="_allocator">The allocator for the buffer.</param>
+			explicit Deque(const TAllocator& _allocator) : ringbuffer_internal::RingBufferBase<T, TAllocator>(_allocator) {}
+			Deque(Deque<T, TAllocator>&& container) : ringbuffer_internal::RingBufferBase<T, TAllocator>(std::move(container)) {}
+			Deque<T, TAllocator>& operator=(Deque<T, TAllocator>&& _move) = default;
+
+			/// <summary>Make sure the buffer could hold a specified number of elements without growing.</summary>
+			/// <param name="_capacity">The expected number of elements.</param>
+			void Reserve(vint _capacity)
+			{
+				if (_capacity > this->capacity)
+				{
+					this->Reallocate(this->GetPowerOfTwoCapacity(_capacity));
+				}
+			}
+
+			/// <summary>Add an element before the first element.</summary>
+			/// <param name="item">The element to add.</param>
+			void PushFront(const T& item)
+			{
+				this->GrowAndPushFront(item);
+			}
+
+			/// <summary>Add an element before the first element.</summary>
+			/// <param name="item">The element to add.</param>
+			void PushFront(T&& item)
+			{
+				this->GrowAndPushFront(std::move(item));
+			}
+
+			/// <summary>Add an element after the last element.</summary>
+			/// <param name="item">The element to add.</param>
+			void PushBack(const T& item)
+			{
+				this->GrowAndPushBack(item);
+			}
+
+			/// <summary>Add an element after the last element.</summary>
+			/// <param name="item">The element to add.</param>
+			void PushBack(T&& item)
+			{
+				this->GrowAndPushBack(std::move(item));
+			}
+
+			/// <summary>Remove the first element.</summary>
+			/// <returns>The removed element. It will crash if the deque is empty.</returns>
+			T PopFront()
+			{
+				CHECK_ERROR(this->count > 0, L"Deque<T, TAllocator>::PopFront()#The deque is empty.");
+				return this->PopFrontInternal();
+			}
+
+			/// <summary>Remove the last element.</summary>
+			/// <returns>The removed element. It will crash if the deque is empty.</returns>
+			T PopBack()
+			{
+				CHECK_ERROR(this->count > 0, L"Deque<T, TAllocator>::PopBack()#The deque is empty.");
+				return this->PopBackInternal();
+			}
+
+			/// <summary>Get the first element.</summary>
+			/// <returns>The first element. It will crash if the deque is empty.</returns>
+			const T& Front()const
+			{
+				CHECK_ERROR(this->count > 0, L"Deque<T, TAllocator>::Front()#The deque is empty.");
+				return this->buffer[this->head];
+			}
+
+			/// <summary>Get the last element.</summary>
+			/// <returns>The last element. It will crash if the deque is empty.</returns>
+			const T& Back()const
+			{
+				CHECK_ERROR(this->count > 0, L"Deque<T, TAllocator>::Back()#The deque is empty.");
+				return this->buffer[this->Wrap(this->head + this->count - 1)];
+			}
+		};
+
+/***********************************************************************
+FixedRingBuffer
+***********************************************************************/
+
+		/// <summary>
+		/// FixedRingBuffer: double ended queue that holds no more than a fixed number of elements.
+		/// When it is full, adding an element to one end discards an element from the other end.
+		/// </summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for the buffer, see <see cref="DefaultAllocator"/>.</typeparam>
+		/// <remarks>The buffer is allocated once when the first element is added, it never grows.</remarks>
+		template<typename T, typename TAllocator = DefaultAllocator>
+		class FixedRingBuffer : public ringbuffer_internal::RingBufferBase<T, TAllocator>
+		{
+		protected:
+			vint								maxCount = 0;
+
+			void Prepare()
+			{
+				if (!this->buffer)
+				{
+					this->Reallocate(this->GetPowerOfTwoCapacity(maxCount));
+				}
+			}
+		public:
+			/// <summary>Create an empty ring buffer.</summary>
+			/// <param name="_maxCount">The maximum number of elements. It will crash if it is not positive.</param>
+			/// <param name="_allocator">The allocator for the buffer.</param>
+			FixedRingBuffer(vint _maxCount, const TAllocator& _allocator = TAllocator())
+				: ringbuffer_internal::RingBufferBase<T, TAllocator>(_allocator)
+				, maxCount(_maxCount)
+			{
+				CHECK_ERROR(maxCount > 0, L"FixedRingBuffer<T, TAllocator>::FixedRingBuffer(vint)#The maximum number of elements should be positive.");
+			}
+			~FixedRingBuffer() = default;
+
+			FixedRingBuffer(FixedRingBuffer<T, TAllocator>&& container) : ringbuffer_internal::RingBufferBase<T, TAllocator>(std::move(container)), maxCount(container.maxCount) {}
+			FixedRingBuffer<T, TAllocator>& operator=(FixedRingBuffer<T, TAllocator>&& _move) = default;
+
+			/// <summary>Get the maximum number of elements.</summary>
+			/// <returns>The maximum number of elements.</returns>
+			vint MaxCount()const
+			{
+				return maxCount;
+			}
+
+			/// <summary>Add an element before the first element. If the ring buffer is full, the last element is discarded.</summary>
+			/// <returns>Returns true if an element is discarded.</returns>
+			/// <param name="item">The element to add.</param>
+			bool PushFront(const T& item)
+			{
+				return PushFrontInternal<const T&>(item);
+			}
+
+			/// <summary>Add an element before the first element. If the ring buffer is full, the last element is discarded.</summary>
+			/// <returns>Returns true if an element is discarded.</returns>
+			/// <param name="item">The element to add.</param>
+			bool PushFront(T&& item)
+			{
+				return PushFrontInternal<T&&>(std::move(item));
+			}
+
+			/// <summary>Add an element after the last element. If the ring buffer is full, the first element is discarded.</summary>
+			/// <returns>Returns true if an element is discarded.</returns>
+			/// <param name="item">The element to add.</param>
+			bool PushBack(const T& item)
+			{
+				return PushBackInternal<const T&>(item);
+			}
+
+			/// <summary>Add an element after the last element. If the ring buffer is full, the first element is discarded.</summary>
+			/// <returns>Returns true if an element is discarded.</returns>
+			/// <param name="item">The element to add.</param>
+			bool PushBack(T&& item)
+			{
+				return PushBackInternal<T&&>(std::move(item));
+			}
+
+			/// <summary>Remove the first element.</summary>
+			/// <returns>The removed element. It will crash if the ring buffer is empty.</returns>
+			T PopFront()
+			{
+				CHECK_ERROR(this->count > 0, L"FixedRingBuffer<T, TAllocator>::PopFront()#The ring buffer is empty.");
+				return this->PopFrontInternal();
+			}
+
+			/// <summary>Remove the last element.</summary>
+			/// <returns>The removed element. It will crash if the ring buffer is empty.</returns>
+			T PopBack()
+			{
+				CHECK_ERROR(this->count > 0, L"FixedRingBuffer<T, TAllocator>::PopBack()#The ring buffer is empty.");
+				return this->PopBackInternal();
+			}
+
+		protected:
+			// the item could be the element to discard, so it is copied before discarding
+			template<typename TItem>
+			bool PushFrontInternal(TItem&& item)
+			{
+				Prepare();
+				if (this->count == maxCount)
+				{
+					T value(std::forward<TItem&&>(item));
+					this->RemoveBackInternal();
+					ringbuffer_internal::RingBufferBase<T, TAllocator>::PushFrontInternal(std::move(value));
+					return true;
+				}
+				ringbuffer_internal::RingBufferBase<T, TAllocator>::PushFrontInternal(std::forward<TItem&&>(item));
+				return false;
+			}
+
+			template<typename TItem>
+			bool PushBackInternal(TItem&& item)
+			{
+				Prepare();
+				if (this->count == maxCount)
+				{
+					T value(std::forward<TItem&&>(item));
+					this->RemoveFrontInternal();
+					ringbuffer_internal::RingBufferBase<T, TAllocator>::PushBackInternal(std::move(value));
+					return true;
+				}
+				ringbuffer_internal::RingBufferBase<T, TAllocator>::PushBackInternal(std::forward<TItem&&>(item));
+				return false;
+			}
+		};
+
+/***********************************************************************
+Random Access
+***********************************************************************/
+
+		namespace randomaccess_internal
+		{
+			template<typename T, typename TAllocator>
+			struct RandomAccessable<Queue<T, TAllocator>>
+			{
+				static const bool							CanRead = true;
+				static const bool							CanResize = false;
+			};
+
+			template<typename T, typename TAllocator>
+			struct RandomAccess<Queue<T, TAllocator>>
+			{
+				static vint GetCount(const Queue<T, TAllocator>& t)
+				{
+					return t.Count();
+				}
+
+				static const T& GetValue(const Queue<T, TAllocator>& t, vint index)
+				{
+					return t.Get(index);
+				}
+
+				static void AppendValue(Queue<T, TAllocator>& t, const T& value)
+				{
+					t.Enqueue(value);
+				}
+			};
+
+			template<typename T, typename TAllocator>
+			struct RandomAccessable<Deque<T, TAllocator>>
+			{
+				static const bool							CanRead = true;
+				static const bool							CanResize = false;
+			};
+
+			template<typename T, typename TAllocator>
+			struct RandomAccess<Deque<T, TAllocator>>
+			{
+				static vint GetCount(const Deque<T, TAllocator>& t)
+				{
+					return t.Count();
+				}
+
+				static const T& GetValue(const Deque<T, TAllocator>& t, vint index)
+				{
+					return t.Get(index);
+				}
+
+				static void AppendValue(Deque<T, TAllocator>& t, const T& value)
+				{
+					t.PushBack(value);
+				}
+			};
+
+			template<typename T, typename TAllocator>
+			struct RandomAccessable<FixedRingBuffer<T, TAllocator>>
+			{
+				static const bool							CanRead = true;
+				static const bool							CanResize = false;
+			};
+
+			template<typename T, typename TAllocator>
+			struct RandomAccess<FixedRingBuffer<T, TAllocator>>
+			{
+				static vint GetCount(const FixedRingBuffer<T, TAllocator>& t)
+				{
+					return t.Count();
+				}
+
+				static const T& GetValue(const FixedRingBuffer<T, TAllocator>& t, vint index)
+				{
+					return t.Get(index);
+				}
+
+				static void AppendValue(FixedRingBuffer<T, TAllocator>& t, const T& value)
+				{
+					t.PushBack(value);
+				}
+			};
+		}
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
@@ -0,0 +1,323 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_SLOTMAP
+#define VCZH_COLLECTIONS_SLOTMAP
+
+#include "List.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		/// <summary>A handle to an element in a <see cref="SlotMap`2"/>. It becomes invalid after the element is removed.</summary>
+		struct SlotMapHandle
+		{
+			/// <summary>The slot of the element.</summary>
+			vuint32_t				index = 0;
+			/// <summary>The generation of the slot when the element is added. A valid handle always has an odd generation.</summary>
+			vuint32_t				generation = 0;
+
+			std::strong_ordering operator<=>(const SlotMapHandle&)const = default;
+			bool operator==(const SlotMapHandle&)const = default;
+		};
+
+		/// <summary>
+		/// SlotMap: linear container with stable handles to elements.
+		/// Elements are contiguous in memory, adding, removing and finding an element by a handle takes constant time.
+		/// </summary>
+		/// <typeparam name="T">Type of elements.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for buffers, see <see cref="DefaultAllocator"/>.</typeparam>
+		/// <remarks>
+		/// <p>
+		/// Removing an element moves the last element to its position, so positions of elements change, but handles do not.
+		/// Enumerating the slot map or accessing elements by positions visits elements in this contiguous order.
+		/// </p>
+		/// <p>
+		/// A slot released by a removed element is reused by a later added element with a new generation,
+		/// so that a handle to the removed element never refers to the new element.
+		/// </p>
+		/// </remarks>
+		template<typename T, typename TAllocator = DefaultAllocator>
+		class SlotMap : public ArrayBase<T>
+		{
+		protected:
+			static constexpr vuint32_t				NoSlot = 0xFFFFFFFF;
+
+			// a slot is occupied when its generation is odd
+			// index is the position of the element when the slot is occupied, or the next free slot
+			struct Slot
+			{
+				vuint32_t							generation = 0;
+				vuint32_t							index = NoSlot;
+			};
+
+			VCZH_NO_UNIQUE_ADDRESS TAllocator		allocator;
+			vint									capacity = 0;
+			List<Slot, TAllocator>					slots;
+			List<vuint32_t, TAllocator>				elementSlots;
+			vuint32_t								freeSlot = NoSlot;
+
+			bool IsValid(SlotMapHandle handle)const
+			{
+				return (vint)handle.index < slots.Count() && slots[handle.index].generation == handle.generation && (handle.generation & 1) == 1;
+			}
+
+			void ReleaseSlot(vuint32_t slotIndex)
+			{
+				auto& slot = slots[slotIndex];
+				slot.generation++;
+				// a slot is retired instead of reused when its generation is exhausted
+				if (slot.generation != NoSlot - 1)
+				{
+					slot.index = freeSlot;
+					freeSlot = slotIndex;
+				}
+			}
+
+			template<typename TItem>
+			SlotMapHandle AddInternal(TItem&& item)
+			{
+				vuint32_t slotIndex = freeSlot;
+				if (slotIndex == NoSlot)
+				{
+					CHECK_ERROR(slots.Count() < (vint)NoSlot, L"SlotMap<T>::Add(const T&)#Too many slots.");
+					slotIndex = (vuint32_t)slots.Add({});
+				}
+				else
+				{
+					freeSlot = slots[slotIndex].index;
+				}
+
+				vint index = this->count;
+				memory_management::InsertUninitializedItems(allocator, this->buffer, capacity, this->count, index, 1);
+				new(&this->buffer[index]) T(std::forward<TItem>(item));
+				elementSlots.Add(slotIndex);
+
+				auto& slot = slots[slotIndex];
+				slot.generation++;
+				slot.index = (vuint32_t)index;
+				return { slotIndex, slot.generation };
+			}
+
+			void TakeOver(SlotMap<T, TAllocator>& _move)
+			{
+				this->buffer = _move.buffer;
+				this->count = _move.count;
+				capacity = _move.capacity;
+				slots = std::move(_move.slots);
+				elementSlots = std::move(_move.elementSlots);
+				freeSlot = _move.freeSlot;
+				_move.buffer = nullptr;
+				_move.count = 0;
+				_move.capacity = 0;
+				_move.freeSlot = NoSlot;
+			}
+
+			void ReleaseItems()
+			{
+				memory_management::CallDtors(this->buffer, this->count);
+				memory_management::DeallocateBuffer(allocator, this->buffer, capacity);
+				this->buffer = nullptr;
+				this->count = 0;
+				capacity = 0;
+			}
+		public:
+			/// <summary>Create an empty slot map.</summary>
+			/// <param name="_allocator">The allocator for buffers.</param>
+			SlotMap(const TAllocator& _allocator = TAllocator())
+				: allocator(_allocator)
+				, slots(_allocator)
+				, elementSlots(_allocator)
+			{
+			}
+
+			SlotMap(const SlotMap<T, TAllocator>&) = delete;
+			SlotMap(SlotMap<T, TAllocator>&& _move)
+				: allocator(_move.allocator)
+				, slots(_move.allocator)
+				, elementSlots(_move.allocator)
+			{
+				TakeOver(_move);
+			}
+
+			~SlotMap()
+			{
+				ReleaseItems();
+			}
+
+			SlotMap<T, TAllocator>& operator=(const SlotMap<T, TAllocator>&) = delete;
+			SlotMap<T, TAllocator>& operator=(SlotMap<T, TAllocator>&& _move)
+			{
+				if (this != &_move)
+				{
+					ReleaseItems();
+					allocator = _move.allocator;
+					TakeOver(_move);
+				}
+				return *this;
+			}
+
+			using ArrayBase<T>::Get;
+			using ArrayBase<T>::operator[];
+
+			/// <summary>Test if a handle refers to an element in this slot map.</summary>
+			/// <returns>Returns true if the element exists.</returns>
+			/// <param name="handle">The handle to test.</param>
+			bool Contains(SlotMapHandle handle)const
+			{
+				return IsValid(handle);
+			}
+
+			/// <summary>Get the position of an element.</summary>
+			/// <returns>The position of the element. Returns -1 if the handle is invalid.</returns>
+			/// <param name="handle">The handle of the element.</param>
+			vint IndexOf(SlotMapHandle handle)const
+			{
+				return IsValid(handle) ? (vint)slots[handle.index].index : -1;
+			}
+
+			/// <summary>Get the handle of an element at a specified position.</summary>
+			/// <returns>The handle of the element. It will crash when the index is out of range.</returns>
+			/// <param name="index">The position of the element.</param>
+			SlotMapHandle GetHandle(vint index)const
+			{
+				CHECK_ERROR(index >= 0 && index < this->count, L"SlotMap<T>::GetHandle(vint)#Argument index not in range.");
+				vuint32_t slotIndex = elementSlots[index];
+				return { slotIndex, slots[slotIndex].generation };
+			}
+
+			/// <summary>Get the reference to an element.</summary>
+			/// <returns>The reference to the element. It will crash if the handle is invalid.</returns>
+			/// <param name="handle">The handle of the element.</param>
+			const T& Get(SlotMapHandle handle)const
+			{
+				CHECK_ERROR(IsValid(handle), L"SlotMap<T>::Get(SlotMapHandle)#Argument handle is invalid.");
+				return this->buffer[slots[handle.index].index];
+			}
+
+			/// <summary>Get the reference to an element.</summary>
+			/// <returns>The reference to the element. It will crash if the handle is invalid.</returns>
+			/// <param name="handle">The handle of the element.</param>
+			const T& operator[](SlotMapHandle handle)const
+			{
+				CHECK_ERROR(IsValid(handle), L"SlotMap<T>::operator[](SlotMapHandle)#Argument handle is invalid.");
+				return this->buffer[slots[handle.index].index];
+			}
+
+			/// <summary>Get the writable reference to an element.</summary>
+			/// <returns>The reference to the element. It will crash if the handle is invalid.</returns>
+			/// <param name="handle">The handle of the element.</param>
+			T& operator[](SlotMapHandle handle)
+			{
+				CHECK_ERROR(IsValid(handle), L"SlotMap<T>::operator[](SlotMapHandle)#Argument handle is invalid.");
+				return this->buffer[slots[handle.index].index];
+			}
+
+			/// <summary>Add an element.</summary>
+			/// <returns>The handle of the added element.</returns>
+			/// <param name="item">The element to add.</param>
+			SlotMapHandle Add(const T& item)
+			{
+				return AddInternal(item);
+			}
+
+			/// <summary>Add an element.</summary>
+			/// <returns>The handle of the added element.</returns>
+			/// <param name="item">The element to add.</param>
+			SlotMapHandle Add(T&& item)
+			{
+				return AddInternal(std::move(item));
+			}
+
+			/// <summary>Remove an element. The last element is moved to its position.</summary>
+			/// <returns>Returns true if the element is removed. Returns false if the handle is invalid.</returns>
+			/// <param name="handle">The handle of the element.</param>
+			bool Remove(SlotMapHandle handle)
+			{
+				if (!IsValid(handle)) return false;
+				vint index = slots[handle.index].index;
+				vint last = this->count - 1;
+				if (index != last)
+				{
+					this->buffer[index] = std::move(this->buffer[last]);
+					vuint32_t lastSlot = elementSlots[last];
+					elementSlots[index] = lastSlot;
+					slots[lastSlot].index = (vuint32_t)index;
+				}
+				elementSlots.RemoveAt(last);
+				this->count--;
+				memory_management::ReleaseUnnecessaryBuffer(allocator, this->buffer, capacity, last + 1, this->count);
+				ReleaseSlot(handle.index);
+				return true;
+			}
+
+			/// <summary>Remove all elements. All handles become invalid.</summary>
+			/// <returns>Returns true if all elements are removed.</returns>
+			bool Clear()
+			{
+				for (vint i = 0; i < this->count; i++)
+				{
+					ReleaseSlot(elementSlots[i]);
+				}
+				elementSlots.Clear();
+				ReleaseItems();
+				return true;
+			}
+		};
+
+/***********************************************************************
+Random Access
+***********************************************************************/
+
+		namespace randomaccess_internal
+		{
+			template<typename T, typename TAllocator>
+			struct RandomAccessable<SlotMap<T, TAllocator>>
+			{
+				static const bool							CanRead = true;
+				static const bool							CanResize = false;
+			};
+
+			template<typename T, typename TAllocator>
+			struct RandomAccess<SlotMap<T, TAllocator>>
+			{
+				static vint GetCount(const SlotMap<T, TAllocator>& t)
+				{
+					return t.Count();
+				}
+
+				static const T& GetValue(const SlotMap<T, TAllocator>& t, vint index)
+				{
+					return t.Get(index);
+				}
+
+				static void AppendValue(SlotMap<T, TAllocator>& t, const T& value)
+				{
+					t.Add(value);
+				}
+			};
+		}
+	}
+
+	template<>
+	struct Hasher<collections::SlotMapHandle>
+	{
+		static vuint64_t GetHashCode(const collections::SlotMapHandle& value)
+		{
+			return MixHashCode(((vuint64_t)value.generation << 32) | value.index);
+		}
+	};
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
@@ -0,0 +1,193 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_COLLECTIONS_SNAPSHOTDICTIONARY
+#define VCZH_COLLECTIONS_SNAPSHOTDICTIONARY
+
+#include "Dictionary.h"
+#include "OperationCopyFrom.h"
+#include "../Primitives/SpinLock.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+	namespace collections
+	{
+		/// <summary>
+		/// SnapshotDictionary: thread safe one to one map container for data that is read much more often than it is changed.
+		/// Readers get the latest published version as an immutable <see cref="Dictionary`3"/> without taking any lock.
+		/// Writers copy the latest version, change the copy, and publish it as the new version.
+		/// </summary>
+		/// <typeparam name="KT">Type of keys.</typeparam>
+		/// <typeparam name="VT">Type of values.</typeparam>
+		/// <typeparam name="TAllocator">Type of the allocator for keys and values in each version, see <see cref="DefaultAllocator"/>.</typeparam>
+		/// <remarks>
+		/// <p>
+		/// A version returned by <see cref="GetSnapshot"/> never changes, and it is deleted when the dictionary and all readers release it.
+		/// </p>
+		/// <p>
+		/// Getting a snapshot takes a fixed number of atomic operations.
+		/// Publishing a version waits until readers that are still copying the previous version have finished, before releasing the previous version.
+		/// Updating the dictionary takes O(n) time to copy the latest version, which is done without locking.
+		/// Only publishing is serialized by a spin lock.
+		/// </p>
+		/// </remarks>
+		template<typename KT, typename VT, typename TAllocator = DefaultAllocator>
+		class SnapshotDictionary : public Object
+		{
+		public:
+			typedef Dictionary<KT, VT, TAllocator>		DictionaryType;
+			typedef Ptr<const DictionaryType>			SnapshotType;
+		protected:
+			using KK = typename KeyType<KT>::Type;
+
+			VCZH_NO_UNIQUE_ADDRESS TAllocator		allocator;
+			std::atomic<SnapshotType*>				current{ nullptr };
+			std::atomic<vint>						phase{ 0 };
+			// readers increase the counter of the phase they observed while copying the current version
+			mutable std::atomic<vint>				readers[2];
+			SpinLock								writerLock;
+
+			void WaitForReaders(vint readerPhase)
+			{
+				while (readers[readerPhase].load() != 0);
+			}
+
+			void PublishInternal(SnapshotType* version)
+			{
+				SnapshotType* previous = current.exchange(version);
+
+				// after two phase changes, no reader could still be copying the previous version
+				vint currentPhase = phase.load();
+				WaitForReaders(1 - currentPhase);
+				phase.store(1 - currentPhase);
+				WaitForReaders(currentPhase);
+
+				delete previous;
+			}
+
+		public:
+			NOT_COPYABLE(SnapshotDictionary);
+
+			/// <summary>Create a dictionary with an empty version.</summary>
+			/// <param name="_allocator">The allocator for keys and values in each version.</param>
+			SnapshotDictionary(const TAllocator& _allocator = TAllocator())
+				: allocator(_allocator)
+			{
+				current = new SnapshotType(Ptr(new DictionaryType(allocator)));
+			}
+
+			~SnapshotDictionary()
+			{
+				delete current.load();
+			}
+
+			/// <summary>Get the latest published version without taking any lock.</summary>
+			/// <returns>The latest published version. It will not be changed by writers.</returns>
+			SnapshotType GetSnapshot()const
+			{
+				vint readerPhase = phase.load();
+				readers[readerPhase]++;
+				SnapshotType snapshot = *current.load();
+				readers[readerPhase]--;
+				return snapshot;
+			}
+
+			/// <summary>Get the number of keys in the latest published version.</summary>
+			/// <returns>The number of keys.</returns>
+			vint Count()const
+			{
+				return GetSnapshot()->Count();
+			}
+
+			/// <summary>Test if a key exists in the latest published version.</summary>
+			/// <returns>Returns true if the key exists.</returns>
+			/// <param name="key">The key to find.</param>
+			bool Contains(const KK& key)const
+			{
+				return GetSnapshot()->Keys().Contains(key);
+			}
+
+			/// <summary>Get a copy of the value associated to a specified key in the latest published version.</summary>
+			/// <returns>Returns true if the key exists.</returns>
+			/// <param name="key">The key to find.</param>
+			/// <param name="value">The variable to receive the value.</param>
+			bool TryGet(const KK& key, VT& value)const
+			{
+				auto snapshot = GetSnapshot();
+				vint index = snapshot->Keys().IndexOf(key);
+				if (index == -1) return false;
+				value = snapshot->Values()[index];
+				return true;
+			}
+
+			/// <summary>Replace the latest version with a new one.</summary>
+			/// <param name="dictionary">The new version. It becomes empty after the dictionary is published.</param>
+			void Publish(DictionaryType&& dictionary)
+			{
+				auto version = new SnapshotType(Ptr(new DictionaryType(std::move(dictionary))));
+				SpinLock::Scope scope(writerLock);
+				PublishInternal(version);
+			}
+
+			/// <summary>Copy the latest version, change the copy by a callback, and publish the copy as the new version.</summary>
+			/// <typeparam name="F">Type of the callback.</typeparam>
+			/// <param name="update">
+			/// The callback to change the copy. If it throws, nothing is published.
+			/// It runs without locking, if another version is published before the copy, it is called again with a copy of the new version.
+			/// </param>
+			template<typename F>
+			void Update(F&& update)
+			{
+				while (true)
+				{
+					auto latest = GetSnapshot();
+					auto version = Ptr(new DictionaryType(allocator));
+					CopyFrom(*version.Obj(), *latest.Obj());
+					update(*version.Obj());
+
+					auto snapshot = new SnapshotType(version);
+					{
+						SpinLock::Scope scope(writerLock);
+						if (current.load()->Obj() == latest.Obj())
+						{
+							PublishInternal(snapshot);
+							return;
+						}
+					}
+					delete snapshot;
+				}
+			}
+
+			/// <summary>Publish a new version with a key associated to a value.</summary>
+			/// <param name="key">The key to find. If the key does not exist, it will be added.</param>
+			/// <param name="value">The associated value to replace.</param>
+			void Set(const KT& key, const VT& value)
+			{
+				Update([&](DictionaryType& dictionary) { dictionary.Set(key, value); });
+			}
+
+			/// <summary>Publish a new version without a specified key.</summary>
+			/// <returns>Returns true if the key existed and a new version is published.</returns>
+			/// <param name="key">The key to remove.</param>
+			bool Remove(const KK& key)
+			{
+				if (!Contains(key)) return false;
+				bool removed = false;
+				Update([&](DictionaryType& dictionary) { removed = dictionary.Remove(key); });
+				return removed;
+			}
+		};
+	}
+}
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
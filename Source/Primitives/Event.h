@@ -6,7 +6,7 @@ Licensed under https://github.com/vczh-libraries/License
 #define VCZH_EVENT
 
 #include "Function.h"
-#include "../Collections/List.h"
+#include "../Collections/HashSet.h"
 
 namespace vl
 {
@@ -43,7 +43,7 @@ namespace vl
 			}
 		};
  
-		collections::SortedList<Ptr<EventHandlerImpl>>	handlers;
+		collections::HashSet<Ptr<EventHandlerImpl>>	handlers;
 	public:
 		NOT_COPYABLE(Event);
 		Event() = default;
@@ -84,14 +84,13 @@ namespace vl
 		{
 			auto impl = handler.Cast<EventHandlerImpl>();
 			if (!impl) return false;
-			vint index = handlers.IndexOf(impl.Obj());
-			if (index == -1) return false;
+			// callbacks are invoked in the order of adding, so removing one keeps the order of the others
+			if (!handlers.RemoveAndKeepOrder(impl.Obj())) return false;
 			impl->attached = false;
-			handlers.RemoveAt(index);
 			return true;
 		}
  
-		/// <summary>Invoke all callbacks in the event.</summary>
+		/// <summary>Invoke all callbacks in the event, in the order of adding.</summary>
 		/// <param name="args">Arguments to invoke all callbacks.</param>
 		template<typename... TArgs2>
 		void operator()(TArgs2&& ...args)const
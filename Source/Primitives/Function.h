@@ -35,6 +35,8 @@ vl::Func<R(TArgs...)>
 			R(*function)(TArgs ...args);
 
 		public:
+			POOLED_ALLOCATION(StaticInvoker)
+
 			StaticInvoker(R(*_function)(TArgs...))
 				:function(_function)
 			{
@@ -56,6 +58,8 @@ vl::Func<R(TArgs...)>
 			R(C::*function)(TArgs ...args);
 
 		public:
+			POOLED_ALLOCATION(MemberInvoker)
+
 			MemberInvoker(C* _sender, R(C::*_function)(TArgs ...args))
 				:sender(_sender)
 				,function(_function)
@@ -77,6 +81,8 @@ vl::Func<R(TArgs...)>
 			C							function;
 
 		public:
+			POOLED_ALLOCATION(ObjectInvoker)
+
 			ObjectInvoker(const C& _function)
 				:function(_function)
 			{
@@ -102,6 +108,8 @@ vl::Func<R(TArgs...)>
 			C							function;
 
 		public:
+			POOLED_ALLOCATION(ObjectInvoker)
+
 			ObjectInvoker(const C& _function)
 				:function(_function)
 			{
@@ -288,5 +296,11 @@ vl::function_lambda::LambdaRetriveType<R(TArgs...)>
 
 	template<typename C, typename R, typename... TArgs>
 	Func(C*, R(C::*)(TArgs...)) -> Func<R(TArgs...)>;
+
+	template<typename T>
+	struct TriviallyRelocatable<Func<T>>
+	{
+		static constexpr bool Value = true;
+	};
 }
 #endif
\ No newline at end of file
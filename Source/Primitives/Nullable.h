@@ -229,6 +229,12 @@ namespace vl
 
 	template<typename T>
 	const Nullable<T> Nullable<T>::Empty;
+
+	template<typename T>
+	struct TriviallyRelocatable<Nullable<T>>
+	{
+		static constexpr bool Value = TriviallyRelocatable<T>::Value;
+	};
 }
 
 #ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
@@ -0,0 +1,406 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_OBJECTPOOL
+#define VCZH_OBJECTPOOL
+
+#include "SpinLock.h"
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#undef new
+#endif
+
+namespace vl
+{
+
+/***********************************************************************
+ObjectPool
+***********************************************************************/
+
+	namespace objectpool_internal
+	{
+		struct Slot
+		{
+			Slot*						next;
+		};
+
+		// slots never cross a cache line: small slots are powers of two, large slots are multiple of cache lines
+		constexpr vint GetSlotSize(vint size)
+		{
+			if (size < (vint)sizeof(Slot)) size = (vint)sizeof(Slot);
+			if (size >= CacheLineSize)
+			{
+				return (size + CacheLineSize - 1) / CacheLineSize * CacheLineSize;
+			}
+			vint slotSize = 1;
+			while (slotSize < size) slotSize <<= 1;
+			return slotSize;
+		}
+	}
+
+	/// <summary>
+	/// A pool for objects of the same type. Memory is allocated in slabs and recycled by a free list.
+	/// Every slot is aligned so that it does not cross a cache line.
+	/// This class is not thread safe, <see cref="ConcurrentObjectPool`1"/> and <see cref="GlobalObjectPool`1"/> are for multi-threading.
+	/// </summary>
+	/// <typeparam name="T">The type of objects.</typeparam>
+	/// <remarks>
+	/// All objects must be deleted before the pool is destroyed, because destroying the pool does not call destructors.
+	/// </remarks>
+	template<typename T>
+	class ObjectPool : public Object
+	{
+		using Slot = objectpool_internal::Slot;
+		static_assert(alignof(T) <= CacheLineSize, "vl::ObjectPool<T> does not support over-aligned types.");
+	public:
+		/// <summary>The size of a slot.</summary>
+		static constexpr vint SlotSize = objectpool_internal::GetSlotSize((vint)sizeof(T));
+
+	protected:
+		struct Slab
+		{
+			Slab*						next;
+			void*						memory;
+		};
+
+		vint							slotsPerSlab;
+		Slab*							slabs = nullptr;
+		Slot*							freeSlots = nullptr;
+		char*							carving = nullptr;
+		char*							carvingEnd = nullptr;
+		vint							allocatedCount = 0;
+
+		void AllocateSlab()
+		{
+			const vint alignment = CacheLineSize;
+			void* memory = malloc(alignment * 2 + SlotSize * slotsPerSlab);
+			CHECK_ERROR(memory != nullptr, L"vl::ObjectPool<T>::AllocateSlab()#Failed to allocate memory.");
+			auto slab = (Slab*)(((vuint)memory + (vuint)alignment - 1) & ~((vuint)alignment - 1));
+			slab->next = slabs;
+			slab->memory = memory;
+			slabs = slab;
+			carving = (char*)slab + alignment;
+			carvingEnd = carving + SlotSize * slotsPerSlab;
+		}
+
+	public:
+		NOT_COPYABLE(ObjectPool);
+
+		/// <summary>Create a pool.</summary>
+		/// <param name="_slotsPerSlab">The number of slots in a slab. Set to 0 to make a slab about 16 kilobytes.</param>
+		ObjectPool(vint _slotsPerSlab = 0)
+			: slotsPerSlab(_slotsPerSlab > 0 ? _slotsPerSlab : (16384 / SlotSize < 8 ? 8 : 16384 / SlotSize))
+		{
+		}
+
+		~ObjectPool()
+		{
+			while (slabs)
+			{
+				auto next = slabs->next;
+				free(slabs->memory);
+				slabs = next;
+			}
+		}
+
+		/// <summary>Get the number of allocated slots that have not been returned to the pool.</summary>
+		/// <returns>The number of allocated slots.</returns>
+		vint GetAllocatedCount()const
+		{
+			return allocatedCount;
+		}
+
+		/// <summary>Allocate uninitialized memory for an object.</summary>
+		/// <returns>The allocated memory.</returns>
+		void* Allocate()
+		{
+			if (freeSlots)
+			{
+				auto slot = freeSlots;
+				freeSlots = slot->next;
+				allocatedCount++;
+				return slot;
+			}
+
+			if (carving == carvingEnd)
+			{
+				AllocateSlab();
+			}
+			allocatedCount++;
+			auto slot = carving;
+			carving += SlotSize;
+			return slot;
+		}
+
+		/// <summary>Return memory to the pool.</summary>
+		/// <param name="memory">The memory returned by <see cref="Allocate"/>.</param>
+		void Deallocate(void* memory)
+		{
+			allocatedCount--;
+			auto slot = (Slot*)memory;
+			slot->next = freeSlots;
+			freeSlots = slot;
+		}
+
+		/// <summary>Create an object in the pool.</summary>
+		/// <typeparam name="TArgs">Types of arguments for the constructor.</typeparam>
+		/// <returns>The created object.</returns>
+		/// <param name="args">Arguments for the constructor.</param>
+		template<typename ...TArgs>
+		T* New(TArgs&& ...args)
+		{
+			void* memory = Allocate();
+			try
+			{
+				return new(memory) T(std::forward<TArgs&&>(args)...);
+			}
+			catch (...)
+			{
+				Deallocate(memory);
+				throw;
+			}
+		}
+
+		/// <summary>Destruct an object and return its memory to the pool.</summary>
+		/// <param name="object">The object created by <see cref="New"/>.</param>
+		void Delete(T* object)
+		{
+			if (object)
+			{
+				object->~T();
+				Deallocate(object);
+			}
+		}
+	};
+
+/***********************************************************************
+ConcurrentObjectPool
+***********************************************************************/
+
+	/// <summary>A thread safe <see cref="ObjectPool`1"/>, protected by a spin lock.</summary>
+	/// <typeparam name="T">The type of objects.</typeparam>
+	template<typename T>
+	class ConcurrentObjectPool : public Object
+	{
+	protected:
+		ObjectPool<T>					pool;
+		SpinLock						lock;
+
+	public:
+		NOT_COPYABLE(ConcurrentObjectPool);
+
+		/// <summary>Create a pool.</summary>
+		/// <param name="slotsPerSlab">The number of slots in a slab. Set to 0 to make a slab about 16 kilobytes.</param>
+		ConcurrentObjectPool(vint slotsPerSlab = 0)
+			: pool(slotsPerSlab)
+		{
+		}
+
+		/// <summary>Get the number of allocated slots that have not been returned to the pool.</summary>
+		/// <returns>The number of allocated slots.</returns>
+		vint GetAllocatedCount()
+		{
+			SpinLock::Scope scope(lock);
+			return pool.GetAllocatedCount();
+		}
+
+		/// <summary>Allocate uninitialized memory for an object.</summary>
+		/// <returns>The allocated memory.</returns>
+		void* Allocate()
+		{
+			SpinLock::Scope scope(lock);
+			return pool.Allocate();
+		}
+
+		/// <summary>Return memory to the pool.</summary>
+		/// <param name="memory">The memory returned by <see cref="Allocate"/>.</param>
+		void Deallocate(void* memory)
+		{
+			SpinLock::Scope scope(lock);
+			pool.Deallocate(memory);
+		}
+
+		/// <summary>Allocate multiple slots in one lock.</summary>
+		/// <param name="memories">The buffer to receive allocated memory.</param>
+		/// <param name="count">The number of slots to allocate.</param>
+		void AllocateBatch(void** memories, vint count)
+		{
+			SpinLock::Scope scope(lock);
+			vint allocated = 0;
+			try
+			{
+				for (; allocated < count; allocated++)
+				{
+					memories[allocated] = pool.Allocate();
+				}
+			}
+			catch (...)
+			{
+				for (vint i = 0; i < allocated; i++)
+				{
+					pool.Deallocate(memories[i]);
+				}
+				throw;
+			}
+		}
+
+		/// <summary>Return multiple slots in one lock.</summary>
+		/// <param name="memories">The memory returned by <see cref="Allocate"/> or <see cref="AllocateBatch"/>.</param>
+		/// <param name="count">The number of slots to return.</param>
+		void DeallocateBatch(void** memories, vint count)
+		{
+			SpinLock::Scope scope(lock);
+			for (vint i = 0; i < count; i++)
+			{
+				pool.Deallocate(memories[i]);
+			}
+		}
+	};
+
+/***********************************************************************
+GlobalObjectPool
+***********************************************************************/
+
+	/// <summary>
+	/// A process-wide <see cref="ConcurrentObjectPool`1"/> for each type, with a thread local cache in front of it.
+	/// Allocating and deallocating only take the lock when the cache of the current thread is empty or full.
+	/// </summary>
+	/// <typeparam name="T">The type of objects.</typeparam>
+	/// <remarks>
+	/// The pool is never destroyed so that objects could be deleted at any time, even during the process exiting.
+	/// Slots cached by a thread are returned to the pool when the thread exits.
+	/// </remarks>
+	template<typename T>
+	class GlobalObjectPool
+	{
+	protected:
+		static constexpr vint			CacheSize = 32;
+
+		struct LocalCache
+		{
+			void*						memories[CacheSize];
+			vint						count = 0;
+
+			~LocalCache()
+			{
+				GetPool().DeallocateBatch(memories, count);
+				count = 0;
+			}
+		};
+
+		static LocalCache& GetCache()
+		{
+			thread_local LocalCache cache;
+			return cache;
+		}
+
+	public:
+		/// <summary>Get the pool behind thread local caches.</summary>
+		/// <returns>The pool.</returns>
+		static ConcurrentObjectPool<T>& GetPool()
+		{
+			alignas(ConcurrentObjectPool<T>) static char storage[sizeof(ConcurrentObjectPool<T>)];
+			static ConcurrentObjectPool<T>* pool = new(storage) ConcurrentObjectPool<T>();
+			return *pool;
+		}
+
+		/// <summary>Allocate uninitialized memory for an object.</summary>
+		/// <returns>The allocated memory.</returns>
+		static void* Allocate()
+		{
+			auto& cache = GetCache();
+			if (cache.count == 0)
+			{
+				GetPool().AllocateBatch(cache.memories, CacheSize / 2);
+				cache.count = CacheSize / 2;
+			}
+			return cache.memories[--cache.count];
+		}
+
+		/// <summary>Return memory to the pool.</summary>
+		/// <param name="memory">The memory returned by <see cref="Allocate"/>.</param>
+		static void Deallocate(void* memory)
+		{
+			auto& cache = GetCache();
+			if (cache.count == CacheSize)
+			{
+				GetPool().DeallocateBatch(cache.memories + CacheSize / 2, CacheSize / 2);
+				cache.count = CacheSize / 2;
+			}
+			cache.memories[cache.count++] = memory;
+		}
+
+		/// <summary>Create an object in the pool.</summary>
+		/// <typeparam name="TArgs">Types of arguments for the constructor.</typeparam>
+		/// <returns>The created object.</returns>
+		/// <param name="args">Arguments for the constructor.</param>
+		template<typename ...TArgs>
+		static T* New(TArgs&& ...args)
+		{
+			void* memory = Allocate();
+			try
+			{
+				return new(memory) T(std::forward<TArgs&&>(args)...);
+			}
+			catch (...)
+			{
+				Deallocate(memory);
+				throw;
+			}
+		}
+
+		/// <summary>Destruct an object and return its memory to the pool.</summary>
+		/// <param name="object">The object created by <see cref="New"/>.</param>
+		static void Delete(T* object)
+		{
+			if (object)
+			{
+				object->~T();
+				Deallocate(object);
+			}
+		}
+	};
+}
+
+/***********************************************************************
+Pooled Allocation
+***********************************************************************/
+
+// OBJECT_POOL_ALLOCATION(TYPE) allocates instances of TYPE from GlobalObjectPool<TYPE> when they are created by the "new" operator.
+// Instances of derived classes in different sizes still use the global "new" and "delete" operator.
+// It expands to nothing when VCZH_CHECK_MEMORY_LEAKS is defined, so that all allocations are tracked.
+#ifdef VCZH_CHECK_MEMORY_LEAKS
+#define OBJECT_POOL_ALLOCATION(TYPE)
+#else
+#define OBJECT_POOL_ALLOCATION(TYPE)\
+	static void* operator new(size_t size)\
+	{\
+		if (size != sizeof(TYPE)) return ::operator new(size);\
+		return ::vl::GlobalObjectPool<TYPE>::Allocate();\
+	}\
+	static void operator delete(void* memory, size_t size)\
+	{\
+		if (!memory) return;\
+		if (size != sizeof(TYPE)) return ::operator delete(memory);\
+		::vl::GlobalObjectPool<TYPE>::Deallocate(memory);\
+	}\
+	static void* operator new(size_t, void* memory) { return memory; }\
+	static void operator delete(void*, void*) {}\
+
+#endif
+
+// POOLED_ALLOCATION(TYPE) is OBJECT_POOL_ALLOCATION(TYPE) only when VCZH_OBJECT_POOL is defined.
+// It is used on small objects that are frequently created by this library, like function invokers and enumerators.
+#ifdef VCZH_OBJECT_POOL
+#define POOLED_ALLOCATION(TYPE) OBJECT_POOL_ALLOCATION(TYPE)
+#else
+#define POOLED_ALLOCATION(TYPE)
+#endif
+
+#ifdef VCZH_CHECK_MEMORY_LEAKS_NEW
+#define new VCZH_CHECK_MEMORY_LEAKS_NEW
+#endif
+
+#endif
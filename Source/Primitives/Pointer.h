@@ -8,6 +8,13 @@ Licensed under https://github.com/vczh-libraries/License
 
 #include "../Basic.h"
 
+// pooled allocation for Ptr, Func and enumerators is only available when VCZH_OBJECT_POOL is defined, see POOLED_ALLOCATION in ObjectPool.h
+#ifdef VCZH_OBJECT_POOL
+#include "ObjectPool.h"
+#else
+#define POOLED_ALLOCATION(TYPE)
+#endif
+
 namespace vl
 {
 
@@ -36,7 +43,11 @@ ReferenceCounterOperator
 		/// <param name="reference">The object.</param>
 		static __forceinline atomic_vint* CreateCounter(T* reference)
 		{
+#if defined VCZH_OBJECT_POOL && !defined VCZH_CHECK_MEMORY_LEAKS
+			return GlobalObjectPool<atomic_vint>::New(0);
+#else
 			return new atomic_vint(0);
+#endif
 		}
 
 		/// <summary>Delete the reference counter from an object.</summary>
@@ -44,7 +55,11 @@ ReferenceCounterOperator
 		/// <param name="reference">The object.</param>
 		static __forceinline void DeleteReference(atomic_vint* counter, void* reference)
 		{
+#if defined VCZH_OBJECT_POOL && !defined VCZH_CHECK_MEMORY_LEAKS
+			GlobalObjectPool<atomic_vint>::Delete(counter);
+#else
 			delete counter;
+#endif
 			delete (T*)reference;
 		}
 	};
@@ -510,6 +525,18 @@ Traits
 			return key.Obj();
 		}
 	};
+
+	template<typename T>
+	struct TriviallyRelocatable<Ptr<T>>
+	{
+		static constexpr bool Value = true;
+	};
+
+	template<typename T>
+	struct TriviallyRelocatable<ComPtr<T>>
+	{
+		static constexpr bool Value = true;
+	};
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,113 @@
+/***********************************************************************
+Author: Zihan Chen (vczh)
+Licensed under https://github.com/vczh-libraries/License
+***********************************************************************/
+
+#ifndef VCZH_SPINLOCK
+#define VCZH_SPINLOCK
+
+#include "../Basic.h"
+#include <thread>
+#ifdef VCZH_MSVC
+#include <intrin.h>
+#endif
+
+namespace vl
+{
+
+/***********************************************************************
+SpinLock
+***********************************************************************/
+
+	/// <summary>
+	/// A lock for very short critical sections, waiting threads keep running instead of sleeping.
+	/// It is not reentrant, do not call anything that could block or take the same lock while holding it.
+	/// </summary>
+	class SpinLock
+	{
+	protected:
+		// after this number of failed checks, a waiting thread gives up its time slice between checks
+		static constexpr vint			SpinCountBeforeYield = 64;
+
+		std::atomic<bool>				locked{ false };
+
+		static void Pause()
+		{
+#if defined VCZH_ARM
+#if defined VCZH_MSVC
+			__yield();
+#else
+			__asm__ __volatile__("yield");
+#endif
+#elif defined VCZH_MSVC
+			_mm_pause();
+#else
+			__builtin_ia32_pause();
+#endif
+		}
+
+	public:
+		/// <summary>Enter and leave a lock in the life time of this object.</summary>
+		class Scope
+		{
+		private:
+			SpinLock&					lock;
+
+		public:
+			NOT_COPYABLE(Scope);
+
+			/// <summary>Enter the lock.</summary>
+			/// <param name="_lock">The lock.</param>
+			Scope(SpinLock& _lock)
+				: lock(_lock)
+			{
+				lock.Enter();
+			}
+
+			~Scope()
+			{
+				lock.Leave();
+			}
+		};
+
+		NOT_COPYABLE(SpinLock);
+		SpinLock() = default;
+
+		/// <summary>Try to enter the lock without waiting.</summary>
+		/// <returns>Returns true if the lock is entered.</returns>
+		bool TryEnter()
+		{
+			return !locked.load(std::memory_order_relaxed) && !locked.exchange(true, std::memory_order_acquire);
+		}
+
+		/// <summary>Enter the lock, wait until no other thread is holding it.</summary>
+		void Enter()
+		{
+			vint spinCount = 0;
+			while (locked.exchange(true, std::memory_order_acquire))
+			{
+				// only read the flag while waiting, so that the cache line is not written by all waiting threads
+				while (locked.load(std::memory_order_relaxed))
+				{
+					if (spinCount < SpinCountBeforeYield)
+					{
+						spinCount++;
+						Pause();
+					}
+					else
+					{
+						std::this_thread::yield();
+					}
+				}
+			}
+		}
+
+		/// <summary>Leave the lock.</summary>
+		void Leave()
+		{
+			locked.store(false, std::memory_order_release);
+		}
+	};
+}
+
+#endif
@@ -507,6 +507,30 @@ namespace vl
 	template<typename T>
 	const T ObjectString<T>::zero=0;
 
+	template<typename T>
+	struct TriviallyRelocatable<ObjectString<T>>
+	{
+		static constexpr bool Value = true;
+	};
+
+	template<typename T>
+	struct Hasher<ObjectString<T>>
+	{
+		static vuint64_t GetHashCode(const ObjectString<T>& value)
+		{
+			// FNV-1a
+			vuint64_t hash = 0xCBF29CE484222325ULL;
+			const T* buffer = value.Buffer();
+			vint length = value.Length();
+			for (vint i = 0; i < length; i++)
+			{
+				hash ^= (vuint64_t)buffer[i];
+				hash *= 0x100000001B3ULL;
+			}
+			return MixHashCode(hash);
+		}
+	};
+
 	extern template class ObjectString<char>;
 	extern template class ObjectString<wchar_t>;
 	extern template class ObjectString<char8_t>;
@@ -160,8 +160,8 @@ void CompareEnumerable(const IEnumerable<T>& dst, const IEnumerable<T>& src)
 	delete srcEnum;
 }
 
-template<typename K, typename V>
-void TestReadonlyDictionary(const Dictionary<K, V>& dictionary, vint* keys, vint* values, vint count)
+template<template<typename, typename, typename...> class TDictionary, typename K, typename V, typename ...TArgs>
+void TestReadonlyDictionary(const TDictionary<K, V, TArgs...>& dictionary, vint* keys, vint* values, vint count)
 {
 	TEST_ASSERT(dictionary.Count() == count);
 	TestReadonlyList(dictionary.Keys(), keys, count);
@@ -186,8 +186,8 @@ void TestReadonlyDictionary(const Dictionary<K, V>& dictionary, vint* keys, vint
 	}
 }
 
-template<typename K, typename V>
-void TestReadonlyGroup(const Group<K, V>& group, vint* keys, vint* values, vint* counts, vint count)
+template<template<typename, typename, typename...> class TGroup, typename K, typename V, typename ...TArgs>
+void TestReadonlyGroup(const TGroup<K, V, TArgs...>& group, vint* keys, vint* values, vint* counts, vint count)
 {
 	TEST_ASSERT(group.Count() == count);
 	TestReadonlyList(group.Keys(), keys, count);
@@ -229,4 +229,18 @@ void TestReadonlyGroup(const Group<K, V>& group, vint* keys, vint* values, vint*
 		TEST_ASSERT(enumerator->Next() == false);
 		delete enumerator;
 	}
-}
\ No newline at end of file
+}
+// Create a container with a CountingAllocator after other constructor arguments, and call the callback with the container and both counters.
+// The allocator must be used at least once, and all memory must be returned when the container is destroyed.
+template<typename TContainer, typename TCallback, typename ...TArgs>
+void TestWithCountingAllocator(TCallback&& callback, TArgs&& ...args)
+{
+	vint allocatedBytes = 0;
+	vint allocations = 0;
+	{
+		TContainer container(std::forward<TArgs&&>(args)..., CountingAllocator(&allocatedBytes, &allocations));
+		callback(container, allocatedBytes, allocations);
+		TEST_ASSERT(allocations > 0);
+	}
+	TEST_ASSERT(allocatedBytes == 0);
+}
@@ -78,6 +78,28 @@ struct Copyable
 	}
 };
 
+struct CountingAllocator
+{
+	vint* allocatedBytes = nullptr;
+	vint* allocations = nullptr;
+
+	CountingAllocator() = default;
+	CountingAllocator(vint* _allocatedBytes, vint* _allocations = nullptr) :allocatedBytes(_allocatedBytes), allocations(_allocations) {}
+
+	void* Allocate(vint size)
+	{
+		if (allocations) (*allocations)++;
+		*allocatedBytes += size;
+		return malloc(size);
+	}
+
+	void Deallocate(void* buffer, vint size)
+	{
+		*allocatedBytes -= size;
+		free(buffer);
+	}
+};
+
 template<typename T>
 struct Moveonly
 {
@@ -267,6 +267,33 @@ TEST_FILE
 			TEST_ASSERT(a == 6);
 			TEST_ASSERT(h2->IsAttached() == false);
 		});
+
+		TEST_CASE(L"Test Event<T> invoking callbacks in subscription order")
+		{
+			List<vint> calls;
+			Event<void(vint)> e;
+			auto h1 = e.Add([&](vint x) { calls.Add(x + 1); });
+			auto h2 = e.Add([&](vint x) { calls.Add(x + 2); });
+			auto h3 = e.Add([&](vint x) { calls.Add(x + 3); });
+			auto h4 = e.Add([&](vint x) { calls.Add(x + 4); });
+
+			TEST_ASSERT(e.Remove(h2));
+			e(10);
+			TEST_ASSERT(calls.Count() == 3);
+			TEST_ASSERT(calls[0] == 11);
+			TEST_ASSERT(calls[1] == 13);
+			TEST_ASSERT(calls[2] == 14);
+
+			calls.Clear();
+			TEST_ASSERT(e.Remove(h1));
+			auto h5 = e.Add([&](vint x) { calls.Add(x + 5); });
+			e(20);
+			TEST_ASSERT(calls.Count() == 3);
+			TEST_ASSERT(calls[0] == 23);
+			TEST_ASSERT(calls[1] == 24);
+			TEST_ASSERT(calls[2] == 25);
+			TEST_ASSERT(h3->IsAttached() && h4->IsAttached() && h5->IsAttached());
+		});
 	});
 
 	TEST_CATEGORY(L"Overloading")
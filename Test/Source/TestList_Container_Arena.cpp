@@ -0,0 +1,163 @@
+#include "AssertCollection.h"
+#include "../../Source/Collections/Arena.h"
+
+namespace TestList_Arena_TestObjects
+{
+	struct Node
+	{
+		vint*		destructed;
+		vint		value;
+		Node*		next;
+
+		Node(vint* _destructed, vint _value, Node* _next)
+			: destructed(_destructed)
+			, value(_value)
+			, next(_next)
+		{
+		}
+
+		~Node()
+		{
+			(*destructed)++;
+		}
+	};
+
+	struct alignas(64) AlignedNode
+	{
+		vint		value;
+	};
+}
+using namespace TestList_Arena_TestObjects;
+
+TEST_FILE
+{
+	TEST_CASE(L"Test Arena::Allocate")
+	{
+		Arena arena(1000);
+		TEST_ASSERT(arena.GetBlockSize() == 1024);
+
+		for (vint i = 0; i < 100; i++)
+		{
+			auto a = (char*)arena.Allocate(3, 1);
+			auto b = (char*)arena.Allocate(8, 8);
+			auto c = (char*)arena.Allocate(16, 16);
+			TEST_ASSERT((vuint)b % 8 == 0);
+			TEST_ASSERT((vuint)c % 16 == 0);
+			memset(a, 1, 3);
+			memset(b, 2, 8);
+			memset(c, 3, 16);
+			TEST_ASSERT(a[2] == 1 && b[7] == 2 && c[15] == 3);
+		}
+
+		auto large = (char*)arena.Allocate(100000);
+		memset(large, 0, 100000);
+		auto small = (char*)arena.Allocate(1);
+		*small = 1;
+		arena.Reset();
+	});
+
+	TEST_CASE(L"Test Arena::New")
+	{
+		vint destructed = 0;
+		{
+			Arena arena(256);
+			Node* head = nullptr;
+			for (vint i = 0; i < 100; i++)
+			{
+				head = arena.New<Node>(&destructed, i, head);
+				auto aligned = arena.New<AlignedNode>(AlignedNode{ i });
+				TEST_ASSERT((vuint)aligned % 64 == 0);
+				TEST_ASSERT(aligned->value == i);
+			}
+
+			vint sum = 0;
+			for (auto node = head; node; node = node->next)
+			{
+				sum += node->value;
+			}
+			TEST_ASSERT(sum == 4950);
+			TEST_ASSERT(destructed == 0);
+		}
+		TEST_ASSERT(destructed == 100);
+	});
+
+	TEST_CASE(L"Test Arena::Rewind and ArenaScope")
+	{
+		vint destructed = 0;
+		Arena arena(256);
+		for (vint i = 0; i < 10; i++)
+		{
+			arena.New<Node>(&destructed, i, nullptr);
+		}
+
+		auto marker = arena.GetMarker();
+		for (vint i = 0; i < 100; i++)
+		{
+			arena.New<Node>(&destructed, i, nullptr);
+		}
+		arena.Rewind(marker);
+		TEST_ASSERT(destructed == 100);
+
+		{
+			ArenaScope scope(arena);
+			for (vint i = 0; i < 100; i++)
+			{
+				arena.New<Node>(&destructed, i, nullptr);
+			}
+		}
+		TEST_ASSERT(destructed == 200);
+
+		arena.Reset();
+		TEST_ASSERT(destructed == 210);
+
+		arena.New<Node>(&destructed, 0, nullptr);
+		arena.Reset();
+		TEST_ASSERT(destructed == 211);
+	});
+
+	TEST_CASE(L"Test TypedArena<T>")
+	{
+		vint destructed = 0;
+		{
+			TypedArena<Node> arena(16);
+			auto marker = arena.GetMarker();
+			for (vint i = 0; i < 100; i++)
+			{
+				arena.New(&destructed, i, nullptr);
+			}
+			arena.Rewind(marker);
+			TEST_ASSERT(destructed == 100);
+
+			auto node = arena.New(&destructed, 1, nullptr);
+			TEST_ASSERT(node->value == 1);
+		}
+		TEST_ASSERT(destructed == 101);
+	});
+
+	TEST_CASE(L"Test List<T, ArenaAllocator>")
+	{
+		Arena arena;
+		{
+			ArenaScope scope(arena);
+			List<vint, ArenaAllocator> list(&arena);
+			for (vint i = 0; i < 1000; i++)
+			{
+				list.Add(i);
+			}
+			TEST_ASSERT(list.Count() == 1000);
+			TEST_ASSERT(From(list).Aggregate([](vint a, vint b) { return a + b; }) == 499500);
+
+			list.RemoveRange(10, 990);
+			CHECK_LIST_ITEMS(list, { 0 _ 1 _ 2 _ 3 _ 4 _ 5 _ 6 _ 7 _ 8 _ 9 });
+		}
+		{
+			ArenaScope scope(arena);
+			Dictionary<vint, WString, ArenaAllocator> dictionary(&arena);
+			for (vint i = 0; i < 100; i++)
+			{
+				dictionary.Add(i, itow(i));
+			}
+			TEST_ASSERT(dictionary[50] == L"50");
+		}
+	});
+}
@@ -2,8 +2,8 @@
 
 namespace TestList_TestObjects
 {
-	template<typename T>
-	void TestArray(Array<T>& arr)
+	template<typename T, typename A>
+	void TestArray(Array<T, A>& arr)
 	{
 		arr.Resize(0);
 		CHECK_EMPTY_LIST(arr);
@@ -49,6 +49,21 @@ TEST_FILE
 		TestArray(arr);
 	});
 
+	TEST_CASE(L"Test Array<vint, CountingAllocator>")
+	{
+		TestWithCountingAllocator<Array<vint, CountingAllocator>>([](auto& arr, vint& allocatedBytes, vint& allocations)
+		{
+			TestArray(arr);
+			TEST_ASSERT(allocatedBytes == (vint)(sizeof(vint) * 5));
+
+			vint allocationsBeforeMoving = allocations;
+			Array<vint, CountingAllocator> moved(std::move(arr));
+			CHECK_LIST_ITEMS(moved, { 0 _ 1 _ 2 _ 3 _ 4 });
+			TEST_ASSERT(allocatedBytes == (vint)(sizeof(vint) * 5));
+			TEST_ASSERT(allocations == allocationsBeforeMoving);
+		}, 0);
+	});
+
 	TEST_CASE(L"Ensure container move constructor and assignment")
 	{
 		{
@@ -0,0 +1,121 @@
+#include "AssertCollection.h"
+#include "../../Source/Collections/BitArray.h"
+
+namespace TestList_Container_BitArray
+{
+	BitArray FromIndexes(vint count, const IEnumerable<vint>& indexes)
+	{
+		BitArray bits(count);
+		for (vint index : indexes)
+		{
+			bits.Set(index, true);
+		}
+		return bits;
+	}
+}
+using namespace TestList_Container_BitArray;
+
+#define CHECK_SET_BITS(BITS, ITEMS)\
+	do{\
+		vint __items__[]=ITEMS;\
+		TEST_ASSERT(BITS.PopCount() == sizeof(__items__)/sizeof(*__items__));\
+		TestLazyList(BITS.SetBits(), __items__, sizeof(__items__)/sizeof(*__items__));\
+	}while(0)\
+
+
+TEST_FILE
+{
+	TEST_CASE(L"Test BitArray")
+	{
+		BitArray bits(130);
+		TEST_ASSERT(bits.Count() == 130);
+		TEST_ASSERT(bits.PopCount() == 0);
+		TEST_ASSERT(!bits.Any());
+		TEST_ASSERT(bits.FindFirst() == -1);
+		TestLazyList(bits.SetBits(), nullptr, 0);
+		TEST_EXCEPTION(bits.Get(130), Error, [](const Error&) {});
+		TEST_EXCEPTION(bits.Set(-1, true), Error, [](const Error&) {});
+
+		bits.Set(0, true);
+		bits.Set(63, true);
+		bits.Set(64, true);
+		bits.Set(129, true);
+		TEST_ASSERT(bits[63] && bits[64] && !bits[65]);
+		TEST_ASSERT(bits.PopCount() == 4);
+		TEST_ASSERT(bits.FindFirst() == 0);
+		TEST_ASSERT(bits.FindNext(1) == 63);
+		TEST_ASSERT(bits.FindNext(65) == 129);
+		TEST_ASSERT(bits.FindNext(130) == -1);
+		CHECK_SET_BITS(bits, { 0 _ 63 _ 64 _ 129 });
+
+		TEST_ASSERT(!bits.Flip(0));
+		TEST_ASSERT(bits.Flip(1));
+		bits.Set(63, false);
+		CHECK_SET_BITS(bits, { 1 _ 64 _ 129 });
+		TEST_ASSERT(From(bits.SetBits()).Count() == 3);
+
+		// shrinking drops bits, growing adds false bits
+		bits.Resize(100);
+		CHECK_SET_BITS(bits, { 1 _ 64 });
+		bits.Resize(200);
+		CHECK_SET_BITS(bits, { 1 _ 64 });
+
+		bits.Fill(true);
+		TEST_ASSERT(bits.PopCount() == 200);
+		bits.Fill(false);
+		TEST_ASSERT(!bits.Any());
+
+		bits.Clear();
+		TEST_ASSERT(bits.Count() == 0);
+		TEST_ASSERT(bits.FindFirst() == -1);
+	});
+
+	TEST_CASE(L"Test BitArray set operations")
+	{
+		for (vint count : { 0, 1, 63, 64, 65, 200, 1000 })
+		{
+			auto evens = FromIndexes(count, Range<vint>(0, count).Where([](vint i) { return i % 2 == 0; }));
+			auto triples = FromIndexes(count, Range<vint>(0, count).Where([](vint i) { return i % 3 == 0; }));
+
+			BitArray bits;
+			bits.Assign(evens).And(triples);
+			CompareEnumerable(bits.SetBits(), Range<vint>(0, count).Where([](vint i) { return i % 6 == 0; }));
+			bits.Assign(evens).Or(triples);
+			CompareEnumerable(bits.SetBits(), Range<vint>(0, count).Where([](vint i) { return i % 2 == 0 || i % 3 == 0; }));
+			bits.Assign(evens).Xor(triples);
+			CompareEnumerable(bits.SetBits(), Range<vint>(0, count).Where([](vint i) { return (i % 2 == 0) != (i % 3 == 0); }));
+			bits.Assign(evens).AndNot(triples);
+			CompareEnumerable(bits.SetBits(), Range<vint>(0, count).Where([](vint i) { return i % 2 == 0 && i % 3 != 0; }));
+			TEST_ASSERT(bits.PopCount() == count / 2 + count % 2 - (count + 5) / 6);
+
+			TEST_ASSERT(bits.Assign(evens) == evens);
+			TEST_ASSERT(count <= 1 || !(triples == evens));
+		}
+
+		BitArray a(10), b(11);
+		TEST_EXCEPTION(a.Or(b), Error, [](const Error&) {});
+		TEST_ASSERT(!(a == b));
+	});
+
+	TEST_CASE(L"Test BitArray with CopyFrom")
+	{
+		BitArray bits;
+		vint items[] = { 5, 70, 3 };
+		CopyFrom(bits, From(items));
+		TEST_ASSERT(bits.Count() == 71);
+		CHECK_SET_BITS(bits, { 3 _ 5 _ 70 });
+
+		CopyFrom(bits, Range<vint>(0, 3), true);
+		TEST_ASSERT(bits.Count() == 71);
+		CHECK_SET_BITS(bits, { 0 _ 1 _ 2 _ 3 _ 5 _ 70 });
+
+		List<vint> indexes;
+		CopyFrom(indexes, bits.SetBits());
+		CHECK_LIST_ITEMS(indexes, { 0 _ 1 _ 2 _ 3 _ 5 _ 70 });
+
+		auto moved = std::move(bits);
+		TEST_ASSERT(bits.Count() == 0);
+		TestLazyList(bits.SetBits(), nullptr, 0);
+		CHECK_SET_BITS(moved, { 0 _ 1 _ 2 _ 3 _ 5 _ 70 });
+	});
+}
@@ -1,5 +1,93 @@
 #include "AssertCollection.h"
 
+namespace TestList_ByteObjectMap_TestObjects
+{
+	template<typename TKey>
+	void TestIntegerObjectMap(TKey(*makeKey)(vint))
+	{
+		vint values[1000];
+		for (vint i = 0; i < 1000; i++)
+		{
+			values[i] = i;
+		}
+
+		typename IntegerObjectMap<TKey, vint>::Allocator allocator;
+		IntegerObjectMap<TKey, vint> map;
+		Dictionary<TKey, vint> expected;
+
+		auto check = [&]()
+		{
+			TEST_ASSERT(map.Count() == expected.Count());
+			for (vint i = 0; i < expected.Count(); i++)
+			{
+				TEST_ASSERT(map.Get(expected.Keys()[i]) == &values[expected.Values()[i]]);
+			}
+
+			vint index = 0;
+			map.ForEach([&](TKey key, vint* value)
+			{
+				TEST_ASSERT(key == expected.Keys()[index]);
+				TEST_ASSERT(value == &values[expected.Values()[index]]);
+				index++;
+			});
+			TEST_ASSERT(index == expected.Count());
+
+			if (expected.Count() >= 4)
+			{
+				vint first = expected.Count() / 4;
+				vint last = expected.Count() * 3 / 4;
+				index = first;
+				map.ForEachInRange(expected.Keys()[first], expected.Keys()[last], [&](TKey key, vint*)
+				{
+					TEST_ASSERT(key == expected.Keys()[index]);
+					index++;
+				});
+				TEST_ASSERT(index == last + 1);
+			}
+		};
+
+		for (vint i = 0; i < 1000; i++)
+		{
+			TKey key = makeKey(i);
+			map.Set(key, &values[i], allocator);
+			expected.Set(key, i);
+		}
+		check();
+
+		for (vint i = 0; i < 1000; i += 3)
+		{
+			TKey key = makeKey(i);
+			TEST_ASSERT(map.Remove(key, allocator));
+			TEST_ASSERT(!map.Remove(key, allocator));
+			TEST_ASSERT(map.Get(key) == nullptr);
+			expected.Remove(key);
+		}
+		check();
+
+		for (vint i = 0; i < 1000; i += 2)
+		{
+			TKey key = makeKey(i);
+			map.Set(key, &values[999 - i], allocator);
+			expected.Set(key, 999 - i);
+		}
+		check();
+
+		map.Clear(allocator);
+		TEST_ASSERT(map.Count() == 0);
+		TEST_ASSERT(map.Get(makeKey(1)) == nullptr);
+		map.Set(makeKey(1), &values[1], allocator);
+		TEST_ASSERT(map.Get(makeKey(1)) == &values[1]);
+		map.Clear(allocator);
+	}
+
+	vuint64_t Scramble(vint i)
+	{
+		vuint64_t x = (vuint64_t)i * 0x9E3779B97F4A7C15ULL;
+		return x ^ (x >> 29);
+	}
+}
+using namespace TestList_ByteObjectMap_TestObjects;
+
 TEST_FILE
 {
 	TEST_CASE(L"Test PushOnlyAllocator<T>")
@@ -36,4 +124,124 @@ TEST_FILE
 			TEST_ASSERT(map.Get((vuint8_t)i) == ints.Get(i));
 		}
 	});
+
+	TEST_CASE(L"Test ByteObjectMap<T> growing through all node sizes")
+	{
+		PushOnlyAllocator<vint> ints(256);
+		for (vint i = 0; i < 256; i++)
+		{
+			*ints.Create() = i;
+		}
+
+		ByteObjectMap<vint>::Allocator mapAllocator;
+		vint counts[] = { 1, 4, 5, 16, 17, 48, 49, 256 };
+		for (vint count : counts)
+		{
+			ByteObjectMap<vint> map;
+			for (vint i = 0; i < count; i++)
+			{
+				vuint8_t key = (vuint8_t)(i * 37 + 11);
+				map.Set(key, ints.Get(key), mapAllocator);
+			}
+
+			for (vint i = 0; i < 256; i++)
+			{
+				bool inserted = false;
+				for (vint j = 0; j < count; j++)
+				{
+					if ((vuint8_t)(j * 37 + 11) == (vuint8_t)i)
+					{
+						inserted = true;
+						break;
+					}
+				}
+				TEST_ASSERT(map.Get((vuint8_t)i) == (inserted ? ints.Get(i) : nullptr));
+			}
+		}
+	});
+
+	TEST_CASE(L"Test ByteObjectMap<T> overriding and clearing values")
+	{
+		PushOnlyAllocator<vint> ints(256);
+		for (vint i = 0; i < 256; i++)
+		{
+			*ints.Create() = i;
+		}
+
+		ByteObjectMap<vint>::Allocator mapAllocator;
+		ByteObjectMap<vint> map;
+		TEST_ASSERT(map.Get(0) == nullptr);
+		map.Set(0, nullptr, mapAllocator);
+		TEST_ASSERT(map.Get(0) == nullptr);
+
+		for (vint i = 0; i < 100; i++)
+		{
+			map.Set((vuint8_t)i, ints.Get(i), mapAllocator);
+			map.Set((vuint8_t)i, ints.Get(255 - i), mapAllocator);
+			map.Set((vuint8_t)(i + 100), nullptr, mapAllocator);
+		}
+
+		for (vint i = 0; i < 256; i++)
+		{
+			TEST_ASSERT(map.Get((vuint8_t)i) == (i < 100 ? ints.Get(255 - i) : nullptr));
+		}
+
+		for (vint i = 0; i < 100; i += 2)
+		{
+			map.Set((vuint8_t)i, nullptr, mapAllocator);
+		}
+		for (vint i = 0; i < 100; i++)
+		{
+			TEST_ASSERT(map.Get((vuint8_t)i) == (i % 2 == 0 ? nullptr : ints.Get(255 - i)));
+		}
+	});
+
+	TEST_CASE(L"Test IntegerObjectMap<TKey, T>")
+	{
+		TestIntegerObjectMap<vuint16_t>([](vint i) { return (vuint16_t)Scramble(i); });
+		TestIntegerObjectMap<vuint32_t>([](vint i) { return (vuint32_t)Scramble(i); });
+		TestIntegerObjectMap<vuint64_t>([](vint i) { return Scramble(i); });
+		TestIntegerObjectMap<vint>([](vint i) { return (vint)Scramble(i); });
+		TestIntegerObjectMap<vint>([](vint i) { return i - 500; });
+		TestIntegerObjectMap<vint32_t>([](vint i) { return (vint32_t)(i * 1000 - 500000); });
+	});
+
+	TEST_CASE(L"Test IntegerObjectMap<TKey, T> with dense keys")
+	{
+		vint values[4096];
+		IntegerObjectMap<vint, vint>::Allocator allocator;
+		IntegerObjectMap<vint, vint> map;
+		for (vint i = 0; i < 4096; i++)
+		{
+			values[i] = i;
+			map.Set(i, &values[i], allocator);
+		}
+		TEST_ASSERT(map.Count() == 4096);
+
+		vint sum = 0;
+		map.ForEachInRange(1000, 1999, [&](vint key, vint* value)
+		{
+			TEST_ASSERT(*value == key);
+			sum += key;
+		});
+		TEST_ASSERT(sum == 1499500);
+
+		for (vint i = 0; i < 4096; i++)
+		{
+			if (i % 100 != 0)
+			{
+				map.Set(i, nullptr, allocator);
+			}
+		}
+		TEST_ASSERT(map.Count() == 41);
+
+		vint expected = 0;
+		map.ForEach([&](vint key, vint*)
+		{
+			TEST_ASSERT(key == expected);
+			expected += 100;
+		});
+		TEST_ASSERT(expected == 4100);
+		map.Clear(allocator);
+	});
 }
\ No newline at end of file
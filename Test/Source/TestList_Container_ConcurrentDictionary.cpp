@@ -0,0 +1,132 @@
+#include <thread>
+#include "AssertCollection.h"
+#include "../../Source/Collections/ConcurrentDictionary.h"
+
+TEST_FILE
+{
+	TEST_CASE(L"Test ConcurrentDictionary<K, V> in one thread")
+	{
+		TEST_EXCEPTION((ConcurrentDictionary<vint, vint>(0)), Error, [](const Error&) {});
+		ConcurrentDictionary<vint, WString> dictionary(5);
+		TEST_ASSERT(dictionary.ShardCount() == 8);
+		TEST_ASSERT(dictionary.Count() == 0);
+
+		WString value;
+		TEST_ASSERT(!dictionary.TryGet(1, value));
+		TEST_ASSERT(dictionary.TryAdd(1, L"one"));
+		TEST_ASSERT(!dictionary.TryAdd(1, L"uno"));
+		TEST_ASSERT(dictionary.TryGet(1, value) && value == L"one");
+
+		TEST_ASSERT(dictionary.GetOrAdd(1, L"uno") == L"one");
+		TEST_ASSERT(dictionary.GetOrAdd(2, L"two") == L"two");
+		TEST_ASSERT(dictionary.GetOrAdd(3, [](vint key) { return itow(key); }) == L"3");
+		TEST_ASSERT(dictionary.GetOrAdd(3, [](vint) -> WString { TEST_ASSERT(false); return {}; }) == L"3");
+
+		auto update = [](vint key, const WString& old) { return old + L"+" + itow(key); };
+		TEST_ASSERT(dictionary.AddOrUpdate(2, L"zwei", update) == L"two+2");
+		TEST_ASSERT(dictionary.AddOrUpdate(4, L"four", update) == L"four");
+
+		// factories run without locking the dictionary
+		TEST_ASSERT(dictionary.GetOrAdd(5, [&](vint) { return dictionary.GetOrAdd(1, L"uno") + L"+5"; }) == L"one+5");
+		TEST_ASSERT(dictionary.AddOrUpdate(5, L"five", [&](vint, const WString& old) { return old + L"+" + itow(dictionary.Count()); }) == L"one+5+5");
+		TEST_ASSERT(dictionary.TryRemove(5));
+		TEST_ASSERT(dictionary.Count() == 4);
+		TEST_ASSERT(dictionary.Contains(4));
+
+		TEST_ASSERT(dictionary.TryRemove(4));
+		TEST_ASSERT(!dictionary.TryRemove(4));
+		TEST_ASSERT(dictionary.TryRemove(2, value) && value == L"two+2");
+		TEST_ASSERT(!dictionary.Contains(2));
+
+		Dictionary<vint, WString> copied;
+		CopyFrom(copied, dictionary);
+		CHECK_LIST_ITEMS(copied.Keys(), { 1 _ 3 });
+		TEST_ASSERT(copied[1] == L"one");
+		TEST_ASSERT(copied[3] == L"3");
+
+		dictionary.Clear();
+		TEST_ASSERT(dictionary.Count() == 0);
+	});
+
+	TEST_CASE(L"Test ConcurrentDictionary<K, V> snapshot enumeration")
+	{
+		ConcurrentDictionary<vint, vint> dictionary;
+		for (vint i = 0; i < 100; i++)
+		{
+			dictionary.TryAdd(i, i * i);
+		}
+
+		auto enumerator = Ptr(dictionary.CreateEnumerator());
+		for (vint i = 0; i < 100; i++)
+		{
+			dictionary.TryRemove(i);
+		}
+		TEST_ASSERT(dictionary.Count() == 0);
+
+		SortedList<vint> keys;
+		vint index = 0;
+		while (enumerator->Next())
+		{
+			TEST_ASSERT(enumerator->Index() == index++);
+			auto pair = enumerator->Current();
+			TEST_ASSERT(pair.value == pair.key * pair.key);
+			keys.Add(pair.key);
+		}
+		CompareEnumerable(keys, Range<vint>(0, 100));
+		TEST_ASSERT(From(dictionary).IsEmpty());
+	});
+
+	TEST_CASE(L"Test ConcurrentDictionary<K, V> with multiple threads")
+	{
+		const vint Threads = 8;
+		const vint Count = 20000;
+		ConcurrentDictionary<vint, vint> dictionary;
+		std::atomic<vint> created{ 0 };
+
+		std::thread threads[Threads];
+		for (vint t = 0; t < Threads; t++)
+		{
+			threads[t] = std::thread([&, t]()
+			{
+				for (vint i = 0; i < Count; i++)
+				{
+					// every thread asks for all keys, values created by threads losing the race are discarded
+					dictionary.GetOrAdd(i, [&](vint key) { created++; return key; });
+					dictionary.AddOrUpdate(-1, 1, [](vint, vint old) { return old + 1; });
+					if (i % Threads == t)
+					{
+						dictionary.TryAdd(Count + i, t);
+						CHECK_ERROR(dictionary.TryRemove(Count + i), L"A key added by a thread is removed by another thread.");
+					}
+				}
+			});
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		vint value = 0;
+		TEST_ASSERT(created >= Count);
+		TEST_ASSERT(dictionary.Count() == Count + 1);
+		TEST_ASSERT(dictionary.TryGet(-1, value) && value == Threads * Count);
+		for (vint i = 0; i < Count; i++)
+		{
+			TEST_ASSERT(dictionary.TryGet(i, value) && value == i);
+		}
+	});
+
+	TEST_CASE(L"Test ConcurrentDictionary<K, V> with CountingAllocator")
+	{
+		TestWithCountingAllocator<ConcurrentDictionary<vint, vint, CountingAllocator>>([](auto& dictionary, vint&, vint& allocations)
+		{
+			// shards are allocated in one buffer, dictionaries in shards allocate only when pairs are added
+			TEST_ASSERT(allocations == 1);
+			for (vint i = 0; i < 100; i++)
+			{
+				dictionary.TryAdd(i, i);
+			}
+			TEST_ASSERT(allocations >= 1 + 3 * dictionary.ShardCount());
+		}, 4);
+	});
+}
@@ -0,0 +1,226 @@
+#include <thread>
+#include "AssertCollection.h"
+#include "../../Source/Collections/ConcurrentQueue.h"
+
+namespace TestList_Container_ConcurrentQueue_TestObjects
+{
+	struct WorkItem
+	{
+		vint* destructed;
+		vint value;
+
+		WorkItem(vint* _destructed, vint _value) :destructed(_destructed), value(_value) {}
+		~WorkItem() { (*destructed)++; }
+	};
+
+	struct ThrowOnCopy
+	{
+		vint value = 0;
+
+		ThrowOnCopy() = default;
+		ThrowOnCopy(vint _value) :value(_value) {}
+		ThrowOnCopy(const ThrowOnCopy& item) :value(item.value) { CHECK_ERROR(value >= 0, L"ThrowOnCopy"); }
+		ThrowOnCopy& operator=(const ThrowOnCopy& item) { CHECK_ERROR(item.value >= 0, L"ThrowOnCopy"); value = item.value; return *this; }
+	};
+}
+using namespace TestList_Container_ConcurrentQueue_TestObjects;
+
+TEST_FILE
+{
+	TEST_CASE(L"Test ConcurrentQueue<T> in one thread")
+	{
+		TEST_EXCEPTION(ConcurrentQueue<vint>(0), Error, [](const Error&) {});
+		ConcurrentQueue<vint> queue(5);
+		TEST_ASSERT(queue.Capacity() == 8);
+
+		vint item = -1;
+		TEST_ASSERT(!queue.TryDequeue(item));
+		for (vint i = 0; i < 8; i++)
+		{
+			TEST_ASSERT(queue.TryEnqueue(i));
+		}
+		TEST_ASSERT(!queue.TryEnqueue(8));
+
+		for (vint round = 0; round < 3; round++)
+		{
+			for (vint i = 0; i < 8; i++)
+			{
+				TEST_ASSERT(queue.TryDequeue(item));
+				TEST_ASSERT(item == round * 8 + i);
+				TEST_ASSERT(queue.TryEnqueue(item + 8));
+			}
+		}
+	});
+
+	TEST_CASE(L"Test ConcurrentQueue<T> when constructing an element throws")
+	{
+		ConcurrentQueue<ThrowOnCopy> queue(4);
+		ThrowOnCopy item;
+		TEST_ASSERT(queue.TryEnqueue(ThrowOnCopy(0)));
+		TEST_EXCEPTION(queue.TryEnqueue(ThrowOnCopy(-1)), Error, [](const Error&) {});
+		TEST_ASSERT(queue.TryEnqueue(ThrowOnCopy(1)));
+		TEST_EXCEPTION(queue.TryEnqueue(ThrowOnCopy(-1)), Error, [](const Error&) {});
+		TEST_ASSERT(!queue.TryEnqueue(ThrowOnCopy(2)));
+
+		// failed slots are skipped instead of blocking consumers
+		TEST_ASSERT(queue.TryDequeue(item) && item.value == 0);
+		TEST_ASSERT(queue.TryDequeue(item) && item.value == 1);
+		TEST_ASSERT(!queue.TryDequeue(item));
+
+		for (vint round = 0; round < 3; round++)
+		{
+			TEST_ASSERT(queue.TryEnqueue(ThrowOnCopy(round)));
+			TEST_ASSERT(queue.TryDequeue(item) && item.value == round);
+		}
+		TEST_EXCEPTION(queue.TryEnqueue(ThrowOnCopy(-1)), Error, [](const Error&) {});
+		TEST_ASSERT(queue.TryEnqueue(ThrowOnCopy(3)));
+	});
+
+	TEST_CASE(L"Test SpscQueue<T> in one thread")
+	{
+		TEST_EXCEPTION(SpscQueue<vint>(0), Error, [](const Error&) {});
+		SpscQueue<vint> queue(3);
+		TEST_ASSERT(queue.Capacity() == 4);
+
+		vint item = -1;
+		TEST_ASSERT(!queue.TryDequeue(item));
+		for (vint i = 0; i < 4; i++)
+		{
+			TEST_ASSERT(queue.TryEnqueue(i));
+		}
+		TEST_ASSERT(!queue.TryEnqueue(4));
+		TEST_ASSERT(queue.TryDequeue(item) && item == 0);
+		TEST_ASSERT(queue.TryEnqueue(4));
+		for (vint i = 1; i <= 4; i++)
+		{
+			TEST_ASSERT(queue.TryDequeue(item) && item == i);
+		}
+		TEST_ASSERT(!queue.TryDequeue(item));
+	});
+
+	TEST_CASE(L"Test ConcurrentQueue<T> with multiple producers and consumers")
+	{
+		const vint Threads = 4;
+		const vint Count = 100000;
+		ConcurrentQueue<vint> queue(64);
+		std::atomic<vint> sum{ 0 };
+		std::atomic<vint> consumed{ 0 };
+		std::atomic<bool> outOfOrder{ false };
+
+		std::thread producers[Threads];
+		std::thread consumers[Threads];
+		for (vint t = 0; t < Threads; t++)
+		{
+			producers[t] = std::thread([&queue, t]()
+			{
+				for (vint i = 0; i < Count; i++)
+				{
+					while (!queue.TryEnqueue(t * Count + i))
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+			consumers[t] = std::thread([&]()
+			{
+				// items from the same producer are received in order
+				vint last[Threads] = { -1, -1, -1, -1 };
+				vint item = -1;
+				while (consumed.load() < Threads * Count)
+				{
+					if (queue.TryDequeue(item))
+					{
+						vint producer = item / Count;
+						if (item <= last[producer]) outOfOrder = true;
+						last[producer] = item;
+						sum += item;
+						consumed++;
+					}
+					else
+					{
+						std::this_thread::yield();
+					}
+				}
+			});
+		}
+		for (vint t = 0; t < Threads; t++)
+		{
+			producers[t].join();
+			consumers[t].join();
+		}
+		TEST_ASSERT(consumed == Threads * Count);
+		TEST_ASSERT(sum == (Threads * Count) * (Threads * Count - 1) / 2);
+		TEST_ASSERT(!outOfOrder);
+	});
+
+	TEST_CASE(L"Test SpscQueue<T> with one producer and one consumer")
+	{
+		const vint Count = 1000000;
+		SpscQueue<vint> queue(256);
+		bool outOfOrder = false;
+
+		std::thread producer([&queue]()
+		{
+			for (vint i = 0; i < Count; i++)
+			{
+				while (!queue.TryEnqueue(i))
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+		std::thread consumer([&queue, &outOfOrder]()
+		{
+			vint item = -1;
+			for (vint i = 0; i < Count; i++)
+			{
+				while (!queue.TryDequeue(item))
+				{
+					std::this_thread::yield();
+				}
+				if (item != i) outOfOrder = true;
+			}
+		});
+		producer.join();
+		consumer.join();
+		TEST_ASSERT(!outOfOrder);
+	});
+
+	TEST_CASE(L"Test concurrent queues with Ptr<T> and CountingAllocator")
+	{
+		vint destructed = 0;
+		auto testQueue = [&](auto& queue, vint&, vint& allocations)
+		{
+			vint destructedBefore = destructed;
+			for (vint i = 0; i < 4; i++)
+			{
+				TEST_ASSERT(queue.TryEnqueue(Ptr(new WorkItem(&destructed, i))));
+			}
+
+			auto rejected = Ptr(new WorkItem(&destructed, 4));
+			TEST_ASSERT(!queue.TryEnqueue(std::move(rejected)));
+			TEST_ASSERT(rejected && rejected->value == 4);
+			rejected = nullptr;
+			TEST_ASSERT(destructed == destructedBefore + 1);
+
+			Ptr<WorkItem> item;
+			TEST_ASSERT(queue.TryDequeue(item) && item->value == 0);
+			TEST_ASSERT(destructed == destructedBefore + 1);
+			item = nullptr;
+			TEST_ASSERT(destructed == destructedBefore + 2);
+
+			// the buffer is allocated in the constructor
+			TEST_ASSERT(allocations == 1);
+		};
+
+		TestWithCountingAllocator<ConcurrentQueue<Ptr<WorkItem>, CountingAllocator>>(testQueue, 4);
+		TEST_ASSERT(destructed == 5);
+
+		TestWithCountingAllocator<SpscQueue<Ptr<WorkItem>, CountingAllocator>>([&](auto& queue, vint& allocatedBytes, vint& allocations)
+		{
+			TEST_ASSERT(allocatedBytes == (vint)(sizeof(Ptr<WorkItem>) * queue.Capacity()));
+			testQueue(queue, allocatedBytes, allocations);
+		}, 4);
+		TEST_ASSERT(destructed == 10);
+	});
+}
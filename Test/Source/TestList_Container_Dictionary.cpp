@@ -2,7 +2,8 @@
 
 namespace TestList_TestObjects
 {
-	void TestSortedDictionary(Dictionary<vint, vint>& dictionary)
+	template<typename A>
+	void TestSortedDictionary(Dictionary<vint, vint, A>& dictionary)
 	{
 		dictionary.Clear();
 		CHECK_EMPTY_DICTIONARY(dictionary);
@@ -40,6 +41,86 @@ TEST_FILE
 		TestSortedDictionary(dictionary);
 	});
 
+	TEST_CASE(L"Test Dictionary<K, V, CountingAllocator>")
+	{
+		TestWithCountingAllocator<Dictionary<vint, vint, CountingAllocator>>([](auto& dictionary, vint& allocatedBytes, vint&)
+		{
+			TestSortedDictionary(dictionary);
+			dictionary.Add(1, 1);
+			TEST_ASSERT(allocatedBytes == (vint)(sizeof(vint) * (dictionary.Keys().Capacity() + dictionary.Values().Capacity())));
+
+			dictionary.Clear();
+			TEST_ASSERT(allocatedBytes == 0);
+		});
+	});
+
+	TEST_CASE(L"Test Dictionary<K, V>::BuildFrom and AddRange")
+	{
+		List<Pair<vint, vint>> pairs;
+		for (vint i = 0; i < 10; i++)
+		{
+			pairs.Add({ (i * 7) % 5, i });
+		}
+
+		Dictionary<vint, vint> dictionary;
+		dictionary.Add(100, 100);
+		dictionary.BuildFrom(pairs);
+		CHECK_DICTIONARY_ITEMS(dictionary, { 0 _ 1 _ 2 _ 3 _ 4 }, { 5 _ 8 _ 6 _ 9 _ 7 });
+
+		dictionary.AddRange(From(Range<vint>(3, 5)).Select([](vint i) { return Pair<vint, vint>(i, -i); }));
+		CHECK_DICTIONARY_ITEMS(dictionary, { 0 _ 1 _ 2 _ 3 _ 4 _ 5 _ 6 _ 7 }, { 5 _ 8 _ 6 _ -3 _ -4 _ -5 _ -6 _ -7 });
+
+		Dictionary<vint, vint> copied;
+		copied.Add(-1, -1);
+		CopyFrom(copied, dictionary, true);
+		CHECK_DICTIONARY_ITEMS(copied, { -1 _ 0 _ 1 _ 2 _ 3 _ 4 _ 5 _ 6 _ 7 }, { -1 _ 5 _ 8 _ 6 _ -3 _ -4 _ -5 _ -6 _ -7 });
+
+		dictionary.BuildFrom(From(dictionary).Where([](auto&& pair) { return pair.value > 0; }));
+		CHECK_DICTIONARY_ITEMS(dictionary, { 0 _ 1 _ 2 }, { 5 _ 8 _ 6 });
+
+		vint evaluated = 0;
+		dictionary.BuildFrom(From(Range<vint>(0, 5)).Select([&](vint i) { evaluated++; return Pair<vint, vint>(4 - i, i); }));
+		TEST_ASSERT(evaluated == 5);
+		CHECK_DICTIONARY_ITEMS(dictionary, { 0 _ 1 _ 2 _ 3 _ 4 }, { 4 _ 3 _ 2 _ 1 _ 0 });
+
+		dictionary.BuildFrom(List<Pair<vint, vint>>());
+		CHECK_EMPTY_DICTIONARY(dictionary);
+	});
+
+	TEST_CASE(L"Test Dictionary<K, V>::BuildFrom with many values")
+	{
+		const vint Count = 10000;
+		List<Pair<vint, vint>> pairs;
+		Dictionary<vint, vint> reference;
+		for (vint i = 0; i < Count; i++)
+		{
+			vint key = (i * 7919) % (Count / 2);
+			pairs.Add({ key, i });
+			reference.Set(key, i);
+		}
+
+		vint allocatedBytes = 0;
+		vint allocations = 0;
+		{
+			Dictionary<vint, vint, CountingAllocator> dictionary(CountingAllocator(&allocatedBytes, &allocations));
+			dictionary.BuildFrom(pairs);
+			// one buffer for keys, one buffer for values, and one temporary buffer for sorting
+			TEST_ASSERT(allocations == 3);
+			TEST_ASSERT(dictionary.Count() == reference.Count());
+			for (vint i = 0; i < reference.Count(); i++)
+			{
+				TEST_ASSERT(dictionary.Keys()[i] == reference.Keys()[i]);
+				TEST_ASSERT(dictionary.Values()[i] == reference.Values()[i]);
+			}
+
+			allocations = 0;
+			dictionary.BuildFrom(reference);
+			TEST_ASSERT(allocations == 2);
+			TEST_ASSERT(dictionary.Count() == reference.Count());
+		}
+		TEST_ASSERT(allocatedBytes == 0);
+	});
+
 	TEST_CASE(L"Ensure container move constructor and assignment")
 	{
 		{
@@ -0,0 +1,84 @@
+#include "AssertCollection.h"
+#include "../../Source/Collections/EytzingerIndex.h"
+
+TEST_FILE
+{
+	TEST_CASE(L"Test EytzingerIndex<T>")
+	{
+		for (vint count = 0; count < 100; count++)
+		{
+			SortedList<vint> list;
+			for (vint i = 0; i < count; i++)
+			{
+				list.Add(i * 2);
+			}
+
+			EytzingerIndex<vint> index(list);
+			TEST_ASSERT(index.Count() == count);
+			for (vint item = -1; item <= count * 2; item++)
+			{
+				TEST_ASSERT(index.IndexOf(item) == list.IndexOf(item));
+				TEST_ASSERT(index.Contains(item) == (item >= 0 && item < count * 2 && item % 2 == 0));
+				TEST_ASSERT(index.LowerBound(item) == (item < 0 ? 0 : (item + 1) / 2));
+			}
+		}
+	});
+
+	TEST_CASE(L"Test EytzingerIndex<T> with duplicated elements")
+	{
+		SortedList<vint> list;
+		for (vint i = 0; i < 30; i++)
+		{
+			list.Add(i / 3);
+		}
+		EytzingerIndex<vint> index(list);
+		for (vint i = 0; i < 10; i++)
+		{
+			TEST_ASSERT(index.IndexOf(i) == i * 3);
+		}
+		TEST_ASSERT(index.IndexOf(10) == -1);
+		TEST_ASSERT(index.LowerBound(10) == 30);
+	});
+
+	TEST_CASE(L"Test EytzingerIndex<T> over dictionary keys")
+	{
+		Dictionary<WString, vint> dictionary;
+		for (vint i = 0; i < 1000; i++)
+		{
+			dictionary.Add(itow(i), i);
+		}
+
+		EytzingerIndex<WString> index(dictionary.Keys());
+		for (vint i = 0; i < 1000; i++)
+		{
+			vint position = index.IndexOf(itow(i));
+			TEST_ASSERT(position == dictionary.Keys().IndexOf(itow(i)));
+			TEST_ASSERT(dictionary.Values()[position] == i);
+		}
+		TEST_ASSERT(!index.Contains(L"-1"));
+
+		// the index is a snapshot
+		dictionary.Clear();
+		TEST_ASSERT(index.Count() == 1000);
+		TEST_ASSERT(index.IndexOf(L"999") == 999);
+
+		auto moved = std::move(index);
+		TEST_ASSERT(index.Count() == 0);
+		TEST_ASSERT(index.IndexOf(L"1") == -1);
+		TEST_ASSERT(moved.Contains(L"1"));
+	});
+
+	TEST_CASE(L"Test EytzingerIndex<T, CountingAllocator>")
+	{
+		TestWithCountingAllocator<SortedList<vint, CountingAllocator>>([](auto& list, vint& allocatedBytes, vint& allocations)
+		{
+			for (vint i = 0; i < 100; i++)
+			{
+				list.Add(i);
+			}
+			vint bytesForList = allocatedBytes;
+			EytzingerIndex<vint, CountingAllocator> index(list, CountingAllocator(&allocatedBytes, &allocations));
+			TEST_ASSERT(allocatedBytes == bytesForList + (vint)(sizeof(vint) * 2 * 101));
+		});
+	});
+}
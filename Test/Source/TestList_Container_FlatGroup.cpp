@@ -0,0 +1,102 @@
+#include "AssertCollection.h"
+#include "../../Source/Collections/FlatGroup.h"
+
+TEST_FILE
+{
+	TEST_CASE(L"Test FlatGroup<K, V>")
+	{
+		FlatGroup<vint, vint> group;
+		CHECK_EMPTY_GROUP(group);
+
+		List<Pair<vint, vint>> pairs;
+		for (vint i = 0; i < 20; i++)
+		{
+			pairs.Add({ 3 - i % 4, i });
+		}
+		group.BuildFrom(pairs);
+		CHECK_GROUP_ITEMS(group, { 0 _ 1 _ 2 _ 3 }, { 3 _ 7 _ 11 _ 15 _ 19 _ 2 _ 6 _ 10 _ 14 _ 18 _ 1 _ 5 _ 9 _ 13 _ 17 _ 0 _ 4 _ 8 _ 12 _ 16 }, { 5 _ 5 _ 5 _ 5 });
+		TEST_ASSERT(group.ValueCount() == 20);
+		TEST_ASSERT(!group.Contains(4));
+		TEST_ASSERT(!group.Contains(0, 0));
+		TEST_EXCEPTION(group.Get(4), Error, [](const Error&) {});
+
+		group.BuildFrom(From(group).Where([](auto&& pair) { return pair.value % 2 == 0; }));
+		CHECK_GROUP_ITEMS(group, { 1 _ 3 }, { 2 _ 6 _ 10 _ 14 _ 18 _ 0 _ 4 _ 8 _ 12 _ 16 }, { 5 _ 5 });
+
+		group.Clear();
+		CHECK_EMPTY_GROUP(group);
+	});
+
+	TEST_CASE(L"Test FlatGroup<K, V> from Group<K, V>")
+	{
+		Group<vint, vint> source;
+		for (vint i = 0; i < 20; i++)
+		{
+			source.Add(i / 5, 20 - i);
+		}
+
+		FlatGroup<vint, vint> group;
+		group.BuildFrom(source);
+		CHECK_GROUP_ITEMS(group, { 0 _ 1 _ 2 _ 3 }, { 20 _ 19 _ 18 _ 17 _ 16 _ 15 _ 14 _ 13 _ 12 _ 11 _ 10 _ 9 _ 8 _ 7 _ 6 _ 5 _ 4 _ 3 _ 2 _ 1 }, { 5 _ 5 _ 5 _ 5 });
+
+		vint sum = 0;
+		for (vint value : group[2])
+		{
+			sum += value;
+		}
+		TEST_ASSERT(sum == 40);
+
+		FlatGroup<vint, vint> moved(std::move(group));
+		CHECK_EMPTY_GROUP(group);
+		TEST_ASSERT(moved.Count() == 4);
+
+		Group<vint, vint> copied;
+		CopyFrom(copied, moved);
+		CHECK_GROUP_ITEMS(copied, { 0 _ 1 _ 2 _ 3 }, { 20 _ 19 _ 18 _ 17 _ 16 _ 15 _ 14 _ 13 _ 12 _ 11 _ 10 _ 9 _ 8 _ 7 _ 6 _ 5 _ 4 _ 3 _ 2 _ 1 }, { 5 _ 5 _ 5 _ 5 });
+	});
+
+	TEST_CASE(L"Test FlatGroup<K, V, CountingAllocator>")
+	{
+		const vint Count = 10000;
+		const vint Keys = 1000;
+		Group<vint, vint> source;
+		for (vint i = 0; i < Count; i++)
+		{
+			source.Add((i * 7919) % Keys, i);
+		}
+
+		TestWithCountingAllocator<FlatGroup<vint, vint, CountingAllocator>>([&](auto& group, vint&, vint& allocations)
+		{
+			// keys, offsets and values are allocated once each
+			group.BuildFrom(source);
+			TEST_ASSERT(allocations == 3);
+			TEST_ASSERT(group.Count() == Keys);
+			TEST_ASSERT(group.ValueCount() == Count);
+			for (vint i = 0; i < Keys; i++)
+			{
+				auto values = group.GetByIndex(i);
+				TEST_ASSERT(values.Count() == Count / Keys);
+				for (vint j = 0; j < values.Count(); j++)
+				{
+					TEST_ASSERT(source.Contains(i, values[j]));
+				}
+			}
+		});
+	});
+
+	TEST_CASE(L"Ensure container move constructor and assignment")
+	{
+		{
+			FlatGroup<vint, vint> a;
+			FlatGroup<vint, vint> b(std::move(a));
+			FlatGroup<vint, vint> c;
+			c = std::move(b);
+		}
+		{
+			FlatGroup<Moveonly<vint>, Moveonly<vint>> a;
+			FlatGroup<Moveonly<vint>, Moveonly<vint>> b(std::move(a));
+			FlatGroup<Moveonly<vint>, Moveonly<vint>> c;
+			c = std::move(b);
+		}
+	});
+}
@@ -2,7 +2,8 @@
 
 namespace TestList_TestObjects
 {
-	void TestSortedGroup(Group<vint, vint>& group)
+	template<typename A>
+	void TestSortedGroup(Group<vint, vint, A>& group)
 	{
 		group.Clear();
 		CHECK_EMPTY_GROUP(group);
@@ -37,6 +38,96 @@ TEST_FILE
 		TestSortedGroup(group);
 	});
 
+	TEST_CASE(L"Test Group<K, V, CountingAllocator>")
+	{
+		TestWithCountingAllocator<Group<vint, vint, CountingAllocator>>([](auto& group, vint& allocatedBytes, vint& allocations)
+		{
+			TestSortedGroup(group);
+			group.Clear();
+			TEST_ASSERT(allocatedBytes == 0);
+
+			// every key has its own value container, which is also allocated by the allocator
+			vint allocationsBeforeAdding = allocations;
+			group.Add(1, 1);
+			group.Add(1, 2);
+			group.Add(2, 3);
+			TEST_ASSERT(allocations - allocationsBeforeAdding >= 2 * 2);
+
+			vint valueBytes = 0;
+			for (vint i = 0; i < group.Count(); i++)
+			{
+				valueBytes += (vint)(sizeof(List<vint, CountingAllocator>) + sizeof(vint) * group.GetByIndex(i).Capacity());
+			}
+			TEST_ASSERT(allocatedBytes > (vint)(valueBytes + sizeof(vint) * group.Keys().Capacity()));
+		});
+	});
+
+	TEST_CASE(L"Test Group<K, V>::BuildFrom and AddRange")
+	{
+		List<Pair<vint, vint>> pairs;
+		for (vint i = 0; i < 10; i++)
+		{
+			pairs.Add({ (i * 7) % 3, i });
+		}
+
+		Group<vint, vint> group;
+		group.Add(100, 100);
+		group.BuildFrom(pairs);
+		CHECK_GROUP_ITEMS(group, { 0 _ 1 _ 2 }, { 0 _ 3 _ 6 _ 9 _ 1 _ 4 _ 7 _ 2 _ 5 _ 8 }, { 4 _ 3 _ 3 });
+
+		group.AddRange(From(Range<vint>(1, 3)).Select([](vint i) { return Pair<vint, vint>(i * 2, -i); }));
+		CHECK_GROUP_ITEMS(group, { 0 _ 1 _ 2 _ 4 _ 6 }, { 0 _ 3 _ 6 _ 9 _ 1 _ 4 _ 7 _ 2 _ 5 _ 8 _ -1 _ -2 _ -3 }, { 4 _ 3 _ 4 _ 1 _ 1 });
+
+		Group<vint, vint> copied;
+		copied.Add(1, -100);
+		CopyFrom(copied, group, true);
+		CHECK_GROUP_ITEMS(copied, { 0 _ 1 _ 2 _ 4 _ 6 }, { 0 _ 3 _ 6 _ 9 _ -100 _ 1 _ 4 _ 7 _ 2 _ 5 _ 8 _ -1 _ -2 _ -3 }, { 4 _ 4 _ 4 _ 1 _ 1 });
+
+		group.BuildFrom(From(group).Where([](auto&& pair) { return pair.value >= 0; }));
+		CHECK_GROUP_ITEMS(group, { 0 _ 1 _ 2 }, { 0 _ 3 _ 6 _ 9 _ 1 _ 4 _ 7 _ 2 _ 5 _ 8 }, { 4 _ 3 _ 3 });
+
+		vint evaluated = 0;
+		group.BuildFrom(From(Range<vint>(0, 6)).Select([&](vint i) { evaluated++; return Pair<vint, vint>(2 - i % 3, i); }));
+		TEST_ASSERT(evaluated == 6);
+		CHECK_GROUP_ITEMS(group, { 0 _ 1 _ 2 }, { 2 _ 5 _ 1 _ 4 _ 0 _ 3 }, { 2 _ 2 _ 2 });
+
+		group.BuildFrom(List<Pair<vint, vint>>());
+		CHECK_EMPTY_GROUP(group);
+	});
+
+	TEST_CASE(L"Test Group<K, V>::BuildFrom with many values")
+	{
+		const vint Count = 10000;
+		const vint Keys = 100;
+		List<Pair<vint, vint>> pairs;
+		for (vint i = 0; i < Count; i++)
+		{
+			pairs.Add({ (i * 7919) % Keys, i });
+		}
+
+		vint allocatedBytes = 0;
+		vint allocations = 0;
+		{
+			Group<vint, vint, CountingAllocator> group(CountingAllocator(&allocatedBytes, &allocations));
+			group.BuildFrom(pairs);
+			// temporary buffers for keys, values and sorting, one buffer for value lists, and one container with one buffer for each key
+			TEST_ASSERT(allocations == 4 + Keys * 2);
+			TEST_ASSERT(group.Count() == Keys);
+			for (vint i = 0; i < Keys; i++)
+			{
+				TEST_ASSERT(group.Keys()[i] == i);
+				auto&& values = group.GetByIndex(i);
+				TEST_ASSERT(values.Count() == Count / Keys);
+				for (vint j = 0; j < values.Count(); j++)
+				{
+					TEST_ASSERT(j == 0 || values[j - 1] < values[j]);
+					TEST_ASSERT((values[j] * 7919) % Keys == i);
+				}
+			}
+		}
+		TEST_ASSERT(allocatedBytes == 0);
+	});
+
 	TEST_CASE(L"Ensure container move constructor and assignment")
 	{
 		{
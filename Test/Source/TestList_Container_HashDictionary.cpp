@@ -0,0 +1,233 @@
+#include "AssertCollection.h"
+#include "../../Source/Collections/HashDictionary.h"
+
+namespace TestList_HashDictionary_TestObjects
+{
+	template<typename A>
+	void TestHashDictionary(HashDictionary<vint, vint, A>& dictionary)
+	{
+		dictionary.Clear();
+		CHECK_EMPTY_DICTIONARY(dictionary);
+
+		dictionary.Add(1, 1);
+		dictionary.Add(2, 4);
+		dictionary.Add(3, 9);
+		dictionary.Add(4, 16);
+		CHECK_DICTIONARY_ITEMS(dictionary, { 1 _ 2 _ 3 _ 4 }, { 1 _ 4 _ 9 _ 16 });
+
+		dictionary.Set(1, -1);
+		dictionary.Set(2, -4);
+		dictionary.Set(3, -9);
+		dictionary.Set(4, -16);
+		dictionary.Set(5, -25);
+		CHECK_DICTIONARY_ITEMS(dictionary, { 1 _ 2 _ 3 _ 4 _ 5 }, { -1 _ - 4 _ - 9 _ - 16 _ - 25 });
+
+		TEST_ASSERT(dictionary.Remove(4) == true);
+		TEST_ASSERT(dictionary.Remove(5) == true);
+		TEST_ASSERT(dictionary.Remove(6) == false);
+		CHECK_DICTIONARY_ITEMS(dictionary, { 1 _ 2 _ 3 }, { -1 _ - 4 _ - 9 });
+
+		TEST_ASSERT(dictionary.Remove(1) == true);
+		CHECK_DICTIONARY_ITEMS(dictionary, { 3 _ 2 }, { -9 _ - 4 });
+
+		dictionary.Clear();
+		CHECK_EMPTY_DICTIONARY(dictionary);
+	}
+
+	struct CollidingHasher
+	{
+		static vuint64_t GetHashCode(vint)
+		{
+			// all keys fall into the same group with the same control byte
+			return 0;
+		}
+	};
+
+	template<typename THasher>
+	void TestLargeHashDictionary()
+	{
+		const vint Count = 3000;
+		HashDictionary<vint, vint, DefaultAllocator, THasher> dictionary;
+		for (vint i = 0; i < Count; i++)
+		{
+			dictionary.Add(i * 7, i);
+		}
+		TEST_ASSERT(dictionary.Count() == Count);
+		for (vint i = 0; i < Count * 7; i++)
+		{
+			if (i % 7 == 0)
+			{
+				TEST_ASSERT(dictionary[i] == i / 7);
+				TEST_ASSERT(dictionary.Keys()[dictionary.IndexOf(i)] == i);
+			}
+			else
+			{
+				TEST_ASSERT(!dictionary.Contains(i));
+			}
+		}
+
+		for (vint i = 0; i < Count; i += 2)
+		{
+			TEST_ASSERT(dictionary.Remove(i * 7));
+		}
+		TEST_ASSERT(dictionary.Count() == Count / 2);
+		for (vint i = 0; i < Count; i++)
+		{
+			TEST_ASSERT(dictionary.Contains(i * 7) == (i % 2 == 1));
+		}
+		for (vint i = 0; i < dictionary.Count(); i++)
+		{
+			TEST_ASSERT(dictionary.Keys()[i] == dictionary.Values()[i] * 7);
+			TEST_ASSERT(dictionary.IndexOf(dictionary.Keys()[i]) == i);
+		}
+
+		for (vint i = 0; i < Count; i++)
+		{
+			dictionary.Set(i * 7, -i);
+		}
+		TEST_ASSERT(dictionary.Count() == Count);
+		for (vint i = 0; i < Count; i++)
+		{
+			TEST_ASSERT(dictionary[i * 7] == -i);
+		}
+	}
+}
+using namespace TestList_HashDictionary_TestObjects;
+
+TEST_FILE
+{
+	TEST_CASE(L"Test HashDictionary<K, V>")
+	{
+		HashDictionary<vint, vint> dictionary;
+		TestHashDictionary(dictionary);
+	});
+
+	TEST_CASE(L"Test HashDictionary<K, V, CountingAllocator>")
+	{
+		TestWithCountingAllocator<HashDictionary<vint, vint, CountingAllocator>>([](auto& dictionary, vint& allocatedBytes, vint& allocations)
+		{
+			TestHashDictionary(dictionary);
+			dictionary.Clear();
+			TEST_ASSERT(allocatedBytes == 0);
+
+			// reserving allocates buffers for keys, values and the hash index, adding pairs allocates nothing
+			vint allocationsBeforeReserving = allocations;
+			dictionary.Reserve(100);
+			TEST_ASSERT(allocations == allocationsBeforeReserving + 3);
+			vint bytesAfterReserving = allocatedBytes;
+			for (vint i = 0; i < 100; i++)
+			{
+				dictionary.Add(i, i);
+			}
+			TEST_ASSERT(allocations == allocationsBeforeReserving + 3);
+			TEST_ASSERT(allocatedBytes == bytesAfterReserving);
+		});
+	});
+
+	TEST_CASE(L"Test HashDictionary<K, V> with many keys")
+	{
+		TestLargeHashDictionary<Hasher<vint>>();
+	});
+
+	TEST_CASE(L"Test HashDictionary<K, V> with colliding hash codes")
+	{
+		TestLargeHashDictionary<CollidingHasher>();
+	});
+
+	TEST_CASE(L"Test HashDictionary<K, V> with string and pair keys")
+	{
+		HashDictionary<WString, vint> strings;
+		for (vint i = 0; i < 100; i++)
+		{
+			strings.Add(itow(i), i);
+		}
+		for (vint i = 0; i < 100; i++)
+		{
+			TEST_ASSERT(strings[itow(i)] == i);
+		}
+		TEST_ASSERT(!strings.Contains(L"100"));
+		TEST_ASSERT(!strings.Contains(WString::Empty));
+		TEST_ASSERT(strings.Remove(L"50"));
+		TEST_ASSERT(!strings.Contains(L"50"));
+		TEST_ASSERT(strings.Count() == 99);
+
+		using PairKey = Pair<vint, WString>;
+		HashDictionary<PairKey, vint> pairs;
+		pairs.Add({ 1, L"a" }, 1);
+		pairs.Add({ 1, L"b" }, 2);
+		pairs.Add({ 2, L"a" }, 3);
+		TEST_ASSERT(pairs[PairKey(1, L"a")] == 1);
+		TEST_ASSERT(pairs[PairKey(1, L"b")] == 2);
+		TEST_ASSERT(pairs[PairKey(2, L"a")] == 3);
+		TEST_ASSERT(!pairs.Contains(PairKey(2, L"b")));
+	});
+
+	TEST_CASE(L"Test HashDictionary<Ptr<T>, V>")
+	{
+		auto a = Ptr(new vint(1));
+		auto b = Ptr(new vint(2));
+		HashDictionary<Ptr<vint>, vint> dictionary;
+		dictionary.Add(a, 1);
+		dictionary.Add(b, 2);
+		TEST_ASSERT(dictionary[a.Obj()] == 1);
+		TEST_ASSERT(dictionary[b.Obj()] == 2);
+		TEST_ASSERT(dictionary.Remove(a.Obj()));
+		TEST_ASSERT(!dictionary.Contains(a.Obj()));
+		TEST_ASSERT(dictionary.Keys()[0] == b);
+	});
+
+	TEST_CASE(L"Test HashDictionary<K, V> with CopyFrom and for loops")
+	{
+		Dictionary<vint, vint> sorted;
+		for (vint i = 0; i < 10; i++)
+		{
+			sorted.Add(i, i * i);
+		}
+
+		HashDictionary<vint, vint> dictionary;
+		CopyFrom(dictionary, sorted);
+		CHECK_DICTIONARY_ITEMS(dictionary, { 0 _ 1 _ 2 _ 3 _ 4 _ 5 _ 6 _ 7 _ 8 _ 9 }, { 0 _ 1 _ 4 _ 9 _ 16 _ 25 _ 36 _ 49 _ 64 _ 81 });
+
+		CopyFrom(dictionary, From(sorted).Where([](auto&& pair) { return pair.key % 2 == 0; }));
+		CHECK_DICTIONARY_ITEMS(dictionary, { 0 _ 2 _ 4 _ 6 _ 8 }, { 0 _ 4 _ 16 _ 36 _ 64 });
+
+		Dictionary<vint, vint> copied;
+		CopyFrom(copied, dictionary);
+		CHECK_DICTIONARY_ITEMS(copied, { 0 _ 2 _ 4 _ 6 _ 8 }, { 0 _ 4 _ 16 _ 36 _ 64 });
+
+		vint sum = 0;
+		for (auto [key, value] : dictionary)
+		{
+			TEST_ASSERT(key * key == value);
+			sum += key;
+		}
+		TEST_ASSERT(sum == 20);
+		TEST_ASSERT(From(dictionary).Select([](auto&& pair) { return pair.value; }).Aggregate([](vint a, vint b) { return a + b; }) == 120);
+	});
+
+	TEST_CASE(L"Test HashDictionary<K, V> with Reserve and move")
+	{
+		HashDictionary<vint, WString> a;
+		a.Reserve(1000);
+		for (vint i = 0; i < 1000; i++)
+		{
+			a.Add(i, itow(i));
+		}
+
+		HashDictionary<vint, WString> b(std::move(a));
+		TEST_ASSERT(a.Count() == 0);
+		TEST_ASSERT(!a.Contains(0));
+		TEST_ASSERT(b.Count() == 1000);
+		TEST_ASSERT(b[999] == L"999");
+
+		a = std::move(b);
+		TEST_ASSERT(b.Count() == 0);
+		TEST_ASSERT(a.Count() == 1000);
+		TEST_ASSERT(a[500] == L"500");
+
+		a.Add(1000, L"1000");
+		b.Add(0, L"0");
+		TEST_ASSERT(a.Count() == 1001);
+		TEST_ASSERT(b.Count() == 1);
+	});
+}
@@ -0,0 +1,240 @@
+#include "AssertCollection.h"
+#include "../../Source/Collections/HashSet.h"
+
+namespace TestList_HashSet_TestObjects
+{
+	template<typename A>
+	void TestHashSet(HashSet<vint, A>& set)
+	{
+		set.Clear();
+		CHECK_EMPTY_LIST(set);
+
+		TEST_ASSERT(set.Add(4) == 0);
+		TEST_ASSERT(set.Add(2) == 1);
+		TEST_ASSERT(set.Add(3) == 2);
+		TEST_ASSERT(set.Add(1) == 3);
+		TEST_ASSERT(set.Add(2) == -1);
+		CHECK_LIST_ITEMS(set, { 4 _ 2 _ 3 _ 1 });
+		TEST_ASSERT(set.IndexOf(3) == 2);
+		TEST_ASSERT(set.IndexOf(5) == -1);
+
+		TEST_ASSERT(set.Remove(4) == true);
+		TEST_ASSERT(set.Remove(5) == false);
+		CHECK_LIST_ITEMS(set, { 1 _ 2 _ 3 });
+
+		TEST_ASSERT(set.RemoveAt(1) == true);
+		CHECK_LIST_ITEMS(set, { 1 _ 3 });
+		TEST_ASSERT(!set.Contains(2));
+		TEST_ASSERT(set.IndexOf(3) == 1);
+
+		set.Add(5);
+		set.Add(6);
+		set.Add(7);
+		TEST_ASSERT(set.RemoveRange(1, 2) == true);
+		CHECK_LIST_ITEMS(set, { 1 _ 6 _ 7 });
+		TEST_ASSERT(!set.Contains(3));
+		TEST_ASSERT(!set.Contains(5));
+		TEST_ASSERT(set.IndexOf(7) == 2);
+
+		set.Add(8);
+		TEST_ASSERT(set.RemoveAndKeepOrder(6) == true);
+		TEST_ASSERT(set.RemoveAndKeepOrder(6) == false);
+		CHECK_LIST_ITEMS(set, { 1 _ 7 _ 8 });
+		TEST_ASSERT(set.IndexOf(8) == 2);
+
+		set.Clear();
+		CHECK_EMPTY_LIST(set);
+		TEST_ASSERT(!set.Contains(1));
+	}
+
+	struct CollidingHasher
+	{
+		static vuint64_t GetHashCode(vint)
+		{
+			return 0;
+		}
+	};
+
+	template<typename THasher>
+	void TestLargeHashSet()
+	{
+		const vint Count = 3000;
+		HashSet<vint, DefaultAllocator, THasher> set;
+		for (vint i = 0; i < Count; i++)
+		{
+			TEST_ASSERT(set.Add(i * 7) == i);
+		}
+		for (vint i = 0; i < Count * 7; i++)
+		{
+			TEST_ASSERT(set.Contains(i) == (i % 7 == 0));
+		}
+
+		for (vint i = 0; i < Count; i += 2)
+		{
+			TEST_ASSERT(set.Remove(i * 7));
+		}
+		TEST_ASSERT(set.Count() == Count / 2);
+		for (vint i = 0; i < Count; i++)
+		{
+			TEST_ASSERT(set.Contains(i * 7) == (i % 2 == 1));
+		}
+		for (vint i = 0; i < set.Count(); i++)
+		{
+			TEST_ASSERT(set[i] % 14 == 7);
+			TEST_ASSERT(set.IndexOf(set[i]) == i);
+		}
+
+		HashSet<vint, DefaultAllocator, THasher> ordered;
+		for (vint i = 0; i < Count; i++)
+		{
+			ordered.Add(i * 7);
+		}
+		for (vint i = 0; i < Count; i += 2)
+		{
+			TEST_ASSERT(ordered.RemoveAndKeepOrder(i * 7));
+		}
+		TEST_ASSERT(ordered.Count() == Count / 2);
+		for (vint i = 0; i < ordered.Count(); i++)
+		{
+			TEST_ASSERT(ordered[i] == (i * 2 + 1) * 7);
+			TEST_ASSERT(ordered.IndexOf(ordered[i]) == i);
+		}
+	}
+}
+using namespace TestList_HashSet_TestObjects;
+
+TEST_FILE
+{
+	TEST_CASE(L"Test HashSet<T>")
+	{
+		HashSet<vint> set;
+		TestHashSet(set);
+	});
+
+	TEST_CASE(L"Test HashSet<T, CountingAllocator>")
+	{
+		TestWithCountingAllocator<HashSet<vint, CountingAllocator>>([](auto& set, vint& allocatedBytes, vint& allocations)
+		{
+			TestHashSet(set);
+			set.Clear();
+			TEST_ASSERT(allocatedBytes == 0);
+
+			// reserving allocates the buffer for elements and the hash index, adding elements allocates nothing
+			vint allocationsBeforeReserving = allocations;
+			set.Reserve(100);
+			TEST_ASSERT(allocations == allocationsBeforeReserving + 2);
+			vint bytesAfterReserving = allocatedBytes;
+			for (vint i = 0; i < 100; i++)
+			{
+				set.Add(i);
+			}
+			TEST_ASSERT(allocations == allocationsBeforeReserving + 2);
+			TEST_ASSERT(allocatedBytes == bytesAfterReserving);
+		});
+	});
+
+	TEST_CASE(L"Test HashSet<T> with many values")
+	{
+		TestLargeHashSet<Hasher<vint>>();
+	});
+
+	TEST_CASE(L"Test HashSet<T> with colliding hash codes")
+	{
+		TestLargeHashSet<CollidingHasher>();
+	});
+
+	TEST_CASE(L"Test HashSet<T> with strings, Ptr<T> and Moveonly")
+	{
+		HashSet<WString> strings;
+		strings.Add(L"a");
+		strings.Add(WString::Unmanaged(L"b"));
+		TEST_ASSERT(strings.Add(L"a") == -1);
+		TEST_ASSERT(strings.Contains(L"b"));
+		TEST_ASSERT(!strings.Contains(L"c"));
+
+		auto a = Ptr(new vint(1));
+		auto b = Ptr(new vint(2));
+		HashSet<Ptr<vint>> pointers;
+		pointers.Add(a);
+		pointers.Add(b);
+		TEST_ASSERT(pointers.Add(a) == -1);
+		TEST_ASSERT(pointers.Contains(a.Obj()));
+		TEST_ASSERT(pointers.Remove(a.Obj()));
+		TEST_ASSERT(!pointers.Contains(a.Obj()));
+		TEST_ASSERT(pointers[0] == b);
+
+		HashSet<Ptr<vint>> moved(std::move(pointers));
+		TEST_ASSERT(pointers.Count() == 0);
+		TEST_ASSERT(moved.Contains(b.Obj()));
+		TEST_ASSERT(!pointers.Contains(b.Obj()));
+		TEST_ASSERT(pointers.Add(b) == 0);
+		TEST_ASSERT(pointers.Contains(b.Obj()));
+		moved.Add(std::move(a));
+		TEST_ASSERT(!a);
+		TEST_ASSERT(moved.Count() == 2);
+	});
+
+	TEST_CASE(L"Ensure HashSet<T> could not be used as a list")
+	{
+		static_assert(!std::is_base_of_v<ListBase<vint>, HashSet<vint>>);
+		static_assert(!std::is_constructible_v<Array<vint>, HashSet<vint>&&>);
+		static_assert(!std::is_constructible_v<List<vint>, HashSet<vint>&&>);
+
+		HashSet<vint> set;
+		set.Add(1);
+		set.Add(2);
+		HashSet<vint> moved;
+		moved = std::move(set);
+		TEST_ASSERT(set.Count() == 0);
+		TEST_ASSERT(!set.Contains(1));
+		TEST_ASSERT(set.Add(3) == 0);
+		CHECK_LIST_ITEMS(set, { 3 });
+		CHECK_LIST_ITEMS(moved, { 1 _ 2 });
+	});
+
+	TEST_CASE(L"Test HashSet<T> with CopyFrom and for loops")
+	{
+		HashSet<vint> set;
+		CopyFrom(set, From(Range<vint>(0, 10)).Select([](vint i) { return i % 5; }));
+		CHECK_LIST_ITEMS(set, { 0 _ 1 _ 2 _ 3 _ 4 });
+
+		vint sum = 0;
+		for (vint i : set)
+		{
+			sum += i;
+		}
+		TEST_ASSERT(sum == 10);
+
+		List<vint> list;
+		CopyFrom(list, set);
+		CHECK_LIST_ITEMS(list, { 0 _ 1 _ 2 _ 3 _ 4 });
+	});
+
+	TEST_CASE(L"Test Distinct, Intersect and Except with MembershipSet<T>")
+	{
+		static_assert(std::is_same_v<MembershipSet<vint>, HashSet<vint>>);
+		static_assert(std::is_same_v<MembershipSet<Ptr<vint>>, HashSet<Ptr<vint>>>);
+		static_assert(std::is_same_v<MembershipSet<Copyable<vint>>, SortedList<Copyable<vint>>>);
+
+		vint xs[] = { 5, 1, 5, 2, 1, 3, 4, 3 };
+		vint ys[] = { 2, 4, 6 };
+		List<vint> result;
+		CopyFrom(result, From(xs).Distinct());
+		CHECK_LIST_ITEMS(result, { 5 _ 1 _ 2 _ 3 _ 4 });
+		CopyFrom(result, From(xs).Intersect(From(ys)));
+		CHECK_LIST_ITEMS(result, { 2 _ 4 });
+		CopyFrom(result, From(xs).Except(From(ys)));
+		CHECK_LIST_ITEMS(result, { 5 _ 1 _ 3 });
+
+		auto distinct = From(xs).Distinct();
+		auto enumerator = distinct.CreateEnumerator();
+		TEST_ASSERT(enumerator->Next() && enumerator->Current() == 5);
+		TEST_ASSERT(enumerator->Next() && enumerator->Current() == 1);
+		auto cloned = enumerator->Clone();
+		TEST_ASSERT(cloned->Next() && cloned->Current() == 2);
+		TEST_ASSERT(cloned->Next() && cloned->Current() == 3);
+		TEST_ASSERT(cloned->Index() == 3);
+		delete cloned;
+		delete enumerator;
+	});
+}
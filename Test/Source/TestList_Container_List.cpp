@@ -24,6 +24,47 @@ namespace TestList_TestObjects
 		}
 		CHECK_LIST_ITEMS(list, { 0 _ 2 _ 4 _ 6 _ 8 _ 10 _ 12 _ 14 _ 16 _ 18 });
 	}
+
+	struct DestructorCounter
+	{
+		vint* counter;
+
+		DestructorCounter(vint* _counter) :counter(_counter) {}
+		~DestructorCounter() { (*counter)++; }
+	};
+
+	enum class ScalarEnum : vuint16_t
+	{
+		Zero,
+	};
+
+	// every element is distinct, and every position around the end of a vector register is tested
+	template<typename T, typename F>
+	void TestScalarIndexOf(F&& makeItem)
+	{
+		for (vint count = 0; count <= 70; count++)
+		{
+			List<T> list;
+			for (vint i = 0; i < count; i++)
+			{
+				list.Add(makeItem(i));
+			}
+			for (vint i = 0; i < count; i++)
+			{
+				TEST_ASSERT(list.IndexOf(makeItem(i)) == i);
+			}
+			TEST_ASSERT(list.IndexOf(makeItem(count)) == -1);
+			TEST_ASSERT(!list.Contains(makeItem(-1)));
+
+			if (count > 0)
+			{
+				list.Set(count - 1, makeItem(0));
+				TEST_ASSERT(list.IndexOf(makeItem(0)) == 0);
+				TEST_ASSERT(list.Remove(makeItem(0)));
+				TEST_ASSERT(list.IndexOf(makeItem(0)) == count - 2);
+			}
+		}
+	}
 }
 
 using namespace TestList_TestObjects;
@@ -51,6 +92,391 @@ TEST_FILE
 		TestNormalList(list);
 	});
 
+	TEST_CASE(L"Test List<vint, CountingAllocator>")
+	{
+		TestWithCountingAllocator<List<vint, CountingAllocator>>([](auto& list, vint& allocatedBytes, vint& allocations)
+		{
+			TestCollectionWithIncreasingItems(list);
+			TestNormalList(list);
+			TEST_ASSERT(allocatedBytes == (vint)(sizeof(vint) * list.Capacity()));
+
+			List<vint, CountingAllocator> moved(std::move(list));
+			CHECK_LIST_ITEMS(moved, { 0 _ 2 _ 4 _ 6 _ 8 _ 10 _ 12 _ 14 _ 16 _ 18 });
+			TEST_ASSERT(allocatedBytes == (vint)(sizeof(vint) * moved.Capacity()));
+
+			moved.Clear();
+			TEST_ASSERT(allocatedBytes == 0);
+
+			// reserved memory is allocated once
+			moved.Reserve(100);
+			vint allocationsAfterReserving = allocations;
+			for (vint i = 0; i < 100; i++)
+			{
+				moved.Add(i);
+			}
+			TEST_ASSERT(allocations == allocationsAfterReserving);
+			TEST_ASSERT(allocatedBytes == (vint)(sizeof(vint) * 100));
+		});
+	});
+
+	TEST_CASE(L"Test List<T> with trivially relocatable types")
+	{
+		static_assert(TriviallyRelocatable<vint>::Value);
+		static_assert(TriviallyRelocatable<WString>::Value);
+		static_assert(TriviallyRelocatable<Ptr<DestructorCounter>>::Value);
+		static_assert(TriviallyRelocatable<Func<void()>>::Value);
+		static_assert(TriviallyRelocatable<Nullable<WString>>::Value);
+		static_assert(!TriviallyRelocatable<Copyable<vint>>::Value);
+		static_assert(!TriviallyRelocatable<Nullable<Copyable<vint>>>::Value);
+
+		{
+			List<WString> list;
+			for (vint i = 0; i < 1000; i++)
+			{
+				list.Insert(i / 2, itow(i));
+			}
+			TEST_ASSERT(list.Count() == 1000);
+			for (vint i = 0; i < 1000; i++)
+			{
+				TEST_ASSERT(list[i] == itow(i < 500 ? i * 2 + 1 : (999 - i) * 2));
+			}
+
+			list.RemoveRange(10, 985);
+			TEST_ASSERT(list.Count() == 15);
+			TEST_ASSERT(list[9] == L"19");
+			TEST_ASSERT(list[10] == L"8");
+		}
+		{
+			vint destructed = 0;
+			{
+				List<Ptr<DestructorCounter>> list;
+				for (vint i = 0; i < 1000; i++)
+				{
+					list.Insert(i / 2, Ptr(new DestructorCounter(&destructed)));
+				}
+				TEST_ASSERT(destructed == 0);
+
+				list.RemoveRange(0, 995);
+				TEST_ASSERT(destructed == 995);
+
+				Array<Ptr<DestructorCounter>> arr(3);
+				arr[0] = list[0];
+				arr.Resize(100);
+				arr.Resize(1);
+				TEST_ASSERT(arr[0] == list[0]);
+			}
+			TEST_ASSERT(destructed == 1000);
+		}
+	});
+
+	TEST_CASE(L"Test List<T>::IndexOf with scalar types")
+	{
+		TestScalarIndexOf<vint8_t>([](vint i) { return (vint8_t)(i - 100); });
+		TestScalarIndexOf<wchar_t>([](vint i) { return (wchar_t)(i + 0x100); });
+		TestScalarIndexOf<ScalarEnum>([](vint i) { return (ScalarEnum)(i + 0xFF00); });
+		TestScalarIndexOf<vint32_t>([](vint i) { return (vint32_t)(i * 0x10001); });
+		TestScalarIndexOf<vint64_t>([](vint i) { return (vint64_t)i << 32; });
+		TestScalarIndexOf<vuint64_t>([](vint i) { return (vuint64_t)(i + 1); });
+
+		vint objects[72];
+		TestScalarIndexOf<vint*>([&](vint i) { return &objects[i + 1]; });
+
+		// both halves of 64 bits elements are compared
+		List<vint64_t> halves;
+		halves.Add(0x100000002);
+		halves.Add(0x200000001);
+		halves.Add(0x100000001);
+		TEST_ASSERT(halves.IndexOf(0x100000001) == 2);
+
+		Array<vint> numbers(100);
+		for (vint i = 0; i < numbers.Count(); i++)
+		{
+			numbers[i] = i * i;
+		}
+		TEST_ASSERT(numbers.IndexOf(81 * 81) == 81);
+		TEST_ASSERT(numbers.IndexOf(2) == -1);
+	});
+
+	TEST_CASE(L"Test List<T>::AddRange and List<T>::InsertRange")
+	{
+		{
+			vint allocatedBytes = 0;
+			vint allocations = 0;
+			vint items[] = { 1,2,3,4,5,6,7,8,9,10 };
+			List<vint, CountingAllocator> list(CountingAllocator(&allocatedBytes, &allocations));
+
+			TEST_ASSERT(list.AddRange(items, 10) == 0);
+			TEST_ASSERT(allocations == 1);
+			CHECK_LIST_ITEMS(list, { 1 _ 2 _ 3 _ 4 _ 5 _ 6 _ 7 _ 8 _ 9 _ 10 });
+
+			TEST_ASSERT(list.InsertRange(2, items, 5) == 2);
+			TEST_ASSERT(allocations == 2);
+			CHECK_LIST_ITEMS(list, { 1 _ 2 _ 1 _ 2 _ 3 _ 4 _ 5 _ 3 _ 4 _ 5 _ 6 _ 7 _ 8 _ 9 _ 10 });
+
+			list.RemoveRange(3, 12);
+			TEST_ASSERT(list.AddRange(list) == 3);
+			CHECK_LIST_ITEMS(list, { 1 _ 2 _ 1 _ 1 _ 2 _ 1 });
+
+			TEST_ASSERT(list.InsertRange(1, &list[3], 3) == 1);
+			CHECK_LIST_ITEMS(list, { 1 _ 1 _ 2 _ 1 _ 2 _ 1 _ 1 _ 2 _ 1 });
+
+			list.Clear();
+			allocations = 0;
+			TEST_ASSERT(list.AddRange(From(items).Where([](vint x) { return x % 2 == 0; })) == 0);
+			CHECK_LIST_ITEMS(list, { 2 _ 4 _ 6 _ 8 _ 10 });
+
+			List<vint> source;
+			source.AddRange(items, 10);
+			list.Clear();
+			allocations = 0;
+			CopyFrom(list, source);
+			TEST_ASSERT(allocations == 1);
+			CHECK_LIST_ITEMS(list, { 1 _ 2 _ 3 _ 4 _ 5 _ 6 _ 7 _ 8 _ 9 _ 10 });
+
+			allocations = 0;
+			CopyFrom(list, (const IEnumerable<vint>&)source, true);
+			TEST_ASSERT(allocations == 1);
+			TEST_ASSERT(list.Count() == 20);
+
+			list.Clear();
+			TEST_ASSERT(allocatedBytes == 0);
+		}
+		{
+			List<WString> list;
+			WString items[] = { L"a",L"b",L"c" };
+			list.AddRange(items, 3);
+			list.InsertRange(0, list);
+			list.InsertRange(3, From(items).Select([](const WString& x) { return x + x; }));
+			TEST_ASSERT(list.Count() == 9);
+			TEST_ASSERT(From(list).Aggregate([](const WString& a, const WString& b) { return a + L"," + b; }) == L"a,b,c,aa,bb,cc,a,b,c");
+		}
+	});
+
+	TEST_CASE(L"Test List<T>::Reserve and List<T>::ShrinkToFit")
+	{
+		{
+			vint allocatedBytes = 0;
+			vint allocations = 0;
+			List<vint, CountingAllocator> list(CountingAllocator(&allocatedBytes, &allocations));
+			TEST_ASSERT(list.Capacity() == 0);
+
+			list.Reserve(100);
+			TEST_ASSERT(list.Capacity() == 100);
+			TEST_ASSERT(allocatedBytes == (vint)(sizeof(vint) * 100));
+			for (vint i = 0; i < 100; i++)
+			{
+				list.Add(i);
+			}
+			TEST_ASSERT(list.Capacity() == 100);
+			TEST_ASSERT(allocations == 1);
+
+			list.Reserve(50);
+			TEST_ASSERT(list.Capacity() == 100);
+
+			list.RemoveRange(10, 90);
+			TEST_ASSERT(list.Capacity() == 100);
+			list.ShrinkToFit();
+			TEST_ASSERT(list.Capacity() == 10);
+			TEST_ASSERT(allocatedBytes == (vint)(sizeof(vint) * 10));
+			CHECK_LIST_ITEMS(list, { 0 _ 1 _ 2 _ 3 _ 4 _ 5 _ 6 _ 7 _ 8 _ 9 });
+
+			list.RemoveRange(0, 10);
+			list.ShrinkToFit();
+			TEST_ASSERT(list.Capacity() == 0);
+			TEST_ASSERT(allocatedBytes == 0);
+		}
+		{
+			List<WString> list;
+			list.Add(L"a");
+			list.Add(L"b");
+			list.Reserve(1000);
+			TEST_ASSERT(list.Capacity() == 1000);
+			list.ShrinkToFit();
+			TEST_ASSERT(list.Capacity() == 2);
+			TEST_ASSERT(list[0] == L"a" && list[1] == L"b");
+		}
+		{
+			vint allocatedBytes = 0;
+			List<vint, GrowthFactorAllocator<2, 1, CountingAllocator>> list{ CountingAllocator(&allocatedBytes) };
+			list.Add(0);
+			TEST_ASSERT(list.Capacity() == 3);
+			list.Add(1);
+			list.Add(2);
+			list.Add(3);
+			TEST_ASSERT(list.Capacity() == 9);
+			for (vint i = 4; i < 100; i++)
+			{
+				list.Add(i);
+			}
+			TEST_ASSERT(list.Capacity() == 189);
+
+			list.RemoveRange(0, 50);
+			TEST_ASSERT(list.Capacity() == 189);
+			list.RemoveRange(0, 10);
+			TEST_ASSERT(list.Capacity() == 81);
+			TEST_ASSERT(list[0] == 60 && list[39] == 99);
+			list.Clear();
+			TEST_ASSERT(allocatedBytes == 0);
+		}
+	});
+
+	TEST_CASE(L"Test moving between Array<T>, List<T> and SortedList<T>")
+	{
+		{
+			vint allocatedBytes = 0;
+			vint allocations = 0;
+			CountingAllocator allocator(&allocatedBytes, &allocations);
+			vint items[] = { 5,3,1,4,2 };
+
+			List<vint, CountingAllocator> list(allocator);
+			list.AddRange(items, 5);
+			list.ShrinkToFit();
+			allocations = 0;
+
+			Array<vint, CountingAllocator> arr(std::move(list));
+			CHECK_EMPTY_LIST(list);
+			CHECK_LIST_ITEMS(arr, { 5 _ 3 _ 1 _ 4 _ 2 });
+
+			SortedList<vint, CountingAllocator> sorted(std::move(arr));
+			CHECK_EMPTY_LIST(arr);
+			CHECK_LIST_ITEMS(sorted, { 1 _ 2 _ 3 _ 4 _ 5 });
+
+			list = std::move(sorted);
+			CHECK_EMPTY_LIST(sorted);
+			CHECK_LIST_ITEMS(list, { 1 _ 2 _ 3 _ 4 _ 5 });
+
+			sorted = std::move(list);
+			CHECK_EMPTY_LIST(list);
+			CHECK_LIST_ITEMS(sorted, { 1 _ 2 _ 3 _ 4 _ 5 });
+			TEST_ASSERT(sorted.Contains(4));
+			TEST_ASSERT(allocations == 0);
+
+			arr = std::move(sorted);
+			list = std::move(arr);
+			list.Add(0);
+			arr = std::move(list);
+			TEST_ASSERT(allocations == 2);
+			CHECK_LIST_ITEMS(arr, { 1 _ 2 _ 3 _ 4 _ 5 _ 0 });
+
+			arr = std::move(sorted);
+			CHECK_EMPTY_LIST(arr);
+			TEST_ASSERT(allocatedBytes == 0);
+		}
+		{
+			List<Moveonly<vint>> list;
+			for (vint i = 0; i < 10; i++)
+			{
+				list.Add(Moveonly<vint>((i * 7) % 10));
+			}
+			SortedList<Moveonly<vint>> sorted(std::move(list));
+			CHECK_LIST_ITEMS(sorted, { 0 _ 1 _ 2 _ 3 _ 4 _ 5 _ 6 _ 7 _ 8 _ 9 });
+			Array<Moveonly<vint>> arr(std::move(sorted));
+			CHECK_LIST_ITEMS(arr, { 0 _ 1 _ 2 _ 3 _ 4 _ 5 _ 6 _ 7 _ 8 _ 9 });
+		}
+	});
+
+	TEST_CASE(L"Test SmallList<vint, 4>")
+	{
+		SmallList<vint, 4> list;
+		TestCollectionWithIncreasingItems(list);
+		TestNormalList(list);
+	});
+
+	TEST_CASE(L"Test SmallList<Copyable<vint>, 4>")
+	{
+		SmallList<Copyable<vint>, 4> list;
+		TestCollectionWithIncreasingItems(list);
+		TestNormalList(list);
+	});
+
+	TEST_CASE(L"Test SmallList<Moveonly<vint>, 4>")
+	{
+		SmallList<Moveonly<vint>, 4> list;
+		TestCollectionWithIncreasingItems(list);
+		TestNormalList(list);
+	});
+
+	TEST_CASE(L"Test SmallList<T, N> with inline storage")
+	{
+		vint allocatedBytes = 0;
+		{
+			SmallList<vint, 4, CountingAllocator> list(&allocatedBytes);
+			for (vint i = 0; i < 4; i++)
+			{
+				list.Add(i);
+			}
+			TEST_ASSERT(list.IsInlineStorage());
+			TEST_ASSERT(allocatedBytes == 0);
+			CHECK_LIST_ITEMS(list, { 0 _ 1 _ 2 _ 3 });
+
+			list.Insert(0, 4);
+			TEST_ASSERT(!list.IsInlineStorage());
+			TEST_ASSERT(allocatedBytes > 0);
+			CHECK_LIST_ITEMS(list, { 4 _ 0 _ 1 _ 2 _ 3 });
+
+			list.RemoveRange(0, 3);
+			TEST_ASSERT(list.IsInlineStorage());
+			TEST_ASSERT(allocatedBytes == 0);
+			CHECK_LIST_ITEMS(list, { 2 _ 3 });
+
+			for (vint i = 0; i < 10; i++)
+			{
+				list.Add(i);
+			}
+			SmallList<vint, 4, CountingAllocator> moved(std::move(list));
+			TEST_ASSERT(list.IsInlineStorage());
+			TEST_ASSERT(!moved.IsInlineStorage());
+			CHECK_EMPTY_LIST(list);
+			CHECK_LIST_ITEMS(moved, { 2 _ 3 _ 0 _ 1 _ 2 _ 3 _ 4 _ 5 _ 6 _ 7 _ 8 _ 9 });
+
+			moved.Clear();
+			TEST_ASSERT(moved.IsInlineStorage());
+			TEST_ASSERT(allocatedBytes == 0);
+
+			moved.Add(1);
+			moved.Add(2);
+			list = std::move(moved);
+			TEST_ASSERT(list.IsInlineStorage());
+			CHECK_EMPTY_LIST(moved);
+			CHECK_LIST_ITEMS(list, { 1 _ 2 });
+
+			for (vint i = 3; i <= 8; i++)
+			{
+				list.Add(i);
+			}
+			List<vint> copied;
+			CopyFrom(copied, list);
+			CHECK_LIST_ITEMS(copied, { 1 _ 2 _ 3 _ 4 _ 5 _ 6 _ 7 _ 8 });
+
+			SmallList<vint, 4, CountingAllocator> copiedBack(&allocatedBytes);
+			CopyFrom(copiedBack, From(copied).Where([](vint x) { return x % 2 == 0; }));
+			CHECK_LIST_ITEMS(copiedBack, { 2 _ 4 _ 6 _ 8 });
+			TEST_ASSERT(copiedBack.IsInlineStorage());
+
+			vint sum = 0;
+			for (auto x : list)
+			{
+				sum += x;
+			}
+			TEST_ASSERT(sum == 36);
+		}
+		TEST_ASSERT(allocatedBytes == 0);
+		{
+			vint destructed = 0;
+			{
+				SmallList<Ptr<DestructorCounter>, 2> list;
+				for (vint i = 0; i < 10; i++)
+				{
+					list.Insert(i / 2, Ptr(new DestructorCounter(&destructed)));
+				}
+				list.RemoveRange(1, 8);
+				TEST_ASSERT(destructed == 8);
+				TEST_ASSERT(list.IsInlineStorage());
+			}
+			TEST_ASSERT(destructed == 10);
+		}
+	});
+
 	TEST_CASE(L"Ensure container move constructor and assignment")
 	{
 		{
@@ -71,5 +497,11 @@ TEST_FILE
 			List<Moveonly<vint>> c;
 			c = std::move(b);
 		}
+		{
+			SmallList<Moveonly<vint>, 2> a;
+			SmallList<Moveonly<vint>, 2> b(std::move(a));
+			SmallList<Moveonly<vint>, 2> c;
+			c = std::move(b);
+		}
 	});
 }
\ No newline at end of file
@@ -0,0 +1,310 @@
+#include "AssertCollection.h"
+#include "../../Source/Collections/OrderedDictionary.h"
+
+#define CHECK_EMPTY_ORDERED_DICTIONARY(CONTAINER)\
+	TestReadonlyOrderedDictionary(CONTAINER, nullptr, nullptr, 0)\
+
+#define CHECK_ORDERED_DICTIONARY_ITEMS(CONTAINER,KEYS,VALUES)\
+	do{\
+		vint __keys__[]=KEYS;\
+		vint __values__[]=VALUES;\
+		TestReadonlyOrderedDictionary(CONTAINER, __keys__, __values__, sizeof(__keys__)/sizeof(*__keys__));\
+	}while(0)\
+
+namespace TestList_OrderedDictionary_TestObjects
+{
+	// OrderedDictionary has no Keys() or Values(), pairs are checked by walking through cursors instead
+	template<typename A>
+	void TestReadonlyOrderedDictionary(const OrderedDictionary<vint, vint, A>& dictionary, vint* keys, vint* values, vint count)
+	{
+		TEST_ASSERT(dictionary.Count() == count);
+		TEST_ASSERT(dictionary.Last().IsValid() == (count > 0));
+		if (count > 0) TEST_ASSERT(dictionary.Last().Key() == keys[count - 1]);
+
+		auto enumerator = dictionary.CreateEnumerator();
+		auto cursor = dictionary.First();
+		for (vint i = 0; i < count; i++)
+		{
+			TEST_ASSERT(dictionary.Get(keys[i]) == values[i]);
+			TEST_ASSERT(dictionary.Find(keys[i]) == cursor);
+			TEST_ASSERT(cursor.IsValid() && cursor.Key() == keys[i] && cursor.Value() == values[i]);
+			TEST_ASSERT(cursor.Next() == (i < count - 1));
+
+			Pair<const vint&, const vint&> pair(keys[i], values[i]);
+			TEST_ASSERT(enumerator->Next());
+			TEST_ASSERT(enumerator->Current() == pair);
+			TEST_ASSERT(enumerator->Index() == i);
+		}
+		TEST_ASSERT(!cursor.IsValid());
+		TEST_ASSERT(enumerator->Next() == false);
+		delete enumerator;
+	}
+
+	// a large key makes nodes contain only a few keys, so that trees become deep
+	struct BigKey
+	{
+		vint			value = 0;
+		char			padding[120] = { 0 };
+
+		BigKey() = default;
+		BigKey(vint _value) :value(_value) {}
+
+		auto operator<=>(const BigKey& key)const { return value <=> key.value; }
+		bool operator==(const BigKey& key)const { return value == key.value; }
+	};
+
+	template<typename A>
+	void TestOrderedDictionary(OrderedDictionary<vint, vint, A>& dictionary)
+	{
+		dictionary.Clear();
+		CHECK_EMPTY_ORDERED_DICTIONARY(dictionary);
+
+		dictionary.Add(4, 16);
+		dictionary.Add(2, 4);
+		dictionary.Add(3, 9);
+		dictionary.Add(1, 1);
+		CHECK_ORDERED_DICTIONARY_ITEMS(dictionary, { 1 _ 2 _ 3 _ 4 }, { 1 _ 4 _ 9 _ 16 });
+
+		dictionary.Set(1, -1);
+		dictionary.Set(2, -4);
+		dictionary.Set(3, -9);
+		dictionary.Set(4, -16);
+		dictionary.Set(5, -25);
+		CHECK_ORDERED_DICTIONARY_ITEMS(dictionary, { 1 _ 2 _ 3 _ 4 _ 5 }, { -1 _ - 4 _ - 9 _ - 16 _ - 25 });
+
+		TEST_ASSERT(dictionary.Remove(4) == true);
+		TEST_ASSERT(dictionary.Remove(5) == true);
+		TEST_ASSERT(dictionary.Remove(6) == false);
+		CHECK_ORDERED_DICTIONARY_ITEMS(dictionary, { 1 _ 2 _ 3 }, { -1 _ - 4 _ - 9 });
+
+		dictionary.Clear();
+		CHECK_EMPTY_ORDERED_DICTIONARY(dictionary);
+	}
+
+	template<typename K>
+	void TestRandomOrderedDictionary(vint count)
+	{
+		OrderedDictionary<K, vint> dictionary;
+		Dictionary<vint, vint> reference;
+
+		auto check = [&]()
+		{
+			TEST_ASSERT(dictionary.Count() == reference.Count());
+			auto cursor = dictionary.First();
+			for (vint i = 0; i < reference.Count(); i++)
+			{
+				TEST_ASSERT(cursor.IsValid());
+				TEST_ASSERT(cursor.Key() == reference.Keys()[i]);
+				TEST_ASSERT(cursor.Value() == reference.Values()[i]);
+				cursor.Next();
+			}
+			TEST_ASSERT(!cursor.IsValid());
+		};
+
+		vuint seed = 1;
+		auto random = [&]()
+		{
+			seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			return (vint)((seed >> 33) % (count * 2));
+		};
+
+		for (vint i = 0; i < count * 2; i++)
+		{
+			vint key = random();
+			dictionary.Set(key, i);
+			reference.Set(key, i);
+		}
+		check();
+
+		for (vint i = 0; i < count * 4; i++)
+		{
+			vint key = random();
+			if (i % 3 == 0)
+			{
+				dictionary.Set(key, -i);
+				reference.Set(key, -i);
+			}
+			else
+			{
+				TEST_ASSERT(dictionary.Remove(key) == reference.Remove(key));
+			}
+		}
+		check();
+
+		while (reference.Count() > 0)
+		{
+			vint key = reference.Keys()[(reference.Count() * 7) / 11];
+			TEST_ASSERT(dictionary.Remove(key));
+			reference.Remove(key);
+		}
+		check();
+		TEST_ASSERT(!dictionary.First().IsValid());
+		TEST_ASSERT(!dictionary.Last().IsValid());
+	}
+
+	template<typename K>
+	void TestLoadSortedOrderedDictionary(vint count)
+	{
+		List<Pair<K, vint>> pairs;
+		for (vint i = 0; i < count; i++)
+		{
+			pairs.Add({ K(i * 2), i });
+		}
+
+		OrderedDictionary<K, vint> dictionary;
+		dictionary.Add(K(-1), -1);
+		dictionary.LoadSorted(pairs);
+		TEST_ASSERT(dictionary.Count() == count);
+		TEST_ASSERT(!dictionary.Contains(K(-1)));
+		for (vint i = 0; i < count * 2; i++)
+		{
+			TEST_ASSERT(dictionary.Contains(K(i)) == (i % 2 == 0));
+		}
+
+		for (vint i = 0; i < count * 2; i += 4)
+		{
+			dictionary.Remove(K(i));
+			dictionary.Set(K(i + 1), i);
+		}
+		vint index = 0;
+		for (auto [key, value] : dictionary)
+		{
+			TEST_ASSERT(key == K(index % 2 == 0 ? index * 2 + 1 : index * 2));
+			index++;
+		}
+		TEST_ASSERT(index == count);
+	}
+}
+using namespace TestList_OrderedDictionary_TestObjects;
+
+TEST_FILE
+{
+	TEST_CASE(L"Test OrderedDictionary<K, V>")
+	{
+		OrderedDictionary<vint, vint> dictionary;
+		TestOrderedDictionary(dictionary);
+	});
+
+	TEST_CASE(L"Test OrderedDictionary<K, V, CountingAllocator>")
+	{
+		TestWithCountingAllocator<OrderedDictionary<vint, vint, CountingAllocator>>([](auto& dictionary, vint& allocatedBytes, vint& allocations)
+		{
+			TestOrderedDictionary(dictionary);
+			dictionary.Clear();
+			TEST_ASSERT(allocatedBytes == 0);
+
+			// every leaf is allocated by the allocator
+			const vint Count = 1000;
+			const vint LeafCapacity = btree_internal::BTree<vint, vint, CountingAllocator>::LeafCapacity;
+			vint allocationsBeforeAdding = allocations;
+			for (vint i = 0; i < Count; i++)
+			{
+				dictionary.Add(i, i);
+			}
+			TEST_ASSERT(allocations - allocationsBeforeAdding >= (Count + LeafCapacity - 1) / LeafCapacity);
+		});
+	});
+
+	TEST_CASE(L"Test OrderedDictionary<K, V> with random keys")
+	{
+		TestRandomOrderedDictionary<vint>(10000);
+		TestRandomOrderedDictionary<BigKey>(3000);
+	});
+
+	TEST_CASE(L"Test OrderedDictionary<K, V> with LoadSorted")
+	{
+		for (vint count : { 0, 1, 2, 3, 5, 10, 33, 100, 1000, 10000 })
+		{
+			TestLoadSortedOrderedDictionary<vint>(count);
+			TestLoadSortedOrderedDictionary<BigKey>(count);
+		}
+
+		OrderedDictionary<vint, vint> dictionary;
+		Pair<vint, vint> unsorted[] = { { 1, 1 }, { 3, 3 }, { 2, 2 } };
+		TEST_EXCEPTION(dictionary.LoadSorted(unsorted), Error, [](const Error&) {});
+		TEST_ASSERT(dictionary.Count() == 2);
+		TEST_ASSERT(dictionary[1] == 1);
+		TEST_ASSERT(dictionary[3] == 3);
+	});
+
+	TEST_CASE(L"Test OrderedDictionary<K, V> with LowerBound and UpperBound")
+	{
+		OrderedDictionary<vint, vint> dictionary;
+		for (vint i = 0; i < 1000; i++)
+		{
+			dictionary.Add(i * 10, i);
+		}
+
+		TEST_ASSERT(dictionary.LowerBound(-1).Key() == 0);
+		TEST_ASSERT(dictionary.LowerBound(0).Key() == 0);
+		TEST_ASSERT(dictionary.UpperBound(0).Key() == 10);
+		TEST_ASSERT(dictionary.LowerBound(555).Key() == 560);
+		TEST_ASSERT(dictionary.UpperBound(555).Key() == 560);
+		TEST_ASSERT(dictionary.LowerBound(560).Key() == 560);
+		TEST_ASSERT(dictionary.UpperBound(560).Key() == 570);
+		TEST_ASSERT(dictionary.LowerBound(9990).Key() == 9990);
+		TEST_ASSERT(!dictionary.UpperBound(9990).IsValid());
+		TEST_ASSERT(!dictionary.LowerBound(9991).IsValid());
+		TEST_ASSERT(!dictionary.Find(555).IsValid());
+		TEST_ASSERT(dictionary.Find(550).Value() == 55);
+
+		vint sum = 0;
+		for (auto cursor = dictionary.LowerBound(100); cursor.IsValid() && cursor.Key() < 200; cursor.Next())
+		{
+			sum += cursor.Value();
+		}
+		TEST_ASSERT(sum == 145);
+
+		auto cursor = dictionary.Last();
+		for (vint i = 999; i >= 0; i--)
+		{
+			TEST_ASSERT(cursor.Value() == i);
+			TEST_ASSERT(cursor.Previous() == (i > 0));
+		}
+	});
+
+	TEST_CASE(L"Test OrderedDictionary<K, V> with WString, Ptr<T> and Moveonly")
+	{
+		OrderedDictionary<WString, Moveonly<vint>> strings;
+		for (vint i = 0; i < 100; i++)
+		{
+			strings.Add(itow(i), Moveonly<vint>(i));
+		}
+		TEST_ASSERT(strings.First().Key() == L"0");
+		TEST_ASSERT(strings.Last().Key() == L"99");
+		TEST_ASSERT(strings[L"42"].value == 42);
+		TEST_ASSERT(strings.Remove(L"42"));
+		TEST_ASSERT(!strings.Contains(L"42"));
+		TEST_ASSERT(strings.LowerBound(L"42").Key() == L"43");
+
+		auto a = Ptr(new vint(1));
+		auto b = Ptr(new vint(2));
+		OrderedDictionary<Ptr<vint>, vint> pointers;
+		pointers.Add(a, 1);
+		pointers.Add(b, 2);
+		TEST_ASSERT(pointers[a.Obj()] == 1);
+		TEST_ASSERT(pointers.Remove(b.Obj()));
+		TEST_ASSERT(pointers.Count() == 1);
+
+		OrderedDictionary<Ptr<vint>, vint> moved(std::move(pointers));
+		TEST_ASSERT(pointers.Count() == 0);
+		TEST_ASSERT(moved[a.Obj()] == 1);
+	});
+
+	TEST_CASE(L"Test OrderedDictionary<K, V> with CopyFrom")
+	{
+		Dictionary<vint, vint> sorted;
+		for (vint i = 0; i < 10; i++)
+		{
+			sorted.Add(9 - i, i);
+		}
+
+		OrderedDictionary<vint, vint> dictionary;
+		CopyFrom(dictionary, sorted);
+		CHECK_ORDERED_DICTIONARY_ITEMS(dictionary, { 0 _ 1 _ 2 _ 3 _ 4 _ 5 _ 6 _ 7 _ 8 _ 9 }, { 9 _ 8 _ 7 _ 6 _ 5 _ 4 _ 3 _ 2 _ 1 _ 0 });
+
+		Dictionary<vint, vint> copied;
+		CopyFrom(copied, From(dictionary).Where([](auto&& pair) { return pair.key % 3 == 0; }));
+		CHECK_DICTIONARY_ITEMS(copied, { 0 _ 3 _ 6 _ 9 }, { 9 _ 6 _ 3 _ 0 });
+	});
+}
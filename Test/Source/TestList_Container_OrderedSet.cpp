@@ -0,0 +1,164 @@
+#include "AssertCollection.h"
+#include "../../Source/Collections/OrderedSet.h"
+
+#define CHECK_EMPTY_ORDERED_SET(CONTAINER)\
+	TestReadonlyOrderedSet(CONTAINER, nullptr, 0)\
+
+#define CHECK_ORDERED_SET_ITEMS(CONTAINER,ITEMS)\
+	do{\
+		vint __items__[]=ITEMS;\
+		TestReadonlyOrderedSet(CONTAINER,__items__, sizeof(__items__)/sizeof(*__items__));\
+	}while(0)\
+
+namespace TestList_OrderedSet_TestObjects
+{
+	// OrderedSet cannot be accessed by index, elements are checked by walking through cursors instead
+	template<typename A>
+	void TestReadonlyOrderedSet(const OrderedSet<vint, A>& set, vint* items, vint count)
+	{
+		TEST_ASSERT(set.Count() == count);
+		TEST_ASSERT(set.Last().IsValid() == (count > 0));
+		if (count > 0) TEST_ASSERT(set.Last().Key() == items[count - 1]);
+
+		auto enumerator = set.CreateEnumerator();
+		TestCloningEnumerator(enumerator, items, count);
+		auto cursor = set.First();
+		for (vint i = 0; i < count; i++)
+		{
+			TEST_ASSERT(set.Contains(items[i]));
+			TEST_ASSERT(set.Find(items[i]) == cursor);
+			TEST_ASSERT(cursor.IsValid() && cursor.Key() == items[i]);
+			TEST_ASSERT(cursor.Next() == (i < count - 1));
+			TEST_ASSERT(enumerator->Next());
+			TEST_ASSERT(enumerator->Current() == items[i]);
+			TEST_ASSERT(enumerator->Index() == i);
+		}
+		TEST_ASSERT(!cursor.IsValid());
+		TEST_ASSERT(enumerator->Next() == false);
+		delete enumerator;
+	}
+
+	template<typename A>
+	void TestOrderedSet(OrderedSet<vint, A>& set)
+	{
+		set.Clear();
+		CHECK_EMPTY_ORDERED_SET(set);
+
+		TEST_ASSERT(set.Add(4) == true);
+		TEST_ASSERT(set.Add(2) == true);
+		TEST_ASSERT(set.Add(3) == true);
+		TEST_ASSERT(set.Add(1) == true);
+		TEST_ASSERT(set.Add(2) == false);
+		CHECK_ORDERED_SET_ITEMS(set, { 1 _ 2 _ 3 _ 4 });
+
+		TEST_ASSERT(set.Remove(4) == true);
+		TEST_ASSERT(set.Remove(5) == false);
+		CHECK_ORDERED_SET_ITEMS(set, { 1 _ 2 _ 3 });
+
+		set.Clear();
+		CHECK_EMPTY_ORDERED_SET(set);
+	}
+}
+using namespace TestList_OrderedSet_TestObjects;
+
+TEST_FILE
+{
+	TEST_CASE(L"Test OrderedSet<T>")
+	{
+		OrderedSet<vint> set;
+		TestOrderedSet(set);
+	});
+
+	TEST_CASE(L"Test OrderedSet<T, CountingAllocator>")
+	{
+		TestWithCountingAllocator<OrderedSet<vint, CountingAllocator>>([](auto& set, vint& allocatedBytes, vint& allocations)
+		{
+			TestOrderedSet(set);
+			set.Clear();
+			TEST_ASSERT(allocatedBytes == 0);
+
+			// every leaf is allocated by the allocator
+			const vint Count = 1000;
+			const vint LeafCapacity = btree_internal::BTree<vint, void, CountingAllocator>::LeafCapacity;
+			vint allocationsBeforeAdding = allocations;
+			for (vint i = 0; i < Count; i++)
+			{
+				set.Add(i);
+			}
+			TEST_ASSERT(allocations - allocationsBeforeAdding >= (Count + LeafCapacity - 1) / LeafCapacity);
+		});
+	});
+
+	TEST_CASE(L"Test OrderedSet<T> with many values")
+	{
+		const vint Count = 20000;
+		OrderedSet<vint> set;
+		for (vint i = 0; i < Count; i++)
+		{
+			TEST_ASSERT(set.Add((i * 7919) % Count));
+		}
+		TEST_ASSERT(set.Count() == Count);
+		vint index = 0;
+		for (vint value : set)
+		{
+			TEST_ASSERT(value == index++);
+		}
+
+		for (vint i = 0; i < Count; i += 3)
+		{
+			TEST_ASSERT(set.Remove(i));
+		}
+		for (vint i = 0; i < Count; i++)
+		{
+			TEST_ASSERT(set.Contains(i) == (i % 3 != 0));
+		}
+		TEST_ASSERT(set.LowerBound(3).Key() == 4);
+		TEST_ASSERT(set.UpperBound(4).Key() == 5);
+		TEST_ASSERT(set.Last().Key() == Count - 1);
+
+		for (vint i = 0; i < Count; i++)
+		{
+			set.Remove(i);
+		}
+		CHECK_EMPTY_ORDERED_SET(set);
+	});
+
+	TEST_CASE(L"Test OrderedSet<T> with LoadSorted and CopyFrom")
+	{
+		OrderedSet<vint> set;
+		set.LoadSorted(Range<vint>(0, 1000));
+		TEST_ASSERT(set.Count() == 1000);
+		TEST_ASSERT(set.First().Key() == 0);
+		TEST_ASSERT(set.Last().Key() == 999);
+
+		vint unsorted[] = { 1, 3, 2 };
+		TEST_EXCEPTION(set.LoadSorted(unsorted), Error, [](const Error&) {});
+		CHECK_ORDERED_SET_ITEMS(set, { 1 _ 3 });
+
+		vint replacement[] = { 2, 4 };
+		set.LoadSorted(replacement);
+		CHECK_ORDERED_SET_ITEMS(set, { 2 _ 4 });
+
+		// bulk loading a tree directly must start from an empty tree
+		btree_internal::BTree<vint, void, DefaultAllocator> tree;
+		tree.Insert(false, 1);
+		TEST_EXCEPTION(tree.LoadNext(2), Error, [](const Error&) {});
+		TEST_EXCEPTION(tree.EndLoad(), Error, [](const Error&) {});
+		tree.Clear();
+		tree.LoadNext(2);
+		tree.EndLoad();
+		TEST_EXCEPTION(tree.LoadNext(3), Error, [](const Error&) {});
+		TEST_ASSERT(tree.Count() == 1);
+
+		CopyFrom(set, From(Range<vint>(0, 10)).Select([](vint i) { return (i * 3) % 5; }));
+		CHECK_ORDERED_SET_ITEMS(set, { 0 _ 1 _ 2 _ 3 _ 4 });
+
+		List<vint> list;
+		CopyFrom(list, set);
+		CHECK_LIST_ITEMS(list, { 0 _ 1 _ 2 _ 3 _ 4 });
+
+		OrderedSet<vint> moved(std::move(set));
+		TEST_ASSERT(set.Count() == 0);
+		CHECK_ORDERED_SET_ITEMS(moved, { 0 _ 1 _ 2 _ 3 _ 4 });
+	});
+}
@@ -0,0 +1,157 @@
+#include "AssertCollection.h"
+#include "../../Source/Collections/PersistentDictionary.h"
+
+namespace TestList_Container_PersistentDictionary
+{
+	// only 8 different hash codes, sharing the lowest 60 bits, to create deep branches and collisions
+	struct CollidingHasher
+	{
+		static vuint64_t GetHashCode(vint key)
+		{
+			return ((vuint64_t)(key % 8) << 60) | 0x0FFFFFFFFFFFFFFFULL;
+		}
+	};
+}
+using namespace TestList_Container_PersistentDictionary;
+
+TEST_FILE
+{
+	TEST_CASE(L"Test PersistentDictionary<K, V>")
+	{
+		PersistentDictionary<vint, WString> dictionary;
+		TEST_ASSERT(dictionary.Count() == 0);
+		TEST_ASSERT(From(dictionary).IsEmpty());
+		TEST_EXCEPTION(dictionary.Get(1), Error, [](const Error&) {});
+
+		dictionary.Add(1, L"one");
+		dictionary.Add(2, L"two");
+		TEST_EXCEPTION(dictionary.Add(1, L"uno"), Error, [](const Error&) {});
+		TEST_ASSERT(dictionary.Count() == 2);
+		TEST_ASSERT(dictionary[1] == L"one");
+
+		auto snapshot = dictionary;
+		dictionary.Set(1, L"uno");
+		dictionary.Set(3, L"tres");
+		TEST_ASSERT(dictionary.Remove(2));
+		TEST_ASSERT(!dictionary.Remove(2));
+		TEST_ASSERT(dictionary.Count() == 2);
+		TEST_ASSERT(dictionary.Get(1) == L"uno");
+		TEST_ASSERT(dictionary.Get(3) == L"tres");
+		TEST_ASSERT(!dictionary.Contains(2));
+
+		TEST_ASSERT(snapshot.Count() == 2);
+		TEST_ASSERT(snapshot.Get(1) == L"one");
+		TEST_ASSERT(snapshot.Get(2) == L"two");
+		TEST_ASSERT(!snapshot.Contains(3));
+
+		Dictionary<vint, WString> copied;
+		CopyFrom(copied, snapshot);
+		CHECK_LIST_ITEMS(copied.Keys(), { 1 _ 2 });
+
+		PersistentDictionary<vint, WString> fromDictionary;
+		CopyFrom(fromDictionary, copied);
+		TEST_ASSERT(fromDictionary.Count() == 2);
+		TEST_ASSERT(fromDictionary[2] == L"two");
+
+		dictionary.Clear();
+		TEST_ASSERT(dictionary.Count() == 0);
+		TEST_ASSERT(snapshot.Count() == 2);
+	});
+
+	TEST_CASE(L"Test PersistentDictionary<K, V> with many keys")
+	{
+		const vint Count = 50000;
+		PersistentDictionary<vint, vint> dictionary;
+		List<PersistentDictionary<vint, vint>> snapshots;
+		for (vint i = 0; i < Count; i++)
+		{
+			if (i % 10000 == 0) snapshots.Add(dictionary);
+			dictionary.Add(i, i);
+		}
+
+		auto snapshot = dictionary;
+		for (vint i = 0; i < Count; i += 3)
+		{
+			dictionary.Set(i, -i);
+		}
+		for (vint i = 1; i < Count; i += 3)
+		{
+			dictionary.Remove(i);
+		}
+
+		TEST_ASSERT(dictionary.Count() == Count - (Count + 1) / 3);
+		for (vint i = 0; i < Count; i++)
+		{
+			TEST_ASSERT(snapshot[i] == i);
+			switch (i % 3)
+			{
+			case 0: TEST_ASSERT(dictionary[i] == -i); break;
+			case 1: TEST_ASSERT(!dictionary.Contains(i)); break;
+			case 2: TEST_ASSERT(dictionary[i] == i); break;
+			}
+		}
+		for (vint i = 0; i < snapshots.Count(); i++)
+		{
+			TEST_ASSERT(snapshots[i].Count() == i * 10000);
+			auto keys = From(snapshots[i]).Select([](auto&& pair) { return pair.key; });
+			SortedList<vint> sorted;
+			CopyFrom(sorted, keys);
+			CompareEnumerable(sorted, Range<vint>(0, i * 10000));
+		}
+
+		vint sum = 0;
+		for (auto [key, value] : snapshot)
+		{
+			TEST_ASSERT(key == value);
+			sum += value;
+		}
+		TEST_ASSERT(sum == Count * (Count - 1) / 2);
+
+		for (vint i = 0; i < Count; i++)
+		{
+			snapshot.Remove(i);
+		}
+		TEST_ASSERT(snapshot.Count() == 0);
+		TEST_ASSERT(From(snapshot).IsEmpty());
+	});
+
+	TEST_CASE(L"Test PersistentDictionary<K, V> with colliding hash codes")
+	{
+		PersistentDictionary<vint, vint, CollidingHasher> dictionary;
+		for (vint i = 0; i < 40; i++)
+		{
+			dictionary.Add(i, i * i);
+		}
+		auto snapshot = dictionary;
+		for (vint i = 0; i < 40; i += 2)
+		{
+			dictionary.Remove(i);
+		}
+		dictionary.Set(1, -1);
+
+		TEST_ASSERT(dictionary.Count() == 20);
+		TEST_ASSERT(snapshot.Count() == 40);
+		for (vint i = 0; i < 40; i++)
+		{
+			TEST_ASSERT(snapshot[i] == i * i);
+			TEST_ASSERT(dictionary.Contains(i) == (i % 2 == 1));
+		}
+		TEST_ASSERT(dictionary[1] == -1);
+
+		auto enumerator = Ptr(snapshot.CreateEnumerator());
+		for (vint i = 0; i < 13; i++) enumerator->Next();
+		auto cloned = Ptr(enumerator->Clone());
+		TEST_ASSERT(cloned->Index() == 12);
+		TEST_ASSERT(cloned->Current().key == enumerator->Current().key);
+		vint rest = 0;
+		while (cloned->Next()) rest++;
+		TEST_ASSERT(rest == 27);
+
+		for (vint i = 1; i < 40; i += 2)
+		{
+			TEST_ASSERT(dictionary.Remove(i));
+		}
+		TEST_ASSERT(From(dictionary).IsEmpty());
+		TEST_ASSERT(snapshot.Count() == 40);
+	});
+}
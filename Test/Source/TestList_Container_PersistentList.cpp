@@ -0,0 +1,147 @@
+#include "AssertCollection.h"
+#include "../../Source/Collections/PersistentList.h"
+
+namespace TestList_Container_PersistentList
+{
+	struct Counted
+	{
+		static vint		alive;
+		vint			value = 0;
+
+		Counted(vint _value) :value(_value) { alive++; }
+		Counted(const Counted& c) :value(c.value) { alive++; }
+		~Counted() { alive--; }
+		Counted& operator=(const Counted&) = default;
+		bool operator==(const Counted& c) const { return value == c.value; }
+	};
+	vint Counted::alive = 0;
+}
+using namespace TestList_Container_PersistentList;
+
+TEST_FILE
+{
+	TEST_CASE(L"Test PersistentList<T>")
+	{
+		PersistentList<vint> list;
+		CHECK_EMPTY_LIST(list);
+		TEST_EXCEPTION(list.Get(0), Error, [](const Error&) {});
+		TEST_EXCEPTION(list.RemoveLast(), Error, [](const Error&) {});
+
+		TEST_ASSERT(list.Add(1) == 0);
+		TEST_ASSERT(list.Add(2) == 1);
+		TEST_ASSERT(list.Add(3) == 2);
+		CHECK_LIST_ITEMS(list, { 1 _ 2 _ 3 });
+		TEST_ASSERT(list.IndexOf(3) == 2);
+		TEST_ASSERT(!list.Contains(4));
+
+		auto snapshot = list;
+		list.Set(0, 10);
+		list.RemoveLast();
+		list.Add(4);
+		CHECK_LIST_ITEMS(list, { 10 _ 2 _ 4 });
+		CHECK_LIST_ITEMS(snapshot, { 1 _ 2 _ 3 });
+
+		list = snapshot;
+		CHECK_LIST_ITEMS(list, { 1 _ 2 _ 3 });
+		list.Clear();
+		CHECK_EMPTY_LIST(list);
+		CHECK_LIST_ITEMS(snapshot, { 1 _ 2 _ 3 });
+
+		auto moved = std::move(snapshot);
+		CHECK_EMPTY_LIST(snapshot);
+		CHECK_LIST_ITEMS(moved, { 1 _ 2 _ 3 });
+	});
+
+	TEST_CASE(L"Test PersistentList<T> with multiple levels")
+	{
+		// 32 * 32 * 32 elements fill a trie with 3 levels, the rest goes to the next level and the tail
+		const vint Count = 32 * 32 * 32 + 100;
+		PersistentList<vint> list;
+		List<PersistentList<vint>> snapshots;
+		for (vint i = 0; i < Count; i++)
+		{
+			if (i % 1000 == 0) snapshots.Add(list);
+			list.Add(i);
+		}
+		CompareEnumerable(list, Range<vint>(0, Count));
+		for (vint i = 0; i < snapshots.Count(); i++)
+		{
+			CompareEnumerable(snapshots[i], Range<vint>(0, i * 1000));
+		}
+
+		auto snapshot = list;
+		for (vint i = 0; i < Count; i += 7)
+		{
+			list.Set(i, -i);
+		}
+		for (vint i = 0; i < Count; i++)
+		{
+			TEST_ASSERT(list[i] == (i % 7 == 0 ? -i : i));
+			TEST_ASSERT(snapshot[i] == i);
+		}
+
+		for (vint i = Count; i > 0; i--)
+		{
+			if (i % 5000 == 0 || i < 40)
+			{
+				CompareEnumerable(From(list).Select([](vint x) { return x < 0 ? -x : x; }), Range<vint>(0, i));
+			}
+			list.RemoveLast();
+		}
+		CHECK_EMPTY_LIST(list);
+		CompareEnumerable(snapshot, Range<vint>(0, Count));
+	});
+
+	TEST_CASE(L"Test PersistentList<T> with CopyFrom and LazyList")
+	{
+		List<vint> source;
+		CopyFrom(source, Range<vint>(0, 100));
+
+		PersistentList<vint> list;
+		list.Add(-1);
+		CopyFrom(list, source);
+		CompareEnumerable(list, source);
+		CopyFrom(list, From(source).Where([](vint x) { return x % 2 == 0; }), true);
+		TEST_ASSERT(list.Count() == 150);
+
+		List<vint> target;
+		CopyFrom(target, list);
+		CompareEnumerable(target, list);
+
+		auto snapshot = list;
+		auto evens = From(snapshot).Skip(100);
+		list.Clear();
+		TEST_ASSERT(evens.Count() == 50);
+		TEST_ASSERT(evens.Aggregate([](vint a, vint b) { return a + b; }) == 2450);
+
+		auto enumerator = Ptr(snapshot.CreateEnumerator());
+		for (vint i = 0; i < 40; i++) enumerator->Next();
+		auto cloned = Ptr(enumerator->Clone());
+		TEST_ASSERT(cloned->Index() == 39);
+		TEST_ASSERT(cloned->Current() == 39);
+		TEST_ASSERT(cloned->Next() && cloned->Current() == 40);
+	});
+
+	TEST_CASE(L"Test PersistentList<T> releases elements")
+	{
+		{
+			PersistentList<Counted> list;
+			for (vint i = 0; i < 2000; i++)
+			{
+				list.Add(Counted(i));
+			}
+			auto snapshot = list;
+			list.Set(0, Counted(-1));
+			list.Set(1999, Counted(-1));
+			for (vint i = 0; i < 1000; i++)
+			{
+				list.RemoveLast();
+			}
+			// the list only owns copies of the first leaf and the last 8 elements
+			TEST_ASSERT(Counted::alive == 2000 + 32 + 8);
+			snapshot.Clear();
+			TEST_ASSERT(Counted::alive == 1000);
+		}
+		TEST_ASSERT(Counted::alive == 0);
+	});
+}
@@ -0,0 +1,179 @@
+#include "AssertCollection.h"
+#include "../../Source/Collections/PriorityQueue.h"
+
+TEST_FILE
+{
+	TEST_CASE(L"Test PriorityQueue<T>")
+	{
+		PriorityQueue<vint> queue;
+		TEST_ASSERT(queue.Count() == 0);
+		TEST_EXCEPTION(queue.Top(), Error, [](const Error&) {});
+		TEST_EXCEPTION(queue.Pop(), Error, [](const Error&) {});
+
+		vint items[] = { 5, 3, 8, 1, 9, 2, 7, 3, 6, 0 };
+		for (vint item : items)
+		{
+			queue.Push(item);
+		}
+		TEST_ASSERT(queue.Count() == 10);
+		TEST_ASSERT(queue.Top() == 0);
+
+		List<vint> popped;
+		while (queue.Count() > 0)
+		{
+			popped.Add(queue.Pop());
+		}
+		CHECK_LIST_ITEMS(popped, { 0 _ 1 _ 2 _ 3 _ 3 _ 5 _ 6 _ 7 _ 8 _ 9 });
+	});
+
+	TEST_CASE(L"Test PriorityQueue<T> with orderer and heapify")
+	{
+		List<vint> list;
+		CopyFrom(list, Range<vint>(0, 1000).Select([](vint i) { return (i * 7919) % 1000; }));
+
+		auto orderer = [](vint a, vint b) { return b <=> a; };
+		PriorityQueue<vint, decltype(orderer)> queue(std::move(list), orderer);
+		TEST_ASSERT(list.Count() == 0);
+		TEST_ASSERT(queue.Count() == 1000);
+
+		for (vint i = 999; i >= 500; i--)
+		{
+			TEST_ASSERT(queue.Pop() == i);
+		}
+		queue.Push(2000);
+		queue.Push(-1);
+		TEST_ASSERT(queue.Pop() == 2000);
+		TEST_ASSERT(queue.Top() == 499);
+
+		List<vint> other;
+		other.Add(1);
+		other.Add(3);
+		other.Add(2);
+		queue = std::move(other);
+		TEST_ASSERT(queue.Pop() == 3);
+		TEST_ASSERT(queue.Pop() == 2);
+		TEST_ASSERT(queue.Pop() == 1);
+		TEST_ASSERT(queue.Count() == 0);
+	});
+
+	TEST_CASE(L"Test IndexedPriorityQueue<T>")
+	{
+		IndexedPriorityQueue<vint> queue;
+		TEST_EXCEPTION(queue.Top(), Error, [](const Error&) {});
+		TEST_EXCEPTION(queue.TopHandle(), Error, [](const Error&) {});
+		TEST_EXCEPTION(queue.Get(0), Error, [](const Error&) {});
+
+		vint a = queue.Push(50);
+		vint b = queue.Push(40);
+		vint c = queue.Push(30);
+		vint d = queue.Push(20);
+		TEST_ASSERT(queue.TopHandle() == d);
+
+		queue.DecreaseKey(a, 10);
+		TEST_ASSERT(queue.TopHandle() == a);
+		TEST_ASSERT(queue.Get(a) == 10);
+		TEST_EXCEPTION(queue.DecreaseKey(b, 100), Error, [](const Error&) {});
+
+		TEST_ASSERT(queue.Remove(d) == 20);
+		TEST_ASSERT(!queue.Contains(d));
+		TEST_EXCEPTION(queue.Remove(d), Error, [](const Error&) {});
+
+		vint e = queue.Push(35);
+		TEST_ASSERT(e == d);
+		TEST_ASSERT(queue.Pop() == 10);
+		TEST_ASSERT(queue.Pop() == 30);
+		TEST_ASSERT(queue.Pop() == 35);
+		TEST_ASSERT(queue.TopHandle() == b);
+		TEST_ASSERT(queue.Pop() == 40);
+		TEST_ASSERT(queue.Count() == 0);
+		TEST_ASSERT(!queue.Contains(c));
+	});
+
+	TEST_CASE(L"Test IndexedPriorityQueue<T> with Dijkstra")
+	{
+		const vint Count = 200;
+		auto weight = [](vint from, vint to) { return (from * 31 + to * 17) % 23 + 1; };
+
+		// reference distances from Bellman-Ford relaxation on a complete graph
+		Array<vint> expected(Count);
+		for (vint i = 0; i < Count; i++)
+		{
+			expected[i] = i == 0 ? 0 : weight(0, i);
+		}
+		for (bool changed = true; changed;)
+		{
+			changed = false;
+			for (vint i = 0; i < Count; i++)
+			{
+				for (vint j = 0; j < Count; j++)
+				{
+					if (expected[i] + weight(i, j) < expected[j])
+					{
+						expected[j] = expected[i] + weight(i, j);
+						changed = true;
+					}
+				}
+			}
+		}
+
+		IndexedPriorityQueue<Pair<vint, vint>> queue;
+		Array<vint> handles(Count);
+		Array<vint> distances(Count);
+		for (vint i = 0; i < Count; i++)
+		{
+			distances[i] = -1;
+			handles[i] = queue.Push({ i == 0 ? 0 : weight(0, i), i });
+		}
+		while (queue.Count() > 0)
+		{
+			auto top = queue.Pop();
+			vint distance = top.key;
+			vint node = top.value;
+			distances[node] = distance;
+			for (vint i = 0; i < Count; i++)
+			{
+				if (queue.Contains(handles[i]) && queue.Get(handles[i]).key > distance + weight(node, i))
+				{
+					queue.DecreaseKey(handles[i], { distance + weight(node, i), i });
+				}
+			}
+		}
+		CompareEnumerable(distances, expected);
+	});
+
+	TEST_CASE(L"Test priority queues with Moveonly and CountingAllocator")
+	{
+		TestWithCountingAllocator<PriorityQueue<Moveonly<vint>, DefaultOrderer, CountingAllocator>>([](auto& queue, vint& allocatedBytes, vint& allocations)
+		{
+			// the heap is in one buffer
+			queue.Reserve(100);
+			TEST_ASSERT(allocations == 1);
+			TEST_ASSERT(allocatedBytes == (vint)(sizeof(Moveonly<vint>) * 100));
+			for (vint i = 0; i < 100; i++)
+			{
+				queue.Push(Moveonly<vint>((i * 37) % 100));
+			}
+			TEST_ASSERT(allocations == 1);
+			for (vint i = 0; i < 50; i++)
+			{
+				TEST_ASSERT(queue.Pop().value == i);
+			}
+		}, DefaultOrderer());
+
+		TestWithCountingAllocator<IndexedPriorityQueue<Moveonly<vint>, DefaultOrderer, CountingAllocator>>([](auto& indexed, vint&, vint& allocations)
+		{
+			for (vint i = 0; i < 100; i++)
+			{
+				indexed.Push(Moveonly<vint>((i * 37) % 100));
+			}
+			// nodes and positions of handles are in different buffers
+			TEST_ASSERT(allocations >= 2);
+			for (vint i = 0; i < 50; i++)
+			{
+				TEST_ASSERT(indexed.Pop().value == i);
+			}
+			indexed.DecreaseKey(indexed.TopHandle(), Moveonly<vint>(-1));
+			TEST_ASSERT(indexed.Top().value == -1);
+		}, DefaultOrderer());
+	});
+}
@@ -0,0 +1,289 @@
+#include "AssertCollection.h"
+#include "../../Source/Collections/Queue.h"
+
+TEST_FILE
+{
+	TEST_CASE(L"Test Queue<T>")
+	{
+		Queue<vint> queue;
+		CHECK_EMPTY_LIST(queue);
+		TEST_EXCEPTION(queue.Dequeue(), Error, [](const Error&) {});
+		TEST_EXCEPTION(queue.Peek(), Error, [](const Error&) {});
+
+		for (vint i = 0; i < 3; i++)
+		{
+			queue.Enqueue(i);
+		}
+		CHECK_LIST_ITEMS(queue, { 0 _ 1 _ 2 });
+		TEST_ASSERT(queue.Capacity() == 4);
+
+		// move the head forward so that elements wrap around the end of the buffer
+		TEST_ASSERT(queue.Dequeue() == 0);
+		TEST_ASSERT(queue.Dequeue() == 1);
+		queue.Enqueue(3);
+		queue.Enqueue(4);
+		queue.Enqueue(5);
+		TEST_ASSERT(queue.Capacity() == 4);
+		CHECK_LIST_ITEMS(queue, { 2 _ 3 _ 4 _ 5 });
+
+		queue.Enqueue(6);
+		TEST_ASSERT(queue.Capacity() == 8);
+		CHECK_LIST_ITEMS(queue, { 2 _ 3 _ 4 _ 5 _ 6 });
+		TEST_ASSERT(queue.Peek() == 2);
+
+		vint sum = 0;
+		for (vint item : queue)
+		{
+			sum += item;
+		}
+		TEST_ASSERT(sum == 20);
+
+		queue.Clear();
+		CHECK_EMPTY_LIST(queue);
+		TEST_ASSERT(queue.Capacity() == 0);
+	});
+
+	TEST_CASE(L"Test Queue<T> with many values")
+	{
+		const vint Count = 100000;
+		Queue<vint> queue;
+		queue.Reserve(100);
+		TEST_ASSERT(queue.Capacity() == 128);
+
+		vint next = 0;
+		for (vint i = 0; i < Count; i++)
+		{
+			queue.Enqueue(i);
+			if (i % 3 != 0)
+			{
+				TEST_ASSERT(queue.Dequeue() == next++);
+			}
+		}
+		TEST_ASSERT(queue.Count() == Count - next);
+		for (vint i = 0; i < queue.Count(); i++)
+		{
+			TEST_ASSERT(queue[i] == next + i);
+		}
+		while (queue.Count() > 0)
+		{
+			TEST_ASSERT(queue.Dequeue() == next++);
+		}
+		TEST_ASSERT(next == Count);
+	});
+
+	TEST_CASE(L"Test Deque<T>")
+	{
+		Deque<vint> deque;
+		CHECK_EMPTY_LIST(deque);
+		TEST_EXCEPTION(deque.PopFront(), Error, [](const Error&) {});
+		TEST_EXCEPTION(deque.PopBack(), Error, [](const Error&) {});
+		TEST_EXCEPTION(deque.Front(), Error, [](const Error&) {});
+		TEST_EXCEPTION(deque.Back(), Error, [](const Error&) {});
+
+		deque.PushBack(3);
+		deque.PushFront(2);
+		deque.PushBack(4);
+		deque.PushFront(1);
+		deque.PushFront(0);
+		CHECK_LIST_ITEMS(deque, { 0 _ 1 _ 2 _ 3 _ 4 });
+		TEST_ASSERT(deque.Front() == 0);
+		TEST_ASSERT(deque.Back() == 4);
+
+		TEST_ASSERT(deque.PopBack() == 4);
+		TEST_ASSERT(deque.PopFront() == 0);
+		CHECK_LIST_ITEMS(deque, { 1 _ 2 _ 3 });
+
+		List<vint> list;
+		CopyFrom(list, deque);
+		CHECK_LIST_ITEMS(list, { 1 _ 2 _ 3 });
+		CopyFrom(deque, From(list).Select([](vint i) { return i * 10; }), true);
+		CHECK_LIST_ITEMS(deque, { 1 _ 2 _ 3 _ 10 _ 20 _ 30 });
+	});
+
+	TEST_CASE(L"Test Deque<T> with random operations")
+	{
+		Deque<vint> deque;
+		List<vint> reference;
+		vuint seed = 1;
+		for (vint i = 0; i < 20000; i++)
+		{
+			seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			switch ((seed >> 33) % 5)
+			{
+			case 0:
+			case 1:
+				deque.PushBack(i);
+				reference.Add(i);
+				break;
+			case 2:
+				deque.PushFront(i);
+				reference.Insert(0, i);
+				break;
+			case 3:
+				if (reference.Count() > 0)
+				{
+					TEST_ASSERT(deque.PopFront() == reference[0]);
+					reference.RemoveAt(0);
+				}
+				break;
+			case 4:
+				if (reference.Count() > 0)
+				{
+					TEST_ASSERT(deque.PopBack() == reference[reference.Count() - 1]);
+					reference.RemoveAt(reference.Count() - 1);
+				}
+				break;
+			}
+		}
+		CompareEnumerable(deque, reference);
+	});
+
+	TEST_CASE(L"Test FixedRingBuffer<T>")
+	{
+		FixedRingBuffer<vint> buffer(3);
+		CHECK_EMPTY_LIST(buffer);
+		TEST_ASSERT(buffer.MaxCount() == 3);
+		TEST_EXCEPTION(FixedRingBuffer<vint>(0), Error, [](const Error&) {});
+
+		TEST_ASSERT(buffer.PushBack(1) == false);
+		TEST_ASSERT(buffer.PushBack(2) == false);
+		TEST_ASSERT(buffer.PushBack(3) == false);
+		TEST_ASSERT(buffer.PushBack(4) == true);
+		TEST_ASSERT(buffer.PushBack(5) == true);
+		CHECK_LIST_ITEMS(buffer, { 3 _ 4 _ 5 });
+
+		TEST_ASSERT(buffer.PushFront(2) == true);
+		CHECK_LIST_ITEMS(buffer, { 2 _ 3 _ 4 });
+		TEST_ASSERT(buffer.Capacity() == 4);
+
+		TEST_ASSERT(buffer.PopBack() == 4);
+		TEST_ASSERT(buffer.PushFront(1) == false);
+		CHECK_LIST_ITEMS(buffer, { 1 _ 2 _ 3 });
+		TEST_ASSERT(buffer.PopFront() == 1);
+
+		CopyFrom(buffer, Range<vint>(0, 10));
+		CHECK_LIST_ITEMS(buffer, { 7 _ 8 _ 9 });
+	});
+
+	TEST_CASE(L"Test Queue<T> and Deque<T> adding their own elements when full")
+	{
+		auto check = [](const IEnumerable<WString>& container, const wchar_t* expected)
+		{
+			List<WString> items;
+			for (auto item = expected; *item; item++)
+			{
+				items.Add(WString::FromChar(*item));
+			}
+			CompareEnumerable(container, items);
+		};
+
+		Queue<WString> queue;
+		for (vint i = 0; i < 4; i++)
+		{
+			queue.Enqueue(itow(i));
+		}
+		TEST_ASSERT(queue.Capacity() == queue.Count());
+		queue.Enqueue(queue.Peek());
+		TEST_ASSERT(queue.Capacity() == 8);
+		check(queue, L"01230");
+
+		Deque<WString> backDeque;
+		for (vint i = 0; i < 4; i++)
+		{
+			backDeque.PushBack(itow(i));
+		}
+		backDeque.PushBack(backDeque.Front());
+		check(backDeque, L"01230");
+
+		Deque<WString> frontDeque;
+		for (vint i = 0; i < 4; i++)
+		{
+			frontDeque.PushBack(itow(i));
+		}
+		frontDeque.PushFront(frontDeque.Back());
+		check(frontDeque, L"30123");
+		frontDeque.PushFront(L"4");
+		frontDeque.PushBack(L"5");
+		check(frontDeque, L"4301235");
+	});
+
+	TEST_CASE(L"Test FixedRingBuffer<T> adding its own elements")
+	{
+		for (vint maxCount = 2; maxCount <= 4; maxCount++)
+		{
+			FixedRingBuffer<WString> buffer(maxCount);
+			for (vint i = 0; i < maxCount; i++)
+			{
+				buffer.PushBack(itow(i));
+			}
+
+			TEST_ASSERT(buffer.PushBack(buffer[0]) == true);
+			TEST_ASSERT(buffer.Count() == maxCount);
+			TEST_ASSERT(buffer[0] == L"1");
+			TEST_ASSERT(buffer[maxCount - 1] == L"0");
+
+			TEST_ASSERT(buffer.PushFront(buffer[maxCount - 1]) == true);
+			TEST_ASSERT(buffer.Count() == maxCount);
+			for (vint i = 0; i < maxCount; i++)
+			{
+				TEST_ASSERT(buffer[i] == itow(i));
+			}
+		}
+	});
+
+	TEST_CASE(L"Test ring buffers with Moveonly and CountingAllocator")
+	{
+		TestWithCountingAllocator<Queue<Moveonly<vint>, CountingAllocator>>([](auto& queue, vint& allocatedBytes, vint& allocations)
+		{
+			for (vint i = 0; i < 100; i++)
+			{
+				queue.Enqueue(Moveonly<vint>(i));
+			}
+			TEST_ASSERT(allocatedBytes == (vint)(sizeof(Moveonly<vint>) * queue.Capacity()));
+			for (vint i = 0; i < 50; i++)
+			{
+				TEST_ASSERT(queue.Dequeue().value == i);
+			}
+
+			vint allocationsBeforeMoving = allocations;
+			Queue<Moveonly<vint>, CountingAllocator> moved(std::move(queue));
+			TEST_ASSERT(queue.Count() == 0);
+			TEST_ASSERT(moved.Count() == 50);
+			TEST_ASSERT(moved.Peek().value == 50);
+			TEST_ASSERT(allocations == allocationsBeforeMoving);
+		});
+
+		TestWithCountingAllocator<Deque<Moveonly<vint>, CountingAllocator>>([](auto& deque, vint& allocatedBytes, vint& allocations)
+		{
+			for (vint i = 0; i < 100; i++)
+			{
+				deque.PushFront(Moveonly<vint>(i));
+			}
+			TEST_ASSERT(allocatedBytes == (vint)(sizeof(Moveonly<vint>) * deque.Capacity()));
+			for (vint i = 0; i < 50; i++)
+			{
+				TEST_ASSERT(deque.PopFront().value == 99 - i);
+			}
+
+			Deque<Moveonly<vint>, CountingAllocator> moved(CountingAllocator(&allocatedBytes, &allocations));
+			moved.PushBack(Moveonly<vint>(-1));
+			moved = std::move(deque);
+			TEST_ASSERT(deque.Count() == 0);
+			TEST_ASSERT(moved.Back().value == 0);
+			TEST_ASSERT(allocatedBytes == (vint)(sizeof(Moveonly<vint>) * moved.Capacity()));
+		});
+
+		TestWithCountingAllocator<FixedRingBuffer<Moveonly<vint>, CountingAllocator>>([](auto& buffer, vint& allocatedBytes, vint& allocations)
+		{
+			// the buffer never grows beyond the maximum number of elements
+			for (vint i = 0; i < 100; i++)
+			{
+				buffer.PushBack(Moveonly<vint>(i));
+			}
+			TEST_ASSERT(allocatedBytes == (vint)(sizeof(Moveonly<vint>) * buffer.Capacity()));
+			TEST_ASSERT(buffer.Capacity() == 8);
+			TEST_ASSERT(allocations <= 2);
+			TEST_ASSERT(buffer.PopFront().value == 95);
+		}, 5);
+	});
+}
@@ -0,0 +1,229 @@
+#include "AssertCollection.h"
+#include "../../Source/Collections/SlotMap.h"
+
+namespace TestList_Container_SlotMap
+{
+	struct Counted
+	{
+		static vint		alive;
+		vint			value;
+
+		Counted(vint _value) :value(_value) { alive++; }
+		Counted(const Counted& c) :value(c.value) { alive++; }
+		~Counted() { alive--; }
+		Counted& operator=(const Counted& c) { value = c.value; return *this; }
+	};
+	vint Counted::alive = 0;
+
+	template<typename T, typename TAllocator>
+	void CheckHandles(const SlotMap<T, TAllocator>& map)
+	{
+		for (vint i = 0; i < map.Count(); i++)
+		{
+			auto handle = map.GetHandle(i);
+			TEST_ASSERT(map.Contains(handle));
+			TEST_ASSERT(map.IndexOf(handle) == i);
+			TEST_ASSERT(&map.Get(handle) == &map.Get(i));
+		}
+	}
+}
+using namespace TestList_Container_SlotMap;
+
+#define CHECK_SLOTMAP_ITEMS(MAP, ITEMS)\
+	do{\
+		vint __items__[]=ITEMS;\
+		TEST_ASSERT(MAP.Count() == sizeof(__items__)/sizeof(*__items__));\
+		TestLazyList(MAP, __items__, sizeof(__items__)/sizeof(*__items__));\
+		CheckHandles(MAP);\
+	}while(0)\
+
+TEST_FILE
+{
+	TEST_CASE(L"Test SlotMap<T>")
+	{
+		SlotMap<vint> map;
+		TEST_ASSERT(map.Count() == 0);
+		TEST_ASSERT(!map.Contains(SlotMapHandle{}));
+		TEST_ASSERT(map.IndexOf(SlotMapHandle{}) == -1);
+
+		auto h1 = map.Add(1);
+		auto h2 = map.Add(2);
+		auto h3 = map.Add(3);
+		auto h4 = map.Add(4);
+		CHECK_SLOTMAP_ITEMS(map, { 1 _ 2 _ 3 _ 4 });
+		TEST_ASSERT(map[h1] == 1);
+		TEST_ASSERT(map[h2] == 2);
+		TEST_ASSERT(map.Get(h3) == 3);
+		TEST_ASSERT(map.Get(h4) == 4);
+
+		TEST_ASSERT(map.Remove(h2));
+		CHECK_SLOTMAP_ITEMS(map, { 1 _ 4 _ 3 });
+		TEST_ASSERT(!map.Contains(h2));
+		TEST_ASSERT(!map.Remove(h2));
+		TEST_ASSERT(map[h4] == 4);
+		TEST_EXCEPTION(map[h2], Error, [](auto&&) {});
+
+		map[h4] = 40;
+		TEST_ASSERT(map.Get(1) == 40);
+
+		TEST_ASSERT(map.Remove(h4));
+		TEST_ASSERT(map.Remove(h1));
+		CHECK_SLOTMAP_ITEMS(map, { 3 });
+		TEST_ASSERT(map.Remove(h3));
+		TEST_ASSERT(map.Count() == 0);
+	});
+
+	TEST_CASE(L"Test SlotMap<T> reusing slots")
+	{
+		SlotMap<vint> map;
+		auto h1 = map.Add(1);
+		auto h2 = map.Add(2);
+		TEST_ASSERT(map.Remove(h1));
+
+		auto h3 = map.Add(3);
+		TEST_ASSERT(h3.index == h1.index);
+		TEST_ASSERT(h3.generation != h1.generation);
+		TEST_ASSERT(h3 != h1);
+		TEST_ASSERT(!map.Contains(h1));
+		TEST_ASSERT(map[h3] == 3);
+		CHECK_SLOTMAP_ITEMS(map, { 2 _ 3 });
+
+		TEST_ASSERT(map.Clear());
+		TEST_ASSERT(map.Count() == 0);
+		TEST_ASSERT(!map.Contains(h2));
+		TEST_ASSERT(!map.Contains(h3));
+
+		auto h4 = map.Add(4);
+		auto h5 = map.Add(5);
+		auto h6 = map.Add(6);
+		TEST_ASSERT(h4 != h2 && h4 != h3);
+		TEST_ASSERT(h5 != h2 && h5 != h3);
+		TEST_ASSERT(h6.index == 2);
+		CHECK_SLOTMAP_ITEMS(map, { 4 _ 5 _ 6 });
+	});
+
+	TEST_CASE(L"Test SlotMap<T> with many values")
+	{
+		const vint Count = 1000;
+		SlotMap<vint> map;
+		List<SlotMapHandle> handles;
+		for (vint round = 0; round < 3; round++)
+		{
+			for (vint i = 0; i < Count; i++)
+			{
+				handles.Add(map.Add(i));
+			}
+
+			for (vint i = 0; i < Count; i += 3)
+			{
+				TEST_ASSERT(map.Remove(handles[i]));
+			}
+			TEST_ASSERT(map.Count() == Count - (Count + 2) / 3);
+			for (vint i = 0; i < Count; i++)
+			{
+				TEST_ASSERT(map.Contains(handles[i]) == (i % 3 != 0));
+				if (i % 3 != 0)
+				{
+					TEST_ASSERT(map[handles[i]] == i);
+				}
+			}
+			CheckHandles(map);
+
+			for (vint i = 0; i < Count; i++)
+			{
+				map.Remove(handles[i]);
+			}
+			TEST_ASSERT(map.Count() == 0);
+			handles.Clear();
+		}
+	});
+
+	TEST_CASE(L"Test SlotMap<T> with Moveonly and Copyable")
+	{
+		SlotMap<Moveonly<vint>> moveonlys;
+		auto m1 = moveonlys.Add(Moveonly<vint>(1));
+		auto m2 = moveonlys.Add(Moveonly<vint>(2));
+		auto m3 = moveonlys.Add(Moveonly<vint>(3));
+		TEST_ASSERT(moveonlys.Remove(m1));
+		TEST_ASSERT(moveonlys[m2].value == 2);
+		TEST_ASSERT(moveonlys[m3].value == 3);
+		TEST_ASSERT(moveonlys.Get(0).value == 3);
+
+		SlotMap<Moveonly<vint>> moved(std::move(moveonlys));
+		TEST_ASSERT(moveonlys.Count() == 0);
+		TEST_ASSERT(!moveonlys.Contains(m2));
+		TEST_ASSERT(moved.Count() == 2);
+		TEST_ASSERT(moved[m2].value == 2);
+
+		SlotMap<Copyable<vint>> copyables;
+		auto h1 = copyables.Add(Copyable<vint>(1));
+		auto h2 = copyables.Add(Copyable<vint>(2));
+		TEST_ASSERT(copyables.Remove(h1));
+		TEST_ASSERT(*copyables[h2].value.Obj() == 2);
+		copyables = SlotMap<Copyable<vint>>();
+		TEST_ASSERT(copyables.Count() == 0);
+		TEST_ASSERT(!copyables.Contains(h2));
+	});
+
+	TEST_CASE(L"Test SlotMap<T> destructing elements")
+	{
+		{
+			SlotMap<Counted> map;
+			auto h1 = map.Add(Counted(1));
+			auto h2 = map.Add(Counted(2));
+			map.Add(Counted(3));
+			TEST_ASSERT(Counted::alive == 3);
+			TEST_ASSERT(map.Remove(h1));
+			TEST_ASSERT(Counted::alive == 2);
+			TEST_ASSERT(map[h2].value == 2);
+			TEST_ASSERT(map.Get(0).value == 3);
+		}
+		TEST_ASSERT(Counted::alive == 0);
+	});
+
+	TEST_CASE(L"Test SlotMap<T> with CopyFrom")
+	{
+		SlotMap<vint> map;
+		List<vint> list;
+		CopyFrom(map, From(list));
+		TEST_ASSERT(map.Count() == 0);
+		for (vint i = 0; i < 5; i++)
+		{
+			list.Add(i);
+		}
+		CopyFrom(map, list);
+		CHECK_SLOTMAP_ITEMS(map, { 0 _ 1 _ 2 _ 3 _ 4 });
+		map.Remove(map.GetHandle(0));
+		CopyFrom(list, map);
+		CHECK_LIST_ITEMS(list, { 4 _ 1 _ 2 _ 3 });
+	});
+
+	TEST_CASE(L"Test SlotMap<T, CountingAllocator>")
+	{
+		TestWithCountingAllocator<SlotMap<vint, CountingAllocator>>([](auto& map, vint& allocatedBytes, vint& allocations)
+		{
+			// elements, slots and slots of elements are in three buffers
+			auto h1 = map.Add(1);
+			TEST_ASSERT(allocations == 3);
+			map.Add(2);
+			map.Remove(h1);
+
+			vint allocationsBeforeMoving = allocations;
+			vint bytesBeforeMoving = allocatedBytes;
+			SlotMap<vint, CountingAllocator> moved(std::move(map));
+			TEST_ASSERT(moved.Count() == 1);
+			TEST_ASSERT(allocations == allocationsBeforeMoving);
+			TEST_ASSERT(allocatedBytes == bytesBeforeMoving);
+		});
+	});
+
+	TEST_CASE(L"Test Hasher<SlotMapHandle>")
+	{
+		SlotMapHandle a{ 1, 1 }, b{ 1, 3 }, c{ 3, 1 };
+		TEST_ASSERT(Hasher<SlotMapHandle>::GetHashCode(a) == Hasher<SlotMapHandle>::GetHashCode(SlotMapHandle{ 1, 1 }));
+		TEST_ASSERT(Hasher<SlotMapHandle>::GetHashCode(a) != Hasher<SlotMapHandle>::GetHashCode(b));
+		TEST_ASSERT(Hasher<SlotMapHandle>::GetHashCode(a) != Hasher<SlotMapHandle>::GetHashCode(c));
+		TEST_ASSERT(a < b);
+		TEST_ASSERT(a < c);
+	});
+}
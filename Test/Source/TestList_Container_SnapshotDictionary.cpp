@@ -0,0 +1,144 @@
+#include <thread>
+#include "AssertCollection.h"
+#include "../../Source/Collections/SnapshotDictionary.h"
+
+TEST_FILE
+{
+	TEST_CASE(L"Test SnapshotDictionary<K, V>")
+	{
+		SnapshotDictionary<vint, WString> dictionary;
+		auto empty = dictionary.GetSnapshot();
+		TEST_ASSERT(empty->Count() == 0);
+		TEST_ASSERT(dictionary.Count() == 0);
+
+		dictionary.Set(2, L"two");
+		dictionary.Set(1, L"one");
+		auto first = dictionary.GetSnapshot();
+		TEST_ASSERT(first->Count() == 2);
+
+		WString value;
+		TEST_ASSERT(dictionary.TryGet(1, value) && value == L"one");
+		TEST_ASSERT(!dictionary.TryGet(3, value));
+		TEST_ASSERT(dictionary.Contains(2));
+
+		dictionary.Update([](Dictionary<vint, WString>& version)
+		{
+			version.Set(1, L"uno");
+			version.Set(3, L"tres");
+		});
+		TEST_ASSERT(dictionary.Remove(2));
+		TEST_ASSERT(!dictionary.Remove(2));
+		CHECK_LIST_ITEMS(dictionary.GetSnapshot()->Keys(), { 1 _ 3 });
+		TEST_ASSERT(dictionary.TryGet(1, value) && value == L"uno");
+
+		// versions taken earlier do not change
+		TEST_ASSERT(empty->Count() == 0);
+		CHECK_LIST_ITEMS(first->Keys(), { 1 _ 2 });
+		TEST_ASSERT(first->Get(1) == L"one");
+
+		TEST_EXCEPTION(dictionary.Update([](Dictionary<vint, WString>& version)
+		{
+			version.Clear();
+			CHECK_FAIL(L"Update is cancelled.");
+		}), Error, [](const Error&) {});
+		TEST_ASSERT(dictionary.Count() == 2);
+
+		Dictionary<vint, WString> replacement;
+		replacement.Add(10, L"ten");
+		dictionary.Publish(std::move(replacement));
+		TEST_ASSERT(replacement.Count() == 0);
+		CHECK_LIST_ITEMS(dictionary.GetSnapshot()->Keys(), { 10 });
+
+		// the callback runs without locking, and it is called again when another version is published
+		vint calls = 0;
+		dictionary.Update([&](Dictionary<vint, WString>& version)
+		{
+			if (calls++ == 0) dictionary.Set(20, L"twenty");
+			version.Set(30, L"thirty");
+		});
+		TEST_ASSERT(calls == 2);
+		CHECK_LIST_ITEMS(dictionary.GetSnapshot()->Keys(), { 10 _ 20 _ 30 });
+	});
+
+	TEST_CASE(L"Test SnapshotDictionary<K, V> releases versions")
+	{
+		vint allocatedBytes = 0;
+		{
+			SnapshotDictionary<vint, vint, CountingAllocator> dictionary(&allocatedBytes);
+			for (vint i = 0; i < 100; i++)
+			{
+				dictionary.Set(i, i);
+			}
+			auto snapshot = dictionary.GetSnapshot();
+			vint bytesForOneVersion = allocatedBytes;
+			dictionary.Set(100, 100);
+			vint bytesForTwoVersions = allocatedBytes;
+			TEST_ASSERT(bytesForTwoVersions > bytesForOneVersion);
+			snapshot = nullptr;
+			TEST_ASSERT(allocatedBytes < bytesForTwoVersions);
+		}
+		TEST_ASSERT(allocatedBytes == 0);
+	});
+
+	TEST_CASE(L"Test SnapshotDictionary<K, V> with readers and writers")
+	{
+		const vint Readers = 6;
+		const vint Versions = 2000;
+		SnapshotDictionary<vint, vint> dictionary;
+		std::atomic<bool> finished{ false };
+		std::atomic<bool> inconsistent{ false };
+
+		std::thread readers[Readers];
+		for (auto& reader : readers)
+		{
+			reader = std::thread([&]()
+			{
+				vint lastVersion = -1;
+				while (!finished)
+				{
+					// every version has keys 0 to 9 with the same value, and versions only grow
+					auto snapshot = dictionary.GetSnapshot();
+					if (snapshot->Count() == 0) continue;
+					vint version = snapshot->Get(0);
+					if (snapshot->Count() != 10 || version < lastVersion) inconsistent = true;
+					for (vint i = 0; i < snapshot->Count(); i++)
+					{
+						if (snapshot->Values()[i] != version) inconsistent = true;
+					}
+					lastVersion = version;
+				}
+			});
+		}
+
+		std::thread writers[2];
+		for (vint t = 0; t < 2; t++)
+		{
+			writers[t] = std::thread([&, t]()
+			{
+				for (vint v = t; v < Versions; v += 2)
+				{
+					dictionary.Update([](Dictionary<vint, vint>& version)
+					{
+						vint next = version.Count() == 0 ? 0 : version.Get(0) + 1;
+						for (vint i = 0; i < 10; i++)
+						{
+							version.Set(i, next);
+						}
+					});
+				}
+			});
+		}
+		for (auto& writer : writers)
+		{
+			writer.join();
+		}
+		finished = true;
+		for (auto& reader : readers)
+		{
+			reader.join();
+		}
+
+		TEST_ASSERT(!inconsistent);
+		TEST_ASSERT(dictionary.GetSnapshot()->Get(0) == Versions - 1);
+	});
+}
@@ -67,6 +67,55 @@ TEST_FILE
 		TestSortedCollection(list);
 	});
 
+	TEST_CASE(L"Test SortedList<Copyable<vint>, CountingAllocator>")
+	{
+		TestWithCountingAllocator<SortedList<Copyable<vint>, CountingAllocator>>([](auto& list, vint& allocatedBytes, vint&)
+		{
+			TestCollectionWithIncreasingItems(list);
+			TestSortedCollection(list);
+
+			for (vint i = 0; i < 10; i++)
+			{
+				list.Add(i);
+			}
+			TEST_ASSERT(allocatedBytes == (vint)(sizeof(Copyable<vint>) * list.Capacity()));
+		});
+	});
+
+	TEST_CASE(L"Test BinarySearchLambda")
+	{
+		for (vint count = 0; count < 40; count++)
+		{
+			// every number appears twice
+			List<vint> numbers;
+			for (vint i = 0; i < count; i++)
+			{
+				numbers.Add(i / 2 * 2);
+			}
+
+			for (vint item = -1; item <= count + 1; item++)
+			{
+				vint lowerBound = 0;
+				while (lowerBound < count && numbers[lowerBound] < item) lowerBound++;
+
+				vint index = -2;
+				vint result = BinarySearchLambda2(count == 0 ? nullptr : &numbers[0], count, item, index);
+				TEST_ASSERT(result == (lowerBound < count && numbers[lowerBound] == item ? lowerBound : -1));
+				TEST_ASSERT(index == (count == 0 ? -1 : lowerBound < count ? lowerBound : count - 1));
+			}
+		}
+
+		SortedList<vint> list;
+		for (vint i = 0; i < 5; i++)
+		{
+			list.Add(1);
+			list.Add(2);
+		}
+		TEST_ASSERT(list.IndexOf(1) == 0);
+		TEST_ASSERT(list.IndexOf(2) == 5);
+		TEST_ASSERT(list.IndexOf(3) == -1);
+	});
+
 	TEST_CASE(L"Ensure container move constructor and assignment")
 	{
 		{
@@ -0,0 +1,216 @@
+#include <thread>
+#include "../../Source/UnitTest/UnitTest.h"
+#include "../../Source/Primitives/ObjectPool.h"
+
+using namespace vl;
+
+namespace TestObjectPool_TestObjects
+{
+	struct Node
+	{
+		vint*		destructed;
+		vint		value;
+
+		Node(vint* _destructed, vint _value)
+			: destructed(_destructed)
+			, value(_value)
+		{
+		}
+
+		~Node()
+		{
+			(*destructed)++;
+		}
+	};
+
+	struct alignas(64) AlignedNode
+	{
+		vint		value;
+	};
+
+	class PooledBase : public Object
+	{
+	public:
+		OBJECT_POOL_ALLOCATION(PooledBase)
+
+		vint		value = 0;
+
+		virtual ~PooledBase() = default;
+	};
+
+	class PooledDerived : public PooledBase
+	{
+	public:
+		vint		values[16] = { 0 };
+	};
+}
+using namespace TestObjectPool_TestObjects;
+
+// defined in TestObjectPool_Enabled.cpp, which is compiled with VCZH_OBJECT_POOL
+namespace TestObjectPool_Enabled
+{
+	extern void TestPtr();
+	extern void TestFunc();
+	extern void TestEnumerators();
+}
+
+TEST_FILE
+{
+	TEST_CASE(L"Test ObjectPool<T>")
+	{
+		vint destructed = 0;
+		{
+			ObjectPool<Node> pool(16);
+			Node* nodes[100];
+			for (vint i = 0; i < 100; i++)
+			{
+				nodes[i] = pool.New(&destructed, i);
+				TEST_ASSERT((vuint)nodes[i] % alignof(Node) == 0);
+			}
+			TEST_ASSERT(pool.GetAllocatedCount() == 100);
+			for (vint i = 0; i < 100; i++)
+			{
+				TEST_ASSERT(nodes[i]->value == i);
+			}
+
+			for (vint i = 0; i < 100; i += 2)
+			{
+				pool.Delete(nodes[i]);
+			}
+			TEST_ASSERT(destructed == 50);
+			TEST_ASSERT(pool.GetAllocatedCount() == 50);
+
+			for (vint i = 0; i < 100; i += 2)
+			{
+				nodes[i] = pool.New(&destructed, -i);
+			}
+			for (vint i = 0; i < 100; i++)
+			{
+				TEST_ASSERT(nodes[i]->value == (i % 2 == 0 ? -i : i));
+			}
+
+			for (vint i = 0; i < 100; i++)
+			{
+				pool.Delete(nodes[i]);
+			}
+			TEST_ASSERT(destructed == 150);
+			TEST_ASSERT(pool.GetAllocatedCount() == 0);
+		}
+	});
+
+	TEST_CASE(L"Test ObjectPool<T> with cache line aligned objects")
+	{
+		ObjectPool<AlignedNode> pool;
+		AlignedNode* nodes[100];
+		for (vint i = 0; i < 100; i++)
+		{
+			nodes[i] = pool.New(AlignedNode{ i });
+			TEST_ASSERT((vuint)nodes[i] % 64 == 0);
+		}
+		for (vint i = 0; i < 100; i++)
+		{
+			TEST_ASSERT(nodes[i]->value == i);
+			pool.Delete(nodes[i]);
+		}
+		TEST_ASSERT(pool.GetAllocatedCount() == 0);
+	});
+
+	TEST_CASE(L"Test ConcurrentObjectPool<T>")
+	{
+		ConcurrentObjectPool<vint> pool;
+		std::thread threads[4];
+		for (vint t = 0; t < 4; t++)
+		{
+			threads[t] = std::thread([&pool, t]()
+			{
+				vint* items[64];
+				for (vint round = 0; round < 100; round++)
+				{
+					for (vint i = 0; i < 64; i++)
+					{
+						items[i] = (vint*)pool.Allocate();
+						*items[i] = t * 1000 + i;
+					}
+					for (vint i = 0; i < 64; i++)
+					{
+						CHECK_ERROR(*items[i] == t * 1000 + i, L"Memory from ConcurrentObjectPool<T> is shared between threads.");
+						pool.Deallocate(items[i]);
+					}
+				}
+			});
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+		TEST_ASSERT(pool.GetAllocatedCount() == 0);
+
+		void* batch[10];
+		pool.AllocateBatch(batch, 10);
+		TEST_ASSERT(pool.GetAllocatedCount() == 10);
+		pool.DeallocateBatch(batch, 10);
+		TEST_ASSERT(pool.GetAllocatedCount() == 0);
+	});
+
+	TEST_CASE(L"Test GlobalObjectPool<T>")
+	{
+		vint destructed = 0;
+		Node* nodes[100];
+		for (vint i = 0; i < 100; i++)
+		{
+			nodes[i] = GlobalObjectPool<Node>::New(&destructed, i);
+		}
+		for (vint i = 0; i < 100; i++)
+		{
+			TEST_ASSERT(nodes[i]->value == i);
+			GlobalObjectPool<Node>::Delete(nodes[i]);
+		}
+		TEST_ASSERT(destructed == 100);
+
+		std::thread thread([&destructed]()
+		{
+			auto node = GlobalObjectPool<Node>::New(&destructed, 0);
+			GlobalObjectPool<Node>::Delete(node);
+		});
+		thread.join();
+		TEST_ASSERT(destructed == 101);
+	});
+
+	TEST_CASE(L"Test OBJECT_POOL_ALLOCATION")
+	{
+		Ptr<PooledBase> base = Ptr(new PooledBase);
+		Ptr<PooledBase> derived = Ptr(new PooledDerived);
+		base->value = 1;
+		derived->value = 2;
+		TEST_ASSERT(base->value + derived->value == 3);
+		base = nullptr;
+		derived = nullptr;
+
+		PooledBase* items[100];
+		for (vint i = 0; i < 100; i++)
+		{
+			items[i] = i % 2 == 0 ? new PooledBase : new PooledDerived;
+			items[i]->value = i;
+		}
+		for (vint i = 0; i < 100; i++)
+		{
+			TEST_ASSERT(items[i]->value == i);
+			delete items[i];
+		}
+	});
+
+	TEST_CASE(L"Test Ptr<T> with VCZH_OBJECT_POOL")
+	{
+		TestObjectPool_Enabled::TestPtr();
+	});
+
+	TEST_CASE(L"Test Func<T> with VCZH_OBJECT_POOL")
+	{
+		TestObjectPool_Enabled::TestFunc();
+	});
+
+	TEST_CASE(L"Test enumerators with VCZH_OBJECT_POOL")
+	{
+		TestObjectPool_Enabled::TestEnumerators();
+	});
+}
@@ -0,0 +1,132 @@
+// VCZH_OBJECT_POOL should be the same in all translation units that share any instantiation of Ptr, Func or enumerators.
+// So this file only uses types defined here, and test cases are registered in TestObjectPool.cpp,
+// because Func<void()> created by TEST_CASE would be released by the unit test framework.
+#define VCZH_OBJECT_POOL
+
+#include <thread>
+#include "../../Source/UnitTest/UnitTest.h"
+#include "../../Source/Collections/Operation.h"
+
+using namespace vl;
+using namespace vl::collections;
+
+namespace TestObjectPool_Enabled_TestObjects
+{
+	struct PooledValue
+	{
+		vint		value = 0;
+
+		auto operator<=>(const PooledValue&) const = default;
+	};
+
+	PooledValue Triple(PooledValue item)
+	{
+		return { item.value * 3 };
+	}
+
+	template<typename T>
+	class ExposedList : public List<T>
+	{
+	public:
+		using Enumerator = typename ArrayBase<T>::Enumerator;
+	};
+
+	// returns true if running the callback in a new thread takes slots from GlobalObjectPool<TPooled>
+	template<typename TPooled, typename TCallback>
+	bool IsAllocatedFromPool(TCallback&& callback)
+	{
+		bool allocated = false;
+		std::thread thread([&]()
+		{
+			auto& pool = GlobalObjectPool<TPooled>::GetPool();
+			vint allocatedCount = pool.GetAllocatedCount();
+			callback();
+			allocated = pool.GetAllocatedCount() > allocatedCount;
+		});
+		thread.join();
+		return allocated;
+	}
+}
+using namespace TestObjectPool_Enabled_TestObjects;
+
+namespace TestObjectPool_Enabled
+{
+	void TestPtr()
+	{
+		TEST_ASSERT(IsAllocatedFromPool<atomic_vint>([]()
+		{
+			auto a = Ptr(new PooledValue{ 1 });
+			auto b = a;
+			CHECK_ERROR(a == b && b->value == 1, L"Ptr<T> is broken with VCZH_OBJECT_POOL.");
+		}));
+
+		List<Ptr<PooledValue>> items;
+		for (vint i = 0; i < 100; i++)
+		{
+			items.Add(Ptr(new PooledValue{ i }));
+		}
+		for (vint i = 0; i < 100; i += 2)
+		{
+			items[i] = Ptr(new PooledValue{ -i });
+		}
+		for (vint i = 0; i < 100; i++)
+		{
+			TEST_ASSERT(items[i]->value == (i % 2 == 0 ? -i : i));
+		}
+	}
+
+	void TestFunc()
+	{
+		auto add = [](PooledValue a, PooledValue b) { return PooledValue{ a.value + b.value }; };
+		using AddInvoker = internal_invokers::ObjectInvoker<decltype(add), PooledValue, PooledValue, PooledValue>;
+		using TripleInvoker = internal_invokers::StaticInvoker<PooledValue, PooledValue>;
+
+		TEST_ASSERT(IsAllocatedFromPool<AddInvoker>([=]()
+		{
+			Func<PooledValue(PooledValue, PooledValue)> f(add);
+			CHECK_ERROR(f({ 1 }, { 2 }).value == 3, L"Func<T> is broken with VCZH_OBJECT_POOL.");
+		}));
+		TEST_ASSERT(IsAllocatedFromPool<TripleInvoker>([]()
+		{
+			Func<PooledValue(PooledValue)> f(&Triple);
+			CHECK_ERROR(f({ 2 }).value == 6, L"Func<T> is broken with VCZH_OBJECT_POOL.");
+		}));
+
+		Func<PooledValue(PooledValue)> f(&Triple);
+		Func<PooledValue(PooledValue)> g = f;
+		f = Func<PooledValue(PooledValue)>();
+		TEST_ASSERT(g({ 3 }).value == 9);
+	}
+
+	void TestEnumerators()
+	{
+		ExposedList<PooledValue> list;
+		for (vint i = 0; i < 10; i++)
+		{
+			list.Add({ i });
+		}
+
+		TEST_ASSERT(IsAllocatedFromPool<typename ExposedList<PooledValue>::Enumerator>([&]()
+		{
+			vint sum = 0;
+			for (auto item : list)
+			{
+				sum += item.value;
+			}
+			CHECK_ERROR(sum == 45, L"List<T> enumerator is broken with VCZH_OBJECT_POOL.");
+		}));
+
+		vint sum = 0;
+		for (vint round = 0; round < 100; round++)
+		{
+			auto query = From(list)
+				.Where([](PooledValue item) { return item.value % 2 == 1; })
+				.Select(&Triple);
+			for (auto item : query)
+			{
+				sum += item.value;
+			}
+		}
+		TEST_ASSERT(sum == 7500);
+	}
+}